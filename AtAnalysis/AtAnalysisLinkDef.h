@@ -5,6 +5,7 @@
 #pragma link off all functions;
 
 #pragma link C++ class AtRunAna + ;
+#pragma link C++ class AtProfilerTask + ;
 #pragma link C++ class AtFindVertex + ;
 
 #pragma link C++ class AtFissionTask + ;
@@ -0,0 +1,101 @@
+#include "AtProfilerTask.h"
+
+#include "AtRunAna.h"
+
+#include <FairLogger.h>
+#include <FairRootFileSink.h>
+#include <FairRunAna.h>
+
+#include <TDirectory.h>
+#include <TObject.h>
+#include <TTree.h>
+
+#include <iostream>
+#include <string>
+
+using AtTools::AtProfiler;
+
+AtProfilerTask::AtProfilerTask(const TString &measured, AtProfilerTask *previous)
+   : FairTask("AtProfilerTask"), fMeasured(measured), fPrevious(previous)
+{
+}
+
+InitStatus AtProfilerTask::Init()
+{
+   AtProfiler::Instance().Register(fMeasured.Data(), true);
+   return kSUCCESS;
+}
+
+void AtProfilerTask::Exec(Option_t *opt)
+{
+   auto now = AtProfiler::Usage::Now();
+   if (fPrevious && fPrevious->fStarted)
+      AtProfiler::Instance().Add(fPrevious->fMeasured.Data(), fPrevious->fStart, now, true);
+
+   if (fIsLast) {
+      // Only save the events saved in the output tree, so the trees can be friends
+      auto run = dynamic_cast<AtRunAna *>(FairRunAna::Instance());
+      if (fSaveTree && (run == nullptr || run->GetMarkFill()))
+         FillTree();
+      AtProfiler::Instance().EndEvent();
+   }
+
+   // Don't count the time spent here in the next task
+   fStart = AtProfiler::Usage::Now();
+   fStarted = true;
+}
+
+void AtProfilerTask::FillTree()
+{
+   if (fTree == nullptr) {
+      // Put the tree next to the output tree (in the shard file if running sharded) so it is merged like an aux
+      // tree. The branches are the tasks and the stages measured so far.
+      auto sink = dynamic_cast<FairRootFileSink *>(FairRunAna::Instance()->GetSink());
+      TDirectory *dir = sink ? sink->GetOutTree()->GetDirectory() : nullptr;
+      if (dir == nullptr)
+         LOG(warn) << "There is no output file, the profile tree will not be saved";
+
+      TDirectory::TContext ctx(dir);
+      fTree = new TTree("AtProfile", "Wall time per event of each task and stage (ms)");
+      fTree->SetDirectory(dir);
+      auto stats = AtProfiler::Instance().GetStats();
+      fEventWall.resize(stats.size());
+      for (size_t i = 0; i < stats.size(); ++i) {
+         TString branch = stats[i].first;
+         for (auto c : {":", " ", "/", "(", ")", "-", ","})
+            branch.ReplaceAll(c, "_");
+         fBranchMeasured.emplace_back(stats[i].first);
+         fTree->Branch(branch, &fEventWall[i], branch + "/D");
+      }
+   }
+
+   auto stats = AtProfiler::Instance().GetStats();
+   if (stats.size() > fBranchMeasured.size() && !fWarnedUnsaved) {
+      LOG(warn) << "Stage " << stats.back().first << " was first measured after the profile tree was created and "
+                << "is not saved to it. Register it with AtTools::AtProfiler::Instance().Register() before the run.";
+      fWarnedUnsaved = true;
+   }
+   for (size_t i = 0, j = 0; i < fBranchMeasured.size(); ++i) {
+      // Stats are only ever appended, so the branches are found in order
+      while (j < stats.size() && fBranchMeasured[i] != stats[j].first.c_str())
+         ++j;
+      fEventWall[i] = (j < stats.size()) ? stats[j].second.eventWall * 1e3 : 0;
+   }
+   fTree->Fill();
+}
+
+void AtProfilerTask::Finish()
+{
+   if (!fIsLast)
+      return;
+
+   LOG(info) << "Profile of the run:";
+   AtProfiler::Instance().Print(std::cout);
+
+   if (fTree != nullptr && fTree->GetDirectory() != nullptr) {
+      TDirectory::TContext ctx(fTree->GetDirectory());
+      fTree->Write("", TObject::kOverwrite);
+   }
+}
+
+ClassImp(AtProfilerTask);
@@ -0,0 +1,60 @@
+#ifndef ATPROFILERTASK_H
+#define ATPROFILERTASK_H
+
+#include "AtProfiler.h"
+
+#include <FairTask.h>
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <vector>
+
+class TBuffer;
+class TClass;
+class TMemberInspector;
+class TTree;
+
+/**
+ * @brief Task placed by AtRunAna before every task of the run to measure them with AtTools::AtProfiler.
+ *
+ * Each probe starts measuring the task that follows it and stops measuring the task measured by the previous probe.
+ * The last probe (after every task) measures the time until the first probe of the next event, which is the I/O of
+ * the run (filling the output tree and reading the next event). It also counts the events, fills the per-event tree
+ * and prints the summary in Finish().
+ */
+class AtProfilerTask : public FairTask {
+private:
+   TString fMeasured;                    //< Task measured from this probe to the next one
+   AtProfilerTask *fPrevious{nullptr};   //!
+   AtTools::AtProfiler::Usage fStart;    //!
+   Bool_t fStarted{false};               //!
+   Bool_t fIsLast{false};                //< If this is the last probe of the event
+   Bool_t fSaveTree{false};              //< Write the wall time per event of every task and stage to a tree
+   TTree *fTree{nullptr};                //! Owned by the directory of the output tree
+   std::vector<Double_t> fEventWall;     //! Branch buffers (ms)
+   std::vector<TString> fBranchMeasured; //! What is saved in each branch
+   Bool_t fWarnedUnsaved{false};         //!
+
+public:
+   AtProfilerTask(const TString &measured, AtProfilerTask *previous = nullptr);
+
+   void SetPrevious(AtProfilerTask *previous) { fPrevious = previous; }
+   void SetIsLast(Bool_t val) { fIsLast = val; }
+   void SetSaveTree(Bool_t val) { fSaveTree = val; }
+
+   InitStatus Init() override;
+   void Exec(Option_t *opt) override;
+   void Finish() override;
+
+private:
+   /**
+    * Fill the per-event tree, creating it on the first call. A branch is made for each task and stage known to the
+    * profiler at that point, so a stage first measured in a later event is not saved (a warning is printed).
+    */
+   void FillTree();
+
+   ClassDefOverride(AtProfilerTask, 1);
+};
+
+#endif // ATPROFILERTASK_H
@@ -1,6 +1,40 @@
 #include "AtRunAna.h"
 
+#include "AtProfiler.h"
+#include "AtProfilerTask.h"
+
+#include <FairLogger.h>
+#include <FairRootFileSink.h>
+#include <FairRootManager.h>
 #include <FairRunAna.h>
+#include <FairRuntimeDb.h>
+#include <FairTask.h>
+
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TROOT.h>
+#include <TRandom.h>
+#include <TSystem.h>
+#include <TTask.h>
+#include <TTree.h>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 AtRunAna::AtRunAna() : FairRunAna() {}
 
@@ -9,4 +43,259 @@ Bool_t AtRunAna::GetMarkFill()
    return fMarkFill;
 }
 
+void AtRunAna::SetProfiling(Bool_t profile, Bool_t eventTree)
+{
+   fProfile = profile;
+   fProfileTree = profile && eventTree;
+   AtTools::AtProfiler::SetEnabled(profile);
+}
+
+void AtRunAna::Init()
+{
+   if (fProfile)
+      AddProfilerTasks();
+   FairRunAna::Init();
+}
+
+void AtRunAna::AddProfilerTasks()
+{
+   // Place a probe before every task, and one after the last to measure the I/O between events
+   auto tasks = fTask->GetListOfTasks();
+   std::vector<TTask *> measured;
+   TIter next(tasks);
+   while (auto task = dynamic_cast<TTask *>(next()))
+      measured.push_back(task);
+
+   AtProfilerTask *previous = nullptr;
+   AtProfilerTask *first = nullptr;
+   std::set<TString> names;
+   for (auto task : measured) {
+      // Tasks with the same name are listed separately
+      TString name = task->GetName();
+      for (int i = 2; !names.insert(name).second; ++i)
+         name = TString::Format("%s (%d)", task->GetName(), i);
+
+      auto probe = new AtProfilerTask(name, previous);
+      tasks->AddBefore(task, probe);
+      first = first ? first : probe;
+      previous = probe;
+   }
+   auto last = new AtProfilerTask("I/O", previous);
+   last->SetIsLast(true);
+   last->SetSaveTree(fProfileTree);
+   tasks->AddLast(last);
+   if (first)
+      first->SetPrevious(last);
+
+   LOG(info) << "Profiling " << measured.size() << " tasks";
+}
+
+Bool_t AtRunAna::RunSharded(Int_t nShards, Long64_t firstEntry, Long64_t lastEntry)
+{
+   if (dynamic_cast<FairRootFileSink *>(GetSink()) == nullptr) {
+      LOG(error) << "AtRunAna::RunSharded needs a FairRootFileSink to merge the shards into";
+      return false;
+   }
+   if (nShards <= 0)
+      nShards = std::max(1U, std::thread::hardware_concurrency());
+
+   Long64_t maxEntry = FairRootManager::Instance()->CheckMaxEventNo(0);
+   if (lastEntry <= 0 || (maxEntry >= 0 && lastEntry > maxEntry))
+      lastEntry = maxEntry;
+   if (lastEntry < 0) {
+      LOG(error) << "AtRunAna::RunSharded cannot split a source without a known number of entries";
+      return false;
+   }
+   firstEntry = std::min(std::max(firstEntry, Long64_t(0)), lastEntry);
+   if (lastEntry > std::numeric_limits<Int_t>::max()) {
+      LOG(error) << "AtRunAna::RunSharded cannot run past entry " << std::numeric_limits<Int_t>::max()
+                 << ", FairRunAna::Run takes Int_t entries";
+      return false;
+   }
+
+   LOG(info) << "Running entries [" << firstEntry << ", " << lastEntry << ") in " << nShards << " shards";
+
+   // Draw every seed before forking so the streams only depend on the seed of this process
+   std::vector<UInt_t> seeds(nShards);
+   for (auto &seed : seeds)
+      seed = gRandom->Integer(kMaxUInt) + 1;
+
+   // Each worker starts its output from a copy of what Init wrote to the output file
+   auto output = dynamic_cast<FairRootFileSink *>(GetSink())->GetRootFile();
+   output->Flush();
+
+   std::vector<pid_t> workers;
+   for (Int_t i = 0; i < nShards; ++i) {
+      Long64_t first = firstEntry + (lastEntry - firstEntry) * i / nShards;
+      Long64_t last = firstEntry + (lastEntry - firstEntry) * (i + 1) / nShards;
+
+      // Don't let the workers flush what is buffered here a second time
+      std::cout.flush();
+      std::fflush(nullptr);
+
+      pid_t pid = fork();
+      if (pid == 0) {
+         Int_t status = 0;
+         try {
+            RunShard(first, last, seeds[i], GetShardFileName(i));
+         } catch (const std::exception &e) {
+            std::cerr << "AtRunAna shard " << i << " failed: " << e.what() << std::endl;
+            status = 1;
+         }
+         std::cout.flush();
+         std::fflush(nullptr);
+         // Skip the destructors and exit handlers, they would close the files of the parent
+         _exit(status);
+      }
+      if (pid < 0) {
+         LOG(error) << "Failed to fork the worker of shard " << i;
+         break;
+      }
+      workers.push_back(pid);
+   }
+
+   Bool_t success = workers.size() == static_cast<size_t>(nShards);
+   for (size_t i = 0; i < workers.size(); ++i) {
+      int status = 0;
+      if (waitpid(workers[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+         LOG(error) << "Worker of shard " << i << " failed";
+         success = false;
+      }
+   }
+
+   if (!success) {
+      LOG(error) << "Not merging the shards of a failed run, they are left in " << GetShardFileName(0) << " etc.";
+      return false;
+   }
+
+   // Finish the run here as FairRunAna::Run does. The tasks of this process saw no event, so what they write now
+   // is replaced by the merged output of the shards.
+   fTask->FinishTask();
+   if (!MergeShards(nShards))
+      return false;
+   GetSink()->Write();
+   if (GetRuntimeDb()->getOutput() != nullptr)
+      GetRuntimeDb()->saveOutput();
+   return true;
+}
+
+TString AtRunAna::GetShardFileName(Int_t shard)
+{
+   TString name = dynamic_cast<FairRootFileSink *>(GetSink())->GetFileName();
+   if (name.EndsWith(".root"))
+      name.Remove(name.Length() - 5);
+   return TString::Format("%s.shard%d.root", name.Data(), shard);
+}
+
+void AtRunAna::RunShard(Long64_t firstEntry, Long64_t lastEntry, UInt_t seed, const TString &fileName)
+{
+   gRandom->SetSeed(seed);
+
+   // The files were opened before the fork, so their descriptors share the file offset with the parent and the
+   // other workers. Give each file a descriptor of its own: the inputs are opened again, the output continues in
+   // a copy of itself for this shard and anything else written to (e.g. a parameter output) is discarded.
+   auto sink = dynamic_cast<FairRootFileSink *>(GetSink());
+   auto output = sink->GetRootFile();
+   TIter next(gROOT->GetListOfFiles());
+   while (auto file = dynamic_cast<TFile *>(next())) {
+      if (file->GetFd() < 0)
+         continue;
+      int fd = -1;
+      if (file == output) {
+         if (gSystem->CopyFile(file->GetName(), fileName, kTRUE) == 0)
+            fd = open(fileName, O_RDWR);
+      } else if (file->IsWritable()) {
+         fd = open("/dev/null", O_RDWR);
+      } else {
+         fd = open(file->GetName(), O_RDONLY);
+      }
+      if (fd < 0 || dup2(fd, file->GetFd()) < 0)
+         throw std::runtime_error("Could not open " + std::string(file->GetName()) + " again in the worker");
+      close(fd);
+   }
+
+   if (lastEntry > firstEntry)
+      Run(static_cast<Int_t>(firstEntry), static_cast<Int_t>(lastEntry)); // Checked to fit by RunSharded
+
+   // Whatever Run wrote at its end, make sure the shard holds the output tree and is complete
+   output->cd();
+   sink->GetOutTree()->Write("", TObject::kOverwrite);
+   output->Close();
+}
+
+Bool_t AtRunAna::MergeShards(Int_t nShards)
+{
+   auto sink = dynamic_cast<FairRootFileSink *>(GetSink());
+   auto tree = sink->GetOutTree();
+   auto out = sink->GetRootFile();
+
+   std::vector<TFile *> shards;
+   for (Int_t i = 0; i < nShards; ++i) {
+      auto file = TFile::Open(GetShardFileName(i), "READ");
+      if (file == nullptr || file->IsZombie()) {
+         LOG(error) << "Could not open " << GetShardFileName(i);
+         for (auto shard : shards)
+            delete shard;
+         return false;
+      }
+      shards.push_back(file);
+   }
+
+   // The shards hold contiguous entry ranges, so appending them in order keeps the event order
+   for (auto shard : shards) {
+      auto shardTree = dynamic_cast<TTree *>(shard->Get(tree->GetName()));
+      if (shardTree != nullptr)
+         tree->CopyEntries(shardTree, -1, "fast");
+   }
+   MergeDirectory(out, shards, "", tree->GetName());
+
+   for (Int_t i = 0; i < nShards; ++i) {
+      delete shards[i];
+      gSystem->Unlink(GetShardFileName(i));
+   }
+   LOG(info) << "Merged " << nShards << " shards into " << tree->GetEntries() << " entries of " << tree->GetName();
+   return true;
+}
+
+void AtRunAna::MergeDirectory(TDirectory *out, const std::vector<TFile *> &shards, const TString &path,
+                              const TString &skip)
+{
+   auto first = shards[0]->GetDirectory(path);
+   std::set<TString> done;
+   TIter next(first->GetListOfKeys());
+   while (auto key = dynamic_cast<TKey *>(next())) {
+      // Keys are listed from the highest cycle, only that one is merged
+      TString name = key->GetName();
+      if (name == skip || !done.insert(name).second)
+         continue;
+      TString keyPath = path.IsNull() ? name : path + "/" + name;
+      auto cl = TClass::GetClass(key->GetClassName());
+      if (cl == nullptr)
+         continue;
+
+      if (cl->InheritsFrom(TDirectory::Class())) {
+         auto dir = out->GetDirectory(name);
+         MergeDirectory(dir ? dir : out->mkdir(name), shards, keyPath, "");
+      } else if (cl->InheritsFrom(TTree::Class())) {
+         // Aux trees are filled per event like the output tree
+         out->cd();
+         auto merged = dynamic_cast<TTree *>(shards[0]->Get(keyPath))->CloneTree(0);
+         for (auto shard : shards)
+            merged->CopyEntries(dynamic_cast<TTree *>(shard->Get(keyPath)), -1, "fast");
+         merged->Write("", TObject::kOverwrite);
+         delete merged;
+      } else if (cl->InheritsFrom(TH1::Class())) {
+         std::unique_ptr<TH1> sum(dynamic_cast<TH1 *>(shards[0]->Get(keyPath)->Clone()));
+         sum->SetDirectory(nullptr);
+         for (size_t i = 1; i < shards.size(); ++i)
+            sum->Add(dynamic_cast<TH1 *>(shards[i]->Get(keyPath)));
+         out->WriteTObject(sum.get(), name, "Overwrite");
+      } else if (out->GetListOfKeys()->FindObject(name) == nullptr) {
+         // Parameter containers, headers, etc. are the same in every shard. Keep the ones written by Init here.
+         std::unique_ptr<TObject> obj(key->ReadObj());
+         out->WriteTObject(obj.get(), name);
+      }
+   }
+}
+
 ClassImp(AtRunAna);
@@ -4,17 +4,82 @@
 #include <FairRunAna.h>
 
 #include <Rtypes.h>
+#include <TString.h>
+
+#include <vector>
 
 class TBuffer;
 class TClass;
+class TDirectory;
+class TFile;
 class TMemberInspector;
 
 class AtRunAna : public FairRunAna {
+private:
+   Bool_t fProfile{false};     //< Measure the tasks of the run
+   Bool_t fProfileTree{false}; //< Save the wall time per event of the tasks to a tree
+
 public:
    AtRunAna();
    Bool_t GetMarkFill();
 
-   ClassDefOverride(AtRunAna, 1);
+   void Init() override;
+
+   /**
+    * @brief Measure the wall time, CPU time, growth of the peak RSS and throughput of each task.
+    *
+    * Must be called before Init(). Every task added to the run is measured, along with the stages placed in the
+    * code with AtTools::AtProfiler::Scope (e.g. the PSA or the sample consensus solve in their tasks), and the
+    * time between events (the I/O of the run). A summary table is printed at the end of the run.
+    *
+    * Only the tasks added directly to the run are measured, the time of a task includes the time of its subtasks.
+    * When disabled (the default) the run is the same as a FairRunAna and the stages only check a flag.
+    *
+    * @param profile If the run is profiled.
+    * @param eventTree Also save the wall time (ms) of every task and stage for each event to the tree AtProfile in
+    * the output file. It has an entry for every entry of the output tree. Its branches are the tasks and the stages
+    * measured or registered (AtTools::AtProfiler::Instance().Register()) by the first event saved, so register a
+    * stage before the run if it may not run in that event.
+    */
+   void SetProfiling(Bool_t profile, Bool_t eventTree = false);
+
+   /**
+    * @brief Run the analysis in several processes and merge their output.
+    *
+    * Called after Init() in place of Run(firstEntry, lastEntry). The entries are split in nShards contiguous
+    * ranges, each processed by a worker forked from this process (so it starts with the initialized tasks and
+    * parameters). A worker opens its input files again, so it does not share their file offsets with the other
+    * workers, and continues the output in its own copy <output>.shard<i>.root of the output file. Other files
+    * written by the tasks are discarded in the workers. gRandom is reseeded in each worker with a seed drawn from
+    * gRandom here, so a run is reproducible for a given seed and number of shards.
+    *
+    * Once every worker is done the run is finished here: FinishTask of the tasks is called, the output tree of
+    * each shard is appended to the output tree of this run in shard order (so the merged tree is in the original
+    * event order), the output is written and the parameters are saved if there is a parameter output. The
+    * parameter containers, folder and file header are the ones written by Init() in this process. Other trees in
+    * the shard files (aux trees) are merged the same way, histograms are summed (replacing the ones written by
+    * FinishTask here) and other objects are taken from the first shard. The shard files are removed after a
+    * successful merge.
+    *
+    * Workers are forked, so this must be called before enabling ROOT implicit multithreading. Random generators
+    * other than gRandom are not reseeded. FairRunAna::Run takes Int_t entries, so lastEntry must fit in an Int_t.
+    *
+    * @param nShards Number of worker processes. If <= 0, one per core.
+    * @param firstEntry First entry to process.
+    * @param lastEntry Last entry (exclusive) to process. If <= 0, every entry of the source.
+    * @return If every worker succeeded and the output was merged.
+    */
+   Bool_t RunSharded(Int_t nShards, Long64_t firstEntry = 0, Long64_t lastEntry = 0);
+
+private:
+   TString GetShardFileName(Int_t shard);
+   void RunShard(Long64_t firstEntry, Long64_t lastEntry, UInt_t seed, const TString &fileName);
+   Bool_t MergeShards(Int_t nShards);
+   void MergeDirectory(TDirectory *out, const std::vector<TFile *> &shards, const TString &path,
+                       const TString &skip);
+   void AddProfilerTasks();
+
+   ClassDefOverride(AtRunAna, 2);
 };
 
 #endif // #ifndef ATRUNANA_H
@@ -0,0 +1,141 @@
+#include "AtRunAna.h"
+
+#include "AtEvent.h"
+
+#include <FairEventHeader.h>
+#include <FairFileSource.h>
+#include <FairRootFileSink.h>
+#include <FairRootManager.h>
+#include <FairSink.h>
+#include <FairTask.h>
+
+#include <TClonesArray.h>
+#include <TFile.h>
+#include <TFolder.h>
+#include <TH1.h>
+#include <TList.h>
+#include <TObjString.h>
+#include <TString.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+/// Copies the ID of the input event to the output event and counts the events in a histogram
+class AtShardTestTask : public FairTask {
+private:
+   TClonesArray *fInput{nullptr};
+   TClonesArray fOutput{"AtEvent", 1};
+   TH1F fCount{"count", "Events", 1, 0, 1};
+
+public:
+   AtShardTestTask() : FairTask("AtShardTestTask") { fCount.SetDirectory(nullptr); }
+
+   InitStatus Init() override
+   {
+      auto ioMan = FairRootManager::Instance();
+      fInput = dynamic_cast<TClonesArray *>(ioMan->GetObject("AtEventIn"));
+      if (fInput == nullptr)
+         return kFATAL;
+      ioMan->Register("AtEventOut", "AtTPC", &fOutput, true);
+      return kSUCCESS;
+   }
+
+   void Exec(Option_t *) override
+   {
+      auto in = dynamic_cast<AtEvent *>(fInput->At(0));
+      auto out = dynamic_cast<AtEvent *>(fOutput.ConstructedAt(0));
+      out->SetEventID(in->GetEventID());
+      fCount.Fill(0.5);
+   }
+
+   void Finish() override
+   {
+      FairRootManager::Instance()->GetSink()->WriteObject(&fCount, "count", TObject::kOverwrite);
+   }
+};
+
+/// Input laid out like the output of a FairRoot run: the tree, the folder of its branches and the branch list
+void MakeInput(const char *fileName, int numEvents)
+{
+   TFile file(fileName, "RECREATE");
+
+   auto header = new FairEventHeader();
+   header->SetRunId(1);
+   auto events = new TClonesArray("AtEvent", 1);
+   events->SetName("AtEventIn");
+
+   TTree tree("cbmsim", "/cbmout");
+   tree.Branch("EventHeader.", "FairEventHeader", &header);
+   tree.Branch("AtEventIn", "TClonesArray", &events);
+   for (int i = 0; i < numEvents; ++i) {
+      dynamic_cast<AtEvent *>(events->ConstructedAt(0))->SetEventID(i);
+      tree.Fill();
+   }
+   tree.Write();
+
+   auto folder = new TFolder("cbmout", "Main Folder");
+   folder->AddFolder("AtTPC", "AtTPC")->Add(events);
+   folder->Add(header);
+   folder->Write();
+
+   TList branches;
+   branches.SetOwner();
+   branches.Add(new TObjString("EventHeader."));
+   branches.Add(new TObjString("AtEventIn"));
+   file.WriteTObject(&branches, "BranchList", "SingleKey");
+   TList timeBased;
+   file.WriteTObject(&timeBased, "TimeBasedBranchList", "SingleKey");
+   file.Close();
+}
+
+/// Removes the files of the test when it ends, even if an assertion failed
+struct RemoveFiles {
+   std::vector<TString> fNames;
+   ~RemoveFiles()
+   {
+      for (auto &name : fNames)
+         gSystem->Unlink(name);
+   }
+};
+} // namespace
+
+TEST(AtRunAnaTest, RunShardedMergesInOrder)
+{
+   const int numEvents = 101;
+   RemoveFiles removeFiles{{"AtRunAnaTest.in.root", "AtRunAnaTest.out.root"}};
+   MakeInput("AtRunAnaTest.in.root", numEvents);
+
+   // FairRunAna is a singleton, so there is only one run in this test
+   auto run = new AtRunAna();
+   run->SetSource(new FairFileSource("AtRunAnaTest.in.root"));
+   run->SetSink(new FairRootFileSink("AtRunAnaTest.out.root"));
+   run->AddTask(new AtShardTestTask());
+   run->Init();
+   ASSERT_TRUE(run->RunSharded(2));
+
+   // The shard files are removed after the merge
+   EXPECT_TRUE(gSystem->AccessPathName("AtRunAnaTest.out.shard0.root"));
+   EXPECT_TRUE(gSystem->AccessPathName("AtRunAnaTest.out.shard1.root"));
+
+   TFile file("AtRunAnaTest.out.root");
+   auto tree = file.Get<TTree>("cbmsim");
+   ASSERT_NE(tree, nullptr);
+   ASSERT_EQ(tree->GetEntries(), numEvents);
+
+   TClonesArray *events = nullptr;
+   tree->SetBranchAddress("AtEventOut", &events);
+   for (int i = 0; i < numEvents; ++i) {
+      tree->GetEntry(i);
+      ASSERT_EQ(events->GetEntriesFast(), 1);
+      EXPECT_EQ(dynamic_cast<AtEvent *>(events->At(0))->GetEventID(), static_cast<ULong_t>(i));
+   }
+
+   // Histograms are summed over the shards, replacing the empty one written when the run finished here
+   auto count = file.Get<TH1>("count");
+   ASSERT_NE(count, nullptr);
+   EXPECT_EQ(count->GetBinContent(1), numEvents);
+}
@@ -3,6 +3,7 @@
 #include "AtCSVReader.h"
 #include "AtContainerManip.h"
 #include "AtDataManip.h"
+#include "AtDigiPar.h"
 #include "AtHit.h"
 #include "AtMap.h"
 #include "AtPad.h" // for AtPad
@@ -12,15 +13,37 @@
 #include "AtTpcMap.h"
 
 #include <FairLogger.h>
+#include <FairRun.h>
+#include <FairRuntimeDb.h>
 
-#include <TF1.h>
 #include <TH1.h>
 #include <TString.h>
 
-#include <algorithm> // for fill_n, max
-#include <cstdlib>   // for getenv
-#include <iosfwd>    // for ifstream
+#include <algorithm> // for find_if
+#include <array>
+#include <cmath>   // for exp
+#include <cstdlib> // for getenv
+#include <iosfwd>  // for ifstream
 #include <set>
+#include <unordered_map>
+
+namespace {
+/// Get the parameter file from the runtime DB if par is null, so it is only looked up once per call
+const AtDigiPar *GetDigiPar(const AtDigiPar *par)
+{
+   if (par == nullptr)
+      par = dynamic_cast<const AtDigiPar *>(FairRun::Instance()->GetRuntimeDb()->getContainer("AtDigiPar"));
+   return par;
+}
+
+/// Evaluate the hit charge at tb, with the parameters from AtTools::GetHitParametersTB
+double EvalHitTB(const std::array<double, 3> &gaus, double tb)
+{
+   double x = (tb - gaus[1]) / gaus[2];
+   return gaus[0] * std::exp(-0.5 * x * x);
+}
+} // namespace
+
 std::shared_ptr<AtMap> E12014::fMap;
 int E12014::fTBMin = 105;
 int E12014::fThreshold = 1;
@@ -100,25 +123,27 @@ std::set<int> E12014::FillHitSum(TH1 &hist, const std::vector<AtHit *> &hits, in
 }
 
 int E12014::FillHitSums(std::vector<double> &exp, std::vector<double> &sim, const std::vector<AtHit *> &expHits,
-                        const std::vector<AtHit *> &simHits, int threshold, float satThresh, const AtDigiPar *fPar,
+                        const std::vector<AtHit *> &simHits, int threshold, float satThresh, const AtDigiPar *par,
                         std::vector<double> *expADC, AtRawEvent *expEvent)
 {
    if (fMap == nullptr)
       LOG(fatal) << "The map (E12014::fMap) was never set!";
 
-   exp.clear();
-   exp.resize(512);
-   std::fill_n(exp.begin(), 512, 0);
-   sim.clear();
-   sim.resize(512);
-   std::fill_n(sim.begin(), 512, 0);
-   if (expADC) {
-      expADC->clear();
-      expADC->resize(512);
-      std::fill_n(expADC->begin(), 512, 0);
-   }
+   exp.assign(512, 0);
+   sim.assign(512, 0);
+   if (expADC)
+      expADC->assign(512, 0);
+   par = GetDigiPar(par);
+
+   // Index the simulated hits by pad number (keeping the first hit on each pad)
+   std::unordered_map<int, const AtHit *> simHitOnPad;
+   simHitOnPad.reserve(simHits.size());
+   for (auto &hit : simHits)
+      simHitOnPad.emplace(hit->GetPadNum(), hit);
 
    int numGoodHits = 0;
+   std::array<double, 3> gausExp;
+   std::array<double, 3> gausSim;
    for (auto &expHit : expHits) {
       if (fMap->IsInhibited(expHit->GetPadNum()) != AtMap::InhibitType::kNone)
          continue;
@@ -128,23 +153,15 @@ int E12014::FillHitSums(std::vector<double> &exp, std::vector<double> &sim, cons
       if (fMap->GetPadSize(expHit->GetPadNum()) != 0)
          continue;
 
-      auto funcExp = AtTools::GetHitFunctionTB(*expHit, fPar);
-      if (funcExp == nullptr)
+      if (!AtTools::GetHitParametersTB(*expHit, gausExp, par))
          continue;
 
       // We have a hit we want to save for both exp and fisison.
       // Find the corresponding simulated hit if it exists.
-      AtHit *simHit = nullptr;
-      for (auto &hit : simHits) {
-         if (expHit->GetPadNum() == hit->GetPadNum()) {
-            simHit = hit;
-            break;
-         }
-      }
-      if (simHit == nullptr)
+      auto simHit = simHitOnPad.find(expHit->GetPadNum());
+      if (simHit == simHitOnPad.end())
          continue;
-      auto funcSim = AtTools::GetHitFunctionTB(*simHit, fPar);
-      if (funcSim == nullptr)
+      if (!AtTools::GetHitParametersTB(*simHit->second, gausSim, par))
          continue;
 
       AtPad *pad = nullptr;
@@ -156,10 +173,10 @@ int E12014::FillHitSums(std::vector<double> &exp, std::vector<double> &sim, cons
       //  We now have the sim and exp hits. Fill the arrays
       for (int tb = fTBMin; tb < 512; ++tb) {
 
-         auto val = funcExp->Eval(tb);
+         auto val = EvalHitTB(gausExp, tb);
          if (val > threshold) {
             exp[tb] += val;
-            sim[tb] += funcSim->Eval(tb);
+            sim[tb] += EvalHitTB(gausSim, tb);
             if (pad && expADC)
                (*expADC)[tb] += pad->GetADC(tb);
          }
@@ -173,18 +190,17 @@ void E12014::FillSimSum(std::vector<double> &sim, const std::vector<AtHit *> &si
    if (fMap == nullptr)
       LOG(fatal) << "The map (E12014::fMap) was never set!";
 
-   sim.clear();
-   sim.resize(512);
-   std::fill_n(sim.begin(), 512, 0);
+   sim.assign(512, 0);
+   auto par = GetDigiPar(nullptr);
 
+   std::array<double, 3> gaus;
    for (auto &expHit : simHits) {
 
-      auto funcExp = AtTools::GetHitFunctionTB(*expHit);
-      if (funcExp == nullptr)
+      if (!AtTools::GetHitParametersTB(*expHit, gaus, par))
          continue;
 
       for (int tb = fTBMin; tb < 512; ++tb) {
-         sim[tb] += funcExp->Eval(tb);
+         sim[tb] += EvalHitTB(gaus, tb);
       }
    }
 }
@@ -255,27 +271,26 @@ void E12014::FillZPos(std::vector<double> &exp, std::vector<double> &sim, const
 std::set<int>
 E12014::FillHitSum(std::vector<double> &vec, const std::vector<AtHit *> &hits, int threshold, float satThresh)
 {
-   vec.clear();
-   vec.resize(512);
-   std::fill_n(vec.begin(), 512, 0);
+   vec.assign(512, 0);
    std::set<int> goodPads;
 
    if (fMap == nullptr)
       LOG(fatal) << "The map (E12014::fMap) was never set!";
+   auto par = GetDigiPar(nullptr);
 
+   std::array<double, 3> gaus;
    for (auto &hit : hits) {
       if (fMap->IsInhibited(hit->GetPadNum()) != AtMap::InhibitType::kNone)
          continue;
       if (hit->GetCharge() > satThresh)
          continue;
 
-      auto func = AtTools::GetHitFunctionTB(*hit);
-      if (func == nullptr)
+      if (!AtTools::GetHitParametersTB(*hit, gaus, par))
          continue;
 
       // Add the charge to the array
       for (int tb = 0; tb < vec.size(); ++tb) {
-         auto val = func->Eval(tb);
+         auto val = EvalHitTB(gaus, tb);
          if (val > threshold)
             vec[tb] += val;
       }
@@ -297,10 +312,10 @@ void E12014::FillSimHitSum(TH1 &hist, const std::vector<AtHit *> &hits, const st
 void E12014::FillSimHitSum(std::vector<double> &vec, const std::vector<AtHit *> &hits, const std::set<int> &goodPads,
                            double amp, int threshold, float satThresh)
 {
-   vec.clear();
-   vec.resize(512);
-   std::fill_n(vec.begin(), 512, 0);
+   vec.assign(512, 0);
+   auto par = GetDigiPar(nullptr);
 
+   std::array<double, 3> gaus;
    for (auto &hit : hits) {
       if (goodPads.find(hit->GetPadNum()) == goodPads.end()) {
          LOG(debug) << "Skipping pad " << hit->GetPadNum() << " because not good";
@@ -309,15 +324,14 @@ void E12014::FillSimHitSum(std::vector<double> &vec, const std::vector<AtHit *>
       if (hit->GetCharge() > satThresh)
          continue;
 
-      auto func = AtTools::GetHitFunctionTB(*hit);
-      if (func == nullptr)
+      if (!AtTools::GetHitParametersTB(*hit, gaus, par))
          continue;
 
       // Add the charge to the array
       LOG(debug) << "Adding pad " << hit->GetPadNum();
 
       for (int tb = 0; tb < vec.size(); ++tb) {
-         auto val = func->Eval(tb) * amp;
+         auto val = EvalHitTB(gaus, tb) * amp;
          if (val > threshold)
             vec[tb] += val;
       }
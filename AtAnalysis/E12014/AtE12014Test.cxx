@@ -0,0 +1,142 @@
+#include "AtE12014.h"
+
+#include "AtDataManip.h"
+#include "AtDigiPar.h"
+#include "AtHit.h"
+#include "AtMap.h"
+#include "AtTpcMap.h"
+
+#include <FairParAsciiFileIo.h>
+#include <FairRunAna.h>
+#include <FairRuntimeDb.h>
+
+#include <Math/Point3D.h>
+#include <Math/Vector3D.h>
+#include <TF1.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const AtDigiPar *GetDigiPar()
+{
+   static const AtDigiPar *par = [] {
+      auto run = FairRunAna::Instance() ? FairRunAna::Instance() : new FairRunAna(); // NOLINT
+      auto rtdb = run->GetRuntimeDb();
+      auto parIo = new FairParAsciiFileIo(); // NOLINT
+      parIo->open((std::string(std::getenv("VMCWORKDIR")) + "/parameters/ATTPC.e12014.par").c_str(), "in");
+      rtdb->setFirstInput(parIo);
+      auto digiPar = dynamic_cast<AtDigiPar *>(rtdb->getContainer("AtDigiPar"));
+      rtdb->initContainers(0);
+      return digiPar;
+   }();
+   return par;
+}
+
+/// The sums as they were filled before FillHitSums evaluated the gaussians directly
+int FillHitSumsTF1(std::vector<double> &exp, std::vector<double> &sim, const std::vector<AtHit *> &expHits,
+                   const std::vector<AtHit *> &simHits, int threshold, float satThresh, const AtDigiPar *par)
+{
+   exp.assign(512, 0);
+   sim.assign(512, 0);
+
+   int numGoodHits = 0;
+   for (auto &expHit : expHits) {
+      if (E12014::fMap->IsInhibited(expHit->GetPadNum()) != AtMap::InhibitType::kNone)
+         continue;
+      if (expHit->GetCharge() > satThresh)
+         continue;
+      if (E12014::fMap->GetPadSize(expHit->GetPadNum()) != 0)
+         continue;
+
+      auto funcExp = AtTools::GetHitFunctionTB(*expHit, par);
+      if (funcExp == nullptr)
+         continue;
+
+      AtHit *simHit = nullptr;
+      for (auto &hit : simHits) {
+         if (hit->GetPadNum() == expHit->GetPadNum()) {
+            simHit = hit;
+            break;
+         }
+      }
+      if (simHit == nullptr)
+         continue;
+      auto funcSim = AtTools::GetHitFunctionTB(*simHit, par);
+      if (funcSim == nullptr)
+         continue;
+
+      numGoodHits++;
+      for (int tb = E12014::fTBMin; tb < 512; ++tb) {
+         auto val = funcExp->Eval(tb);
+         if (val > threshold) {
+            exp[tb] += val;
+            sim[tb] += funcSim->Eval(tb);
+         }
+      }
+   }
+   return numGoodHits;
+}
+} // namespace
+
+TEST(AtE12014Test, FillHitSumsMatchesTF1)
+{
+   const char *dir = std::getenv("VMCWORKDIR");
+   if (dir == nullptr)
+      GTEST_SKIP() << "VMCWORKDIR is not set, no map or parameters to load";
+
+   auto par = GetDigiPar();
+   ASSERT_NE(par, nullptr);
+   E12014::fMap = std::make_shared<AtTpcMap>();
+   E12014::fMap->ParseXMLMap((std::string(dir) + "/scripts/e12014_pad_map_size.xml").c_str());
+
+   // Length of drift in a TB, and the position along the drift direction of a TB
+   double mmPerTB = par->GetDriftVelocity() * 10. * par->GetTBTime() / 1000.;
+   auto zOfTB = [par, mmPerTB](double tb) { return par->GetZPadPlane() - (par->GetTBEntrance() - tb) * mmPerTB; };
+
+   // Pads 24-33 are small (size 0) and 0-3 are large. Two simulated hits on pad 26 (only the first is used), and
+   // none on pad 33. The last hits are saturated.
+   std::mt19937 rng(17);
+   std::uniform_real_distribution<double> uni(0, 1);
+   std::vector<std::unique_ptr<AtHit>> hits;
+   std::vector<AtHit *> expHits;
+   std::vector<AtHit *> simHits;
+   auto addHit = [&](std::vector<AtHit *> &vec, int pad, double charge) {
+      double tb = 120 + 350 * uni(rng);
+      hits.push_back(std::make_unique<AtHit>(pad, ROOT::Math::XYZPoint(0, 0, zOfTB(tb)), charge));
+      hits.back()->SetPositionSigma({1, 1, (1 + 5 * uni(rng)) * mmPerTB});
+      vec.push_back(hits.back().get());
+   };
+   for (int pad : {0, 1, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33})
+      addHit(expHits, pad, 100 + 3000 * uni(rng));
+   for (int pad : {0, 1, 24, 25, 26, 26, 27, 28, 29, 30, 31, 32})
+      addHit(simHits, pad, 100 + 3000 * uni(rng));
+   addHit(expHits, 34, 5000);
+   addHit(simHits, 34, 1000);
+
+   std::vector<double> exp;
+   std::vector<double> sim;
+   std::vector<double> expTF1;
+   std::vector<double> simTF1;
+   auto numHits = E12014::FillHitSums(exp, sim, expHits, simHits, 5, E12014::fSatThreshold, par);
+   auto numHitsTF1 = FillHitSumsTF1(expTF1, simTF1, expHits, simHits, 5, E12014::fSatThreshold, par);
+   EXPECT_EQ(numHits, 9);
+   EXPECT_EQ(numHits, numHitsTF1);
+
+   ASSERT_EQ(exp.size(), 512u);
+   ASSERT_EQ(sim.size(), 512u);
+   double total = 0;
+   for (int tb = 0; tb < 512; ++tb) {
+      EXPECT_NEAR(exp[tb], expTF1[tb], 1e-9 * (1 + expTF1[tb])) << "TB " << tb;
+      EXPECT_NEAR(sim[tb], simTF1[tb], 1e-9 * (1 + simTF1[tb])) << "TB " << tb;
+      total += exp[tb];
+   }
+   EXPECT_GT(total, 0);
+
+   E12014::fMap.reset();
+}
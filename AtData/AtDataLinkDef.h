@@ -20,6 +20,8 @@
 #pragma link C++ class AtRawEvent + ;
 #pragma link C++ class AtHit + ;
 #pragma link C++ class AtHitCluster + ;
+// Versions <= 4 of AtHitCluster stored the covariance matrices as TMatrixDSym
+#pragma read sourceClass = "AtHitCluster" targetClass = "AtHitCluster" version = "[-4]" source = "TMatrixDSym fCovMatrix; TMatrixDSym fCovNumerator" target = "fCovMatrix, fCovNumerator" include = "TMatrixTSym.h" code = "{ for (int i = 0; i < 3; ++i) for (int j = 0; j <= i; ++j) { fCovMatrix(i, j) = onfile.fCovMatrix(i, j); fCovNumerator(i, j) = onfile.fCovNumerator(i, j); } }"
 #pragma link C++ struct AtHit::MCSimPoint + ;
 #pragma link C++ class AtEvent + ;
 #pragma link C++ class AtProtoEvent + ;
@@ -5,8 +5,7 @@
 #include <Math/Point3D.h>  // for Cartesian3D, operator<<, operator-
 #include <Math/Vector3D.h> // for DisplacementVector3D, operator<<, operator*
 #include <Rtypes.h>
-#include <TError.h>        // for Error
-#include <TMatrixTUtils.h> // for TMatrixTRow
+#include <TMatrixTSym.h> // for TMatrixTSym
 
 #include <array> // for array
 
@@ -21,18 +20,25 @@ std::unique_ptr<AtHit> AtHitCluster::Clone()
 
 AtHitCluster::AtHitCluster() : AtHit(-1, -1, {0, 0, 0}, 0)
 {
-   fCovMatrix.Zero();
-   fCovNumerator.Zero();
    fPositionVariance.SetCoordinates(0, 0, 0);
 }
 
+/**
+ * @brief Sets the covariance matrix from the upper left 3x3 block of matrix.
+ */
+void AtHitCluster::SetCovMatrix(const TMatrixDSym &matrix)
+{
+   for (int i = 0; i < 3; ++i)
+      for (int j = 0; j <= i; ++j)
+         fCovMatrix(i, j) = matrix(i, j);
+}
+
 /**
  * @brief Sets the cov[i,j] = cov[j,i] = val.
  */
 void AtHitCluster::SetCovMatrix(int i, int j, double val)
 {
    fCovMatrix(i, j) = val;
-   fCovMatrix(j, i) = val;
 }
 
 /**
@@ -72,17 +78,12 @@ void AtHitCluster::updateCovariance(const AtHit &hit)
    fPositionChargeOld.GetCoordinates(oldPos.begin());
    fPositionCharge.GetCoordinates(pos.begin());
 
-   // Update off diagonal elements of the covariance matrix
+   // Update off diagonal elements of the covariance matrix (the symmetric storage also sets [j][i])
+   double norm = fCharge != 1 ? fCharge - 1 : fCharge;
    for (int i = 0; i < 3; ++i)
       for (int j = 0; j < i; ++j) {
-         fCovNumerator[i][j] += hit.GetCharge() * (hitPos[i] - pos[i]) * (hitPos[j] - oldPos[j]);
-         fCovNumerator[j][i] = fCovNumerator[i][j];
-         if (fCharge != 1)
-            fCovMatrix[i][j] = fCovNumerator[i][j] / (fCharge - 1);
-         else
-            fCovMatrix[i][j] = fCovNumerator[i][j] / (fCharge);
-
-         fCovMatrix[j][i] = fCovMatrix[i][j];
+         fCovNumerator(i, j) += hit.GetCharge() * (hitPos[i] - pos[i]) * (hitPos[j] - oldPos[j]);
+         fCovMatrix(i, j) = fCovNumerator(i, j) / norm;
       }
 
    std::array<double, 3> weight{}, totalWeight{}, totalWeight2{};
@@ -3,12 +3,13 @@
 
 #include "AtHit.h"
 
+#include <Math/MatrixRepresentationsStatic.h> // for MatRepSym
+#include <Math/SMatrix.h>
 #include <Rtypes.h>
 #include <TMatrixDSymfwd.h> // for TMatrixDSym
 #include <TMatrixTSym.h>    // for TMatrixTSym
 
 #include <memory>  // for unique_ptr
-#include <utility> // for move
 
 class TBuffer;
 class TClass;
@@ -28,6 +29,9 @@ class TMemberInspector;
  *
  * The covariance and matrix can also be manually set like the old version of the class.
  *
+ * The covariance is stored as a fixed-size symmetric 3x3 matrix, so clusters are cheap to copy and move.
+ * Files written with versions of the class storing it as a TMatrixDSym are converted on read.
+ *
  * Three positions are stored in the cluster:
  * fPositionFull is the position using the full information(charge and hit position variance).
  * fPositionCharge is the position from just charge weighting.
@@ -35,14 +39,17 @@ class TMemberInspector;
  *
  */
 class AtHitCluster : public AtHit {
+public:
+   using CovMatrix = ROOT::Math::SMatrix<double, 3, 3, ROOT::Math::MatRepSym<double, 3>>;
+
 protected:
    Int_t fClusterID{-1};
 
    // Off diagonal elements are calcualed using eqn 18. Diagonal from eqn 24
-   TMatrixDSym fCovMatrix{3}; //< Cluster covariance matrix
+   CovMatrix fCovMatrix; //< Cluster covariance matrix
 
    // Corresponds to equations 15 for off diagonal and 20 for on diagonal
-   TMatrixDSym fCovNumerator{3}; //< Numerator for updating covariance matrix
+   CovMatrix fCovNumerator; //< Numerator for updating covariance matrix
 
    // The reliability weight for each coordinate is 1/variance.
    XYZVector fTotalWeight{0, 0, 0};  //< Sum of 1/Var*q (Eqn 10)
@@ -59,10 +66,14 @@ protected:
 public:
    AtHitCluster();
    AtHitCluster(const AtHitCluster &cluster) = default;
+   AtHitCluster(AtHitCluster &&cluster) = default;
+   AtHitCluster &operator=(const AtHitCluster &cluster) = default;
+   AtHitCluster &operator=(AtHitCluster &&cluster) = default;
    virtual ~AtHitCluster() = default;
    virtual std::unique_ptr<AtHit> Clone() override; //< Create a copy of sub-type
 
-   void SetCovMatrix(TMatrixDSym matrix) { fCovMatrix = std::move(matrix); }
+   void SetCovMatrix(const CovMatrix &matrix) { fCovMatrix = matrix; }
+   void SetCovMatrix(const TMatrixDSym &matrix);
    void SetCovMatrix(int i, int j, double val);
    virtual void SetPositionVariance(const XYZVector &vec) override;
    void SetLength(Double_t length) { fLength = length; }
@@ -72,8 +83,8 @@ public:
    Double_t GetLength() const { return fLength; }
    XYZPoint GetPositionCharge() const { return fPositionCharge; }
 
-   const TMatrixDSym &GetCovMatrix() const { return fCovMatrix; }
-   const TMatrixDSym &GetCovNumerator() const { return fCovNumerator; }
+   const CovMatrix &GetCovMatrix() const { return fCovMatrix; }
+   const CovMatrix &GetCovNumerator() const { return fCovNumerator; }
 
    Int_t GetClusterID() const { return fClusterID; }
    Int_t GetClusterSize() const { return fClusterSize; }
@@ -99,7 +110,7 @@ protected:
    void updatePosition(const AtHit &hit);
    void updateCovariance(const AtHit &hit);
 
-   ClassDefOverride(AtHitCluster, 4);
+   ClassDefOverride(AtHitCluster, 5);
 };
 
 #endif
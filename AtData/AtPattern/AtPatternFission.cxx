@@ -1,10 +1,10 @@
 #include "AtPatternFission.h"
 
-#include "AtPattern.h" // for AtPatterns
+#include "AtPattern.h"           // for AtPatterns
+#include "AtPatternYObjective.h" // for AtPatternYObjective
 
 #include <FairLogger.h> // for Logger, LOG
 
-#include <Math/Functor.h>
 #include <TString.h>
 
 #include <Fit/FitConfig.h> // for FitConfig
@@ -26,44 +26,26 @@ void AtPatternFission::FitPattern(const std::vector<XYZPoint> &points, const std
    bool weighted = points.size() == charge.size();
    LOG(debug) << "Fitting with" << (weighted ? " " : "out ") << "charge weighting";
 
-   // This functor is what we are minimizing. It takes in the model parameters and defines an example
-   // of this pattern based on the model parameters. It then loops through every hit associated with
-   // pattern and calculates the chi2.
-   auto func = [&points, &charge, weighted, this](const double *par) {
-      AtPatternY pat;
-      pat.DefinePattern(std::vector<double>(par, par + 12));
-      std::array<double, 3> chi2 = {0, 0, 0};
-      std::array<double, 3> qTot = {0, 0, 0};
-
-      for (int i = 0; i < points.size(); ++i) {
-         auto q = weighted ? charge[i] : 1;
-         auto pointAss = this->GetPointAssignment(points[i]);
-
-         // We can skip including points if they were originally FF points, or they were beam points
-         // and are now FF points and are too close to the center of the detector.
-         bool origFF = pointAss < 2;
-         origFF |= (pointAss == 2 && pat.GetPointAssignment(points[i]) < 2);
-
-         if (origFF && points[i].Rho() < 20)
-            continue;
-         LOG(debug) << q << " " << pat.DistanceToPattern(points[i]);
-         chi2[pointAss] += pat.DistanceToPattern(points[i]) * pat.DistanceToPattern(points[i]) * q;
-         qTot[pointAss] += q;
-      }
-
-      double retVal = 0;
-
-      // Only include the chi2 for the two fission fragments
-      for (int i = 0; i < 2; ++i) {
-         LOG(debug) << i << ": " << chi2[i] << "/" << qTot[i] << " = " << chi2[i] / qTot[i];
-         if (qTot[i] != 0)
-            retVal += chi2[i] / qTot[i];
-      }
-      LOG(debug) << "Obj: " << retVal;
-      return retVal;
-   };
-
-   auto functor = ROOT::Math::Functor(func, 12);
+   // This is what we are minimizing. It is the sum over the two fission fragments of the charge weighted
+   // mean of the squared distance to the pattern of the hits originally assigned to that fragment.
+   // We skip hits that are too close to the center of the detector. Beam hits do not contribute to the
+   // objective. Since the assignment is taken from the initial pattern, the hits and weights are fixed
+   // during the fit.
+   std::vector<int> assignment(points.size());
+   std::array<double, 2> qTot = {0, 0};
+   for (int i = 0; i < points.size(); ++i) {
+      assignment[i] = GetPointAssignment(points[i]);
+      if (assignment[i] < 2 && points[i].Rho() >= 20)
+         qTot[assignment[i]] += weighted ? charge[i] : 1;
+   }
+
+   AtPatternYObjective objective;
+   objective.Reserve(points.size());
+   for (int i = 0; i < points.size(); ++i) {
+      if (assignment[i] < 2 && points[i].Rho() >= 20)
+         objective.AddPoint(points[i], (weighted ? charge[i] : 1) / qTot[assignment[i]]);
+   }
+   LOG(debug) << "Fitting " << objective.GetNumPoints() << " of " << points.size() << " points";
 
    ROOT::Fit::Fitter fitter;
    auto iniPar = GetPatternPar();
@@ -72,7 +54,7 @@ void AtPatternFission::FitPattern(const std::vector<XYZPoint> &points, const std
    for (int i = 0; i < iniPar.size(); ++i)
       LOG(debug) << Form("Par_%d", i) << "\t = " << iniPar[i];
 
-   fitter.SetFCN(functor, iniPar.data());
+   fitter.SetFCN(objective, iniPar.data());
 
    // Constrain the Z direction to be the same
    for (int i = 0; i < 3; ++i)
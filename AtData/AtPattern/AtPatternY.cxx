@@ -1,10 +1,11 @@
 #include "AtPatternY.h"
 // IWYU pragma: no_include <ext/alloc_traits.h>
-#include "AtPatternLine.h" // for AtPatternLine::XYZPoint, AtPatter...
+#include "AtHit.h"               // for AtHit
+#include "AtPatternLine.h"       // for AtPatternLine::XYZPoint, AtPatter...
+#include "AtPatternYObjective.h" // for AtPatternYObjective
 
 #include <FairLogger.h>
 
-#include <Math/Functor.h>
 #include <Math/Point3D.h>  // for DisplacementVector3D, operator*
 #include <Math/Vector3D.h> // for DisplacementVector3D, operator*
 #include <TEveCompound.h>
@@ -19,7 +20,6 @@
 #include <Fit/ParameterSettings.h> // for ParameterSettings
 #include <algorithm>               // for max, min_element, sort
 #include <cmath>                   // for cos, sin, pow, sqrt, acos, atan, fabs
-#include <set>                     // for set, _Rb_tree_const_iterator
 #include <utility>                 // for swap
 
 using namespace AtPatterns;
@@ -62,41 +62,70 @@ TEveElement *AtPatternY::GetEveElement() const
    return shape;
 }
 
+namespace {
+/**
+ * Squared distance from point to the ray starting at vertex with direction dir. Is the same as
+ * AtPatternRay::DistanceToPattern squared, but works directly on the ray parameters. If closest is not null it is set
+ * to the closest point on the ray.
+ */
+double RayDistance2(const ROOT::Math::XYZPoint &vertex, const ROOT::Math::XYZVector &dir,
+                    const ROOT::Math::XYZPoint &point, ROOT::Math::XYZPoint *closest = nullptr)
+{
+   auto t = (point - vertex).Dot(dir) / dir.Mag2();
+   auto closestPoint = t > 0 ? vertex + t * dir : vertex;
+   if (closest)
+      *closest = closestPoint;
+   return (closestPoint - point).Mag2();
+}
+} // namespace
+
+std::array<double, 3> AtPatternY::GetBranchDistances2(const XYZPoint &point) const
+{
+   return {RayDistance2(fFragments[0].GetPoint(), fFragments[0].GetDirection(), point),
+           RayDistance2(fFragments[1].GetPoint(), fFragments[1].GetDirection(), point),
+           RayDistance2(fBeam.GetPoint(), fBeam.GetDirection(), point)};
+}
+
 AtPatternY::XYZPoint AtPatternY::ClosestPointOnPattern(const XYZPoint &point) const
 {
-   // create a set of pairs with points and distance to pattern sorted by distance
-   auto comp = [](const std::pair<XYZPoint, double> &a, const std::pair<XYZPoint, double> &b) {
-      return a.second < b.second;
-   };
-   auto points = std::set<std::pair<XYZPoint, double>, decltype(comp)>(comp);
-
-   points.insert({fBeam.ClosestPointOnPattern(point), fBeam.DistanceToPattern(point)});
-   for (const auto &ray : fFragments)
-      points.insert({ray.ClosestPointOnPattern(point), ray.DistanceToPattern(point)});
-
-   // Get the closest point to the pattern
-   return points.begin()->first;
+   // Get the closest point to the pattern. On ties the beam is preferred, then the fragments in order.
+   XYZPoint closest;
+   auto minDist = RayDistance2(fBeam.GetPoint(), fBeam.GetDirection(), point, &closest);
+   for (const auto &ray : fFragments) {
+      XYZPoint rayPoint;
+      auto dist = RayDistance2(ray.GetPoint(), ray.GetDirection(), point, &rayPoint);
+      if (dist < minDist) {
+         minDist = dist;
+         closest = rayPoint;
+      }
+   }
+   return closest;
 }
 
 Double_t AtPatternY::DistanceToPattern(const XYZPoint &point) const
 {
-   std::vector<double> distances;
-   distances.push_back(fBeam.DistanceToPattern(point));
-   for (const auto &ray : fFragments)
-      distances.push_back(ray.DistanceToPattern(point));
-   return *std::min_element(distances.begin(), distances.end());
+   auto distances = GetBranchDistances2(point);
+   return std::sqrt(*std::min_element(distances.begin(), distances.end()));
 }
 
 int AtPatternY::GetPointAssignment(const XYZPoint &point) const
 {
-   auto comp = [](const std::pair<int, double> &a, const std::pair<int, double> &b) { return a.second < b.second; };
-   auto points = std::set<std::pair<int, double>, decltype(comp)>(comp);
-
-   for (int i = 0; i < fFragments.size(); ++i)
-      points.insert({i, fFragments[i].DistanceToPattern(point)});
-   points.insert({fFragments.size(), fBeam.DistanceToPattern(point)});
+   // On ties the fragments are preferred over the beam
+   auto distances = GetBranchDistances2(point);
+   return std::min_element(distances.begin(), distances.end()) - distances.begin();
+}
 
-   return points.begin()->first;
+void AtPatternY::EvaluatePoints(const std::vector<const AtHit *> &hits, std::vector<int> &assignment,
+                                std::vector<double> &distance2) const
+{
+   assignment.resize(hits.size());
+   distance2.resize(hits.size());
+   for (size_t i = 0; i < hits.size(); ++i) {
+      auto distances = GetBranchDistances2(hits[i]->GetPosition());
+      auto minIt = std::min_element(distances.begin(), distances.end());
+      assignment[i] = minIt - distances.begin();
+      distance2[i] = *minIt;
+   }
 }
 
 std::vector<double> AtPatternY::GetPatternPar() const
@@ -190,24 +219,16 @@ void AtPatternY::FitPattern(const std::vector<XYZPoint> &points, const std::vect
    bool weighted = points.size() == charge.size();
    LOG(debug) << "Fitting with" << (weighted ? " " : "out ") << "charge weighting";
 
-   // This functor is what we are minimizing. It takes in the model parameters and defines an example
-   // of this pattern based on the model parameters. It then loops through every hit associated with
-   // pattern and calculates the chi2.
-   auto func = [&points, &charge, weighted](const double *par) {
-      AtPatternY pat;
-      pat.DefinePattern(std::vector<double>(par, par + 12));
-      double chi2 = 0;
-      double qTot = 0;
-      for (int i = 0; i < points.size(); ++i) {
-         auto q = weighted ? charge[i] : 1;
-         chi2 += pat.DistanceToPattern(points[i]) * pat.DistanceToPattern(points[i]) * q;
-         qTot += q;
-      }
-
-      return fabs(chi2 / qTot);
-   };
+   // This is what we are minimizing. It is the charge weighted mean of the squared distance of every hit
+   // associated with the pattern to the pattern defined by the model parameters.
+   double qTot = 0;
+   for (int i = 0; i < points.size(); ++i)
+      qTot += weighted ? charge[i] : 1;
 
-   auto functor = ROOT::Math::Functor(func, 12);
+   AtPatternYObjective objective;
+   objective.Reserve(points.size());
+   for (int i = 0; i < points.size(); ++i)
+      objective.AddPoint(points[i], (weighted ? charge[i] : 1) / qTot);
 
    ROOT::Fit::Fitter fitter;
    auto iniPar = GetPatternPar();
@@ -216,7 +237,7 @@ void AtPatternY::FitPattern(const std::vector<XYZPoint> &points, const std::vect
    for (int i = 0; i < iniPar.size(); ++i)
       LOG(debug) << Form("Par_%d", i) << "\t = " << iniPar[i];
 
-   fitter.SetFCN(functor, iniPar.data());
+   fitter.SetFCN(objective, iniPar.data());
 
    // Constrain the Z direction to be the same
    for (int i = 0; i < 3; ++i)
@@ -13,6 +13,7 @@
 #include <array>
 #include <memory> // for make_unique, unique_ptr
 #include <vector> // for vector
+class AtHit;
 class TEveElement;
 
 class TBuffer;
@@ -60,6 +61,23 @@ public:
     */
    int GetPointAssignment(const XYZPoint &point) const;
 
+   /**
+    * @brief Squared distance from point to each ray.
+    *
+    * Indexed the same as GetPointAssignment (0 -> fragment 0. 1 -> fragment 1. 2 -> beam). Does not allocate.
+    */
+   std::array<double, 3> GetBranchDistances2(const XYZPoint &point) const;
+
+   /**
+    * @brief Assignment and squared distance to pattern of every hit in one pass.
+    *
+    * Equivalent to calling GetPointAssignment and squaring DistanceToPattern for the position of each hit, but each
+    * ray is only evaluated once per hit. The output vectors are resized to the number of hits, so they can be reused
+    * between calls without allocating.
+    */
+   void EvaluatePoints(const std::vector<const AtHit *> &hits, std::vector<int> &assignment,
+                       std::vector<double> &distance2) const;
+
    virtual void DefinePattern(const std::vector<XYZPoint> &points) override;
    virtual void DefinePattern(std::vector<double> par) override;
    virtual Double_t DistanceToPattern(const XYZPoint &point) const override;
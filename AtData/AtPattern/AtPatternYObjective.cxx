@@ -0,0 +1,124 @@
+#include "AtPatternYObjective.h"
+
+#include <cmath> // for fabs
+
+using namespace AtPatterns;
+
+namespace {
+/**
+ * Evaluates the objective at par and, if grad is not null, its gradient.
+ *
+ * The rays are evaluated like AtPatternRay: the direction is normalized to |z| = 1 (if z != 0) and the distance
+ * to a point is the distance to the line if the point projects in front of the vertex, otherwise the distance to
+ * the vertex. With w = X - V and t = (w.D)/(D.D) the residual is r = w - t*D (t > 0) or r = w, giving
+ *   d(d^2)/dV = -2r and d(d^2)/dD = -2t*r (only for t > 0).
+ */
+double Evaluate(const std::vector<double> &coords, const std::vector<double> &weights, const double *par,
+                double *grad)
+{
+   constexpr int nRays = 3;
+   // Index of the first direction parameter of each ray (fragment 0, fragment 1, beam)
+   constexpr std::array<int, nRays> parIdx = {6, 9, 3};
+
+   std::array<std::array<double, 3>, nRays> dir;
+   std::array<double, nRays> dirScale;
+   std::array<double, nRays> dirMag2;
+   for (int k = 0; k < nRays; ++k) {
+      const double *raw = par + parIdx[k];
+      dirScale[k] = raw[2] != 0 ? 1. / std::fabs(raw[2]) : 1.;
+      for (int c = 0; c < 3; ++c)
+         dir[k][c] = raw[c] * dirScale[k];
+      dirMag2[k] = dir[k][0] * dir[k][0] + dir[k][1] * dir[k][1] + dir[k][2] * dir[k][2];
+   }
+
+   // Gradient w.r.t. the vertex and the normalized directions
+   std::array<double, 3> gradV = {0, 0, 0};
+   std::array<std::array<double, 3>, nRays> gradD{};
+
+   double f = 0;
+   for (size_t i = 0; i < weights.size(); ++i) {
+      const double *point = &coords[3 * i];
+      const double w[3] = {point[0] - par[0], point[1] - par[1], point[2] - par[2]};
+
+      double minDist2 = 0;
+      double minT = 0;
+      int minRay = -1;
+      std::array<double, 3> minRes{};
+      for (int k = 0; k < nRays; ++k) {
+         double t = (w[0] * dir[k][0] + w[1] * dir[k][1] + w[2] * dir[k][2]) / dirMag2[k];
+         if (t < 0)
+            t = 0;
+         std::array<double, 3> res = {w[0] - t * dir[k][0], w[1] - t * dir[k][1], w[2] - t * dir[k][2]};
+         double dist2 = res[0] * res[0] + res[1] * res[1] + res[2] * res[2];
+         if (minRay < 0 || dist2 < minDist2) {
+            minDist2 = dist2;
+            minT = t;
+            minRay = k;
+            minRes = res;
+         }
+      }
+
+      f += weights[i] * minDist2;
+      if (grad) {
+         for (int c = 0; c < 3; ++c) {
+            gradV[c] -= 2 * weights[i] * minRes[c];
+            gradD[minRay][c] -= 2 * weights[i] * minT * minRes[c];
+         }
+      }
+   }
+
+   if (grad) {
+      for (int c = 0; c < 3; ++c)
+         grad[c] = gradV[c];
+
+      // Chain rule through the normalization of the direction
+      for (int k = 0; k < nRays; ++k) {
+         const double *raw = par + parIdx[k];
+         double *g = grad + parIdx[k];
+         g[0] = gradD[k][0] * dirScale[k];
+         g[1] = gradD[k][1] * dirScale[k];
+         if (raw[2] != 0)
+            g[2] = -(gradD[k][0] * raw[0] + gradD[k][1] * raw[1]) / (raw[2] * std::fabs(raw[2]));
+         else
+            g[2] = gradD[k][2];
+      }
+   }
+   return f;
+}
+} // namespace
+
+void AtPatternYObjective::Reserve(size_t n)
+{
+   fCoords.reserve(3 * n);
+   fWeights.reserve(n);
+}
+
+void AtPatternYObjective::AddPoint(const XYZPoint &point, double weight)
+{
+   fCoords.push_back(point.X());
+   fCoords.push_back(point.Y());
+   fCoords.push_back(point.Z());
+   fWeights.push_back(weight);
+}
+
+double AtPatternYObjective::DoEval(const double *par) const
+{
+   return Evaluate(fCoords, fWeights, par, nullptr);
+}
+
+void AtPatternYObjective::Gradient(const double *par, double *grad) const
+{
+   Evaluate(fCoords, fWeights, par, grad);
+}
+
+void AtPatternYObjective::FdF(const double *par, double &f, double *grad) const
+{
+   f = Evaluate(fCoords, fWeights, par, grad);
+}
+
+double AtPatternYObjective::DoDerivative(const double *par, unsigned int icoord) const
+{
+   std::array<double, kNPar> grad;
+   Evaluate(fCoords, fWeights, par, grad.data());
+   return grad[icoord];
+}
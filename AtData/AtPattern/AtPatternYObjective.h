@@ -0,0 +1,55 @@
+#ifndef ATPATTERNYOBJECTIVE_H
+#define ATPATTERNYOBJECTIVE_H
+
+#include <Math/IFunction.h>
+#include <Math/Point3D.h>
+#include <Math/Point3Dfwd.h> // for XYZPoint
+
+#include <array>
+#include <vector>
+
+namespace AtPatterns {
+
+/**
+ * @brief Weighted sum of squared distances to a Y pattern, with analytic gradient.
+ *
+ * Objective minimized when fitting AtPatternY and AtPatternFission. It is a function of the 12 parameters
+ * of AtPatternY::DefinePattern(std::vector<double>) and evaluates
+ *   f(par) = sum_i w_i * d_i^2
+ * where d_i is the distance of point i to the closest ray of the pattern described by par.
+ *
+ * The points are stored in a flat array and the pattern is evaluated with fixed-size arrays, so evaluating
+ * the objective or its gradient never allocates.
+ *
+ * @ingroup AtPattern
+ */
+class AtPatternYObjective : public ROOT::Math::IMultiGradFunction {
+public:
+   using XYZPoint = ROOT::Math::XYZPoint;
+   static constexpr unsigned int kNPar = 12;
+
+private:
+   std::vector<double> fCoords;  //< Points to evaluate (x,y,z of point i at 3*i)
+   std::vector<double> fWeights; //< Weight of each point
+
+public:
+   AtPatternYObjective() = default;
+
+   void Reserve(size_t n);
+   void AddPoint(const XYZPoint &point, double weight);
+   size_t GetNumPoints() const { return fWeights.size(); }
+
+   unsigned int NDim() const override { return kNPar; }
+   ROOT::Math::IMultiGradFunction *Clone() const override { return new AtPatternYObjective(*this); }
+
+   void Gradient(const double *par, double *grad) const override;
+   void FdF(const double *par, double &f, double *grad) const override;
+
+private:
+   double DoEval(const double *par) const override;
+   double DoDerivative(const double *par, unsigned int icoord) const override;
+};
+
+} // namespace AtPatterns
+
+#endif // ATPATTERNYOBJECTIVE_H
@@ -0,0 +1,95 @@
+#include "AtPatternYObjective.h"
+
+#include "AtPatternY.h"
+
+#include <Math/Point3D.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace AtPatterns;
+
+namespace {
+/// Y pattern with the vertex near the origin, the beam along +z and the fragments going forward
+std::vector<double> MakePar(std::mt19937 &rng)
+{
+   std::uniform_real_distribution<double> uni(-1, 1);
+   return {10 * uni(rng),  10 * uni(rng),  500 + 10 * uni(rng), 0.05 * uni(rng), 0.05 * uni(rng), 1 + 0.1 * uni(rng),
+           0.5 + uni(rng), 0.5 * uni(rng), 1 + 0.5 * uni(rng),  -0.5 + uni(rng), 0.5 * uni(rng),  -1 - 0.5 * uni(rng)};
+}
+
+/// Points scattered around the rays of the pattern and around the vertex
+AtPatternYObjective MakeObjective(const AtPatternY &pattern, std::mt19937 &rng)
+{
+   std::uniform_real_distribution<double> length(-20, 200);
+   std::normal_distribution<double> spread(0, 5);
+   std::uniform_real_distribution<double> weight(0.5, 2);
+
+   AtPatternYObjective objective;
+   objective.Reserve(300);
+   for (int i = 0; i < 300; ++i) {
+      auto dir = i % 3 == 2 ? pattern.GetBeamDirection() : pattern.GetFragmentDirection(i % 3);
+      auto point = pattern.GetVertex() + length(rng) * dir.Unit();
+      objective.AddPoint({point.X() + spread(rng), point.Y() + spread(rng), point.Z() + spread(rng)}, weight(rng));
+   }
+   return objective;
+}
+} // namespace
+
+TEST(AtPatternYObjectiveTest, MatchesPatternDistance)
+{
+   std::mt19937 rng(11);
+   std::uniform_real_distribution<double> uni(-1, 1);
+   for (int i = 0; i < 10; ++i) {
+      auto par = MakePar(rng);
+      AtPatternY pattern;
+      pattern.DefinePattern(par);
+
+      AtPatternYObjective objective;
+      double expected = 0;
+      for (int j = 0; j < 100; ++j) {
+         ROOT::Math::XYZPoint point(100 * uni(rng), 100 * uni(rng), 500 + 200 * uni(rng));
+         double weight = 1 + uni(rng) / 2;
+         objective.AddPoint(point, weight);
+         expected += weight * std::pow(pattern.DistanceToPattern(point), 2);
+      }
+      EXPECT_NEAR(objective(par.data()), expected, 1e-9 * expected) << "Pattern " << i;
+   }
+}
+
+TEST(AtPatternYObjectiveTest, GradientMatchesFiniteDifferences)
+{
+   std::mt19937 rng(13);
+   for (int i = 0; i < 10; ++i) {
+      auto par = MakePar(rng);
+      AtPatternY pattern;
+      pattern.DefinePattern(par);
+      auto objective = MakeObjective(pattern, rng);
+
+      std::array<double, AtPatternYObjective::kNPar> grad;
+      double f = 0;
+      objective.FdF(par.data(), f, grad.data());
+      EXPECT_DOUBLE_EQ(f, objective(par.data()));
+
+      for (unsigned int k = 0; k < AtPatternYObjective::kNPar; ++k) {
+         // Central difference with a step relative to the size of the parameter
+         double h = 1e-6 * std::max(1., std::fabs(par[k]));
+         auto parUp = par;
+         auto parDown = par;
+         parUp[k] += h;
+         parDown[k] -= h;
+         double numeric = (objective(parUp.data()) - objective(parDown.data())) / (2 * h);
+
+         EXPECT_NEAR(grad[k], numeric, 1e-5 * std::max(1., std::fabs(numeric))) << "Pattern " << i << " par " << k;
+         EXPECT_DOUBLE_EQ(objective.Derivative(par.data(), k), grad[k]) << "Pattern " << i << " par " << k;
+      }
+
+      std::array<double, AtPatternYObjective::kNPar> gradOnly;
+      objective.Gradient(par.data(), gradOnly.data());
+      EXPECT_EQ(gradOnly, grad) << "Pattern " << i;
+   }
+}
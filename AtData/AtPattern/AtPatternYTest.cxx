@@ -0,0 +1,54 @@
+#include "AtPatternY.h"
+
+#include "AtHit.h"
+
+#include <Math/Point3D.h>
+#include <Math/Vector3D.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace AtPatterns;
+
+TEST(AtPatternYTest, EvaluatePointsMatchesPerPoint)
+{
+   AtPatternY pattern;
+   pattern.DefinePattern({1, -2, 500, 0.01, 0.02, 1, 0.6, 0.2, 1, -0.5, -0.1, 1.2});
+
+   // Hits around the three rays, and far from all of them
+   std::mt19937 rng(17);
+   std::uniform_real_distribution<double> length(-20, 200);
+   std::normal_distribution<double> spread(0, 5);
+   std::vector<std::unique_ptr<AtHit>> hits;
+   std::vector<const AtHit *> hitArray;
+   for (int i = 0; i < 200; ++i) {
+      auto dir = i % 4 == 2 ? pattern.GetBeamDirection() : pattern.GetFragmentDirection(i % 2);
+      auto point = pattern.GetVertex() + length(rng) * dir.Unit();
+      if (i % 4 == 3)
+         point = ROOT::Math::XYZPoint(200 * spread(rng), 200 * spread(rng), 500 + 200 * spread(rng));
+      point += ROOT::Math::XYZVector(spread(rng), spread(rng), spread(rng));
+      hits.push_back(std::make_unique<AtHit>(i, point, 1));
+      hitArray.push_back(hits.back().get());
+   }
+
+   std::vector<int> assignment;
+   std::vector<double> distance2;
+   pattern.EvaluatePoints(hitArray, assignment, distance2);
+   ASSERT_EQ(assignment.size(), hitArray.size());
+   ASSERT_EQ(distance2.size(), hitArray.size());
+   for (size_t i = 0; i < hitArray.size(); ++i) {
+      auto &pos = hitArray[i]->GetPosition();
+      EXPECT_EQ(assignment[i], pattern.GetPointAssignment(pos)) << "Hit " << i;
+      EXPECT_DOUBLE_EQ(std::sqrt(distance2[i]), pattern.DistanceToPattern(pos)) << "Hit " << i;
+   }
+
+   // The output is resized when reused for fewer hits
+   hitArray.resize(10);
+   pattern.EvaluatePoints(hitArray, assignment, distance2);
+   EXPECT_EQ(assignment.size(), 10u);
+   EXPECT_EQ(distance2.size(), 10u);
+}
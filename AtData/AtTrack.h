@@ -103,6 +103,7 @@ public:
    void SetGeoRadius(Double_t radius) { fGeoRadius = radius; }
    void SetGeoCenter(std::pair<Double_t, Double_t> center) { fGeoCenter = center; }
    void AddClusterHit(std::shared_ptr<AtHitCluster> hitCluster);
+   void AddClusterHit(AtHitCluster &&hitCluster) { fHitClusterArray.push_back(std::move(hitCluster)); }
 
    void SetIsMerged(bool val) { fIsMerged = val; }
    void SetVertexToZDist(Double_t val) { fVertexToZDist = val; }
@@ -72,7 +72,7 @@ void AtTpc::trackEnteringVolume()
    fTrackID = gMC->GetStack()->GetCurrentTrackNumber();
 
    // Position of the first hit of the beam in the TPC volume ( For tracking purposes in the TPC)
-   if (fTrackID == 0 && (fVolName == "drift_volume" || fVolName == "cell"))
+   if (fTrackID == 0 && (volName() == "drift_volume" || volName() == "cell"))
       InPos = fPosIn;
 
    Int_t VolumeID = 0;
@@ -82,7 +82,7 @@ void AtTpc::trackEnteringVolume()
    else
       LOG(debug) << cBLUE << " AtTPC: Reaction/Decay Event ";
 
-   LOG(debug) << " AtTPC: First hit in Volume " << fVolName;
+   LOG(debug) << " AtTPC: First hit in Volume " << volName();
    LOG(debug) << " Particle : " << gMC->ParticleName(gMC->TrackPid());
    LOG(debug) << " PID PdG : " << gMC->TrackPid();
    LOG(debug) << " Atomic Mass : " << AZ.first;
@@ -122,7 +122,7 @@ void AtTpc::getTrackParametersWhileExiting()
    // Correct fPosOut
    if (gMC->IsTrackExiting()) {
       correctPosOut();
-      if ((fVolName.Contains("drift_volume") || fVolName.Contains("cell")) && fTrackID == 0)
+      if (isGasVolume() && fTrackID == 0)
          resetVertex();
    }
 }
@@ -166,17 +166,30 @@ bool AtTpc::reactionOccursHere()
 {
    bool atEnergyLoss = fELossAcc * 1000 > AtVertexPropagator::Instance()->GetRndELoss();
    bool isPrimaryBeam = fTrackID == 0;
-   bool isInRightVolume = fVolName.Contains("drift_volume") || fVolName.Contains("cell");
+   bool isInRightVolume = isGasVolume();
    return atEnergyLoss && isPrimaryBeam && isInRightVolume;
 }
+Int_t AtTpc::internVolume(Int_t volumeID)
+{
+   if (volumeID >= static_cast<Int_t>(fVolNameIDs.size()))
+      fVolNameIDs.resize(volumeID + 1, -1);
+
+   auto &id = fVolNameIDs[volumeID];
+   if (id < 0) {
+      id = fVolNames.size();
+      fVolNames.emplace_back(gMC->CurrentVolName());
+      fIsGasVolume.push_back(fVolNames.back().Contains("drift_volume") || fVolNames.back().Contains("cell"));
+   }
+   return id;
+}
+
 Bool_t AtTpc::ProcessHits(FairVolume *vol)
 {
    /** This method is called from the MC stepping */
 
-   auto *stack = dynamic_cast<AtStack *>(gMC->GetStack());
-   fVolName = gMC->CurrentVolName();
    fVolumeID = vol->getMCid();
    fDetCopyID = vol->getCopyNo();
+   fVolNameID = internVolume(fVolumeID);
 
    if (gMC->IsTrackEntering())
       trackEnteringVolume();
@@ -189,11 +202,11 @@ Bool_t AtTpc::ProcessHits(FairVolume *vol)
    addHit();
 
    // Reaction Occurs here
-   if (reactionOccursHere())
+   if (reactionOccursHere()) {
+      flushPoint();
       startReactionEvent();
+   }
 
-   // Increment number of AtTpc det points in TParticle
-   stack->AddPoint(kAtTpc);
    return kTRUE;
 }
 
@@ -220,28 +233,80 @@ void AtTpc::startReactionEvent()
 
 void AtTpc::addHit()
 {
+   bool firstStep = fTrackID != fLastTrackID || gMC->IsTrackEntering();
+   fLastTrackID = fTrackID;
+
+   if (fNumPendingSteps > 0) {
+      bool sameSegment = fTrackID == fPending.trackID && fVolNameID == fPending.volNameID;
+      bool tooLong = fLength - fPendingStart > fMaxStepLength;
+      bool tooMuchELoss = fMaxStepELoss > 0 && fPending.eLoss + fELoss > fMaxStepELoss;
+      if (firstStep || !sameSegment || tooLong || tooMuchELoss)
+         flushPoint();
+   }
+
+   // The point ends at this step and holds the energy deposited by all merged steps
+   if (fNumPendingSteps == 0) {
+      fPendingStart = fLength - gMC->TrackStep();
+      fPending.eLoss = 0;
+   }
    auto AZ = DecodePdG(gMC->TrackPid());
+   fPending.trackID = fTrackID;
+   fPending.volumeID = fVolumeID;
+   fPending.detCopyID = fDetCopyID;
+   fPending.volNameID = fVolNameID;
+   fPending.A = AZ.first;
+   fPending.Z = AZ.second;
+   fPending.pos = fPosIn;
+   fPending.mom = fMomIn;
+   fPending.time = fTime;
+   fPending.length = fLength;
+   fPending.eLoss += fELoss;
+   fNumPendingSteps++;
+
+   bool lastStep = gMC->IsTrackExiting() || gMC->IsTrackStop() || gMC->IsTrackDisappeared();
+   if (fMaxStepLength <= 0 || firstStep || lastStep)
+      flushPoint();
+}
 
-   Double_t EIni = 0;
-   Double_t AIni = 0;
+void AtTpc::flushPoint()
+{
+   if (fNumPendingSteps == 0)
+      return;
+   fNumPendingSteps = 0;
 
    // We assume that the beam-like particle is fTrackID==0 since it is the first one added in the
    // primary generator
-   if (fTrackID == 0) {
-      EIni = 0;
-      AIni = 0;
-   } else {
-      EIni = AtVertexPropagator::Instance()->GetTrackEnergy(fTrackID);
-      AIni = AtVertexPropagator::Instance()->GetTrackAngle(fTrackID);
+   if (fPending.trackID != fIniTrackID) {
+      fIniTrackID = fPending.trackID;
+      if (fIniTrackID == 0) {
+         fEIni = 0;
+         fAIni = 0;
+      } else {
+         fEIni = AtVertexPropagator::Instance()->GetTrackEnergy(fIniTrackID);
+         fAIni = AtVertexPropagator::Instance()->GetTrackAngle(fIniTrackID);
+      }
    }
 
-   AddHit(fTrackID, fVolumeID, fVolName, fDetCopyID, TVector3(fPosIn.X(), fPosIn.Y(), fPosIn.Z()),
-          TVector3(fMomIn.Px(), fMomIn.Py(), fMomIn.Pz()), fTime, fLength, fELoss, EIni, AIni, AZ.first, AZ.second);
+   const auto &pos = fPending.pos;
+   const auto &mom = fPending.mom;
+   AddHit(fPending.trackID, fPending.volumeID, fVolNames[fPending.volNameID], fPending.detCopyID,
+          TVector3(pos.X(), pos.Y(), pos.Z()), TVector3(mom.Px(), mom.Py(), mom.Pz()), fPending.time, fPending.length,
+          fPending.eLoss, fEIni, fAIni, fPending.A, fPending.Z);
+
+   // Increment number of AtTpc det points in TParticle
+   dynamic_cast<AtStack *>(gMC->GetStack())->AddPoint(kAtTpc, fPending.trackID);
 }
 
-void AtTpc::EndOfEvent()
+void AtTpc::PostTrack()
 {
+   flushPoint();
+}
 
+void AtTpc::EndOfEvent()
+{
+   fNumPendingSteps = 0;
+   fLastTrackID = -1;
+   fIniTrackID = -1;
    fAtTpcPointCollection->Clear();
 }
 
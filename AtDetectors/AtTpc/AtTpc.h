@@ -17,6 +17,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 class AtMCPoint;
 class FairVolume;
@@ -51,10 +52,44 @@ private:
    TClonesArray *fTraCollection{}; //!  The hit collection
    Bool_t kGeoSaved{};             //!
    TList *flGeoPar{};              //!
-   TString fVolName;
    Double32_t fELossAcc;
    TLorentzVector InPos;
 
+   /** Names of the volumes seen so far, the current one is referred to by its index (interned ID) so
+   no string is copied or searched at each step.
+   */
+   std::vector<TString> fVolNames;   //!
+   std::vector<Bool_t> fIsGasVolume; //!  If the volume name contains drift_volume or cell
+   std::vector<Int_t> fVolNameIDs;   //!  Interned ID of each MC volume ID
+   Int_t fVolNameID{-1};             //!  Interned ID of the current volume
+
+   Int_t fIniTrackID{-1}; //!  Track of fEIni and fAIni
+   Double_t fEIni{0};     //!
+   Double_t fAIni{0};     //!
+
+   /** Step aggregation. Consecutive steps of a track in a volume are merged into one point until it is longer
+   than fMaxStepLength or deposits more than fMaxStepELoss.
+   */
+   struct StepPoint {
+      Int_t trackID;
+      Int_t volumeID;
+      Int_t detCopyID;
+      Int_t volNameID;
+      Int_t A;
+      Int_t Z;
+      TLorentzVector pos;
+      TLorentzVector mom;
+      Double_t time;
+      Double_t length;
+      Double_t eLoss;
+   };
+   Double_t fMaxStepLength{0}; //  [cm] Aggregation is off if <= 0
+   Double_t fMaxStepELoss{0};  //  [GeV] No limit if <= 0
+   StepPoint fPending{};       //!  Steps merged so far, ending at the last one
+   Int_t fNumPendingSteps{0};  //!
+   Double_t fPendingStart{0};  //!  Track length at the start of the first merged step
+   Int_t fLastTrackID{-1};     //!  Track of the last step recorded
+
    /** container for data points */
 
    TClonesArray *fAtTpcPointCollection; //!
@@ -76,11 +111,26 @@ public:
    virtual void Reset() override;
    virtual void Print(Option_t *option = "") const override;
    virtual void EndOfEvent() override;
+   virtual void PostTrack() override;
 
    /** From FairModule **/
    virtual void ConstructGeometry() override;
    virtual Bool_t CheckIfSensitive(std::string name) override;
 
+   /**
+    * Merge consecutive steps of the same track in the same volume into a single AtMCPoint, to reduce the
+    * number of points to store and digitize. A point ends at the last merged step, with its position, time,
+    * length and momentum, and holds the energy deposited by all merged steps. The first step of a track in a
+    * volume is always kept alone since AtClusterize uses it as the start of the track. Off by default.
+    * @param maxLength Maximum track length covered by a point [cm]. Aggregation is off if <= 0.
+    * @param maxELoss Maximum energy deposited in a point [GeV]. No limit if <= 0.
+    */
+   void SetStepAggregation(Double_t maxLength, Double_t maxELoss = 0)
+   {
+      fMaxStepLength = maxLength;
+      fMaxStepELoss = maxELoss;
+   }
+
    AtMCPoint *
    AddHit(Int_t trackID, Int_t detID, TVector3 pos, TVector3 mom, Double_t time, Double_t length, Double_t eLoss);
 
@@ -96,13 +146,17 @@ private:
    void correctPosOut();
    void resetVertex();
    void addHit();
+   void flushPoint();
+   Int_t internVolume(Int_t volumeID);
+   const TString &volName() const { return fVolNames[fVolNameID]; }
+   Bool_t isGasVolume() const { return fIsGasVolume[fVolNameID]; }
    bool reactionOccursHere();
    void startReactionEvent();
 
    AtTpc(const AtTpc &);
    AtTpc &operator=(const AtTpc &);
 
-   ClassDefOverride(AtTpc, 2)
+   ClassDefOverride(AtTpc, 3)
 };
 
 #endif // NEWDETECTOR_H
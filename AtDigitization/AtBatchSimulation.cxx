@@ -0,0 +1,202 @@
+#include "AtBatchSimulation.h"
+
+#include "AtClusterize.h"
+#include "AtPulse.h"
+#include "AtSimpleSimulation.h"
+#include "AtSimulatedPoint.h" // IWYU pragma: keep
+#include "AtSpaceChargeModel.h"
+
+#include <FairLogger.h>
+
+#include <TGeoManager.h>
+#include <TROOT.h>
+#include <TRandom3.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+AtBatchSimulation::AtBatchSimulation(SimPtr sim, ClusterPtr clusterize, PulsePtr pulse, EventGenerator generator)
+   : fSim(std::move(sim)), fClusterize(std::move(clusterize)), fPulse(std::move(pulse)),
+     fGenerator(std::move(generator))
+{
+}
+
+AtBatchSimulation::~AtBatchSimulation() = default;
+
+void AtBatchSimulation::SetParameters(const AtDigiPar *par)
+{
+   fClusterize->GetParameters(par);
+   fPulse->SetParameters(par);
+   if (fSim->GetSpaceChargeModel()) {
+      fSim->GetSpaceChargeModel()->LoadParameters(par);
+      fSim->GetSpaceChargeModel()->BakeField();
+   }
+
+   // The workers are clones of the old clusterize and pulse
+   fWorkers.clear();
+}
+
+void AtBatchSimulation::SetNumThreads(int num)
+{
+   if (num <= 0)
+      num = std::max(1U, std::thread::hardware_concurrency());
+   if (num > 1)
+      ROOT::EnableThreadSafety();
+   if (num != fNumThreads)
+      fWorkers.clear();
+   fNumThreads = num;
+}
+
+UInt_t AtBatchSimulation::GetEventSeed(ULong64_t seed, Long64_t eventID)
+{
+   // splitmix64 of the seed and event, so neighbouring events get unrelated seeds
+   ULong64_t z = seed + 0x9e3779b97f4a7c15ULL * (eventID + 1);
+   z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+   z ^= z >> 31;
+
+   // TRandom3 picks a seed from the clock for 0
+   auto eventSeed = static_cast<UInt_t>(z ^ (z >> 32));
+   return eventSeed == 0 ? 1 : eventSeed;
+}
+
+void AtBatchSimulation::CreateWorkers()
+{
+   // Cloning the pulse is expensive, so the workers are kept between runs
+   if (fWorkers.size() == static_cast<size_t>(fNumThreads))
+      return;
+
+   fWorkers.clear();
+   for (int i = 0; i < fNumThreads; ++i) {
+      Worker worker{fClusterize->Clone(), fPulse->Clone(), std::make_unique<TRandom3>()};
+      worker.clusterize->SetRandom(worker.rng.get());
+      worker.pulse->SetRandom(worker.rng.get());
+      fWorkers.push_back(std::move(worker));
+   }
+}
+
+void AtBatchSimulation::SimulateEvent(Worker &worker, Long64_t eventID, AtRawEvent &event)
+{
+   worker.rng->SetSeed(GetEventSeed(fSeed, eventID));
+
+   try {
+      fSim->NewEvent();
+      fGenerator(*fSim, *worker.rng, eventID);
+      auto points = worker.clusterize->ProcessEvent(fSim->GetPointsArray());
+      event = worker.pulse->GenerateEvent(points);
+   } catch (const std::exception &e) {
+      LOG(error) << "Failed to simulate event " << eventID << ": " << e.what();
+      event = AtRawEvent();
+      event.SetIsGood(false);
+   }
+   event.SetEventID(eventID);
+}
+
+void AtBatchSimulation::Run(Long64_t firstEvent, Long64_t numEvents, const EventSink &sink)
+{
+   CreateWorkers();
+
+   if (fNumThreads == 1) {
+      for (Long64_t i = 0; i < numEvents; ++i) {
+         AtRawEvent event;
+         SimulateEvent(fWorkers[0], firstEvent + i, event);
+         sink(event);
+      }
+   } else
+      RunParallel(firstEvent, numEvents, sink);
+}
+
+std::vector<AtRawEvent> AtBatchSimulation::Run(Long64_t firstEvent, Long64_t numEvents)
+{
+   std::vector<AtRawEvent> events;
+   events.reserve(numEvents);
+   Run(firstEvent, numEvents, [&events](AtRawEvent &event) { events.push_back(std::move(event)); });
+   return events;
+}
+
+/**
+ * The workers take the next event to simulate and leave it in a ring buffer, from which this thread passes
+ * the events to the sink in order. A worker waits when the buffer is full, so a slow event only holds up the
+ * workers once they are fMaxBuffered events ahead of it.
+ */
+void AtBatchSimulation::RunParallel(Long64_t firstEvent, Long64_t numEvents, const EventSink &sink)
+{
+   if (gGeoManager == nullptr)
+      LOG(fatal) << "No geometry loaded to simulate events with";
+   else if (!gGeoManager->IsMultiThread() || TGeoManager::GetMaxThreads() < fNumThreads)
+      gGeoManager->SetMaxThreads(fNumThreads);
+
+   Long64_t bufferSize = fMaxBuffered > 0 ? fMaxBuffered : 16 * fNumThreads;
+   std::vector<AtRawEvent> buffer(bufferSize);
+   std::vector<bool> done(bufferSize, false);
+   Long64_t nextEvent = 0; // Next event to simulate
+   Long64_t nextSink = 0;  // Next event to pass to the sink
+   std::mutex mutex;
+   std::condition_variable eventDone;
+   std::condition_variable spaceFree;
+
+   auto work = [&](Worker &worker) {
+      while (true) {
+         Long64_t i = 0;
+         {
+            std::unique_lock<std::mutex> lock(mutex);
+            spaceFree.wait(lock, [&] { return nextEvent >= numEvents || nextEvent - nextSink < bufferSize; });
+            if (nextEvent >= numEvents)
+               break;
+            i = nextEvent++;
+         }
+
+         AtRawEvent event;
+         SimulateEvent(worker, firstEvent + i, event);
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffer[i % bufferSize] = std::move(event);
+            done[i % bufferSize] = true;
+         }
+         eventDone.notify_one();
+      }
+      AtSimpleSimulation::ReleaseNavigator();
+   };
+
+   std::vector<std::thread> threads;
+   for (auto &worker : fWorkers)
+      threads.emplace_back(work, std::ref(worker));
+
+   auto joinWorkers = [&threads] {
+      for (auto &th : threads)
+         th.join();
+
+      // The geometry gives an id to each thread navigating, forget the ones of the workers
+      gGeoManager->ClearThreadsMap();
+   };
+
+   try {
+      for (Long64_t i = 0; i < numEvents; ++i) {
+         AtRawEvent event;
+         {
+            std::unique_lock<std::mutex> lock(mutex);
+            eventDone.wait(lock, [&] { return done[i % bufferSize]; });
+            event = std::move(buffer[i % bufferSize]);
+            done[i % bufferSize] = false;
+            nextSink = i + 1;
+         }
+         spaceFree.notify_all();
+         sink(event);
+      }
+   } catch (...) {
+      // Let the workers finish the events they are simulating but start no new one
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         nextEvent = numEvents;
+      }
+      spaceFree.notify_all();
+      joinWorkers();
+      throw;
+   }
+
+   joinWorkers();
+}
@@ -0,0 +1,91 @@
+#ifndef ATBATCHSIMULATION_H
+#define ATBATCHSIMULATION_H
+
+#include "AtRawEvent.h"
+
+#include <Rtypes.h> // for Long64_t, ULong64_t, UInt_t
+
+#include <functional> // for function
+#include <memory>     // for shared_ptr, unique_ptr
+#include <vector>
+
+class AtClusterize;
+class AtDigiPar;
+class AtPulse;
+class AtSimpleSimulation;
+class TRandom;
+
+/**
+ * @brief Generate and digitize many independent events concurrently with an AtSimpleSimulation.
+ *
+ * Each event is simulated by the event generator (which calls AtSimpleSimulation::SimulateParticle), then clusterized
+ * and pulsed into an AtRawEvent. No FairRun is needed: the parameters are passed with SetParameters().
+ *
+ * With several threads every worker has its own clone of the clusterize and pulse, its own random number generator
+ * and its own geometry navigator (the geometry is set up with TGeoManager::SetMaxThreads), so nothing is locked
+ * while an event is simulated. The random number generator is reseeded from the seed and the event number at the
+ * start of every event and is used by the event generator, the clusterize and the pulse. The events only depend
+ * on the seed and their event number, not on the number of threads, and are passed on in event order.
+ */
+class AtBatchSimulation {
+public:
+   using SimPtr = std::shared_ptr<AtSimpleSimulation>;
+   using ClusterPtr = std::shared_ptr<AtClusterize>;
+   using PulsePtr = std::shared_ptr<AtPulse>;
+
+   /**
+    * Simulate the particles of one event with sim. The MC points of the event are cleared before it is called.
+    * Anything random must be drawn from rng for the event to be reproducible.
+    */
+   using EventGenerator = std::function<void(AtSimpleSimulation &sim, TRandom &rng, Long64_t eventID)>;
+   /// Called with every event, in event order, from the thread calling Run().
+   using EventSink = std::function<void(AtRawEvent &event)>;
+
+private:
+   struct Worker {
+      ClusterPtr clusterize;
+      PulsePtr pulse;
+      std::unique_ptr<TRandom> rng;
+   };
+
+   SimPtr fSim;
+   ClusterPtr fClusterize;
+   PulsePtr fPulse;
+   EventGenerator fGenerator;
+
+   int fNumThreads{1};
+   ULong64_t fSeed{0};
+   Long64_t fMaxBuffered{0}; //< Events simulated ahead of the one waiting to be passed on (0 for 16 per thread)
+   std::vector<Worker> fWorkers;
+
+public:
+   AtBatchSimulation(SimPtr sim, ClusterPtr clusterize, PulsePtr pulse, EventGenerator generator);
+   ~AtBatchSimulation();
+
+   /// Load the parameters of the clusterize, pulse and space charge model (if any)
+   void SetParameters(const AtDigiPar *par);
+   /// Number of threads simulating events. If <= 0, one per core.
+   void SetNumThreads(int num);
+   void SetSeed(ULong64_t seed) { fSeed = seed; }
+   /// Maximum number of events simulated ahead of the one waiting to be passed on (limits the memory used)
+   void SetMaxBuffered(Long64_t num) { fMaxBuffered = num; }
+
+   /**
+    * Simulate and digitize the events [firstEvent, firstEvent + numEvents) and pass them in order to sink. An
+    * event that failed to simulate is empty and marked as bad. If sink throws, the events being simulated are
+    * finished and dropped, and the exception is passed on.
+    */
+   void Run(Long64_t firstEvent, Long64_t numEvents, const EventSink &sink);
+   /// Simulate and digitize the events [firstEvent, firstEvent + numEvents) and return them in order.
+   std::vector<AtRawEvent> Run(Long64_t firstEvent, Long64_t numEvents);
+
+   /// Seed used for the event eventID with the seed seed
+   static UInt_t GetEventSeed(ULong64_t seed, Long64_t eventID);
+
+private:
+   void CreateWorkers();
+   void SimulateEvent(Worker &worker, Long64_t eventID, AtRawEvent &event);
+   void RunParallel(Long64_t firstEvent, Long64_t numEvents, const EventSink &sink);
+};
+
+#endif // ATBATCHSIMULATION_H
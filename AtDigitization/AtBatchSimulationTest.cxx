@@ -0,0 +1,165 @@
+#include "AtBatchSimulation.h"
+
+#include "AtClusterize.h"
+#include "AtDigiPar.h"
+#include "AtELossTable.h"
+#include "AtPad.h"
+#include "AtPulse.h"
+#include "AtRawEvent.h"
+#include "AtSimpleSimulation.h"
+#include "AtTpcMap.h"
+
+#include <FairParAsciiFileIo.h>
+#include <FairRunAna.h>
+#include <FairRuntimeDb.h>
+
+#include <Math/Point3D.h>
+#include <Math/Vector4D.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+#include <TRandom.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * Protons from the beam axis simulated in a box of gas, and digitized with the AT-TPC of e12014
+ * (scripts/e12014_pad_mapping.xml and parameters/ATTPC.e12014.par).
+ */
+class AtBatchSimulationTest : public ::testing::Test {
+protected:
+   std::unique_ptr<AtBatchSimulation> fBatch;
+
+   void SetUp() override
+   {
+      const char *dir = std::getenv("VMCWORKDIR");
+      if (dir == nullptr)
+         GTEST_SKIP() << "VMCWORKDIR is not set, no map or parameters to load";
+
+      if (gGeoManager == nullptr) {
+         new TGeoManager("FAIRGeom", "AtBatchSimulationTest");
+         auto mat = new TGeoMaterial("H2", 1.008, 1, 8.4e-5);
+         auto med = new TGeoMedium("H2", 1, mat);
+         gGeoManager->SetTopVolume(gGeoManager->MakeBox("drift_volume", med, 50, 50, 100));
+         gGeoManager->CloseGeometry();
+      }
+
+      auto map = std::make_shared<AtTpcMap>();
+      map->ParseXMLMap((std::string(dir) + "/scripts/e12014_pad_mapping.xml").c_str());
+      map->GeneratePadPlane();
+
+      // Stopping power of a proton with a range of 20 mm at 2 MeV [MeV/mm]
+      std::vector<double> energy;
+      std::vector<double> dEdx;
+      for (double E = 0.001; E < 10; E *= 1.2) {
+         energy.push_back(E);
+         dEdx.push_back(std::pow(E, -0.75) / (1.75 * 20 / std::pow(2, 1.75)));
+      }
+      auto sim = std::make_shared<AtSimpleSimulation>();
+      sim->AddModel(1, 1, std::make_shared<AtTools::AtELossTable>(energy, dEdx));
+
+      auto generator = [](AtSimpleSimulation &simulation, TRandom &rng, Long64_t) {
+         const double mass = 938.272;
+         for (int i = 0; i < 2; ++i) {
+            double E = mass + rng.Uniform(0.5, 2);
+            double p = std::sqrt(E * E - mass * mass);
+            double theta = rng.Uniform(0.3, 1.2);
+            double phi = rng.Uniform(0, TMath::TwoPi());
+            ROOT::Math::PxPyPzEVector mom(p * std::sin(theta) * std::cos(phi), p * std::sin(theta) * std::sin(phi),
+                                          p * std::cos(theta), E);
+            simulation.SimulateParticle(1, 1, {rng.Gaus(0, 2), rng.Gaus(0, 2), rng.Uniform(100, 900)}, mom);
+         }
+      };
+
+      fBatch = std::make_unique<AtBatchSimulation>(sim, std::make_shared<AtClusterize>(),
+                                                   std::make_shared<AtPulse>(map), generator);
+      fBatch->SetParameters(GetDigiPar());
+      fBatch->SetSeed(42);
+   }
+
+   static const AtDigiPar *GetDigiPar()
+   {
+      static const AtDigiPar *par = [] {
+         auto run = FairRunAna::Instance() ? FairRunAna::Instance() : new FairRunAna(); // NOLINT
+         auto rtdb = run->GetRuntimeDb();
+         auto parIo = new FairParAsciiFileIo(); // NOLINT
+         parIo->open((std::string(std::getenv("VMCWORKDIR")) + "/parameters/ATTPC.e12014.par").c_str(), "in");
+         rtdb->setFirstInput(parIo);
+         auto digiPar = dynamic_cast<AtDigiPar *>(rtdb->getContainer("AtDigiPar"));
+         rtdb->initContainers(0);
+         return digiPar;
+      }();
+      return par;
+   }
+
+   static void ExpectSameEvent(const AtRawEvent &expected, const AtRawEvent &event)
+   {
+      EXPECT_EQ(event.GetEventID(), expected.GetEventID());
+      EXPECT_EQ(event.IsGood(), expected.IsGood());
+      ASSERT_EQ(event.GetNumPads(), expected.GetNumPads()) << "Event " << expected.GetEventID();
+      for (auto &pad : expected.GetPads()) {
+         auto other = event.GetPad(pad->GetPadNum());
+         ASSERT_NE(other, nullptr) << "Event " << expected.GetEventID() << " pad " << pad->GetPadNum();
+         EXPECT_EQ(other->GetADC(), pad->GetADC()) << "Event " << expected.GetEventID() << " pad " << pad->GetPadNum();
+      }
+   }
+};
+} // namespace
+
+TEST_F(AtBatchSimulationTest, SameEventsWithEveryNumberOfThreads)
+{
+   fBatch->SetNumThreads(1);
+   auto expected = fBatch->Run(10, 20);
+   ASSERT_EQ(expected.size(), 20u);
+
+   int numPads = 0;
+   for (int i = 0; i < 20; ++i) {
+      EXPECT_EQ(expected[i].GetEventID(), 10u + i);
+      EXPECT_TRUE(expected[i].IsGood());
+      numPads += expected[i].GetNumPads();
+   }
+   EXPECT_GT(numPads, 20);
+
+   // Few events buffered, so the workers wait for the sink
+   fBatch->SetNumThreads(4);
+   fBatch->SetMaxBuffered(3);
+   auto events = fBatch->Run(10, 20);
+   ASSERT_EQ(events.size(), 20u);
+   for (int i = 0; i < 20; ++i)
+      ExpectSameEvent(expected[i], events[i]);
+
+   // The events only depend on their number, not on the first event of the run
+   events = fBatch->Run(15, 5);
+   ASSERT_EQ(events.size(), 5u);
+   for (int i = 0; i < 5; ++i)
+      ExpectSameEvent(expected[i + 5], events[i]);
+}
+
+TEST_F(AtBatchSimulationTest, SinkThrows)
+{
+   fBatch->SetNumThreads(4);
+   int numEvents = 0;
+   auto sink = [&numEvents](AtRawEvent &event) {
+      if (event.GetEventID() == 5)
+         throw std::runtime_error("Sink failed");
+      numEvents++;
+   };
+   EXPECT_THROW(fBatch->Run(0, 100, sink), std::runtime_error);
+   EXPECT_EQ(numEvents, 5);
+
+   // The workers were stopped, so the next run works
+   auto events = fBatch->Run(0, 8);
+   ASSERT_EQ(events.size(), 8u);
+   for (int i = 0; i < 8; ++i)
+      EXPECT_EQ(events[i].GetEventID(), static_cast<ULong_t>(i));
+}
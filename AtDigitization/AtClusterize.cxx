@@ -116,7 +116,7 @@ uint64_t AtClusterize::getNumberOfElectronsGenerated(const AtMCPoint &mcPoint)
    auto energyLoss = mcPoint.GetEnergyLoss() * 1000.;
    auto meanElec = energyLoss / fEIonize;
    auto sigElec = TMath::Sqrt(fFano * meanElec);
-   return gRandom->Gaus(meanElec, sigElec);
+   return getRandom()->Gaus(meanElec, sigElec);
 }
 
 AtClusterize::XYZPoint AtClusterize::getCurrentPointLocation(const AtMCPoint &mcPoint)
@@ -127,12 +127,17 @@ AtClusterize::XYZPoint AtClusterize::getCurrentPointLocation(const AtMCPoint &mc
    return {mcPoint.GetX() * 10., mcPoint.GetY() * 10., driftTime};
 }
 
+TRandom *AtClusterize::getRandom() const
+{
+   return fRandom ? fRandom : gRandom;
+}
+
 AtClusterize::XYZPoint
 AtClusterize::applyDiffusion(const AtClusterize::XYZPoint &loc, double_t sigTrans, double sigLong)
 {
-   auto r = gRandom->Gaus(0, sigTrans);
-   auto phi = gRandom->Uniform(0, TMath::TwoPi());
-   auto dz = gRandom->Gaus(0, sigLong);
+   auto r = getRandom()->Gaus(0, sigTrans);
+   auto phi = getRandom()->Uniform(0, TMath::TwoPi());
+   auto dz = getRandom()->Gaus(0, sigLong);
 
    return loc + XYZVector(r * TMath::Cos(phi), r * TMath::Sin(phi), dz);
 }
@@ -15,6 +15,7 @@ class AtDigiPar;
 class AtMCPoint;
 class AtSimulatedPoint;
 class TClonesArray;
+class TRandom;
 
 /**
  * Class to hold the clusterizing logic
@@ -34,6 +35,8 @@ protected:
    double fCoefL{};       //!< Longitudinal diffusion coefficient. [cm^2/us]
    double fDetPadPlane{}; //!< Position of the pad plane with respect to the entrance [mm]
 
+   TRandom *fRandom{nullptr}; //!< Random number generator (gRandom if null). Not owned.
+
    static thread_local XYZPoint fPrevPoint; //!< The previous point we recorded charge.
    static thread_local int fTrackID;        //!< The current track ID
 
@@ -43,6 +46,8 @@ public:
    virtual std::string GetSavedClassName() const { return "AtSimulatedPoint"; }
    virtual void FillTClonesArray(TClonesArray &array, std::vector<SimPointPtr> &vec);
    virtual std::shared_ptr<AtClusterize> Clone() const { return std::make_shared<AtClusterize>(*this); }
+   /// Use rng instead of gRandom (not owned). Used to give each thread its own generator.
+   void SetRandom(TRandom *rng) { fRandom = rng; }
 
 private:
    XYZPoint applyDiffusion(const XYZPoint &loc, double_t sigTrans, double sigLong);
@@ -55,6 +60,7 @@ protected:
    double getLongitudinalDiffusion(double driftTime); // in us
    uint64_t getNumberOfElectronsGenerated(const AtMCPoint &mcPoint);
    XYZPoint getCurrentPointLocation(const AtMCPoint &mcPoint);
+   TRandom *getRandom() const;
 };
 
 #endif // #ifndef ATCLUSTERIZE_H
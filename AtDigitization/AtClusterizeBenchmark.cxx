@@ -0,0 +1,35 @@
+#include "AtClusterize.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtMCPoint.h"
+#include "AtSimulatedPoint.h"
+
+#include <TClonesArray.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/// Drift and diffuse the electrons of the MC points of a track
+void BM_ClusterizeProcessEvent(benchmark::State &state)
+{
+   TClonesArray mcPoints("AtMCPoint");
+   AtBenchmark::FillMCPoints(mcPoints);
+   AtClusterize clusterize;
+   clusterize.GetParameters(AtBenchmark::GetDigiPar());
+
+   std::size_t numElectrons = 0;
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      auto points = clusterize.ProcessEvent(mcPoints);
+      numElectrons = points.size();
+   }
+   counter.SetCounters();
+
+   state.counters["MC points"] = mcPoints.GetEntriesFast();
+   state.counters["electrons"] = numElectrons;
+}
+BENCHMARK(BM_ClusterizeProcessEvent);
+
+} // namespace
@@ -23,4 +23,5 @@
 #pragma link C++ class AtVectorResponse - ;
 #pragma link C++ class AtTestSimulation + ;
 #pragma link C++ class AtSimpleSimulation - !;
+#pragma link C++ class AtBatchSimulation - !;
 #endif
@@ -16,7 +16,6 @@
 #include <Math/Point2D.h>
 #include <Math/Point2Dfwd.h> // for XYPoint
 #include <Rtypes.h>          // for Int_t
-#include <TAxis.h>
 #include <TMath.h> // for Gamma, Sqrt
 #include <TRandom.h>
 #include <TString.h> // for TString
@@ -35,8 +34,9 @@ AtPulse::AtPulse(const AtPulse &other)
    : fMap(other.fMap), fEventID(other.fEventID), fGain(other.fGain), fLowGainFactor(other.fLowGainFactor),
      fGETGain(other.fGETGain), fPeakingTime(other.fPeakingTime), fTBTime(other.fTBTime), fNumTbs(other.fNumTbs),
      fTBEntrance(other.fTBEntrance), fTBPadPlane(other.fTBPadPlane), fResponse(other.fResponse),
-     fUseFastGain(other.fUseFastGain), fNoiseSigma(other.fNoiseSigma), fSaveCharge(other.fSaveCharge),
-     fDoConvolution(other.fDoConvolution), fAvgGainDeviation(other.fAvgGainDeviation)
+     fResponseKernels(other.fResponseKernels), fUseFastGain(other.fUseFastGain), fNoiseSigma(other.fNoiseSigma),
+     fSaveCharge(other.fSaveCharge), fDoConvolution(other.fDoConvolution), fAvgGainDeviation(other.fAvgGainDeviation),
+     fRandom(other.fRandom)
 {
 
    // For reasons unknown, copying the historgam from other (calling copy constructor) causes a huge performance hit.
@@ -81,30 +81,28 @@ AtRawEvent AtPulse::GenerateEvent(std::vector<AtSimulatedPoint *> &vec)
 
 void AtPulse::FillPad(AtPad &pad, TH1F &hist)
 {
-   auto axis = hist.GetXaxis();
-   double binWidth = axis->GetBinWidth(10);
+   const auto &kernel = GetResponseKernel(pad.GetPadNum());
    auto charge = std::make_unique<AtPadArray>();
+   auto adc = pad.GetADC();
 
    for (int kk = 1; kk <= fNumTbs; ++kk) {
       double nEle = hist.GetBinContent(kk);
       if (nEle > 0) {
          // Scale the saved charge down so its closer to reco
-         charge->SetArray(kk - 1, nEle * fGETGain * fResponse(pad.GetPadNum(), fPeakingTime));
+         charge->SetArray(kk - 1, nEle * fGETGain * kernel.peak);
          // charge->SetArray(kk - 1, nEle);
          if (!fDoConvolution) {
-            pad.SetADC(kk - 1, 0);
+            adc[kk - 1] = 0;
             continue;
          }
 
-         // Do the convolution
-         for (int nn = kk - 1; nn < fNumTbs; ++nn) {
-            double binCenter = axis->GetBinCenter(kk);
-            double time = ((double)nn + 0.5) * binWidth - binCenter;
-            double newADC = pad.GetADC(nn) + nEle * fResponse(pad.GetPadNum(), time);
-            pad.SetADC(nn, newADC);
-         }
+         // Do the convolution. The charge is at the center of bin kk-1, so the response at the center
+         // of bin nn is evaluated (nn - kk + 1) time buckets after the charge arrived.
+         for (int nn = kk - 1; nn < fNumTbs; ++nn)
+            adc[nn] += nEle * kernel.response[nn - kk + 1];
       }
    }
+   pad.SetADC(adc);
 
    pad.SetValidPad(true);
    pad.SetPadCoord(fMap->CalcPadCenter(pad.GetPadNum()));
@@ -115,12 +113,33 @@ void AtPulse::FillPad(AtPad &pad, TH1F &hist)
    ApplyNoise(pad);
 }
 
+/**
+ * Get the response of the electronics for padNum sampled at every time bucket. The response
+ * function is only evaluated the first time a pad is requested by this AtPulse or any of its clones.
+ */
+const AtPulse::ResponseKernel &AtPulse::GetResponseKernel(int padNum)
+{
+   std::lock_guard<std::mutex> lock(fResponseKernels->mutex);
+   auto &kernel = fResponseKernels->kernels[padNum];
+   if (kernel)
+      return *kernel;
+
+   auto newKernel = std::make_unique<ResponseKernel>();
+   newKernel->peak = fResponse(padNum, fPeakingTime);
+   newKernel->response.resize(fNumTbs);
+   for (int i = 0; i < fNumTbs; ++i)
+      newKernel->response[i] = fResponse(padNum, i * fTBTime);
+
+   kernel = std::move(newKernel);
+   return *kernel;
+}
+
 void AtPulse::ApplyNoise(AtPad &pad)
 {
    for (int i = 0; i < fNumTbs; ++i) {
       pad.SetADC(i, pad.GetADC(i) * fGETGain);
       if (fNoiseSigma != 0)
-         pad.SetADC(i, pad.GetADC(i) * gRandom->Gaus(0, fNoiseSigma));
+         pad.SetADC(i, pad.GetADC(i) * GetRandom()->Gaus(0, fNoiseSigma));
    }
 }
 
@@ -173,6 +192,8 @@ void AtPulse::SetParameters(const AtDigiPar *fPar)
    // If there is not a response function create a default one
    if (fResponse == nullptr)
       fResponse = ElectronicResponse::AtNominalResponse(fPeakingTime);
+   // Clones made before keep the kernels of the old parameters
+   fResponseKernels = std::make_shared<ResponseKernels>();
 }
 
 /**
@@ -214,10 +235,15 @@ double AtPulse::GetGain(int padNum, int numElectrons)
       lowGain = fLowGainFactor;
 
    if (fUseFastGain && numElectrons > 10)
-      return gRandom->Gaus(fGain, fAvgGainDeviation / TMath::Sqrt(numElectrons)) * lowGain;
+      return GetRandom()->Gaus(fGain, fAvgGainDeviation / TMath::Sqrt(numElectrons)) * lowGain;
 
    double g = 0;
    for (Int_t i = 0; i < numElectrons; i++)
-      g += fGainFunc->GetRandom();
+      g += fGainFunc->GetRandom(GetRandom());
    return g / numElectrons * lowGain;
 }
+
+TRandom *AtPulse::GetRandom() const
+{
+   return fRandom ? fRandom : gRandom;
+}
@@ -10,14 +10,17 @@
 
 #include <functional> // for function
 #include <memory>     // for unique_ptr, shared_ptr
+#include <mutex>
 #include <set>
-#include <type_traits> // for add_pointer_t
-#include <vector>      // for vector
+#include <type_traits>   // for add_pointer_t
+#include <unordered_map> // for unordered_map
+#include <vector>        // for vector
 class AtMap;
 class AtSimulatedPoint;
 class AtRawEvent;
 class AtDigiPar;
 class AtPad;
+class TRandom;
 
 class AtPulse {
 protected:
@@ -42,6 +45,18 @@ protected:
    int fTBPadPlane = 0;       //! Pad plane location in TBs (calculated from DriftVelocity, TBEntrance, ZPadPlane
 
    ResponseFunc fResponse; //! Response function of the electronics
+
+   /// Response function of a pad sampled at the time buckets
+   struct ResponseKernel {
+      double peak;                  //< Response at the peaking time
+      std::vector<double> response; //< Response at time i * fTBTime
+   };
+   /// Response kernel of each pad, filled on first use and shared between an AtPulse and its clones
+   struct ResponseKernels {
+      std::mutex mutex;
+      std::unordered_map<int, std::unique_ptr<const ResponseKernel>> kernels;
+   };
+   std::shared_ptr<ResponseKernels> fResponseKernels{std::make_shared<ResponseKernels>()}; //!<
    bool fUseFastGain = true;
    double fNoiseSigma = 0; //! Sigma of random gaussian noise to apply to trace
    bool fSaveCharge = true;
@@ -52,6 +67,7 @@ protected:
 
    std::unique_ptr<TF1> fGainFunc; //!<
    double fAvgGainDeviation{};
+   TRandom *fRandom{nullptr}; //!< Random number generator (gRandom if null). Not owned.
 
 public:
    AtPulse(AtMapPtr map, ResponseFunc response = nullptr);
@@ -64,6 +80,8 @@ public:
    void SetSaveCharge(bool val) { fSaveCharge = val; }
    void SetDoConvolution(bool val) { fDoConvolution = val; }
    void SetLowGain(double val) { fLowGainFactor = val; }
+   /// Use rng instead of gRandom (not owned). Used to give each thread its own generator.
+   void SetRandom(TRandom *rng) { fRandom = rng; }
 
    AtRawEvent GenerateEvent(std::vector<SimPointPtr> &vec);
    virtual AtRawEvent GenerateEvent(std::vector<AtSimulatedPoint *> &vec);
@@ -76,7 +94,9 @@ protected:
    double GetGain(int padNum, int numElectrons);
    void GenerateTraceFromElectrons();
    void FillPad(AtPad &pad, TH1F &hist);
+   const ResponseKernel &GetResponseKernel(int padNum);
    void ApplyNoise(AtPad &pad);
+   TRandom *GetRandom() const;
 };
 
 #endif // ATPULSE_H
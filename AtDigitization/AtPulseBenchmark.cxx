@@ -0,0 +1,45 @@
+#include "AtPulse.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtClusterize.h"
+#include "AtMCPoint.h"
+#include "AtRawEvent.h"
+#include "AtSimulatedPoint.h"
+
+#include <TClonesArray.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+/**
+ * Generate the traces from the simulated electrons of a track. This covers the convolution with the response of
+ * the electronics done in AtPulse::FillPad (protected) for every pad with charge.
+ */
+void BM_PulseGenerateEvent(benchmark::State &state)
+{
+   TClonesArray mcPoints("AtMCPoint");
+   AtBenchmark::FillMCPoints(mcPoints);
+   AtClusterize clusterize;
+   clusterize.GetParameters(AtBenchmark::GetDigiPar());
+   auto electrons = clusterize.ProcessEvent(mcPoints);
+
+   AtPulse pulse(AtBenchmark::GetMap());
+   pulse.SetParameters(AtBenchmark::GetDigiPar());
+   pulse.SetDoConvolution(state.range(0));
+
+   AtRawEvent event;
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state)
+      event = pulse.GenerateEvent(electrons);
+   counter.SetCounters();
+
+   state.counters["electrons"] = electrons.size();
+   state.counters["pads"] = event.GetNumPads();
+}
+BENCHMARK(BM_PulseGenerateEvent)->ArgName("convolution")->Arg(false)->Arg(true);
+
+} // namespace
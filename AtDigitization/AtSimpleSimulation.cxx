@@ -10,10 +10,12 @@
 
 #include <TClonesArray.h> // for TClonesArray
 #include <TGeoManager.h>
+#include <TGeoNavigator.h>
 #include <TGeoNode.h>
 #include <TGeoVolume.h>
 #include <TObject.h> // for TObject
 
+#include <algorithm> // for clamp
 #include <cmath>     // for sqrt
 #include <stdexcept> // for invalid_argument
 #include <utility>   // for pair
@@ -55,6 +57,16 @@ bool AtSimpleSimulation::ParticleID::operator<(const ParticleID &other) const
 TGeoVolume *AtSimpleSimulation::GetVolume(const XYZPoint &point)
 {
    auto pointCm = point / 10.;
+
+   // With several threads each one has its own navigator, so no lock is needed
+   if (gGeoManager->IsMultiThread()) {
+      auto nav = gGeoManager->GetCurrentNavigator();
+      if (nav == nullptr)
+         nav = gGeoManager->AddNavigator();
+      TGeoNode *node = nav->FindNode(pointCm.X(), pointCm.Y(), pointCm.Z());
+      return node ? node->GetVolume() : nullptr;
+   }
+
    {
       std::lock_guard<std::mutex> lock(fGeoMutex);
       TGeoNode *node = gGeoManager->FindNode(pointCm.X(), pointCm.Y(), pointCm.Z());
@@ -65,6 +77,14 @@ TGeoVolume *AtSimpleSimulation::GetVolume(const XYZPoint &point)
    }
 }
 
+void AtSimpleSimulation::ReleaseNavigator()
+{
+   if (gGeoManager == nullptr || !gGeoManager->IsMultiThread())
+      return;
+   if (auto nav = gGeoManager->GetCurrentNavigator())
+      gGeoManager->RemoveNavigator(nav);
+}
+
 bool AtSimpleSimulation::IsInVolume(const std::string &volName, const XYZPoint &point)
 {
 
@@ -131,7 +151,8 @@ AtSimpleSimulation::SimulateParticle(ModelPtr model, const XYZPoint &iniPos, con
 
       // Get the energy loss from the model
       double KE = mom.E() - mom.M();
-      double eLoss = model->GetEnergyLoss(KE, fDistStep);
+      double step = GetStep(*model, KE);
+      double eLoss = model->GetEnergyLoss(KE, step);
 
       // Update the momentum from the energy loss model. Assume the energy loss does not change
       // the direction of the particle.
@@ -142,14 +163,38 @@ AtSimpleSimulation::SimulateParticle(ModelPtr model, const XYZPoint &iniPos, con
 
       LOG(debug) << mom << " " << mom.M() << " " << iniMom.M();
 
-      pos += dir * fDistStep;
-      length += fDistStep;
+      pos += dir * step;
+      length += step;
       AddHit(eLoss, pos, mom, length);
    }
 
    return {pos, mom};
 }
 
+/**
+ * The relative change in the stopping power S over a step s is |dS/dE| * S * s / S = |dS/dE| * s, so the step
+ * is maxdEdxChange / |dS/dE|. dS/dE is estimated over the energy lost in a maximum step.
+ */
+double AtSimpleSimulation::GetStep(const AtTools::AtELossModel &model, double KE) const
+{
+   if (fMaxdEdxChange <= 0)
+      return fDistStep;
+
+   double dEdx = model.GetdEdx(KE);
+   double dE = std::min(dEdx * fDistStep, KE / 2);
+   if (dE <= 0)
+      return fDistStep;
+   double gradient = std::abs(dEdx - model.GetdEdx(KE - dE)) / dE;
+   if (gradient == 0)
+      return fDistStep;
+   return std::clamp(fMaxdEdxChange / gradient, std::min(fMinDistStep, fDistStep), fDistStep);
+}
+
+void AtSimpleSimulation::SetSpaceChargeModel(SpaceChargeModel model)
+{
+   fSCModel = std::move(model);
+}
+
 void AtSimpleSimulation::NewEvent()
 {
    fMCPoints.Clear();
@@ -175,7 +220,7 @@ void AtSimpleSimulation::AddHit(double ELoss, const XYZPoint &pos, const PxPyPzE
       // In the data analysis that is flipped, so we must adjust the z value, apply SC and move back
       auto posExpCoord = pos;
       posExpCoord.SetZ(1000 - pos.Z());
-      auto corrExpCoord = fSCModel->ApplySpaceCharge(posExpCoord);
+      auto corrExpCoord = fSCModel->ApplyPosition(posExpCoord);
       corrExpCoord.SetZ(1000 + corrExpCoord.Z());
       mcPoint->SetPosition(corrExpCoord / 10.);
    } else
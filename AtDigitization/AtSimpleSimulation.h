@@ -44,8 +44,10 @@ protected:
 
    std::map<ParticleID, ModelPtr> fModels;
    SpaceChargeModel fSCModel{nullptr};
-   double fDistStep{1.}; // Distance step in mm for particles
-   std::mutex fGeoMutex;
+   double fDistStep{1.};      // Distance step in mm for particles (the maximum step if adaptive)
+   double fMinDistStep{0.1};  // Minimum distance step in mm if adaptive
+   double fMaxdEdxChange{0.}; // Maximum relative change in the stopping power over a step (0 for a fixed step)
+   std::mutex fGeoMutex;      // Only used if the geometry is not set up for multiple threads
 
    // Variables to across an entire event
    static thread_local int fTrackID;
@@ -62,9 +64,28 @@ public:
 
    void RegisterBranch(std::string branchName = "AtTpcPoint", bool pers = true);
    void AddModel(int Z, int A, ModelPtr model);
-   void SetSpaceChargeModel(SpaceChargeModel model) { fSCModel = model; }
+   /// The field of the model is tabulated when first used (see AtSpaceChargeModel::SetFieldGrid)
+   void SetSpaceChargeModel(SpaceChargeModel model);
    void SetDistanceStep(double step) { fDistStep = step; } //<In mm
 
+   /**
+    * Use a step size driven by the stopping power gradient of the energy loss model. The step is the one over which
+    * the stopping power changes by maxdEdxChange (relative), between minStep and the distance step (in mm). Steps
+    * are long where the particle is fast and shrink approaching the Bragg peak. 0 to use a fixed step (the default).
+    */
+   void SetAdaptiveStep(double maxdEdxChange, double minStep = 0.1)
+   {
+      fMaxdEdxChange = maxdEdxChange;
+      fMinDistStep = minStep;
+   }
+
+   /**
+    * Free the geometry navigator of the calling thread. When the geometry is set up for multiple threads
+    * (TGeoManager::SetMaxThreads) each thread navigates with its own navigator, created on first use. Call this
+    * before a thread simulating particles exits.
+    */
+   static void ReleaseNavigator();
+
    void NewEvent();
 
    /**
@@ -95,6 +116,7 @@ protected:
       ModelPtr model, const XYZPoint &iniPos, const PxPyPzEVector &iniMom,
       std::function<bool(XYZPoint, PxPyPzEVector)> func = [](XYZPoint pos, PxPyPzEVector mom) { return true; });
    void AddHit(double ELoss, const XYZPoint &pos, const PxPyPzEVector &mom, double length);
+   double GetStep(const AtTools::AtELossModel &model, double KE) const;
    TGeoVolume *GetVolume(const XYZPoint &pos);
 };
 
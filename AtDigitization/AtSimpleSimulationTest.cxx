@@ -0,0 +1,150 @@
+#include "AtSimpleSimulation.h"
+
+#include "AtELossModel.h"
+#include "AtMCPoint.h"
+
+#include <Math/Point3D.h>
+#include <Math/Vector4D.h>
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+/// Bragg-Kleeman rule: the range is alpha * E^p, so the stopping power diverges at the end of the track
+class AtBraggKleemanModel : public AtTools::AtELossModel {
+   double fAlpha;
+   double fP;
+
+public:
+   AtBraggKleemanModel(double alpha, double p) : AtELossModel(0), fAlpha(alpha), fP(p) {}
+
+   double GetdEdx(double energy) const override { return std::pow(energy, 1 - fP) / (fP * fAlpha); }
+   double GetRange(double energyIni, double energyFin = 0) const override
+   {
+      return fAlpha * (std::pow(energyIni, fP) - std::pow(energyFin, fP));
+   }
+   double GetEnergyLoss(double energyIni, double distance) const override
+   {
+      return energyIni - GetEnergy(energyIni, distance);
+   }
+   double GetEnergy(double energyIni, double distance) const override
+   {
+      double range = GetRange(energyIni) - distance;
+      return range <= 0 ? 0 : std::pow(range / fAlpha, 1 / fP);
+   }
+};
+
+class AtStepTestSimulation : public AtSimpleSimulation {
+public:
+   using AtSimpleSimulation::GetStep;
+};
+
+class AtSimpleSimulationTest : public ::testing::Test {
+protected:
+   static constexpr double kMass = 938.272;
+   static constexpr double kEnergy = 5.1;
+
+   std::shared_ptr<AtBraggKleemanModel> fModel{std::make_shared<AtBraggKleemanModel>(100 / std::pow(5., 1.75), 1.75)};
+
+   void SetUp() override
+   {
+      if (gGeoManager == nullptr) {
+         new TGeoManager("FAIRGeom", "AtSimpleSimulationTest");
+         auto mat = new TGeoMaterial("H2", 1.008, 1, 8.4e-5);
+         auto med = new TGeoMedium("H2", 1, mat);
+         gGeoManager->SetTopVolume(gGeoManager->MakeBox("drift_volume", med, 50, 50, 100));
+         gGeoManager->CloseGeometry();
+      }
+   }
+
+   /// Energy deposited by a proton in each bin of width binWidth along its track, from start to end [mm]
+   std::vector<double> BraggCurve(AtSimpleSimulation &sim, double start, double end, double binWidth)
+   {
+      sim.NewEvent();
+      sim.AddModel(1, 1, fModel);
+      double E = kEnergy + kMass;
+      sim.SimulateParticle(1, 1, {0, 0, 0}, {0, 0, std::sqrt(E * E - kMass * kMass), E});
+
+      // The energy lost over a step is spread uniformly over the step
+      std::vector<double> curve(std::lround((end - start) / binWidth));
+      double stepStart = 0;
+      for (int i = 0; i < sim.GetNumPoints(); ++i) {
+         auto &point = sim.GetMcPoint(i);
+         double stepEnd = point.GetLength() * 10;
+         for (int bin = 0; bin < curve.size(); ++bin) {
+            double binStart = start + bin * binWidth;
+            double overlap = std::min(stepEnd, binStart + binWidth) - std::max(stepStart, binStart);
+            if (overlap > 0)
+               curve[bin] += point.GetEnergyLoss() * 1000 * overlap / (stepEnd - stepStart);
+         }
+         stepStart = stepEnd;
+      }
+      return curve;
+   }
+
+   /// Largest difference between two Bragg curves, relative to the maximum of the first one
+   static double MaxDifference(const std::vector<double> &expected, const std::vector<double> &curve)
+   {
+      double diff = 0;
+      for (int i = 0; i < expected.size(); ++i)
+         diff = std::max(diff, std::abs(curve[i] - expected[i]));
+      return diff / *std::max_element(expected.begin(), expected.end());
+   }
+};
+} // namespace
+
+TEST_F(AtSimpleSimulationTest, GetStep)
+{
+   AtStepTestSimulation sim;
+   sim.SetDistanceStep(1);
+   EXPECT_EQ(sim.GetStep(*fModel, 5), 1);
+   EXPECT_EQ(sim.GetStep(*fModel, 0.01), 1);
+
+   sim.SetAdaptiveStep(0.02, 0.01);
+   // The stopping power barely changes over a mm while the particle is fast, and diverges at the end of the track
+   EXPECT_EQ(sim.GetStep(*fModel, 5), 1);
+   double last = 1;
+   for (double E : {2., 1., 0.5, 0.3}) {
+      double step = sim.GetStep(*fModel, E);
+      EXPECT_LT(step, last) << "At " << E << " MeV";
+      EXPECT_GE(step, 0.01) << "At " << E << " MeV";
+      last = step;
+   }
+   EXPECT_EQ(sim.GetStep(*fModel, 1e-4), 0.01);
+
+   // The minimum step can't be larger than the step
+   sim.SetDistanceStep(0.005);
+   EXPECT_EQ(sim.GetStep(*fModel, 1e-4), 0.005);
+}
+
+TEST_F(AtSimpleSimulationTest, AdaptiveStepFollowsBraggCurve)
+{
+   // The end of the track (the range is 103.5 mm), where the peak is
+   double start = std::floor(fModel->GetRange(kEnergy)) - 4;
+   double end = start + 6;
+   double binWidth = 0.25;
+
+   AtSimpleSimulation sim;
+   sim.SetDistanceStep(0.01);
+   auto expected = BraggCurve(sim, start, end, binWidth);
+   int numFixed = sim.GetNumPoints();
+
+   sim.SetDistanceStep(1);
+   sim.SetAdaptiveStep(0.02, 0.01);
+   auto adaptive = BraggCurve(sim, start, end, binWidth);
+   EXPECT_LT(MaxDifference(expected, adaptive), 0.05);
+   EXPECT_LT(sim.GetNumPoints(), numFixed / 20);
+
+   // A fixed step of the same length along the plateau does not resolve the peak
+   sim.SetAdaptiveStep(0);
+   auto fixed = BraggCurve(sim, start, end, binWidth);
+   EXPECT_GT(MaxDifference(expected, fixed), 0.2);
+}
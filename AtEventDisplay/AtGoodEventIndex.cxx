@@ -0,0 +1,162 @@
+#include "AtGoodEventIndex.h"
+
+#include <FairLogger.h>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TObjArray.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderArray.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+void AtGoodEventIndex::Build(TChain *chain, const TString &branchName)
+{
+   if (chain == nullptr || branchName == fBranchName)
+      return;
+
+   // Wait for the previous index, it owns its own files
+   if (fFuture.valid())
+      fFuture.wait();
+
+   fBranchName = branchName;
+   fIsGood.clear();
+   fAvailable = false;
+
+   std::vector<TString> files;
+   for (auto elem : *chain->GetListOfFiles())
+      files.emplace_back(elem->GetTitle());
+
+   // The index is read from separate TFiles on another thread
+   ROOT::EnableThreadSafety();
+   fFuture = std::async(std::launch::async, BuildIndex, std::move(files), TString(chain->GetName()), branchName,
+                        fCacheDir);
+}
+
+Bool_t AtGoodEventIndex::IsAvailable(const TString &branchName)
+{
+   if (branchName != fBranchName)
+      return false;
+   if (fFuture.valid() && fFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      fIsGood = fFuture.get();
+      fAvailable = !fIsGood.empty();
+      LOG(info) << "Good event index of " << fBranchName << (fAvailable ? " is ready" : " is not available");
+   }
+   return fAvailable;
+}
+
+Long64_t AtGoodEventIndex::Next(Long64_t entry) const
+{
+   for (Long64_t i = std::max<Long64_t>(entry + 1, 0); i < static_cast<Long64_t>(fIsGood.size()); ++i)
+      if (fIsGood[i])
+         return i;
+   return -1;
+}
+
+Long64_t AtGoodEventIndex::Prev(Long64_t entry) const
+{
+   for (Long64_t i = std::min<Long64_t>(entry, fIsGood.size()) - 1; i >= 0; --i)
+      if (fIsGood[i])
+         return i;
+   return -1;
+}
+
+std::vector<Bool_t>
+AtGoodEventIndex::BuildIndex(std::vector<TString> files, TString treeName, TString branchName, TString cacheDir)
+{
+   std::vector<Bool_t> isGood;
+   for (auto &fileName : files) {
+      std::vector<Bool_t> fileIsGood;
+      auto cacheName = CacheName(cacheDir, fileName, branchName);
+      if (!cacheName.IsNull() && ReadCache(cacheName, fileName, fileIsGood)) {
+         isGood.insert(isGood.end(), fileIsGood.begin(), fileIsGood.end());
+         continue;
+      }
+
+      std::unique_ptr<TFile> file(TFile::Open(fileName));
+      auto tree = file ? file->Get<TTree>(treeName) : nullptr;
+      if (tree == nullptr || tree->GetBranch(branchName + ".fIsGood") == nullptr) {
+         LOG(info) << "No " << branchName << ".fIsGood in " << fileName << ", not indexing good events";
+         return {};
+      }
+
+      // Only the fIsGood leaf is read
+      TTreeReader reader(tree);
+      TTreeReaderArray<Bool_t> good(reader, branchName + ".fIsGood");
+      fileIsGood.reserve(tree->GetEntries());
+      while (reader.Next())
+         fileIsGood.push_back(good.GetSize() > 0 && good[0]);
+
+      if (!cacheName.IsNull())
+         WriteCache(cacheDir, cacheName, fileName, fileIsGood);
+      isGood.insert(isGood.end(), fileIsGood.begin(), fileIsGood.end());
+   }
+   return isGood;
+}
+
+/// Name of the cache of the index of fileName, or an empty string if there is no cache directory. Input files with
+/// the same name in different directories get different caches.
+TString AtGoodEventIndex::CacheName(const TString &cacheDir, const TString &fileName, const TString &branchName)
+{
+   if (cacheDir.IsNull())
+      return {};
+   auto hash = std::hash<std::string>{}(fileName.Data());
+   return TString::Format("%s/%s.%zx.%s.good", cacheDir.Data(), gSystem->BaseName(fileName), hash, branchName.Data());
+}
+
+/// The cache is valid if the size and modification time of the file match the ones in its header
+Bool_t AtGoodEventIndex::ReadCache(const TString &cacheName, const TString &fileName, std::vector<Bool_t> &isGood)
+{
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fileName, stat) != 0)
+      return false;
+
+   std::ifstream cache(cacheName.Data());
+   Long64_t size = -1;
+   Long_t mtime = -1;
+   std::string flags;
+   if (!(cache >> size >> mtime >> flags) || size != stat.fSize || mtime != stat.fMtime)
+      return false;
+
+   isGood.clear();
+   for (auto flag : flags)
+      isGood.push_back(flag == '1');
+   return true;
+}
+
+/// Written to a temporary file first, so a failed write never leaves a truncated index behind
+void AtGoodEventIndex::WriteCache(const TString &cacheDir, const TString &cacheName, const TString &fileName,
+                                  const std::vector<Bool_t> &isGood)
+{
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fileName, stat) != 0)
+      return;
+
+   gSystem->mkdir(cacheDir, true);
+   auto tmpName = TString::Format("%s.%d.tmp", cacheName.Data(), gSystem->GetPid());
+   {
+      std::ofstream cache(tmpName.Data());
+      if (!cache) {
+         LOG(debug) << "Could not write the good event index to " << cacheName;
+         return;
+      }
+      cache << stat.fSize << " " << stat.fMtime << " ";
+      for (auto good : isGood)
+         cache << (good ? '1' : '0');
+      cache << "\n";
+      cache.close();
+      if (cache)
+         std::rename(tmpName.Data(), cacheName.Data());
+   }
+   std::remove(tmpName.Data());
+}
@@ -0,0 +1,55 @@
+#ifndef ATGOODEVENTINDEX_H
+#define ATGOODEVENTINDEX_H
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <future>
+#include <vector>
+
+class TChain;
+
+/**
+ * @brief Index of the good events (AtBaseEvent::IsGood()) of a branch of the input tree.
+ *
+ * Used by the viewer to jump directly to the next or previous good event instead of reconstructing every event in
+ * between. The index is built in a background thread from the fIsGood leaf of the branch only, reading the input
+ * files through their own TChain (so the tree used by FairRunAna is never touched), while the viewer is already
+ * usable.
+ *
+ * If a cache directory is set, the index of each input file is cached there along with the size and modification
+ * time of the file, so it is only computed once per input file. If the branch is not in the input tree (it is
+ * created by a task run in the viewer) there is no index and IsAvailable() is false.
+ */
+class AtGoodEventIndex {
+private:
+   TString fBranchName;
+   TString fCacheDir;
+   std::future<std::vector<Bool_t>> fFuture;
+   std::vector<Bool_t> fIsGood;
+   Bool_t fAvailable{false};
+
+public:
+   /// Directory to cache the index of each input file in (empty to not cache it). Before Build().
+   void SetCacheDir(const TString &dir) { fCacheDir = dir; }
+
+   /// Start building the index of branchName for the files of chain, if it is not the current one
+   void Build(TChain *chain, const TString &branchName);
+   /// Is the index of branchName built. Does not wait for the index to finish building.
+   Bool_t IsAvailable(const TString &branchName);
+
+   /// Next good entry after entry, or -1 if there is none
+   Long64_t Next(Long64_t entry) const;
+   /// Previous good entry before entry, or -1 if there is none
+   Long64_t Prev(Long64_t entry) const;
+
+private:
+   static std::vector<Bool_t>
+   BuildIndex(std::vector<TString> files, TString treeName, TString branchName, TString cacheDir);
+   static TString CacheName(const TString &cacheDir, const TString &fileName, const TString &branchName);
+   static Bool_t ReadCache(const TString &cacheName, const TString &fileName, std::vector<Bool_t> &isGood);
+   static void WriteCache(const TString &cacheDir, const TString &cacheName, const TString &fileName,
+                          const std::vector<Bool_t> &isGood);
+};
+
+#endif // ATGOODEVENTINDEX_H
@@ -0,0 +1,160 @@
+#include "AtGoodEventIndex.h"
+
+#include "AtEvent.h"
+
+#include <TChain.h>
+#include <TClonesArray.h>
+#include <TFile.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+class AtGoodEventIndexTest : public ::testing::Test {
+protected:
+   const TString fFileName{"AtGoodEventIndexTest.root"};
+   const TString fBranchName{"AtEventH"};
+   std::filesystem::path fCacheDir{std::filesystem::temp_directory_path() / "AtGoodEventIndexTest"};
+
+   void SetUp() override { std::filesystem::remove_all(fCacheDir); }
+   void TearDown() override
+   {
+      std::filesystem::remove_all(fCacheDir);
+      gSystem->Unlink(fFileName);
+   }
+
+   /// Write a tree with an AtEvent per entry, like the output of a FairRun
+   void WriteFile(const std::vector<bool> &isGood)
+   {
+      TFile file(fFileName, "RECREATE");
+      TTree tree("cbmsim", "cbmsim");
+      TClonesArray events("AtEvent", 1);
+      tree.Branch(fBranchName, &events, 32000, 99);
+      for (bool good : isGood) {
+         events.Clear();
+         auto event = new (events[0]) AtEvent(); // NOLINT
+         event->SetIsGood(good);
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   /// Build the index of the file (reading or writing the cache) and wait for it
+   void Build(AtGoodEventIndex &index, bool useCache = true)
+   {
+      TChain chain("cbmsim");
+      chain.Add(fFileName);
+      if (useCache)
+         index.SetCacheDir(fCacheDir.c_str());
+      index.Build(&chain, fBranchName);
+
+      auto start = std::chrono::steady_clock::now();
+      while (!index.IsAvailable(fBranchName)) {
+         ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10)) << "Index was never built";
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+   }
+
+   /// Good entries of the index, found by stepping through it with Next
+   static std::vector<Long64_t> GoodEntries(const AtGoodEventIndex &index)
+   {
+      std::vector<Long64_t> entries;
+      for (auto entry = index.Next(-1); entry >= 0; entry = index.Next(entry))
+         entries.push_back(entry);
+      return entries;
+   }
+
+   /// Path of the only cache file in the cache directory
+   std::filesystem::path CacheFile()
+   {
+      std::vector<std::filesystem::path> files;
+      for (auto &entry : std::filesystem::directory_iterator(fCacheDir))
+         files.push_back(entry.path());
+      EXPECT_EQ(files.size(), 1u);
+      return files.empty() ? std::filesystem::path() : files[0];
+   }
+
+   /// Replace the index in the cache by every entry being good, keeping its header. Returns the cached mtime.
+   Long_t SpoilCache()
+   {
+      auto cacheFile = CacheFile();
+      Long64_t size = 0;
+      Long_t mtime = 0;
+      std::string flags;
+      std::ifstream(cacheFile) >> size >> mtime >> flags;
+      std::ofstream(cacheFile) << size << " " << mtime << " " << std::string(flags.size(), '1') << "\n";
+      return mtime;
+   }
+};
+} // namespace
+
+TEST_F(AtGoodEventIndexTest, NextAndPrev)
+{
+   WriteFile({false, true, true, false, false, false, true, false});
+   AtGoodEventIndex index;
+   Build(index, false);
+   EXPECT_FALSE(index.IsAvailable("AtRawEvent"));
+
+   EXPECT_EQ(GoodEntries(index), std::vector<Long64_t>({1, 2, 6}));
+   EXPECT_EQ(index.Next(2), 6);
+   EXPECT_EQ(index.Next(3), 6);
+   EXPECT_EQ(index.Next(6), -1);
+   EXPECT_EQ(index.Next(100), -1);
+
+   EXPECT_EQ(index.Prev(0), -1);
+   EXPECT_EQ(index.Prev(1), -1);
+   EXPECT_EQ(index.Prev(2), 1);
+   EXPECT_EQ(index.Prev(6), 2);
+   EXPECT_EQ(index.Prev(7), 6);
+   EXPECT_EQ(index.Prev(100), 6);
+
+   // Nothing was cached
+   EXPECT_FALSE(std::filesystem::exists(fCacheDir));
+}
+
+TEST_F(AtGoodEventIndexTest, CacheIsRebuiltWhenFileChanges)
+{
+   std::vector<bool> isGood = {true, false, false, true, false, true};
+   std::vector<Long64_t> good = {0, 3, 5};
+   WriteFile(isGood);
+   {
+      AtGoodEventIndex index;
+      Build(index);
+      EXPECT_EQ(GoodEntries(index), good);
+   }
+
+   // The index comes from the cache while the file is unchanged
+   auto mtime = SpoilCache();
+   {
+      AtGoodEventIndex index;
+      Build(index);
+      EXPECT_EQ(GoodEntries(index), std::vector<Long64_t>({0, 1, 2, 3, 4, 5}));
+   }
+
+   // The cache is out of date if the modification time changes
+   gSystem->Utime(fFileName, mtime + 100, 0);
+   {
+      AtGoodEventIndex index;
+      Build(index);
+      EXPECT_EQ(GoodEntries(index), good);
+   }
+
+   // or if the size changes, even with the same modification time
+   mtime = SpoilCache();
+   isGood.insert(isGood.end(), {false, false, true});
+   WriteFile(isGood);
+   gSystem->Utime(fFileName, mtime, 0);
+   {
+      AtGoodEventIndex index;
+      Build(index);
+      EXPECT_EQ(GoodEntries(index), std::vector<Long64_t>({0, 3, 5, 8}));
+   }
+}
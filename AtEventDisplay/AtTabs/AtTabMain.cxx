@@ -32,6 +32,7 @@
 #include <TGeoVolume.h>          // for TGeoVolume
 #include <TH1.h>                 // for TH1I
 #include <TH2Poly.h>             // for TH2Poly
+#include <TList.h>               // for TList
 #include <TNamed.h>              // for TNamed
 #include <TObject.h>             // for TObject
 #include <TRootEmbeddedCanvas.h> // for TRootEmbeddedCanvas
@@ -163,9 +164,22 @@ void AtTabMain::DrawPadPlane()
       return;
    }
 
-   AtViewerManager::Instance()->GetMap()->GeneratePadPlane();
-   fPadPlane = AtViewerManager::Instance()->GetMap()->GetPadPlane();
+   auto map = AtViewerManager::Instance()->GetMap();
+   map->GeneratePadPlane();
+   fPadPlane = map->GetPadPlane();
    fPadPlane->SetBit(TH1::kNoTitle);
+
+   // Map each pad to its bin once, so the pad plane can be filled without searching the polygons
+   fPadToBin.assign(map->GetNumPads(), 0);
+   for (int bin = 1; bin <= fPadPlane->GetNumberOfBins(); ++bin) {
+      auto pad = map->BinToPad(bin);
+      if (pad < 0)
+         continue;
+      if (pad >= static_cast<int>(fPadToBin.size()))
+         fPadToBin.resize(pad + 1, 0);
+      fPadToBin[pad] = bin;
+   }
+
    fCvsPadPlane->cd();
    fPadPlane->Draw("COL L0");
    fPadPlane->SetMinimum(1.0);
@@ -259,13 +273,34 @@ void AtTabMain::UpdateEventElements()
    SetPointsFromHits(*fHitSet, hits);
 }
 
+/**
+ * Bin of the pad plane containing (x, y). Checks the bin of the pad first, and only searches every bin if the point
+ * is not in it.
+ */
+Int_t AtTabMain::GetPadPlaneBin(Int_t padNum, Double_t x, Double_t y)
+{
+   if (padNum >= 0 && padNum < static_cast<Int_t>(fPadToBin.size()) && fPadToBin[padNum] > 0) {
+      auto bin = dynamic_cast<TH2PolyBin *>(fPadPlane->GetBins()->At(fPadToBin[padNum] - 1));
+      if (bin != nullptr && bin->IsInside(x, y))
+         return fPadToBin[padNum];
+   }
+   return fPadPlane->FindBin(x, y);
+}
+
 void AtTabMain::UpdatePadPlane()
 {
+   if (fPadPlane == nullptr)
+      return;
 
-   if (fPadPlane)
+   // Only clear the bins filled by the last event
+   if (fResetPadPlane)
       fPadPlane->Reset(nullptr);
    else
-      return;
+      for (auto bin : fFilledBins)
+         fPadPlane->SetBinContent(bin, 0);
+   fFilledBins.clear();
+   fResetPadPlane = false;
+   fPadPlane->SetEntries(0);
 
    LOG(debug) << "Updating pad plane ";
 
@@ -276,13 +311,24 @@ void AtTabMain::UpdatePadPlane()
    }
    auto &hits = fEvent->GetHits();
 
+   Int_t numFilled = 0;
    for (auto &hit : hits) {
-      int padMultiHit = GetFairRootInfo<AtEvent>()->GetHitPadMult(hit->GetPadNum());
+      int padMultiHit = fEvent->GetHitPadMult(hit->GetPadNum());
       if (hit->GetCharge() < fThreshold || padMultiHit > fMaxHitMulti)
          continue;
       auto position = hit->GetPosition();
-      fPadPlane->Fill(position.X(), position.Y(), hit->GetCharge());
+      auto bin = GetPadPlaneBin(hit->GetPadNum(), position.X(), position.Y());
+      numFilled++;
+      if (bin > 0) {
+         fPadPlane->SetBinContent(bin, fPadPlane->GetBinContent(bin) + hit->GetCharge());
+         fFilledBins.push_back(bin);
+      } else {
+         // Outside of every pad, let TH2Poly fill its overflow bins
+         fPadPlane->Fill(position.X(), position.Y(), hit->GetCharge());
+         fResetPadPlane = true;
+      }
    }
+   fPadPlane->SetEntries(numFilled);
 
    fCvsPadPlane->Modified();
    fCvsPadPlane->Update();
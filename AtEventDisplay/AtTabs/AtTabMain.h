@@ -51,6 +51,9 @@ protected:
 
    TCanvas *fCvsPadPlane{nullptr};
    TH2Poly *fPadPlane{nullptr};
+   std::vector<Int_t> fPadToBin;   //! Bin of the pad plane for each pad number (0 if none)
+   std::vector<Int_t> fFilledBins; //! Bins of the pad plane filled by the current event
+   bool fResetPadPlane{false};     //! If some hits were outside every pad, and the plane must be fully reset
 
    TCanvas *fCvsPadWave{nullptr};
    TH1I *fPadWave{nullptr};
@@ -94,6 +97,7 @@ private:
    // Functions to draw the initial canvases
    void DrawPadPlane();
    void DrawPadWave();
+   Int_t GetPadPlaneBin(Int_t padNum, Double_t x, Double_t y);
 
    bool DrawWave(Int_t PadNum);
 
@@ -104,7 +108,7 @@ private:
 
    void ExpandNumPatterns(int num);
 
-   ClassDefOverride(AtTabMain, 1)
+   ClassDefOverride(AtTabMain, 2)
 };
 
 #endif
@@ -39,10 +39,14 @@ AtTabPad::AtTabPad(int nRow, int nCol, TString name) : AtTabCanvas(name, nRow, n
 
    fPadNum = &AtViewerManager::Instance()->GetPadNum();
    fPadNum->Attach(this);
+
+   fEventBranch = &AtViewerManager::Instance()->GetEventBranch();
+   fEventBranch->Attach(this);
 }
 AtTabPad::~AtTabPad()
 {
    fPadNum->Detach(this);
+   fEventBranch->Detach(this);
 }
 
 void AtTabPad::InitTab()
@@ -67,6 +71,8 @@ void AtTabPad::MakeTab(TEveWindowSlot *slot)
 
 void AtTabPad::Exec()
 {
+   fPadHitsValid = false;
+
    auto fRawEvent = GetFairRootInfo<AtRawEvent>();
    if (fRawEvent == nullptr) {
       LOG(debug) << "fRawEvent is nullptr for tab " << fTabId << "! Please set the raw event branch.";
@@ -93,6 +99,13 @@ void AtTabPad::Update(DataHandling::AtSubject *sub)
 {
    if (sub == fPadNum)
       DrawPad();
+
+   // The hits drawn on the pad come from the event branch
+   if (sub == fEventBranch) {
+      fPadHitsValid = false;
+      if (!fDrawHits.empty())
+         DrawPad();
+   }
 }
 
 void AtTabPad::DrawPad()
@@ -184,16 +197,31 @@ void AtTabPad::DrawArrayAug(TH1D *hist, const AtPad &pad, TString augName)
    hist->Draw();
 }
 
+/// Sort the hits of the current event by pad once, instead of looping over the event for every drawn pad
+void AtTabPad::FillPadHits()
+{
+   if (fPadHitsValid)
+      return;
+
+   fPadHits.clear();
+   auto event = GetFairRootInfo<AtEvent>();
+   if (event == nullptr)
+      return;
+   for (auto &hit : event->GetHits())
+      fPadHits[hit->GetPadNum()].push_back(hit.get());
+   fPadHitsValid = true;
+}
+
 void AtTabPad::DrawHit(const AtPad &pad, TF1Vec &vec)
 {
    vec.clear();
 
-   // Loop through all hits and
-   auto event = GetFairRootInfo<AtEvent>();
-   for (auto &hit : event->GetHits()) {
-      if (hit->GetPadNum() != pad.GetPadNum())
-         continue;
+   FillPadHits();
+   auto hits = fPadHits.find(pad.GetPadNum());
+   if (hits == fPadHits.end())
+      return;
 
+   for (auto hit : hits->second) {
       LOG(debug) << "Drawing hit with charge " << hit->GetCharge();
       LOG(debug) << hit->GetPosition().Z() << " " << hit->GetPositionSigma().Z();
       auto func = AtTools::GetHitFunctionTB(*hit);
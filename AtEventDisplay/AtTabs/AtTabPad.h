@@ -3,7 +3,7 @@
 
 #include "AtDataObserver.h"
 #include "AtTabCanvas.h"
-#include "AtViewerManagerSubject.h" // for AtPadNum
+#include "AtViewerManagerSubject.h" // for AtPadNum, AtBranch
 
 #include <Rtypes.h>  // for Int_t, Bool_t, THashConsistencyHolder, Color_t
 #include <TString.h> // for TString
@@ -20,6 +20,7 @@ class TClass;
 class TMemberInspector;
 class TF1;
 class AtPad;
+class AtHit;
 class TH1D;
 
 namespace DataHandling {
@@ -40,8 +41,11 @@ protected:
    std::unordered_map<Int_t, std::pair<PadDrawType, TH1D *>> fDrawMap; //! Let root handle hist memory
    std::unordered_map<Int_t, std::string> fAugNames;                   //< Augment and Aux pad names
    DataHandling::AtPadNum *fPadNum;
+   DataHandling::AtBranch *fEventBranch; //!
 
    std::unordered_map<Int_t, TF1Vec> fDrawHits; //< Draw representation of hits on trace in these TPads
+   std::unordered_map<Int_t, std::vector<const AtHit *>> fPadHits; //! Hits of the current event by pad number
+   bool fPadHitsValid{false};                                        //! If fPadHits matches the event and branch
 
 public:
    AtTabPad(int nRow = 1, int nCol = 1, TString name = "AtPad");
@@ -73,13 +77,14 @@ private:
    void DrawRawAdc(TH1D *hist, const AtPad &pad);
    void DrawArrayAug(TH1D *hist, const AtPad &pad, TString augName);
    void DrawHit(const AtPad &pad, TF1Vec &funcs);
+   void FillPadHits();
    // void DrawHit(TPad *canv, const AtHit &hit);
 
    void UpdateCvsPad();
    std::string GetName(int pos, PadDrawType type);
    // Functions for drawing hits
 
-   ClassDefOverride(AtTabPad, 1)
+   ClassDefOverride(AtTabPad, 2)
 };
 
 #endif
@@ -10,6 +10,8 @@
 #include <FairRunAna.h>      // for FairRunAna
 
 #include <Rtypes.h> // for ClassImp, Long64_t, TGenericClassInfo
+#include <TChain.h>
+#include <TClass.h>
 #include <TClonesArray.h>
 #include <TEveBrowser.h>  // for TEveBrowser
 #include <TEveManager.h>  // for TEveManager, gEve
@@ -114,6 +116,15 @@ void AtViewerManager::Init()
       LOG(fatal) << "Cannot find RootManager!";
    }
 
+   // Read ahead the baskets of the input so stepping through events does not go back to the file each time
+   auto inChain = ioMan->GetInChain();
+   if (inChain != nullptr && fCacheSize > 0) {
+      inChain->SetCacheSize(fCacheSize);
+      inChain->AddBranchToCache("*", true);
+   }
+   if (fCheckGood)
+      fGoodEvents.Build(inChain, fCheckEvt->GetBranch().GetBranchName());
+
    GotoEvent(0);
    std::cout << "End of AtViewerManager" << std::endl;
 }
@@ -123,9 +134,9 @@ void AtViewerManager::GenerateBranchLists()
    LOG(info) << "Generating branch list";
 
    auto ioMan = FairRootManager::Instance();
-   GotoEvent(0);
 
-   // Loop through the entire branch list and map class type to branch name in fBranchNames
+   // Loop through the entire branch list and map class type to branch name in fBranchNames. The type is the one
+   // the TClonesArray was created with (from the tree for input branches), so no event has to be read.
    for (int i = 0; i < ioMan->GetBranchNameList()->GetSize(); i++) {
 
       auto branchName = ioMan->GetBranchName(i);
@@ -133,24 +144,12 @@ void AtViewerManager::GenerateBranchLists()
       if (branchArray == nullptr)
          continue;
 
-      // Loop until there is something in this branch
-      int event = 0;
-      while (branchArray->GetEntries() == 0 && event < 5) {
-         GotoEvent(event++);
-      }
-
-      if (branchArray->GetEntries() == 0) {
+      if (branchArray->GetClass() == nullptr) {
          LOG(error) << "Failed to find type of branch " << branchName << std::endl;
-
          continue;
       }
-      LOG(debug) << "Examining " << branchArray->At(0);
-      LOG(debug) << "With type " << branchArray->At(0)->ClassName();
 
-      if (branchArray->At(0) == nullptr)
-         LOG(error) << "Failed to determine type of " << branchName << "! The TCLonesArray contains a nullptr.";
-
-      auto type = branchArray->At(0)->ClassName();
+      auto type = branchArray->GetClass()->GetName();
       fBranchNames[type].push_back(branchName);
       LOG(info) << "Found " << branchName << " with type " << type << std::endl;
    }
@@ -172,8 +171,30 @@ void AtViewerManager::Update(DataHandling::AtSubject *subject)
    }
 }
 
+/**
+ * Go directly to the next (or previous) good event using the good event index. Returns false if the index is not
+ * available for the check branch.
+ */
+bool AtViewerManager::GotoGoodEvent(bool forward)
+{
+   auto branchName = fCheckEvt->GetBranch().GetBranchName();
+   fGoodEvents.Build(FairRootManager::Instance()->GetInChain(), branchName);
+   if (!fGoodEvents.IsAvailable(branchName))
+      return false;
+
+   auto entry = forward ? fGoodEvents.Next(fEntry.Get()) : fGoodEvents.Prev(fEntry.Get());
+   if (entry < 0)
+      LOG(info) << "No good event " << (forward ? "after " : "before ") << fEntry.Get();
+   else
+      GotoEvent(entry);
+   return true;
+}
+
 void AtViewerManager::NextEvent()
 {
+   if (fCheckGood && GotoGoodEvent(true))
+      return;
+
    while (true) {
       GotoEvent(fEntry.Get() + 1);
       if (fCheckGood == false) {
@@ -185,6 +206,9 @@ void AtViewerManager::NextEvent()
 
 void AtViewerManager::PrevEvent()
 {
+   if (fCheckGood && GotoGoodEvent(false))
+      return;
+
    while (true) {
       GotoEvent(fEntry.Get() - 1);
       if (fCheckGood == false) {
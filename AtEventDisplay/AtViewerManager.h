@@ -2,6 +2,7 @@
 #define ATVIEWERMANAGER_H
 
 #include "AtDataObserver.h"
+#include "AtGoodEventIndex.h"
 #include "AtRawEvent.h"
 #include "AtTabInfo.h"
 #include "AtViewerManagerSubject.h"
@@ -50,6 +51,8 @@ private:
 
    bool fCheckGood{false}; //< Check if the event is good and skip if not when using next and prev
    std::unique_ptr<AtTabInfoFairRoot<AtRawEvent>> fCheckEvt{nullptr};
+   AtGoodEventIndex fGoodEvents;  //! Good entries of the check branch, if it is in the input tree
+   Long64_t fCacheSize{50000000}; //< Size of the TTreeCache reading ahead the input tree (bytes)
 
    static AtViewerManager *fInstance;
 
@@ -79,6 +82,10 @@ public:
       fCheckGood = true;
       fCheckEvt = std::make_unique<AtTabInfoFairRoot<AtRawEvent>>(branch);
    }
+   /// Set the size of the cache reading ahead the baskets of the input tree (0 to disable). Before Init().
+   void SetCacheSize(Long64_t bytes) { fCacheSize = bytes; }
+   /// Set the directory to cache the good event index of each input file in (not cached by default). Before Init().
+   void SetGoodEventCacheDir(const TString &dir) { fGoodEvents.SetCacheDir(dir); }
 
    /**
     * Main function for navigating to an event. Everything that changes event number should end up
@@ -93,8 +100,9 @@ public:
 private:
    void GenerateBranchLists();
    void GotoEventImpl();
+   bool GotoGoodEvent(bool forward);
 
-   ClassDef(AtViewerManager, 1);
+   ClassDef(AtViewerManager, 2);
 };
 
 #endif
@@ -0,0 +1,31 @@
+#include "AtFilterFFT.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtPad.h"
+#include "AtRawEvent.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/// Filter every pad of the fission raw event (in place, as AtFilterTask does on its output event)
+void BM_FilterFFT(benchmark::State &state)
+{
+   auto rawEvent = AtBenchmark::MakeFissionRawEvent();
+   AtFilterFFT filter;
+   filter.SetLowPass(6, 50);
+   filter.Init();
+   filter.InitEvent(&rawEvent);
+
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state)
+      for (auto &pad : rawEvent.GetPads())
+         filter.Filter(pad.get(), nullptr);
+   counter.SetCounters();
+
+   state.counters["pads"] = rawEvent.GetNumPads();
+}
+BENCHMARK(BM_FilterFFT);
+
+} // namespace
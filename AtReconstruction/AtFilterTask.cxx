@@ -4,6 +4,7 @@
 #include "AtBaseEvent.h"
 #include "AtFilter.h"
 #include "AtPadReference.h" // for operator<<
+#include "AtProfiler.h"
 #include "AtRawEvent.h"
 
 #include <FairLogger.h>
@@ -67,6 +68,7 @@ void AtFilterTask::Exec(Option_t *opt)
    if (!rawEvent->IsGood())
       return;
 
+   AtTools::AtProfiler::Scope scope("AtFilter::Filter");
    if (fFilterAux)
       for (auto &padIt : filteredEvent->fAuxPadMap) {
          AtPad *pad = &(padIt.second);
@@ -2,6 +2,7 @@
 
 #include "AtFittedTrack.h"
 #include "AtHitCluster.h"
+#include "AtProfiler.h"
 #include "AtSpacePointMeasurement.h"
 #include "AtTrack.h"
 
@@ -33,6 +34,7 @@
 #include <Exception.h>
 #include <FieldManager.h>
 #include <FitStatus.h>
+#include <KalmanFitStatus.h>
 #include <KalmanFitterRefTrack.h>
 #include <MaterialEffects.h>
 #include <MeasuredStateOnPlane.h>
@@ -46,20 +48,44 @@
 
 using XYZPoint = ROOT::Math::XYZPoint;
 
+namespace {
+/// Mean charge of the clusters in the first 80% of a track, like the energy loss of the fitted tracks
+Double_t MeanStartCharge(const std::vector<AtHitCluster> &clusters, bool forward)
+{
+   // Forward tracks start at the back of the cluster array
+   std::size_t n = 0;
+   Double_t charge = 0;
+   for (; n < clusters.size() && static_cast<Float_t>(n) / clusters.size() <= 0.8; ++n)
+      charge += clusters[forward ? clusters.size() - 1 - n : n].GetCharge();
+   return n > 0 ? charge / n : 0;
+}
+} // namespace
+
+/// Objects GENFIT uses while fitting a single track
+struct AtFITTER::AtGenfit::FitContext {
+   std::unique_ptr<TClonesArray> hitClusterArray{std::make_unique<TClonesArray>("AtHitCluster")};
+   std::unique_ptr<TClonesArray> genfitTrackArray{std::make_unique<TClonesArray>("genfit::Track")};
+   genfit::MeasurementFactory<genfit::AbsMeasurement> measurementFactory; //< Owns the producer of hitClusterArray
+   std::unique_ptr<genfit::AbsKalmanFitter> kalmanFitter{std::make_unique<genfit::KalmanFitterRefTrack>()};
+};
+
+/// Seed of a track from pattern recognition, shared by every hypothesis the track is fitted with
+struct AtFITTER::AtGenfit::TrackSeed {
+   genfit::TrackCand trackCand; //< Measurements (in the hit cluster array of the context) and covariance seed
+   TVector3 posSeed;            //< Initial position (cm)
+   Double_t theta{0};           //< Initial direction
+   Double_t phi{0};
+   Double_t brho{0};      //< Tm
+   Double_t thetaConv{0}; //< Polar angle of the track in the experiment convention
+};
+
 AtFITTER::AtGenfit::AtGenfit(Float_t magfield, Float_t minbrho, Float_t maxbrho, std::string eLossFile,
                              Float_t gasMediumDensity, Int_t pdg, Int_t minit, Int_t maxit, Bool_t noMatEffects)
-   : fEnergyLossFile(std::move(eLossFile)),
-     fMeasurementProducer(
-        new genfit::MeasurementProducer<AtHitCluster, genfit::AtSpacepointMeasurement>(fHitClusterArray)),
-     fMeasurementFactory(new genfit::MeasurementFactory<genfit::AbsMeasurement>()), fMinIterations(minit),
-     fMaxIterations(maxit), fMinBrho(minbrho), fMaxBrho(maxbrho), fMagneticField(10.0 * magfield), fPDGCode(pdg),
-     fGenfitTrackArray(new TClonesArray("genfit::Track")), fHitClusterArray(new TClonesArray("AtHitCluster"))
+   : fEnergyLossFile(std::move(eLossFile)), fMinIterations(minit), fMaxIterations(maxit), fMinBrho(minbrho),
+     fMaxBrho(maxbrho), fMagneticField(10.0 * magfield), fPDGCode(pdg)
 {
-   fKalmanFitter = std::make_shared<genfit::KalmanFitterRefTrack>();
-   fKalmanFitter->setMinIterations(fMinIterations);
-   fKalmanFitter->setMaxIterations(fMaxIterations);
+   fContext = MakeFitContext();
    // fKalmanFitter->setDebugLvl();
-   fMeasurementFactory->addProducer(fTPCDetID, fMeasurementProducer);
 
    genfit::FieldManager::getInstance()->init(new genfit::ConstField(0., 0., fMagneticField)); // NOLINT TODO kGauss
    genfit::MaterialEffects *materialEffects = genfit::MaterialEffects::getInstance();
@@ -127,14 +153,43 @@ AtFITTER::AtGenfit::AtGenfit(Float_t magfield, Float_t minbrho, Float_t maxbrho,
 
 AtFITTER::AtGenfit::~AtGenfit()
 {
-   // delete fKalmanFitter;
-   delete fGenfitTrackArray;
-   delete fHitClusterArray;
-   delete fMeasurementProducer;
-   delete fMeasurementFactory;
    delete fPDGCandidateArray;
 }
 
+std::unique_ptr<AtFITTER::AtGenfit::FitContext> AtFITTER::AtGenfit::MakeFitContext()
+{
+   auto context = std::make_unique<FitContext>();
+   context->measurementFactory.addProducer(
+      fTPCDetID, new genfit::MeasurementProducer<AtHitCluster, genfit::AtSpacepointMeasurement>( // NOLINT
+                    context->hitClusterArray.get()));
+   context->kalmanFitter->setMinIterations(fMinIterations);
+   context->kalmanFitter->setMaxIterations(fMaxIterations);
+   return context;
+}
+
+void AtFITTER::AtGenfit::AddHypothesis(Hypothesis hypothesis)
+{
+   const auto &eLossFile = hypothesis.eLossFile.empty() ? fEnergyLossFile : hypothesis.eLossFile;
+   genfit::MaterialEffects::getInstance()->setEnergyLossFile(eLossFile, hypothesis.pdg);
+   auto trackRep = std::make_unique<genfit::RKTrackRep>(hypothesis.pdg);
+
+   auto it = std::find_if(fHypotheses.begin(), fHypotheses.end(),
+                          [&hypothesis](const Hypothesis &hyp) { return hyp.pdg == hypothesis.pdg; });
+   if (it != fHypotheses.end()) {
+      fHypothesisReps[std::distance(fHypotheses.begin(), it)] = std::move(trackRep);
+      *it = std::move(hypothesis);
+   } else {
+      fHypothesisReps.push_back(std::move(trackRep));
+      fHypotheses.push_back(std::move(hypothesis));
+   }
+}
+
+void AtFITTER::AtGenfit::ClearHypotheses()
+{
+   fHypotheses.clear();
+   fHypothesisReps.clear();
+}
+
 void AtFITTER::AtGenfit::Init()
 {
    LOG(debug) << cGREEN << " AtFITTER::AtGenfit::Init() " << cNORMAL << "\n";
@@ -152,13 +207,13 @@ void AtFITTER::AtGenfit::Init()
    LOG(debug) << " Energy loss file     : " << fEnergyLossFile << "\n";
    LOG(debug) << " --------------------------------------------- " << cNORMAL << "\n";
 
-   fHitClusterArray->Delete();
-   fGenfitTrackArray->Delete();
+   fContext->hitClusterArray->Delete();
+   fContext->genfitTrackArray->Delete();
 }
 
 TClonesArray *AtFITTER::AtGenfit::GetGenfitTrackArray()
 {
-   return fGenfitTrackArray;
+   return fContext->genfitTrackArray.get();
 }
 
 std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(std::vector<AtTrack> &tracks)
@@ -171,25 +226,6 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
    Float_t xiniPRA = -100;
    Float_t yiniPRA = -100;
    Float_t ziniPRA = -1000;
-   Float_t EPRA = 0;
-   Float_t APRA = 0;
-   Float_t PhiPRA = 0;
-   std::string PDG = "2212";
-   Float_t xiniFit = -100;
-   Float_t yiniFit = -100;
-   Float_t ziniFit = -1000;
-   Float_t xiniFitXtr = -100;
-   Float_t yiniFitXtr = -100;
-   Float_t ziniFitXtr = -1000;
-   Float_t pVal = 0;
-   Float_t trackLength = -1000.0;
-   Float_t POCAXtr = -1000.0;
-   Int_t particleQ = -10;
-   Float_t EFit = 0;
-   Float_t EFitXtr = 0;
-   Float_t AFit = 0;
-   Float_t PhiFit = 0;
-   Float_t distXtr = -1000.0;
    //////////////////////////////
 
    // TODO
@@ -204,7 +240,8 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
    auto sp = std::unique_ptr<AtTrack[]>(new AtTrack[tracks.size()]);
 
    for (auto iTrack = 0; iTrack < tracks.size(); ++iTrack) {
-      AtTrack track = tracks.at(iTrack);
+      // Only the candidates kept for merging are copied
+      AtTrack &track = tracks.at(iTrack);
 
       std::cout << cYELLOW << " Track " << track.GetTrackID() << " with " << track.GetHitClusterArray()->size()
                 << " clusters and " << track.GetHitArray().size() << " hits. " << cNORMAL << "\n";
@@ -234,9 +271,9 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
          thetaConv = theta * TMath::RadToDeg();
 
       auto hitClusterArray = track.GetHitClusterArray();
-      AtHitCluster iniCluster;
-      AtHitCluster secCluster;
-      AtHitCluster endCluster;
+      const AtHitCluster *iniCluster = nullptr;
+      const AtHitCluster *secCluster = nullptr;
+      const AtHitCluster *endCluster = nullptr;
       Double_t zIniCal = 0;
       Double_t zEndCal = 0;
       ROOT::Math::XYZPoint iniPos;
@@ -244,22 +281,22 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
       ROOT::Math::XYZPoint endPos;
 
       if (thetaConv < 90.0) { // Forward tracks
-         iniCluster =
-            hitClusterArray->back(); // NB: Use back because We do not reverse the cluster vector like in AtGenfit!
-         secCluster = hitClusterArray->at(hitClusterArray->size() - 2);
-         iniPos = iniCluster.GetPosition();
-         secPos = secCluster.GetPosition();
-         endCluster = hitClusterArray->front();
-         endPos = endCluster.GetPosition();
+         // NB: Use back because We do not reverse the cluster vector like in AtGenfit!
+         iniCluster = &hitClusterArray->back();
+         secCluster = &hitClusterArray->at(hitClusterArray->size() - 2);
+         iniPos = iniCluster->GetPosition();
+         secPos = secCluster->GetPosition();
+         endCluster = &hitClusterArray->front();
+         endPos = endCluster->GetPosition();
          zIniCal = 1000.0 - iniPos.Z();
          zEndCal = 1000.0 - endPos.Z();
       } else if (thetaConv > 90.0) { // Backward tracks
-         iniCluster = hitClusterArray->front();
-         secCluster = hitClusterArray->at(1);
-         iniPos = iniCluster.GetPosition();
-         secPos = secCluster.GetPosition();
-         endCluster = hitClusterArray->back();
-         endPos = endCluster.GetPosition();
+         iniCluster = &hitClusterArray->front();
+         secCluster = &hitClusterArray->at(1);
+         iniPos = iniCluster->GetPosition();
+         secPos = secCluster->GetPosition();
+         endCluster = &hitClusterArray->back();
+         endPos = endCluster->GetPosition();
          zIniCal = iniPos.Z();
          zEndCal = endPos.Z();
       }
@@ -271,39 +308,42 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
       // NB: Mind the x sign. Currently set for backward tracks
       // std::cout<<"   Old phi from PRA : "<<track.GetGeoPhi()*TMath::RadToDeg()<<"\n";
       Double_t phiClus = 0;
+      Double_t geoPhi = track.GetGeoPhi();
 
       if (thetaConv > 90) {
          phiClus = TMath::ATan2(secPos.Y() - iniPos.Y(), -secPos.X() + iniPos.X());
          if (fSimulationConv)
             phiClus = TMath::ATan2(secPos.Y() - iniPos.Y(), secPos.X() - iniPos.X());
-         track.SetGeoPhi(-phiClus);
+         geoPhi = -phiClus;
       } else if (thetaConv < 90) {
          phiClus = TMath::ATan2(secPos.Y() - iniPos.Y(), -secPos.X() + iniPos.X());
          if (fSimulationConv)
             phiClus = TMath::ATan2(secPos.Y() - iniPos.Y(), secPos.X() - iniPos.X());
-         track.SetGeoPhi(phiClus);
+         geoPhi = phiClus;
       }
 
-      // This is just to select distances
+      // This is just to select distances (there are no clusters for a track at 90 deg)
+      auto timeStamp = [](const AtHitCluster *cluster) { return cluster ? cluster->GetTimeStamp() : -1; };
       LOG(debug) << cBLUE << "   Track ID " << track.GetTrackID() << "\n";
       LOG(debug) << "   Initial position : " << xiniPRA << " - " << yiniPRA << " - " << ziniPRA << " "
-                 << iniCluster.GetTimeStamp() << "\n";
+                 << timeStamp(iniCluster) << "\n";
       LOG(debug) << "   Second position : " << secPos.X() << " - " << secPos.Y() << " - " << secPos.Z() << " "
-                 << secCluster.GetTimeStamp() << "\n";
+                 << timeStamp(secCluster) << "\n";
       LOG(debug) << "   End position : " << endPos.X() << " - " << endPos.Y() << " - " << zEndCal << " "
-                 << endCluster.GetTimeStamp() << "\n";
+                 << timeStamp(endCluster) << "\n";
       LOG(debug) << "   Theta (PRA) " << track.GetGeoTheta() * TMath::RadToDeg()
                  << "   Theta (convention) : " << thetaConv << " - Phi Clus : " << phiClus * TMath::RadToDeg() << "\n";
       LOG(debug) << "   Track center - X :  " << center.first << " - Y : " << center.second << "\n";
-      LOG(debug) << "   Track phi recalc : " << track.GetGeoPhi() * TMath::RadToDeg() << cNORMAL << "\n";
+      LOG(debug) << "   Track phi recalc : " << geoPhi * TMath::RadToDeg() << cNORMAL << "\n";
 
       // Skip tracks that are far from Z (to be checked against number of iterations for extrapolation)
       Double_t dist = TMath::Sqrt(iniPos.X() * iniPos.X() + iniPos.Y() * iniPos.Y());
       LOG(debug) << KRED << "    Distance to Z " << dist << cNORMAL << "\n";
       LOG(debug) << KGRN << "    ---- Adding track candidate " << cNORMAL << "\n";
-      track.SetVertexToZDist(dist);
       if (fEnableMerging) {
          sp[iTrack] = track;
+         sp[iTrack].SetGeoPhi(geoPhi);
+         sp[iTrack].SetVertexToZDist(dist);
          candTrackPool.push_back(std::move(&sp[iTrack]));
 
       } else {
@@ -344,8 +384,8 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
       }
 
    } else {
-      for (auto track : candTrackPool)
-         mergedTrackPool.push_back(*track);
+      for (auto *track : candTrackPool)
+         mergedTrackPool.push_back(std::move(*track));
    }
 
    std::cout << "\n";
@@ -357,68 +397,53 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
    eventMultiplicity = mergedTrackPool.size();
 
    // Fitting track candidates
-   for (auto track : mergedTrackPool) {
-
-      if (fEnableReclustering) {
-         track.ResetHitClusterArray();
-         fTrackTransformer->ClusterizeSmooth3D(track, fClusterRadius,
-                                               fClusterSize); // NB: Just for analysis benchmarking
-      }
-
-      Double_t theta = track.GetGeoTheta();
-      Double_t radius = track.GetGeoRadius() / 1000.0; // mm to m
-      Double_t phi = track.GetGeoPhi();
-      Double_t brho = (fMagneticField / 10.0) * radius / TMath::Sin(theta); // Tm
-      Double_t points = track.GetHitArray().size();
-
-      std::cout << "      Merged track - Theta : " << theta * TMath::RadToDeg() << " Phi : " << phi * TMath::RadToDeg()
-                << "\n";
+   Init();
+   for (auto &track : mergedTrackPool)
+      for (auto &fittedTrack : FitMergedTrack(track, trackID, *fContext))
+         fittedTracks.push_back(std::move(fittedTrack));
 
-      auto hitClusterArray = track.GetHitClusterArray();
-      AtHitCluster iniCluster;
-      Double_t zIniCal = 0;
-      ROOT::Math::XYZPoint iniPos;
+   // std::cout<<" Fitted tracks "<<fittedTracks.size()<<"\n";
+   return std::move(fittedTracks);
+}
 
-      // for(auto hitCluster : *hitClusterArray)
-      // std::cout<<" Cluster hit "<<hitCluster.GetHitID()<<" - "<<hitCluster.GetPosition().X()<<" -
-      // "<<hitCluster.GetPosition().Y()<<" - "<<1000.0-hitCluster.GetPosition().Z()<<"\n";
+/**
+ * Fit a single merged track candidate using the GENFIT objects of context and extract the fit results. If
+ * hypotheses are set the track is fitted with each of them, otherwise with the particle of the experiment.
+ * Returns the tracks that could be fitted.
+ */
+std::vector<std::unique_ptr<AtFittedTrack>>
+AtFITTER::AtGenfit::FitMergedTrack(AtTrack &track, Int_t trackID, FitContext &context)
+{
+   std::vector<std::unique_ptr<AtFittedTrack>> fittedTracks;
 
-      // Variable for convention (simulation comes reversed)
-      Double_t thetaConv;
-      if (fSimulationConv) {
-         thetaConv = 180.0 - theta * TMath::RadToDeg();
-      } else {
-         thetaConv = theta * TMath::RadToDeg();
-      }
+   if (fEnableReclustering) {
+      track.ResetHitClusterArray();
+      fTrackTransformer->ClusterizeSmooth3D(track, fClusterRadius,
+                                            fClusterSize); // NB: Just for analysis benchmarking
+   }
 
-      if (thetaConv < 90.0) {
-         iniCluster =
-            hitClusterArray->back(); // NB: Use back because We do not reverse the cluster vector like in AtGenfit!
-         iniPos = iniCluster.GetPosition();
-         zIniCal = 1000.0 - iniPos.Z();
-      } else if (thetaConv > 90.0) {
-         iniCluster = hitClusterArray->front();
-         iniPos = iniCluster.GetPosition();
-         zIniCal = iniPos.Z();
+   try {
+      if (!fHypotheses.empty()) {
+         for (auto &fit : FitHypotheses(track, {}, context)) {
+            if (fit.track == nullptr)
+               continue;
+            auto hypothesis = std::find_if(fHypotheses.begin(), fHypotheses.end(),
+                                           [&fit](const Hypothesis &hyp) { return hyp.pdg == fit.pdg; });
+            auto fittedTrack = ExtractFittedTrack(track, trackID, fit.track, fit.rep, fit.pdg, hypothesis->mass,
+                                                  hypothesis->atomicNumber);
+            if (fittedTrack)
+               fittedTracks.push_back(std::move(fittedTrack));
+         }
+         return fittedTracks;
       }
 
-      xiniPRA = iniPos.X();
-      yiniPRA = iniPos.Y();
-      ziniPRA = zIniCal;
-
-      // This is just to select distances
-      // std::cout << cGREEN << "      Merged track - Initial position : " << xiniPRA << " - " << yiniPRA << " - "
-      //         << ziniPRA << cNORMAL << "\n";
-
-      // Skip border angles
-      //    if (theta * TMath::RadToDeg() < 5 || theta * TMath::RadToDeg() > 175)
-      // continue;
-      // Skip tracks that are far from Z (to be checked against number of iterations for extrapolation)
-      Double_t dist = TMath::Sqrt(iniPos.X() * iniPos.X() + iniPos.Y() * iniPos.Y());
-
-      std::cout << KRED << "       Merged track - Distance to Z (Candidate Track Pool) " << dist << cNORMAL << "\n";
+      // Variable for convention (simulation comes reversed)
+      Double_t thetaConv = track.GetGeoTheta() * TMath::RadToDeg();
+      if (fSimulationConv)
+         thetaConv = 180.0 - thetaConv;
 
-      Init();
+      context.hitClusterArray->Delete();
+      context.genfitTrackArray->Delete();
 
       std::vector<Int_t> pdgCandFit;
       if (thetaConv > 90) {
@@ -454,266 +479,342 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
          }
       }
 
-      try {
+      genfit::Track *fitTrack = FitTracks(&track, context);
+      if (fitTrack == nullptr)
+         return fittedTracks;
 
-         genfit::Track *fitTrack = FitTracks(&track);
-
-         Int_t atomicNumber = fAtomicNumber;
-         Double_t mass = fMass;
-         Double_t M_Ener = mass * 931.49401 / 1000.0;
-
-         // PDG needs to be defined
-         Int_t pdg = pdgCandFit.at(0);
-
-         /*auto fIl =
-            std::find_if(ionList->begin(), ionList->end(), [&pdg](AtTools::IonFitInfo ion) { return ion._PDG == pdg; });
-         if (fIl != ionList->end()) {
-
-            int index = std::distance(ionList->begin(), fIl);
-            std::cout << cBLUE << "  -  Ion info for : " << pdg << " found in " << index << cNORMAL << "\n";
-            atomicNumber = ionList->at(index)._atomicNumber;
-            mass = ionList->at(index)._mass;
-            M_Ener = mass * 931.49401 / 1000.0;
-         }*/
-
-         // Kinematics from PRA
-
-         std::tuple<Double_t, Double_t> mom_ener = fKinematics->GetMomFromBrho(mass, atomicNumber, brho);
-         EPRA = std::get<1>(mom_ener) * 1000.0;
-         APRA = theta * TMath::RadToDeg();
-         PhiPRA = phi * TMath::RadToDeg();
-
-         // Extract info from Fit track
-
-         PDG = std::to_string(pdg);
-
-         TVector3 pos_res;
-         TVector3 mom_res;
-         TMatrixDSym cov_res;
-
-         Double_t bChi2 = 0, fChi2 = 0, bNdf = 0, fNdf = 0;
-         Double_t distance = -100;
-         Double_t POCA = 1E6;
-         TVector3 mom_ext;
-         TVector3 pos_ext;
-         TVector3 mom_ext_buff;
-         TVector3 pos_ext_buff;
-         Int_t nSteps = 0;
-
-         // First orbit
-         Double_t POCAOrbZ = 1E6;
-         Double_t firstOrbZ = 0.0;
-         Double_t phiOrbZ = 0.0;
-         Double_t lengthOrbZ = 0.0;
-         Double_t eLossOrbZ = 0.0;
-
-         // Fit convergence
-         Int_t fitConverged = 0;
-
-         // Reset variables assigned in fitting
-         pVal = -1;
-         trackLength = 0;
-         xiniFitXtr = -1000.0;
-         yiniFitXtr = -1000.0;
-         ziniFitXtr = -1E4;
-         xiniFit = -1000.0;
-         yiniFit = -1000.0;
-         ziniFit = -1E4;
-         POCAXtr = -1000.0;
-         EFit = -10.0;
-         EFitXtr = -10.0;
-         AFit = 0.0;
-         PhiFit = 0.0;
-         particleQ = -10.0;
-
-         // PID
-         Double_t len = 0;
-         Double_t eloss = 0;
-         Double_t dedx = 0;
-
-         // Energy loss from ADC
-         auto hitClusterArray = track.GetHitClusterArray();
-         std::size_t cnt = 0;
-
-         if (thetaConv < 90) {
-
-            auto it = hitClusterArray->rbegin();
-            while (it != hitClusterArray->rend()) {
-
-               if (((Float_t)cnt / (Float_t)hitClusterArray->size()) > 0.8)
-                  break;
-               auto dir = (*it).GetPosition() - (*std::next(it, 1)).GetPosition();
-               eloss += (*it).GetCharge();
-               len = std::sqrt(dir.Mag2());
-               dedx += (*it).GetCharge();
-               // std::cout<<(*it).GetCharge()<<"\n";
-               it++;
-               ++cnt;
-            }
-         } else if (thetaConv > 90) {
+      // PDG needs to be defined
+      auto fittedTrack = ExtractFittedTrack(track, trackID, fitTrack, fitTrack->getTrackRep(0), pdgCandFit.at(0),
+                                            fMass, fAtomicNumber);
+      if (fittedTrack)
+         fittedTracks.push_back(std::move(fittedTrack));
 
-            eloss += hitClusterArray->at(0).GetCharge();
+   } catch (std::exception &e) {
+      std::cout << " Exception fitting track !" << e.what() << "\n";
+   }
 
-            cnt = 1;
-            for (auto iHitClus = 1; iHitClus < hitClusterArray->size(); ++iHitClus) {
+   return fittedTracks;
+}
 
-               if (((Float_t)cnt / (Float_t)hitClusterArray->size()) > 0.8)
-                  break;
-               auto dir = hitClusterArray->at(iHitClus).GetPosition() - hitClusterArray->at(iHitClus - 1).GetPosition();
-               len = std::sqrt(dir.Mag2());
-               eloss += hitClusterArray->at(iHitClus).GetCharge();
-               dedx += hitClusterArray->at(iHitClus).GetCharge();
-               // std::cout<<len<<" - "<<eloss<<" - "<<hitClusterArray->at(iHitClus).GetCharge()<<"\n";
-               ++cnt;
-            }
+/**
+ * Extract the results of the fit of track with trackRep, the representation of the particle pdg of mass (amu) and
+ * atomic number. Returns nullptr if the results could not be extracted.
+ */
+std::unique_ptr<AtFittedTrack>
+AtFITTER::AtGenfit::ExtractFittedTrack(AtTrack &track, Int_t trackID, genfit::Track *fitTrack,
+                                       genfit::AbsTrackRep *trackRep, Int_t pdg, Double_t mass, Int_t atomicNumber)
+{
+   Float_t xiniPRA = -100;
+   Float_t yiniPRA = -100;
+   Float_t ziniPRA = -1000;
+   Float_t EPRA = 0;
+   Float_t APRA = 0;
+   Float_t PhiPRA = 0;
+   std::string PDG = "2212";
+   Float_t xiniFit = -100;
+   Float_t yiniFit = -100;
+   Float_t ziniFit = -1000;
+   Float_t xiniFitXtr = -100;
+   Float_t yiniFitXtr = -100;
+   Float_t ziniFitXtr = -1000;
+   Float_t pVal = 0;
+   Float_t trackLength = -1000.0;
+   Float_t POCAXtr = -1000.0;
+   Int_t particleQ = -10;
+   Float_t EFit = 0;
+   Float_t EFitXtr = 0;
+   Float_t AFit = 0;
+   Float_t PhiFit = 0;
+   Float_t distXtr = -1000.0;
+
+   Double_t theta = track.GetGeoTheta();
+   Double_t radius = track.GetGeoRadius() / 1000.0; // mm to m
+   Double_t phi = track.GetGeoPhi();
+   Double_t brho = (fMagneticField / 10.0) * radius / TMath::Sin(theta); // Tm
+   Double_t points = track.GetHitArray().size();
+
+   std::cout << "      Merged track - Theta : " << theta * TMath::RadToDeg() << " Phi : " << phi * TMath::RadToDeg()
+             << "\n";
+
+   auto hitClusterArray = track.GetHitClusterArray();
+   Double_t zIniCal = 0;
+   ROOT::Math::XYZPoint iniPos;
+
+   // for(auto hitCluster : *hitClusterArray)
+   // std::cout<<" Cluster hit "<<hitCluster.GetHitID()<<" - "<<hitCluster.GetPosition().X()<<" -
+   // "<<hitCluster.GetPosition().Y()<<" - "<<1000.0-hitCluster.GetPosition().Z()<<"\n";
+
+   // Variable for convention (simulation comes reversed)
+   Double_t thetaConv;
+   if (fSimulationConv) {
+      thetaConv = 180.0 - theta * TMath::RadToDeg();
+   } else {
+      thetaConv = theta * TMath::RadToDeg();
+   }
+
+   if (thetaConv < 90.0) {
+      // NB: Use back because We do not reverse the cluster vector like in AtGenfit!
+      iniPos = hitClusterArray->back().GetPosition();
+      zIniCal = 1000.0 - iniPos.Z();
+   } else if (thetaConv > 90.0) {
+      iniPos = hitClusterArray->front().GetPosition();
+      zIniCal = iniPos.Z();
+   }
+
+   xiniPRA = iniPos.X();
+   yiniPRA = iniPos.Y();
+   ziniPRA = zIniCal;
+
+   // This is just to select distances
+   // std::cout << cGREEN << "      Merged track - Initial position : " << xiniPRA << " - " << yiniPRA << " - "
+   //         << ziniPRA << cNORMAL << "\n";
+
+   // Skip border angles
+   //    if (theta * TMath::RadToDeg() < 5 || theta * TMath::RadToDeg() > 175)
+   // continue;
+   // Skip tracks that are far from Z (to be checked against number of iterations for extrapolation)
+   Double_t dist = TMath::Sqrt(iniPos.X() * iniPos.X() + iniPos.Y() * iniPos.Y());
+
+   std::cout << KRED << "       Merged track - Distance to Z (Candidate Track Pool) " << dist << cNORMAL << "\n";
+
+   try {
+
+      Double_t M_Ener = mass * 931.49401 / 1000.0;
+
+      // Kinematics from PRA
+
+      std::tuple<Double_t, Double_t> mom_ener = fKinematics->GetMomFromBrho(mass, atomicNumber, brho);
+      EPRA = std::get<1>(mom_ener) * 1000.0;
+      APRA = theta * TMath::RadToDeg();
+      PhiPRA = phi * TMath::RadToDeg();
+
+      // Extract info from Fit track
+
+      PDG = std::to_string(pdg);
+
+      TVector3 pos_res;
+      TVector3 mom_res;
+      TMatrixDSym cov_res;
+
+      Double_t bChi2 = 0, fChi2 = 0, bNdf = 0, fNdf = 0;
+      Double_t distance = -100;
+      Double_t POCA = 1E6;
+      TVector3 mom_ext;
+      TVector3 pos_ext;
+      TVector3 mom_ext_buff;
+      TVector3 pos_ext_buff;
+      Int_t nSteps = 0;
+
+      // First orbit
+      Double_t POCAOrbZ = 1E6;
+      Double_t firstOrbZ = 0.0;
+      Double_t phiOrbZ = 0.0;
+      Double_t lengthOrbZ = 0.0;
+      Double_t eLossOrbZ = 0.0;
+
+      // Fit convergence
+      Int_t fitConverged = 0;
+
+      // Reset variables assigned in fitting
+      pVal = -1;
+      trackLength = 0;
+      xiniFitXtr = -1000.0;
+      yiniFitXtr = -1000.0;
+      ziniFitXtr = -1E4;
+      xiniFit = -1000.0;
+      yiniFit = -1000.0;
+      ziniFit = -1E4;
+      POCAXtr = -1000.0;
+      EFit = -10.0;
+      EFitXtr = -10.0;
+      AFit = 0.0;
+      PhiFit = 0.0;
+      particleQ = -10.0;
+
+      // PID
+      Double_t len = 0;
+      Double_t eloss = 0;
+      Double_t dedx = 0;
+
+      // Energy loss from ADC
+      auto hitClusterArray = track.GetHitClusterArray();
+      std::size_t cnt = 0;
+
+      if (thetaConv < 90) {
+
+         auto it = hitClusterArray->rbegin();
+         while (it != hitClusterArray->rend()) {
+
+            if (((Float_t)cnt / (Float_t)hitClusterArray->size()) > 0.8)
+               break;
+            auto dir = (*it).GetPosition() - (*std::next(it, 1)).GetPosition();
+            eloss += (*it).GetCharge();
+            len = std::sqrt(dir.Mag2());
+            dedx += (*it).GetCharge();
+            // std::cout<<(*it).GetCharge()<<"\n";
+            it++;
+            ++cnt;
          }
+      } else if (thetaConv > 90) {
+
+         eloss += hitClusterArray->at(0).GetCharge();
 
-         eloss /= cnt;
-         // dedx /= len;
-
-         if (fitTrack == nullptr)
-            continue;
-
-         try {
-
-            if (fitTrack && fitTrack->hasKalmanFitStatus()) {
-
-               auto KalmanFitStatus = fitTrack->getKalmanFitStatus();
-               auto trackRep = fitTrack->getTrackRep(0); // Only one representation is sved for the moment.
-               fitConverged = KalmanFitStatus->isFitConverged(false);
-
-               if (KalmanFitStatus->isFitConverged(false)) {
-                  // KalmanFitStatus->Print();
-                  genfit::MeasuredStateOnPlane fitState = fitTrack->getFittedState();
-                  particleQ = fitState.getCharge();
-
-                  fChi2 = KalmanFitStatus->getForwardChi2();
-                  bChi2 = KalmanFitStatus->getBackwardChi2();
-                  fNdf = KalmanFitStatus->getForwardNdf();
-                  bNdf = KalmanFitStatus->getBackwardNdf();
-                  // fitState.Print();
-                  fitState.getPosMomCov(pos_res, mom_res, cov_res);
-                  trackLength = KalmanFitStatus->getTrackLen();
-                  pVal = KalmanFitStatus->getPVal();
-
-                  // fKalmanFitter -> getChiSquNdf(gfTrack, trackRep, bChi2, fChi2, bNdf, fNdf);
-                  Float_t stepXtr = -0.01;
-                  Int_t minCnt = 0;
-                  Int_t minCntExt = 0;
-
-                  TVector3 pos_ini_buff = pos_res;
-                  Double_t length = 0.0;
-                  mom_ext = fitState.getMom();
-                  pos_ext = fitState.getPos();
-
-                  // Backward extrapolation
-                  try {
-
-                     for (auto iStep = 0; iStep < 200; ++iStep) {
-
-                        trackRep->extrapolateBy(fitState, stepXtr * iStep);
-                        mom_ext_buff = fitState.getMom();
-                        pos_ext_buff = fitState.getPos();
-
-                        length += (pos_ext_buff - pos_ini_buff).Mag();
-                        pos_ini_buff = pos_ext_buff;
-
-                        double distPOCA =
-                           TMath::Sqrt(pos_ext_buff.X() * pos_ext_buff.X() + pos_ext_buff.Y() * pos_ext_buff.Y());
-                        // if (fVerbosityLevel > 2){
-                        // std::cout << cYELLOW << " Extrapolation: Total Momentum : " << mom_ext_buff.Mag()
-                        //        << " - Position : " << pos_ext_buff.X() << "  " << pos_ext_buff.Y() << "  "
-                        //      << pos_ext_buff.Z() << " - distance of approach : " << distance <<" - length :
-                        //  "<<length<< cNORMAL << "\n";
-                        //}
-
-                        // if(pos_ext_buff.Z()<0)
-                        // break;
-
-                        if (distPOCA < POCA) {
-                           POCA = distPOCA;
-                           POCAXtr = distPOCA;
-                           mom_ext = mom_ext_buff;
-                           pos_ext = pos_ext_buff;
-                           distXtr = iStep * stepXtr;
-                           ++minCnt;
-                           minCntExt = 0;
-                           nSteps = iStep;
-                        } else {
-
-                           break;
-                        }
-
-                        ++minCntExt;
-                     } // Extrapolation loop
-
-                  } catch (genfit::Exception &e) {
-                     mom_ext.SetXYZ(0, 0, 0);
-                     pos_ext.SetXYZ(0, 0, 0);
-                  } // try
-
-                  // mom_res = mom_ext;
-                  // pos_res = pos_ext;
-                  xiniFitXtr = pos_ext.X();
-                  yiniFitXtr = pos_ext.Y();
-                  ziniFitXtr = pos_ext.Z();
-
-                  // std::cout << cYELLOW << " Extrapolation: Total Momentum : " << mom_ext.Mag()
-                  // << " - Position : " << pos_ext.X() << "  " << pos_ext.Y() << "  " << pos_ext.Z()
-                  // << " - POCA : " << POCA << " - Steps : " << nSteps << cNORMAL << "\n";
-
-                  Double_t thetaA = 0.0;
-                  if (thetaConv > 90.0) {
-                     thetaA = 180.0 * TMath::DegToRad() - mom_res.Theta();
-
-                  } else {
-                     thetaA = mom_res.Theta();
-                  }
-
-                  Double_t E = TMath::Sqrt(TMath::Power(mom_res.Mag(), 2) + TMath::Power(M_Ener, 2)) - M_Ener;
-                  EFit = E * 1000.0;
-                  EFitXtr = 1000.0 * (TMath::Sqrt(TMath::Power(mom_ext.Mag(), 2) + TMath::Power(M_Ener, 2)) - M_Ener);
-                  std::cout << " Energy : " << E * 1000.0 << " - Energy Xtr : " << EFitXtr << "\n";
-                  AFit = thetaA * TMath::RadToDeg();
-                  PhiFit = mom_res.Phi();
-                  xiniFit = pos_res.X();
-                  yiniFit = pos_res.Y();
-                  ziniFit = pos_res.Z();
-
-               } // Kalman fit
-
-            } // Kalman status
-
-         } catch (std::exception &e) {
-            std::cout << " " << e.what() << "\n";
-            continue;
+         cnt = 1;
+         for (auto iHitClus = 1; iHitClus < hitClusterArray->size(); ++iHitClus) {
+
+            if (((Float_t)cnt / (Float_t)hitClusterArray->size()) > 0.8)
+               break;
+            auto dir = hitClusterArray->at(iHitClus).GetPosition() - hitClusterArray->at(iHitClus - 1).GetPosition();
+            len = std::sqrt(dir.Mag2());
+            eloss += hitClusterArray->at(iHitClus).GetCharge();
+            dedx += hitClusterArray->at(iHitClus).GetCharge();
+            // std::cout<<len<<" - "<<eloss<<" - "<<hitClusterArray->at(iHitClus).GetCharge()<<"\n";
+            ++cnt;
          }
+      }
 
-         ROOT::Math::XYZVector iniFitVec(xiniFit, yiniFit, ziniFit);
-         ROOT::Math::XYZVector iniFitXtrVec(xiniPRA, yiniPRA, ziniPRA);
-         ROOT::Math::XYZVector iniPRAVec(xiniPRA, yiniPRA, ziniPRA);
-
-         // NB: Here need the data block
-         std::unique_ptr<AtFittedTrack> fittedTrack = std::make_unique<AtFittedTrack>();
-         fittedTrack->SetTrackID(trackID);
-         fittedTrack->SetEnergyAngles(EFit, EFitXtr, AFit, PhiFit, EPRA, APRA, PhiPRA);
-         fittedTrack->SetVertexPosition(iniFitVec, iniPRAVec, iniFitXtrVec);
-         fittedTrack->SetStats(pVal, fChi2, bChi2, fNdf, bNdf, fitConverged);
-         fittedTrack->SetTrackProperties(particleQ, brho, eloss, dedx, std::to_string(pdg), points);
-         // fittedTrack->SetIonChamber(Float_t icenergy, Int_t ictime);
-         // fittedTrack->SetExcitationEnergy(Float_t exenergy, Float_t exenergyxtr);
-         fittedTrack->SetDistances(distXtr, trackLength, POCA);
-         fittedTracks.push_back(std::move(fittedTrack));
+      eloss /= cnt;
+      // dedx /= len;
+
+      if (fitTrack == nullptr)
+         return nullptr;
+
+      try {
+
+         if (fitTrack && fitTrack->hasKalmanFitStatus(trackRep)) {
+
+            auto KalmanFitStatus = fitTrack->getKalmanFitStatus(trackRep);
+            fitConverged = KalmanFitStatus->isFitConverged(false);
+
+            if (KalmanFitStatus->isFitConverged(false)) {
+               // KalmanFitStatus->Print();
+               genfit::MeasuredStateOnPlane fitState = fitTrack->getFittedState(0, trackRep);
+               particleQ = fitState.getCharge();
+
+               fChi2 = KalmanFitStatus->getForwardChi2();
+               bChi2 = KalmanFitStatus->getBackwardChi2();
+               fNdf = KalmanFitStatus->getForwardNdf();
+               bNdf = KalmanFitStatus->getBackwardNdf();
+               // fitState.Print();
+               fitState.getPosMomCov(pos_res, mom_res, cov_res);
+               trackLength = KalmanFitStatus->getTrackLen();
+               pVal = KalmanFitStatus->getPVal();
+
+               // fKalmanFitter -> getChiSquNdf(gfTrack, trackRep, bChi2, fChi2, bNdf, fNdf);
+               Float_t stepXtr = -0.01;
+               Int_t minCnt = 0;
+               Int_t minCntExt = 0;
+
+               TVector3 pos_ini_buff = pos_res;
+               Double_t length = 0.0;
+               mom_ext = fitState.getMom();
+               pos_ext = fitState.getPos();
+
+               // Backward extrapolation
+               try {
+
+                  for (auto iStep = 0; iStep < 200; ++iStep) {
+
+                     trackRep->extrapolateBy(fitState, stepXtr * iStep);
+                     mom_ext_buff = fitState.getMom();
+                     pos_ext_buff = fitState.getPos();
+
+                     length += (pos_ext_buff - pos_ini_buff).Mag();
+                     pos_ini_buff = pos_ext_buff;
+
+                     double distPOCA =
+                        TMath::Sqrt(pos_ext_buff.X() * pos_ext_buff.X() + pos_ext_buff.Y() * pos_ext_buff.Y());
+                     // if (fVerbosityLevel > 2){
+                     // std::cout << cYELLOW << " Extrapolation: Total Momentum : " << mom_ext_buff.Mag()
+                     //        << " - Position : " << pos_ext_buff.X() << "  " << pos_ext_buff.Y() << "  "
+                     //      << pos_ext_buff.Z() << " - distance of approach : " << distance <<" - length :
+                     //  "<<length<< cNORMAL << "\n";
+                     //}
+
+                     // if(pos_ext_buff.Z()<0)
+                     // break;
+
+                     if (distPOCA < POCA) {
+                        POCA = distPOCA;
+                        POCAXtr = distPOCA;
+                        mom_ext = mom_ext_buff;
+                        pos_ext = pos_ext_buff;
+                        distXtr = iStep * stepXtr;
+                        ++minCnt;
+                        minCntExt = 0;
+                        nSteps = iStep;
+                     } else {
+
+                        break;
+                     }
+
+                     ++minCntExt;
+                  } // Extrapolation loop
+
+               } catch (genfit::Exception &e) {
+                  mom_ext.SetXYZ(0, 0, 0);
+                  pos_ext.SetXYZ(0, 0, 0);
+               } // try
+
+               // mom_res = mom_ext;
+               // pos_res = pos_ext;
+               xiniFitXtr = pos_ext.X();
+               yiniFitXtr = pos_ext.Y();
+               ziniFitXtr = pos_ext.Z();
+
+               // std::cout << cYELLOW << " Extrapolation: Total Momentum : " << mom_ext.Mag()
+               // << " - Position : " << pos_ext.X() << "  " << pos_ext.Y() << "  " << pos_ext.Z()
+               // << " - POCA : " << POCA << " - Steps : " << nSteps << cNORMAL << "\n";
+
+               Double_t thetaA = 0.0;
+               if (thetaConv > 90.0) {
+                  thetaA = 180.0 * TMath::DegToRad() - mom_res.Theta();
+
+               } else {
+                  thetaA = mom_res.Theta();
+               }
+
+               Double_t E = TMath::Sqrt(TMath::Power(mom_res.Mag(), 2) + TMath::Power(M_Ener, 2)) - M_Ener;
+               EFit = E * 1000.0;
+               EFitXtr = 1000.0 * (TMath::Sqrt(TMath::Power(mom_ext.Mag(), 2) + TMath::Power(M_Ener, 2)) - M_Ener);
+               std::cout << " Energy : " << E * 1000.0 << " - Energy Xtr : " << EFitXtr << "\n";
+               AFit = thetaA * TMath::RadToDeg();
+               PhiFit = mom_res.Phi();
+               xiniFit = pos_res.X();
+               yiniFit = pos_res.Y();
+               ziniFit = pos_res.Z();
+
+            } // Kalman fit
+
+         } // Kalman status
 
       } catch (std::exception &e) {
-         std::cout << " Exception fitting track !" << e.what() << "\n";
-         continue;
+         std::cout << " " << e.what() << "\n";
+         return nullptr;
       }
 
-   } // Merged track loop
+      ROOT::Math::XYZVector iniFitVec(xiniFit, yiniFit, ziniFit);
+      ROOT::Math::XYZVector iniFitXtrVec(xiniPRA, yiniPRA, ziniPRA);
+      ROOT::Math::XYZVector iniPRAVec(xiniPRA, yiniPRA, ziniPRA);
+
+      // NB: Here need the data block
+      std::unique_ptr<AtFittedTrack> fittedTrack = std::make_unique<AtFittedTrack>();
+      fittedTrack->SetTrackID(trackID);
+      fittedTrack->SetEnergyAngles(EFit, EFitXtr, AFit, PhiFit, EPRA, APRA, PhiPRA);
+      fittedTrack->SetVertexPosition(iniFitVec, iniPRAVec, iniFitXtrVec);
+      fittedTrack->SetStats(pVal, fChi2, bChi2, fNdf, bNdf, fitConverged);
+      fittedTrack->SetTrackProperties(particleQ, brho, eloss, dedx, std::to_string(pdg), points);
+      // fittedTrack->SetIonChamber(Float_t icenergy, Int_t ictime);
+      // fittedTrack->SetExcitationEnergy(Float_t exenergy, Float_t exenergyxtr);
+      fittedTrack->SetDistances(distXtr, trackLength, POCA);
+      return fittedTrack;
+
+   } catch (std::exception &e) {
+      std::cout << " Exception fitting track !" << e.what() << "\n";
+      return nullptr;
+   }
 
-   // std::cout<<" Fitted tracks "<<fittedTracks.size()<<"\n";
-   return std::move(fittedTracks);
+   return nullptr;
 }
 
 /**
@@ -721,6 +822,16 @@ std::vector<std::unique_ptr<AtFittedTrack>> AtFITTER::AtGenfit::ProcessTracks(st
  * Radius from track is used to construct the magnitude of the initial momentum of the track.
  */
 genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
+{
+   return FitTracks(track, *fContext);
+}
+
+/**
+ * Build the seed of a track from the pattern recognition: fill the hit cluster array of context with the
+ * measurements of the track, and compute the initial position, direction and Brho. Returns false if the track
+ * cannot be fitted.
+ */
+Bool_t AtFITTER::AtGenfit::MakeSeed(AtTrack *track, FitContext &context, TrackSeed &seed)
 {
 
    // std::vector<genfit::Track> genfitTrackArray;
@@ -731,20 +842,16 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    //<< cNORMAL << "\n";
 
    // for (auto track : patternTrackCand) {
-   fHitClusterArray->Delete();
-   genfit::TrackCand trackCand;
+   context.hitClusterArray->Delete();
+   genfit::TrackCand &trackCand = seed.trackCand;
 
    auto hitClusterArray = track->GetHitClusterArray();
 
-   TVector3 pos_res;
-   TVector3 mom_res;
-   TMatrixDSym cov_res;
-
    std::cout << cYELLOW << " Track " << track->GetTrackID() << " with " << hitClusterArray->size() << " clusters "
              << cNORMAL << "\n";
 
    if (hitClusterArray->size() < 3) //&& patternTrackCand.size()<5) { // TODO Check minimum number of clusters
-      return nullptr;
+      return false;
 
    if (fVerbosity > 0) {
       std::cout << " Initial angles from PRA "
@@ -790,21 +897,16 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    } else {
       std::cout << cRED << " AtGenfit::FitTracks - Warning! Undefined theta angle. Skipping event..." << cNORMAL
                 << "\n";
-      return nullptr;
+      return false;
    }
 
    Double_t radius = track->GetGeoRadius() / 1000.0; // mm to m
 
    Double_t brho = (fMagneticField / 10.0) * radius / TMath::Sin(theta); // Tm
 
-   Double_t p_mass = fMass;
-   Int_t p_Z = fAtomicNumber;
-   Int_t PDGCode = fPDGCode;
-
    if (fVerbosity > 0) {
       LOG(debug) << cYELLOW << "    ---- AtGenfit : Initial parameters "
                  << "\n";
-      LOG(debug) << "    PDG : " << PDGCode << " - Mass : " << p_mass << " - Atomic number : " << p_Z << "\n";
       LOG(debug) << "    B field : " << fMagneticField / 10.0 << " - Min. Bhro : " << fMinBrho
                  << "    - Max. Brho : " << fMaxBrho << "\n";
       LOG(debug) << "    Theta : " << theta * TMath::RadToDeg() << " - Phi : " << phi * TMath::RadToDeg()
@@ -816,9 +918,10 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    // Adding clusterized  hits
    // for (auto cluster : *hitClusterArray) {
    for (auto iCluster = 0; iCluster < hitClusterArray->size(); ++iCluster) {
-      auto cluster = hitClusterArray->at(iCluster);
+      const auto &cluster = hitClusterArray->at(iCluster);
       auto pos = cluster.GetPosition();
-      auto clusterClone(cluster);
+      Int_t idx = context.hitClusterArray->GetEntriesFast();
+      auto *clusterClone = new ((*context.hitClusterArray)[idx]) AtHitCluster(cluster); // NOLINT
 
       if (iCluster == 0) {
          std::cout << cYELLOW << "    First cluster : " << pos.X() << " - " << pos.Y() << " - " << pos.Z() << cNORMAL
@@ -832,18 +935,16 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
 
       if (IsForwardTrack(thetaConv)) { // Experiment forward
          if (fSimulationConv)
-            clusterClone.SetPosition({pos.X(), pos.Y(), 1000.0 - pos.Z()});
+            clusterClone->SetPosition({pos.X(), pos.Y(), 1000.0 - pos.Z()});
          else
-            clusterClone.SetPosition({-pos.X(), pos.Y(), 1000.0 - pos.Z()});
+            clusterClone->SetPosition({-pos.X(), pos.Y(), 1000.0 - pos.Z()});
       } else if (thetaConv > 90.0 * TMath::DegToRad()) {
          if (fSimulationConv)
-            clusterClone.SetPosition({pos.X(), pos.Y(), pos.Z()});
+            clusterClone->SetPosition({pos.X(), pos.Y(), pos.Z()});
          else
-            clusterClone.SetPosition({-pos.X(), pos.Y(), pos.Z()});
+            clusterClone->SetPosition({-pos.X(), pos.Y(), pos.Z()});
       }
 
-      Int_t idx = fHitClusterArray->GetEntriesFast();
-      new ((*fHitClusterArray)[idx]) AtHitCluster(clusterClone);
       trackCand.addHit(fTPCDetID, idx);
       // std::cout<<" Adding  cluster "<<idx<<"\n";
       // std::cout<<pos.X()<<"     "<<pos.Y()<<"   "<<pos.Z()<<"\n";
@@ -851,44 +952,16 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
       // iniPos	= pos;
    }
 
-   // Initial cluster
-   // Last(first) one for tracks with angle >(<) 90
-   AtHitCluster iniCluster;
-   Double_t zIniCal = 0;
-   Double_t xIniCal = 0;
-
-   XYZPoint iniPos;
-
-   // Initial track position
-   if (IsForwardTrack(thetaConv)) {
-      iniCluster = hitClusterArray->front();
-      // iniCluster = hitClusterArray->back();
-      iniPos = iniCluster.GetPosition();
-      zIniCal = 1000.0 - iniPos.Z();
-
-      if (fSimulationConv)
-         xIniCal = iniPos.X();
-      else
-         xIniCal = -iniPos.X();
+   // Initial cluster: the first one, the clusters of forward tracks are reversed at this point. The tracks with an
+   // undefined angle were skipped above.
+   XYZPoint iniPos = hitClusterArray->front().GetPosition();
+   Double_t zIniCal = IsForwardTrack(thetaConv) ? 1000.0 - iniPos.Z() : iniPos.Z();
+   Double_t xIniCal = fSimulationConv ? iniPos.X() : -iniPos.X();
 
-      // Leave hit cluster array in its original state
+   // Leave hit cluster array in its original state (the initial cluster of forward tracks is now the last one)
+   if (IsForwardTrack(thetaConv))
       std::reverse(hitClusterArray->begin(), hitClusterArray->end());
-
-   } else if (thetaConv > 90.0 * TMath::DegToRad()) {
-      iniCluster = hitClusterArray->front();
-      // iniCluster = hitClusterArray->back();
-      iniPos = iniCluster.GetPosition();
-      zIniCal = iniPos.Z();
-
-      if (fSimulationConv)
-         xIniCal = iniPos.X();
-      else
-         xIniCal = -iniPos.X();
-
-   } else {
-      std::cout << cRED << " AtGenfit::FitTracks - Warning! Undefined theta angle. Skipping event..." << cNORMAL
-                << "\n";
-   }
+   const auto &iniCluster = IsForwardTrack(thetaConv) ? hitClusterArray->back() : hitClusterArray->front();
 
    // Double_t dist = TMath::Sqrt(iniPos.X() * iniPos.X() + iniPos.Y() * iniPos.Y());
 
@@ -899,22 +972,35 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    // if(fVerbosity>1)
    std::cout << "    Initial position : " << xIniCal << " - " << iniPos.Y() << " - " << zIniCal << "\n";
 
-   TVector3 posSeed(xIniCal / 10.0, iniPos.Y() / 10.0, zIniCal / 10.0);
-   posSeed.SetMag(posSeed.Mag());
+   seed.posSeed.SetXYZ(xIniCal / 10.0, iniPos.Y() / 10.0, zIniCal / 10.0);
 
    // Starting wih fit...
 
    TMatrixDSym covSeed(6); // TODO Check where COV matrix is defined, likely in AtPattern clusterize (hard coded
                            // in AtSpacePoint measurement)
-   TMatrixD covMatrix = iniCluster.GetCovMatrix();
+   const auto &covMatrix = iniCluster.GetCovMatrix();
    for (Int_t iComp = 0; iComp < 3; iComp++)
       covSeed(iComp, iComp) = covMatrix(iComp, iComp) / 100.; // unit conversion mm2 -> cm2
 
    for (Int_t iComp = 3; iComp < 6; iComp++)
       covSeed(iComp, iComp) = covSeed(iComp - 3, iComp - 3);
 
+   trackCand.setCovSeed(covSeed);
+
+   seed.theta = theta;
+   seed.phi = phi;
+   seed.brho = brho;
+   seed.thetaConv = thetaConv;
+   return true;
+}
+
+/// Momentum seed (GeV) of a particle of mass (amu) and atomic number along the direction of the seed
+TVector3 AtFITTER::AtGenfit::GetMomentumSeed(const TrackSeed &seed, Double_t mass, Int_t atomicNumber)
+{
+   Double_t theta = seed.theta;
+   Double_t phi = seed.phi;
    std::tuple<Double_t, Double_t> mom_ener =
-      GetMomFromBrho(p_mass, p_Z, brho); // TODO Change to structured bindings when C++17
+      GetMomFromBrho(mass, atomicNumber, seed.brho); // TODO Change to structured bindings when C++17
 
    // Momentum calculation
    Double_t px = 0, py = 0, pz = 0;
@@ -932,23 +1018,42 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    TVector3 momSeed(px, py, pz);
    momSeed.SetTheta(theta); // TODO: Check angle conventions
    momSeed.SetPhi(phi);     // TODO
-   trackCand.setCovSeed(covSeed);
-   trackCand.setPosMomSeed(posSeed, momSeed, p_Z);
+   return momSeed;
+}
+
+genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track, FitContext &context)
+{
+   AtTools::AtProfiler::Scope scope("AtGenfit::FitTracks");
+   TrackSeed seed;
+   if (!MakeSeed(track, context, seed))
+      return nullptr;
+
+   if (fVerbosity > 0)
+      LOG(debug) << cYELLOW << "    PDG : " << fPDGCode << " - Mass : " << fMass
+                 << " - Atomic number : " << fAtomicNumber << cNORMAL << "\n";
+
+   genfit::TrackCand &trackCand = seed.trackCand;
+   Double_t brho = seed.brho;
+   TVector3 pos_res;
+   TVector3 mom_res;
+   TMatrixDSym cov_res;
+
+   trackCand.setPosMomSeed(seed.posSeed, GetMomentumSeed(seed, fMass, fAtomicNumber), fAtomicNumber);
    trackCand.setPdgCode(fPDGCode);
    // trackCand.Print();
 
-   if (brho > fMaxBrho && brho < fMinBrho)
+   if (brho > fMaxBrho || brho < fMinBrho)
       return nullptr;
 
-   auto *gfTrack = new ((*fGenfitTrackArray)[fGenfitTrackArray->GetEntriesFast()]) // NOLINT
-      genfit::Track(trackCand, *fMeasurementFactory);
+   auto *gfTrack = new ((*context.genfitTrackArray)[context.genfitTrackArray->GetEntriesFast()]) // NOLINT
+      genfit::Track(trackCand, context.measurementFactory);
    gfTrack->addTrackRep(new genfit::RKTrackRep(fPDGCode)); // NOLINT
 
    auto *trackRep = dynamic_cast<genfit::RKTrackRep *>(gfTrack->getTrackRep(0));
    // trackRep->setPropDir(-1);
 
    try {
-      fKalmanFitter->processTrackWithRep(gfTrack, trackRep, false);
+      context.kalmanFitter->processTrackWithRep(gfTrack, trackRep, false);
    } catch (genfit::Exception &e) {
       std::cout << " AtGenfit -  Exception caught from Kalman Fitter : " << e.what() << "\n";
       return nullptr;
@@ -999,6 +1104,104 @@ genfit::Track *AtFITTER::AtGenfit::FitTracks(AtTrack *track)
    return gfTrack;
 }
 
+/// Prefit of a hypothesis from pattern recognition. Sets energy to the kinetic energy (MeV) of the particle at brho.
+Bool_t AtFITTER::AtGenfit::IsExcluded(const Hypothesis &hypothesis, Double_t brho, Double_t eloss, Double_t &energy)
+{
+   energy = std::get<1>(fKinematics->GetMomFromBrho(hypothesis.mass, hypothesis.atomicNumber, brho)) * 1000.0;
+   return energy < hypothesis.minEnergy || energy > hypothesis.maxEnergy || eloss < hypothesis.minELoss ||
+          eloss > hypothesis.maxELoss;
+}
+
+std::vector<AtFITTER::AtGenfit::HypothesisFit>
+AtFITTER::AtGenfit::FitHypotheses(AtTrack &track, const std::vector<Int_t> &pdgCodes)
+{
+   return FitHypotheses(track, pdgCodes, *fContext);
+}
+
+std::vector<AtFITTER::AtGenfit::HypothesisFit>
+AtFITTER::AtGenfit::FitHypotheses(AtTrack &track, const std::vector<Int_t> &pdgCodes, FitContext &context)
+{
+   std::vector<HypothesisFit> fits;
+
+   std::vector<std::size_t> selected;
+   for (std::size_t iHyp = 0; iHyp < fHypotheses.size(); ++iHyp)
+      selected.push_back(iHyp);
+   if (!pdgCodes.empty()) {
+      selected.clear();
+      for (auto pdg : pdgCodes) {
+         auto it = std::find_if(fHypotheses.begin(), fHypotheses.end(),
+                                [pdg](const Hypothesis &hyp) { return hyp.pdg == pdg; });
+         if (it != fHypotheses.end())
+            selected.push_back(std::distance(fHypotheses.begin(), it));
+         else
+            LOG(error) << "AtGenfit::FitHypotheses - No hypothesis for PDG code " << pdg;
+      }
+   }
+
+   context.hitClusterArray->Delete();
+   context.genfitTrackArray->Delete();
+
+   // Measurements and seed shared by every hypothesis
+   TrackSeed seed;
+   if (!MakeSeed(&track, context, seed))
+      return fits;
+
+   Bool_t brhoAllowed = seed.brho >= fMinBrho && seed.brho <= fMaxBrho;
+   Double_t eloss = MeanStartCharge(*track.GetHitClusterArray(), IsForwardTrack(seed.thetaConv));
+   genfit::Track *gfTrack = nullptr;
+
+   for (auto iHyp : selected) {
+      const auto &hypothesis = fHypotheses[iHyp];
+      HypothesisFit fit;
+      fit.pdg = hypothesis.pdg;
+      fit.skipped = IsExcluded(hypothesis, seed.brho, eloss, fit.energyPRA) || !brhoAllowed;
+      if (fit.skipped) {
+         LOG(debug) << cYELLOW << " AtGenfit::FitHypotheses - Skipping " << hypothesis.pdg
+                    << " - Energy (PRA) : " << fit.energyPRA << " - Brho : " << seed.brho
+                    << " - Energy loss : " << eloss << cNORMAL;
+         fits.push_back(fit);
+         continue;
+      }
+
+      // Momentum from the Brho of the track, the same for every hypothesis with the same charge
+      TVector3 momSeed = GetMomentumSeed(seed, hypothesis.mass, hypothesis.atomicNumber);
+      if (gfTrack == nullptr) {
+         seed.trackCand.setPosMomSeed(seed.posSeed, momSeed, hypothesis.atomicNumber);
+         seed.trackCand.setPdgCode(hypothesis.pdg);
+         gfTrack = new ((*context.genfitTrackArray)[context.genfitTrackArray->GetEntriesFast()]) // NOLINT
+            genfit::Track(seed.trackCand, context.measurementFactory);
+      } else {
+         gfTrack->setStateSeed(seed.posSeed, momSeed);
+      }
+
+      auto *trackRep = fHypothesisReps[iHyp]->clone();
+      gfTrack->addTrackRep(trackRep);
+
+      try {
+         context.kalmanFitter->processTrackWithRep(gfTrack, trackRep, false);
+      } catch (genfit::Exception &e) {
+         std::cout << " AtGenfit -  Exception caught from Kalman Fitter : " << e.what() << "\n";
+         fits.push_back(fit);
+         continue;
+      }
+
+      fit.track = gfTrack;
+      fit.rep = trackRep;
+      if (gfTrack->hasKalmanFitStatus(trackRep)) {
+         auto *status = gfTrack->getKalmanFitStatus(trackRep);
+         fit.converged = status->isFitConverged(false);
+         fit.fChi2 = status->getForwardChi2();
+         fit.bChi2 = status->getBackwardChi2();
+         fit.fNdf = status->getForwardNdf();
+         fit.bNdf = status->getBackwardNdf();
+         fit.pVal = status->getPVal();
+      }
+      fits.push_back(fit);
+   }
+
+   return fits;
+}
+
 std::vector<AtTrack *> AtFITTER::AtGenfit::FindSingleTracks(std::vector<AtTrack *> &tracks)
 {
 
@@ -8,6 +8,7 @@
 
 #include <Rtypes.h>
 #include <TMath.h> // for DegToRad
+#include <TVector3.h>
 #include <Track.h>
 
 #include "AbsFitterInfo.h"
@@ -31,11 +32,13 @@
 #include "MeasurementOnPlane.h"
 #include "MeasurementProducer.h"
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+class AtFittedTrack;
 class AtHitCluster;
 class AtTrack;
 class TBuffer;
@@ -46,6 +49,7 @@ class TMemberInspector;
 namespace genfit {
 class AbsKalmanFitter;
 class AbsMeasurement;
+class AbsTrackRep;
 class AtSpacepointMeasurement;
 template <class hit_T, class measurement_T>
 class MeasurementProducer;
@@ -55,11 +59,56 @@ class MeasurementFactory;
 
 namespace AtFITTER {
 
+/**
+ * @brief Fit track candidates using the Kalman filter of GENFIT.
+ *
+ * Everything GENFIT keeps while fitting a track (the measurements, the fitter and the fitted track) lives in
+ * a FitContext. The magnetic field and the material effects are GENFIT singletons configured in the constructor
+ * and used internally by the track representations while propagating, so they cannot be given per thread. The
+ * tracks are therefore fitted one after the other, and AtGenfit is not thread safe: every instance shares the
+ * singletons (the last one constructed sets them), so instances must not be used from different threads.
+ *
+ * A track can also be fitted against a list of particle hypotheses (see AddHypothesis and FitHypotheses). The
+ * measurements and the seed from pattern recognition are then built once and every hypothesis is fitted as a
+ * separate track representation of the same GENFIT track.
+ */
 class AtGenfit : public AtFitter {
+public:
+   /// Particle hypothesis fitted by FitHypotheses
+   struct Hypothesis {
+      Int_t pdg{2212};
+      Double_t mass{1.00727647}; //< Mass in atomic mass unit
+      Int_t atomicNumber{1};
+      std::string eLossFile; //< Energy loss file of the particle (if empty the one of the constructor is used)
+      // Prefit windows: the hypothesis is not fitted if the track is outside of them
+      Double_t minEnergy{0}; //< Kinetic energy (MeV) from the Brho of the track
+      Double_t maxEnergy{std::numeric_limits<Double_t>::max()};
+      Double_t minELoss{0}; //< Mean charge of the clusters at the start of the track
+      Double_t maxELoss{std::numeric_limits<Double_t>::max()};
+   };
+
+   /// Result of fitting a track with one hypothesis
+   struct HypothesisFit {
+      Int_t pdg{0};
+      Bool_t skipped{false}; //< Excluded by the prefit, so not fitted
+      Bool_t converged{false};
+      Double_t energyPRA{0}; //< Kinetic energy (MeV) from the Brho of the track
+      Double_t fChi2{0};     //< Chi2 and ndf of the forward and backward passes of the Kalman fitter
+      Double_t bChi2{0};
+      Double_t fNdf{0};
+      Double_t bNdf{0};
+      Double_t pVal{-1};
+      genfit::Track *track{nullptr};     //< Fitted track (nullptr if skipped or failed), owned by the fitter and
+                                         // valid until the next fit
+      genfit::AbsTrackRep *rep{nullptr}; //< Representation of the hypothesis in track
+   };
+
 private:
-   std::shared_ptr<genfit::AbsKalmanFitter> fKalmanFitter;
-   TClonesArray *fGenfitTrackArray;
-   TClonesArray *fHitClusterArray;
+   struct FitContext;
+   struct TrackSeed;
+
+   std::unique_ptr<FitContext> fContext; //! Objects GENFIT uses to fit a track
+
    Int_t fPDGCode{2212}; //<! Particle PGD code
    Int_t fTPCDetID{0};
    Int_t fFitDirection{0};
@@ -88,16 +137,28 @@ private:
    std::unique_ptr<AtTools::AtTrackTransformer> fTrackTransformer;
    std::shared_ptr<AtTools::AtKinematics> fKinematics;
 
-   genfit::MeasurementProducer<AtHitCluster, genfit::AtSpacepointMeasurement> *fMeasurementProducer;
-   genfit::MeasurementFactory<genfit::AbsMeasurement> *fMeasurementFactory;
-
    std::vector<Int_t> *fPDGCandidateArray{};
 
+   std::vector<Hypothesis> fHypotheses;                                //! Hypotheses fitted by FitHypotheses
+   std::vector<std::unique_ptr<genfit::AbsTrackRep>> fHypothesisReps; //! Representation of each hypothesis
+
    std::vector<AtTrack *> FindSingleTracks(std::vector<AtTrack *> &tracks);
    Double_t CenterDistance(AtTrack *trA, AtTrack *trB);
    Bool_t CompareTracks(AtTrack *trA, AtTrack *trB);
    Bool_t CheckOverlap(AtTrack *trA, AtTrack *trB);
 
+   std::unique_ptr<FitContext> MakeFitContext();
+   genfit::Track *FitTracks(AtTrack *track, FitContext &context);
+   std::vector<std::unique_ptr<AtFittedTrack>> FitMergedTrack(AtTrack &track, Int_t trackID, FitContext &context);
+   std::unique_ptr<AtFittedTrack> ExtractFittedTrack(AtTrack &track, Int_t trackID, genfit::Track *fitTrack,
+                                                     genfit::AbsTrackRep *trackRep, Int_t pdg, Double_t mass,
+                                                     Int_t atomicNumber);
+   Bool_t MakeSeed(AtTrack *track, FitContext &context, TrackSeed &seed);
+   TVector3 GetMomentumSeed(const TrackSeed &seed, Double_t mass, Int_t atomicNumber);
+   Bool_t IsExcluded(const Hypothesis &hypothesis, Double_t brho, Double_t eloss, Double_t &energy);
+   std::vector<HypothesisFit>
+   FitHypotheses(AtTrack &track, const std::vector<Int_t> &pdgCodes, FitContext &context);
+
 public:
    AtGenfit(Float_t magfield, Float_t minbrho, Float_t maxbrho, std::string eLossFile, Float_t gasMediumDensity,
             Int_t pdg = 2212, Int_t minit = 5, Int_t maxit = 20, Bool_t noMatEffects = kFALSE);
@@ -107,6 +168,31 @@ public:
    Exp fExpNum{a1975};
 
    genfit::Track *FitTracks(AtTrack *track);
+
+   /**
+    * @brief Add a particle hypothesis to fit with FitHypotheses.
+    *
+    * Registers the energy loss file of the particle with GENFIT and sets up its track representation, which is
+    * reused for every track. If hypotheses are set, ProcessTracks fits every one of them and returns a fitted
+    * track for each hypothesis that was not excluded by the prefit.
+    */
+   void AddHypothesis(Hypothesis hypothesis);
+   void ClearHypotheses();
+   const std::vector<Hypothesis> &GetHypotheses() const { return fHypotheses; }
+
+   /**
+    * @brief Fit a track with several particle hypotheses.
+    *
+    * The measurements and the seed (position, direction and Brho from pattern recognition) are built once. Each
+    * hypothesis the prefit does not exclude, from its energy at the Brho of the track and the mean charge of the
+    * first clusters, is then fitted as its own representation of the same GENFIT track.
+    *
+    * @param[in] pdgCodes Hypotheses to fit, in this order. If empty every hypothesis is fitted.
+    * @return Result of each hypothesis (in the order of pdgCodes or of AddHypothesis). Empty if the track could
+    * not be seeded.
+    */
+   std::vector<HypothesisFit> FitHypotheses(AtTrack &track, const std::vector<Int_t> &pdgCodes = {});
+
    std::vector<std::unique_ptr<AtFittedTrack>> ProcessTracks(std::vector<AtTrack> &tracks) override;
    void Init() override;
 
@@ -143,7 +229,7 @@ public:
 
 protected:
    inline bool IsForwardTrack(double theta) { return theta < 90.0 * TMath::DegToRad(); }
-   ClassDefOverride(AtGenfit, 1);
+   ClassDefOverride(AtGenfit, 3);
 };
 
 } // namespace AtFITTER
@@ -0,0 +1,187 @@
+#include "AtGenfit.h"
+
+#include "AtHitCluster.h"
+#include "AtTrack.h"
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * Fitter in a box of deuterium gas with a constant field of 3 T along z. Every hypothesis is excluded by its prefit
+ * window unless a test opens it, so only the seeding and the bookkeeping of FitHypotheses run (no Kalman fit).
+ */
+class AtGenfitTest : public ::testing::Test {
+protected:
+   std::unique_ptr<AtFITTER::AtGenfit> fFitter;
+
+   void SetUp() override
+   {
+      const char *dir = std::getenv("VMCWORKDIR");
+      if (dir == nullptr)
+         GTEST_SKIP() << "VMCWORKDIR is not set, no energy loss file to load";
+
+      if (gGeoManager == nullptr) {
+         new TGeoManager("FAIRGeom", "AtGenfitTest");
+         auto mat = new TGeoMaterial("D2", 2.014, 1, 1.1e-4);
+         auto med = new TGeoMedium("D2", 1, mat);
+         gGeoManager->SetTopVolume(gGeoManager->MakeBox("drift_volume", med, 50, 50, 100));
+         gGeoManager->CloseGeometry();
+      }
+
+      std::string eLossFile = std::string(dir) + "/resources/energy_loss/proton_D2_600torr.txt";
+      fFitter = std::make_unique<AtFITTER::AtGenfit>(3.0, 0.00001, 1000.0, eLossFile, 0.1097, 2212);
+
+      AtFITTER::AtGenfit::Hypothesis proton;
+      proton.maxEnergy = 0;
+      fFitter->AddHypothesis(proton);
+
+      AtFITTER::AtGenfit::Hypothesis deuteron;
+      deuteron.pdg = 1000010020;
+      deuteron.mass = 2.01355321;
+      deuteron.maxEnergy = 0;
+      fFitter->AddHypothesis(deuteron);
+   }
+
+   /// Backward track with numClusters along z
+   static AtTrack MakeTrack(int numClusters)
+   {
+      AtTrack track;
+      track.SetGeoTheta(120 * TMath::DegToRad());
+      track.SetGeoPhi(30 * TMath::DegToRad());
+      track.SetGeoRadius(500);
+      for (int i = 0; i < numClusters; ++i) {
+         AtHitCluster cluster;
+         cluster.SetPosition({10. + i, 5. + i, 100. + 10 * i});
+         cluster.SetCharge(100);
+         track.AddClusterHit(std::move(cluster));
+      }
+      return track;
+   }
+
+   /**
+    * Backward track of a proton with brho (Tm) leaving (0, 0, 100) mm with theta = 60 deg and phi = -30 deg in the
+    * frame of GENFIT. The clusters are on the helix of the proton without energy loss, 5 mm apart.
+    */
+   static AtTrack MakeHelixTrack(int numClusters, double brho)
+   {
+      const double theta = 60 * TMath::DegToRad();
+      const double phi = -30 * TMath::DegToRad();
+      const double radius = brho * std::sin(theta) / 3.0 * 1000; // mm
+
+      AtTrack track;
+      track.SetGeoTheta(TMath::Pi() - theta);
+      track.SetGeoPhi(-phi);
+      track.SetGeoRadius(radius);
+
+      // A positive charge turns clockwise around the field
+      double xc = radius * std::sin(phi);
+      double yc = -radius * std::cos(phi);
+      double step = 5 * std::sin(theta) / radius;
+      for (int i = 0; i < numClusters; ++i) {
+         double alpha = step * i;
+         double x = xc - radius * std::sin(phi - alpha);
+         double y = yc + radius * std::cos(phi - alpha);
+         double z = 100 + radius * alpha / std::tan(theta);
+
+         // The experiment convention mirrors x for backward tracks
+         AtHitCluster cluster;
+         cluster.SetPosition({-x, y, z});
+         cluster.SetPositionVariance({1, 1, 1});
+         cluster.SetCharge(100);
+         track.AddClusterHit(std::move(cluster));
+      }
+      return track;
+   }
+};
+} // namespace
+
+TEST_F(AtGenfitTest, FitHypothesesInOrder)
+{
+   auto track = MakeTrack(10);
+   auto fits = fFitter->FitHypotheses(track, {1000010020, 2212, 999});
+
+   // The unknown hypothesis is dropped
+   ASSERT_EQ(fits.size(), 2u);
+   EXPECT_EQ(fits[0].pdg, 1000010020);
+   EXPECT_EQ(fits[1].pdg, 2212);
+   for (const auto &fit : fits) {
+      EXPECT_TRUE(fit.skipped);
+      EXPECT_EQ(fit.track, nullptr);
+      EXPECT_GT(fit.energyPRA, 0);
+   }
+   // At the same Brho the heavier particle has less energy
+   EXPECT_LT(fits[0].energyPRA, fits[1].energyPRA);
+
+   // Every hypothesis in the order they were added
+   fits = fFitter->FitHypotheses(track);
+   ASSERT_EQ(fits.size(), 2u);
+   EXPECT_EQ(fits[0].pdg, 2212);
+   EXPECT_EQ(fits[1].pdg, 1000010020);
+}
+
+TEST_F(AtGenfitTest, FitHypothesesInWindow)
+{
+   // Open the window of the proton, the deuteron is still excluded
+   fFitter->AddHypothesis(AtFITTER::AtGenfit::Hypothesis{});
+
+   const double brho = 0.3;
+   auto track = MakeHelixTrack(30, brho);
+   auto fits = fFitter->FitHypotheses(track, {1000010020, 2212});
+   ASSERT_EQ(fits.size(), 2u);
+
+   EXPECT_EQ(fits[0].pdg, 1000010020);
+   EXPECT_TRUE(fits[0].skipped);
+   EXPECT_EQ(fits[0].track, nullptr);
+
+   const auto &fit = fits[1];
+   EXPECT_EQ(fit.pdg, 2212);
+   EXPECT_FALSE(fit.skipped);
+   ASSERT_NE(fit.track, nullptr);
+   ASSERT_NE(fit.rep, nullptr);
+   EXPECT_TRUE(fit.track->hasKalmanFitStatus(fit.rep));
+   EXPECT_TRUE(std::isfinite(fit.fChi2));
+   EXPECT_TRUE(std::isfinite(fit.bChi2));
+   EXPECT_GE(fit.bChi2, 0);
+   EXPECT_GT(fit.bNdf, 0);
+
+   // Kinetic energy of a proton at the Brho of the track
+   const double mass = 0.93827208; // GeV
+   double p = brho * 0.299792458;
+   EXPECT_NEAR(fit.energyPRA, (std::sqrt(p * p + mass * mass) - mass) * 1000, 0.05);
+
+   // Once the deuteron is also open, both are fitted in the requested order
+   AtFITTER::AtGenfit::Hypothesis deuteron;
+   deuteron.pdg = 1000010020;
+   deuteron.mass = 2.01355321;
+   fFitter->AddHypothesis(deuteron);
+   fits = fFitter->FitHypotheses(track, {2212, 1000010020});
+   ASSERT_EQ(fits.size(), 2u);
+   EXPECT_EQ(fits[0].pdg, 2212);
+   EXPECT_EQ(fits[1].pdg, 1000010020);
+   for (const auto &hypFit : fits) {
+      EXPECT_FALSE(hypFit.skipped);
+      ASSERT_NE(hypFit.track, nullptr);
+      EXPECT_TRUE(std::isfinite(hypFit.bChi2));
+   }
+   // Every hypothesis is a representation of the same track
+   EXPECT_EQ(fits[0].track, fits[1].track);
+   EXPECT_NE(fits[0].rep, fits[1].rep);
+}
+
+TEST_F(AtGenfitTest, FitHypothesesShortTrack)
+{
+   auto track = MakeTrack(2);
+   EXPECT_TRUE(fFitter->FitHypotheses(track).empty());
+}
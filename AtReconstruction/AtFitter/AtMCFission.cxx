@@ -108,7 +108,7 @@ void AtMCFission::SetParamDistributions(const AtPatternEvent &event)
 double AtMCFission::ObjectiveFunction(const AtBaseEvent &expEvent, int SimEventID, AtMCResult &definition)
 {
    // Make sure we were passed the right event type
-   auto expFission = dynamic_cast<const AtFissionEvent &>(expEvent);
+   const auto &expFission = dynamic_cast<const AtFissionEvent &>(expEvent);
    auto charge = ObjectiveCharge(expFission, SimEventID, definition);
    // auto charge = ObjectiveChargePads(expFission, SimEventID, definition);
    auto pos = ObjectivePositionPads(expFission, SimEventID);
@@ -270,6 +270,39 @@ AtMCFission::ObjectiveChargeDiff2(const std::vector<double> &exp, const std::vec
    return chi2;
 }
 
+bool AtMCFission::GetBestAmp(const ObjectiveFuncCharge &obj, const std::vector<double> &exp,
+                             const std::vector<double> &sim, double &amp)
+{
+   using ObjectivePtr = double (*)(const std::vector<double> &, const std::vector<double> &, const double *);
+   auto objPtr = obj.target<ObjectivePtr>();
+   if (objPtr == nullptr || exp.size() != sim.size())
+      return false;
+
+   // Weight of each term in the objective (up to a constant factor)
+   double (*weight)(double) = nullptr;
+   if (*objPtr == &ObjectiveChargeChi2)
+      weight = [](double e) { return 1 / e; };
+   else if (*objPtr == &ObjectiveChargeChi2Norm)
+      weight = [](double e) { return 1 / (e * e); };
+   else if (*objPtr == &ObjectiveChargeDiff2)
+      weight = [](double) { return 1.0; };
+   else
+      return false;
+
+   double num = 0;
+   double denom = 0;
+   for (int i = 0; i < exp.size(); ++i) {
+      auto w = weight(exp[i]);
+      num += w * exp[i] * sim[i];
+      denom += w * sim[i] * sim[i];
+   }
+   if (denom == 0)
+      return false;
+
+   amp = num / denom;
+   return true;
+}
+
 double AtMCFission::ObjectiveCharge(const std::array<std::vector<double>, 2> &expFull,
                                     const std::array<std::vector<double>, 2> &simFull, AtMCResult &definition)
 {
@@ -289,6 +322,16 @@ double AtMCFission::ObjectiveCharge(const std::array<std::vector<double>, 2> &ex
 
    if (fFitAmp && !(exp.size() == 0 || exp.size() != sim.size())) {
       LOG(info) << exp.size() << " " << sim.size();
+
+      // Built-in objectives are quadratic in the amplitude so it does not need to be fit
+      double amp = 0;
+      if (GetBestAmp(fObjCharge, exp, sim, amp)) {
+         auto chi2 = fObjCharge(exp, sim, &amp);
+         definition.fParameters["Amp"] = amp;
+         definition.fParameters["qChi2"] = chi2;
+         return chi2;
+      }
+
       auto functor = ROOT::Math::Functor(std::bind(fObjCharge, exp, sim, std::placeholders::_1), 1); // NOLINT
 
       std::vector<double> A = {fAmp};
@@ -301,7 +344,7 @@ double AtMCFission::ObjectiveCharge(const std::array<std::vector<double>, 2> &ex
          return std::numeric_limits<double>::max();
       }
       auto &result = fitter.Result();
-      double amp = result.Parameter(0);
+      amp = result.Parameter(0);
       definition.fParameters["Amp"] = amp;
       definition.fParameters["qChi2"] = result.MinFcnValue();
       return result.MinFcnValue();
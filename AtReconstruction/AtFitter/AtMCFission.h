@@ -65,6 +65,14 @@ public:
    static double
    ObjectiveChargeDiff2(const std::vector<double> &exp, const std::vector<double> &sim, const double *par);
 
+   /**
+    * Get the amplitude minimizing obj in closed form. All of the objectives above are weighted least squares
+    * in the amplitude A, sum_i w_i (exp_i - A sim_i)^2, so A = sum_i w_i exp_i sim_i / sum_i w_i sim_i^2.
+    * @return false if obj is not one of the objectives above or the amplitude is undefined.
+    */
+   static bool GetBestAmp(const ObjectiveFuncCharge &obj, const std::vector<double> &exp,
+                          const std::vector<double> &sim, double &amp);
+
 protected:
    virtual void CreateParamDistros() override;
    virtual void SetParamDistributions(const AtPatternEvent &event) override;
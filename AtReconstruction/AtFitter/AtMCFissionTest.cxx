@@ -0,0 +1,81 @@
+#include "AtMCFission.h"
+
+#include <Fit/FitResult.h>
+#include <Fit/Fitter.h>
+#include <Math/Functor.h>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <random>
+#include <vector>
+
+using MCFitter::AtMCFission;
+
+namespace {
+using ObjectivePtr = double (*)(const std::vector<double> &, const std::vector<double> &, const double *);
+
+/// The amplitude found by the Minuit fit AtMCFission::ObjectiveCharge used for every objective
+bool FitMinuit(ObjectivePtr obj, const std::vector<double> &exp, const std::vector<double> &sim, double &amp)
+{
+   auto func = [obj, &exp, &sim](const double *par) { return obj(exp, sim, par); };
+   auto functor = ROOT::Math::Functor(func, 1);
+
+   std::vector<double> A = {1};
+   ROOT::Fit::Fitter fitter;
+   fitter.Config().SetMinimizer("Minuit2");
+   fitter.SetFCN(functor, A.data());
+   if (!fitter.FitFCN())
+      return false;
+   amp = fitter.Result().Parameter(0);
+   return true;
+}
+} // namespace
+
+TEST(AtMCFissionTest, GetBestAmpMatchesMinuit)
+{
+   std::mt19937 rng(17);
+   std::uniform_real_distribution<double> uni(0, 1);
+
+   for (auto obj : {&AtMCFission::ObjectiveChargeChi2, &AtMCFission::ObjectiveChargeChi2Norm,
+                    &AtMCFission::ObjectiveChargeDiff2}) {
+      for (int i = 0; i < 10; ++i) {
+         // Charge curves where the experimental one is a noisy, scaled copy of the simulated one
+         double trueAmp = 0.2 + 5 * uni(rng);
+         std::vector<double> exp;
+         std::vector<double> sim;
+         for (int tb = 0; tb < 100; ++tb) {
+            sim.push_back(10 + 1000 * uni(rng));
+            exp.push_back(trueAmp * sim.back() * (0.8 + 0.4 * uni(rng)));
+         }
+
+         double best = 0;
+         double minuit = 0;
+         ASSERT_TRUE(AtMCFission::GetBestAmp(obj, exp, sim, best));
+         ASSERT_TRUE(FitMinuit(obj, exp, sim, minuit));
+         EXPECT_NEAR(best, minuit, 1e-4 * minuit) << "Curve " << i;
+
+         // The closed form is the minimum, so it can be no worse than what Minuit found
+         EXPECT_LE(obj(exp, sim, &best), obj(exp, sim, &minuit) * (1 + 1e-12)) << "Curve " << i;
+      }
+   }
+}
+
+TEST(AtMCFissionTest, GetBestAmpFallsBack)
+{
+   std::vector<double> exp = {1, 2, 3};
+   std::vector<double> sim = {2, 4, 6};
+   double amp = 0;
+
+   // Objectives without a closed form are left to Minuit
+   std::function<double(const std::vector<double> &, const std::vector<double> &, const double *)> obj =
+      [](const std::vector<double> &, const std::vector<double> &, const double *par) { return par[0] * par[0]; };
+   EXPECT_FALSE(AtMCFission::GetBestAmp(obj, exp, sim, amp));
+
+   // As are curves that do not constrain the amplitude
+   EXPECT_FALSE(AtMCFission::GetBestAmp(&AtMCFission::ObjectiveChargeChi2, exp, {0, 0, 0}, amp));
+   EXPECT_FALSE(AtMCFission::GetBestAmp(&AtMCFission::ObjectiveChargeChi2, exp, {2, 4}, amp));
+
+   ASSERT_TRUE(AtMCFission::GetBestAmp(&AtMCFission::ObjectiveChargeDiff2, exp, sim, amp));
+   EXPECT_DOUBLE_EQ(amp, 0.5);
+}
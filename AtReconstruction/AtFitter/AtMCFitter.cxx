@@ -7,7 +7,8 @@
 #include "AtMCResult.h"
 #include "AtPSA.h" // for AtPSA
 #include "AtParameterDistribution.h"
-#include "AtPatternEvent.h"     // for AtPatternEvent
+#include "AtPatternEvent.h" // for AtPatternEvent
+#include "AtProfiler.h"
 #include "AtPulse.h"            // for AtPulse
 #include "AtRawEvent.h"         // for AtRawEvent
 #include "AtSimpleSimulation.h" // for AtSimpleSimulation
@@ -22,7 +23,6 @@
 #include <TROOT.h>
 
 #include <algorithm> // for max
-#include <chrono>
 #include <mutex>
 #include <thread>
 using std::move;
@@ -61,8 +61,10 @@ void AtMCFitter::Init()
    fClusterize->GetParameters(fPar);
    if (fPSA)
       fPSA->Init();
-   if (fSim->GetSpaceChargeModel())
+   if (fSim->GetSpaceChargeModel()) {
       fSim->GetSpaceChargeModel()->LoadParameters(fPar);
+      fSim->GetSpaceChargeModel()->BakeField();
+   }
 
    fThPulse.resize(fNumThreads);
    for (int i = 0; i < fNumThreads; ++i)
@@ -116,8 +118,7 @@ void AtMCFitter::Exec(const AtPatternEvent &event)
 }
 void AtMCFitter::RunRound()
 {
-   // Begining of round
-   auto start = std::chrono::high_resolution_clock::now();
+   AtTools::AtProfiler::Scope scope("AtMCFitter::RunRound");
 
    // Get what iterations to do on what thread.
    std::vector<std::pair<int, int>> threadParam;
@@ -147,16 +148,11 @@ void AtMCFitter::RunRound()
    // Wait for all threads to finish
    for (auto &th : threads)
       th.join();
-
-   auto stop = std::chrono::high_resolution_clock::now();
-
-   if (fTimeEvent)
-      LOG(info) << "Simulation of " << fNumIter << " events took "
-                << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms.";
 }
 
 int AtMCFitter::DigitizeEvent(const TClonesArray &points, int idx, AtPulse *pulse)
 {
+   AtTools::AtProfiler::Scope scope("AtMCFitter::DigitizeEvent");
    // Event has been simulated and is sitting in the fSim
    auto vec = fClusterize->ProcessEvent(points);
    LOG(debug) << "Digitizing event at " << idx;
@@ -50,7 +50,6 @@ protected:
    int fNumIter{1};
    int fNumRounds{1};
    int fNumEventsToSave{10};
-   bool fTimeEvent{false};
    int fNumThreads{1};
 
    // Things used by threads excecuting that are either expensive to create and delete
@@ -83,7 +82,6 @@ public:
 
    /// Set number of times to run fNumIter iterations and then re-center and truncate the parameter space.
    void SetNumRounds(int rounds) { fNumRounds = rounds; }
-   void SetTimeEvent(bool val) { fTimeEvent = val; }
    void SetNumEventsToSave(int num) { fNumEventsToSave = num; }
    void SetNumThreads(int num);
 
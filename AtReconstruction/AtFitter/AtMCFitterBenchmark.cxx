@@ -0,0 +1,87 @@
+#include "AtMCFitter.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtClusterize.h"
+#include "AtMCPoint.h"
+#include "AtMCResult.h"
+#include "AtPSAMax.h"
+#include "AtPatternEvent.h"
+#include "AtPulse.h"
+#include "AtSimpleSimulation.h"
+
+#include <TClonesArray.h>
+#include <TGeoManager.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+namespace {
+
+/**
+ * Fitter that "simulates" the same track every iteration, so a round measures the digitization (clusterize, pulse
+ * and PSA) of the iterations and how it scales with the number of threads.
+ */
+class AtMCFitterBenchmark : public MCFitter::AtMCFitter {
+private:
+   TClonesArray fMCPoints{"AtMCPoint"};
+   AtPatternEvent fEvent;
+
+public:
+   AtMCFitterBenchmark()
+      : AtMCFitter(std::make_shared<AtSimpleSimulation>(), std::make_shared<AtClusterize>(),
+                   std::make_shared<AtPulse>(AtBenchmark::GetMap()))
+   {
+      AtBenchmark::FillMCPoints(fMCPoints);
+   }
+
+   /// Set up the event arrays like Exec() does
+   void Prepare()
+   {
+      fCurrentEvent = &fEvent;
+      fRawEventArray.resize(fNumIter);
+      fEventArray.resize(fNumIter);
+   }
+   void Run()
+   {
+      fResults.clear();
+      RunRound();
+   }
+
+protected:
+   void CreateParamDistros() override {}
+   void SetParamDistributions(const AtPatternEvent &event) override {}
+   double ObjectiveFunction(const AtBaseEvent &expEvent, int SimEventID, AtMCResult &definition) override
+   {
+      return fEventArray[SimEventID].GetNumHits();
+   }
+   TClonesArray SimulateEvent(AtMCResult &definition) override { return fMCPoints; }
+};
+
+/// One round of 64 iterations of the fitter, the argument is the number of threads
+void BM_MCFitterRunRound(benchmark::State &state)
+{
+   constexpr int numIter = 64;
+   AtBenchmark::GetDigiPar(); // The fitter gets the parameters from the FairRun
+   // The simulation requires a geometry, even though nothing is simulated here
+   if (gGeoManager == nullptr)
+      new TGeoManager("AtMCFitterBenchmark", "Empty geometry");
+
+   AtMCFitterBenchmark fitter;
+   auto psa = std::make_shared<AtPSAMax>();
+   psa->SetThreshold(45);
+   fitter.SetPSA(psa);
+   fitter.SetNumIter(numIter);
+   fitter.SetNumThreads(state.range(0));
+   fitter.Init();
+   fitter.Prepare();
+
+   AtBenchmark::EventCounter counter(state, numIter);
+   for (auto _ : state)
+      fitter.Run();
+   counter.SetCounters();
+}
+BENCHMARK(BM_MCFitterRunRound)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+} // namespace
@@ -24,7 +24,6 @@ Adapted to AtTPCROOTv2 by Yassid Ayyad ayyadlim@frib.msu.edu
 
 #include <Math/Point3D.h>
 #include <TMatrixDSymfwd.h>
-#include <TMatrixDfwd.h>
 #include <TMatrixT.h>
 #include <TMatrixTSym.h>
 #include <TVectorDfwd.h>
@@ -47,8 +46,7 @@ ClassImp(genfit::AtSpacepointMeasurement)
    AtSpacepointMeasurement::AtSpacepointMeasurement(const AtHitCluster *detHit, const TrackCandHit *hit)
       : SpacepointMeasurement(), fCharge(detHit->GetCharge())
    {
-      auto pos = detHit->GetPosition();
-      TMatrixD mat = detHit->GetCovMatrix();
+      const auto &pos = detHit->GetPosition();
 
       rawHitCoords_(0) = pos.X() / 10.;
       rawHitCoords_(1) = pos.Y() / 10.;
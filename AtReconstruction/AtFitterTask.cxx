@@ -5,6 +5,7 @@
 #include "AtGenfit.h"
 #include "AtParsers.h"
 #include "AtPatternEvent.h"
+#include "AtProfiler.h"
 #include "AtTrackingEvent.h"
 
 #include <FairLogger.h>
@@ -97,7 +98,11 @@ void AtFitterTask::Exec(Option_t *option)
    std::vector<AtTrack> &tracks = patternEvent.GetTrackCand();
    std::cout << " AtFitterTask:Exec -  Number of candidate tracks : " << tracks.size() << "\n";
 
-   auto fittedTracks = fFitter->ProcessTracks(tracks);
+   std::vector<std::unique_ptr<AtFittedTrack>> fittedTracks;
+   {
+      AtTools::AtProfiler::Scope scope("AtFitter::ProcessTracks");
+      fittedTracks = fFitter->ProcessTracks(tracks);
+   }
 
    std::cout << " Number of fitted tracks " << fittedTracks.size() << "\n";
 
@@ -4,6 +4,7 @@
 #include "AtEvent.h"         // for AtEvent
 #include "AtPRA.h"           // for AtPRA
 #include "AtPatternEvent.h"  // for AtPatternEvent
+#include "AtProfiler.h"
 #include "AtTrackFinderTC.h" // for AtTrackFinderHC
 
 #include <FairLogger.h>      // for LOG, FairLogger
@@ -167,6 +168,7 @@ void AtPRAtask::Exec(Option_t *option)
    try {
 
       if (hitArray.size() > fMinNumHits && hitArray.size() < fMaxNumHits) {
+         AtTools::AtProfiler::Scope scope("AtPRA::FindTracks");
          auto patternEvent = fPRA->FindTracks(event);
          new (fPatternEventArray[0]) AtPatternEvent(std::move(*patternEvent));
       }
@@ -2,6 +2,7 @@
 
 #include "AtEvent.h"
 #include "AtPSA.h"
+#include "AtProfiler.h"
 #include "AtRawEvent.h"
 
 #include <FairLogger.h>
@@ -100,7 +101,10 @@ void AtPSAtask::Exec(Option_t *opt)
    LOG(debug) << "Staring PSA on event Number: " << rawEvent->GetEventID() << " with " << rawEvent->GetNumPads()
               << " valid pads";
 
-   fPSA->Analyze(rawEvent, event);
+   {
+      AtTools::AtProfiler::Scope scope("AtPSA::Analyze");
+      fPSA->Analyze(rawEvent, event);
+   }
 
    LOG(debug) << "Finished running PSA";
 }
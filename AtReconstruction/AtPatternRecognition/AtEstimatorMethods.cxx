@@ -8,6 +8,7 @@
 #include <algorithm> // for max_element, nth_element, max
 #include <cassert>
 #include <cmath> // for exp, sqrt, isinf, log, M_PI
+#include <vector>
 using namespace SampleConsensus;
 
 int SampleConsensus::EvaluateChi2(AtPatterns::AtPattern *model, const std::vector<const AtHit *> &hitArray,
@@ -50,14 +51,16 @@ int SampleConsensus::EvaluateYRansac(AtPatterns::AtPattern *model, const std::ve
    auto *yModel = dynamic_cast<AtPatterns::AtPatternY *>(model);
    assert(yModel != nullptr);
 
+   // Reused between the models of a solve, so evaluating a model does not allocate
+   thread_local std::vector<int> assignment;
+   thread_local std::vector<double> distance2;
+   yModel->EvaluatePoints(hitArray, assignment, distance2);
+
    int nbInliers = 0;
-   for (const auto &hit : hitArray) {
-      auto &pos = hit->GetPosition();
-      if (yModel->GetPointAssignment(pos) >= 2)
+   for (size_t i = 0; i < hitArray.size(); ++i) {
+      if (assignment[i] >= 2)
          continue;
-      double error = model->DistanceToPattern(pos);
-      error = error * error;
-      if (error < (distanceThreshold * distanceThreshold)) {
+      if (distance2[i] < (distanceThreshold * distanceThreshold)) {
          nbInliers++;
       }
    }
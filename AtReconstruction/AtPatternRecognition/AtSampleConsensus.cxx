@@ -7,6 +7,7 @@
 #include "AtPattern.h"
 #include "AtPatternEvent.h"
 #include "AtPatternTypes.h"
+#include "AtProfiler.h"
 #include "AtSample.h" // for AtSample
 #include "AtSampleEstimator.h"
 #include "AtSampleMethods.h"
@@ -71,6 +72,8 @@ AtPatternEvent AtSampleConsensus::Solve(const std::vector<AtHit> &hitArray, AtBa
 
 AtPatternEvent AtSampleConsensus::Solve(const std::vector<const AtHit *> &hitArray, AtBaseEvent *event)
 {
+   AtTools::AtProfiler::Scope scope("AtSampleConsensus::Solve");
+
    // Return early if we were passed an event and it is marked bad
    if (event != nullptr && !event->IsGood())
       return {*event};
@@ -0,0 +1,65 @@
+#include "AtSampleConsensus.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtEstimatorMethods.h"
+#include "AtEvent.h"
+#include "AtPatternEvent.h"
+#include "AtPatternTypes.h"
+#include "AtSampleMethods.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using SampleConsensus::AtSampleConsensus;
+using SampleConsensus::Estimators;
+
+/// Fit a Y (beam and two fission fragments) to the fission hit cloud, as in the e12014 analysis
+void BM_SampleConsensusY(benchmark::State &state)
+{
+   auto event = AtBenchmark::MakeHitCloud();
+   AtSampleConsensus sac(Estimators::kRANSAC, AtPatterns::PatternType::kY, RandomSample::SampleMethod::kWeightedY);
+   sac.SetDistanceThreshold(20);
+   sac.SetNumIterations(500);
+   sac.SetMinHitsPattern(150);
+   sac.SetChargeThreshold(20);
+
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      auto patternEvent = sac.Solve(&event);
+      benchmark::DoNotOptimize(patternEvent);
+   }
+   counter.SetCounters();
+
+   state.counters["hits"] = event.GetNumHits();
+}
+BENCHMARK(BM_SampleConsensusY);
+
+/// Find lines in the fission hit cloud with each estimator
+void BM_SampleConsensusLine(benchmark::State &state)
+{
+   auto event = AtBenchmark::MakeHitCloud();
+   AtSampleConsensus sac(static_cast<Estimators>(state.range(0)), AtPatterns::PatternType::kLine,
+                         RandomSample::SampleMethod::kUniform);
+   sac.SetDistanceThreshold(15);
+   sac.SetNumIterations(500);
+   sac.SetMinHitsPattern(30);
+
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      auto patternEvent = sac.Solve(&event);
+      benchmark::DoNotOptimize(patternEvent);
+   }
+   counter.SetCounters();
+
+   state.counters["hits"] = event.GetNumHits();
+}
+BENCHMARK(BM_SampleConsensusLine)
+   ->ArgName("estimator")
+   ->Arg(static_cast<int>(Estimators::kRANSAC))
+   ->Arg(static_cast<int>(Estimators::kLMedS))
+   ->Arg(static_cast<int>(Estimators::kMLESAC))
+   ->Arg(static_cast<int>(Estimators::kWRANSAC));
+
+} // namespace
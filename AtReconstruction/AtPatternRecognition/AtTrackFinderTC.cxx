@@ -3,6 +3,7 @@
 #include "AtEvent.h"            // for AtEvent
 #include "AtHit.h"              // for AtHit
 #include "AtPatternEvent.h"     // for AtPatternEvent
+#include "AtSpatialIndex.h"
 #include "AtTrack.h"            // for AtTrack
 #include "AtTrackTransformer.h" // for AtTrackTransformer
 
@@ -45,8 +46,11 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderTC::FindTracks(AtEvent &
       return nullptr;
    }
 
+   // kd-tree of the event shared by the dnn estimate and the smoothing
+   auto kdtree_xyz = build_kdtree(cloud_xyz);
+
    if (opt_params.needs_dnn()) {
-      double dnn = std::sqrt(first_quartile(cloud_xyz));
+      double dnn = std::sqrt(first_quartile(cloud_xyz, kdtree_xyz));
       if (opt_verbose > 0) {
          std::cout << "AtPATTERN::AtTrackFinderTC - [Info] computed dnn: " << dnn << std::endl;
       }
@@ -60,11 +64,13 @@ std::unique_ptr<AtPatternEvent> AtPATTERN::AtTrackFinderTC::FindTracks(AtEvent &
 
    // Step 1) smoothing by position averaging of neighboring points
    PointCloud cloud_xyz_smooth;
-   smoothen_cloud(cloud_xyz, cloud_xyz_smooth, opt_params.get_r());
+   smoothen_cloud(cloud_xyz, cloud_xyz_smooth, opt_params.get_r(), kdtree_xyz);
 
    // Step 2) finding triplets of approximately collinear points
    std::vector<triplet> triplets;
-   generate_triplets(cloud_xyz_smooth, triplets, opt_params.get_k(), opt_params.get_n(), opt_params.get_a());
+   auto kdtree_smooth = build_kdtree(cloud_xyz_smooth);
+   generate_triplets(cloud_xyz_smooth, kdtree_smooth, triplets, opt_params.get_k(), opt_params.get_n(),
+                     opt_params.get_a(), fNumThreads);
 
    // Step 3) single link hierarchical clustering of the triplets
    cluster_group cl_group;
@@ -42,6 +42,7 @@ struct hc_params {
 class AtTrackFinderTC : public AtPRA {
 private:
    hc_params inputParams{.s = 0.3, .k = 19, .n = 2, .m = 15, .r = 2, .a = 0.03, .t = 4.0};
+   size_t fNumThreads{1}; //! Number of threads used for triplet generation
 
 public:
    AtTrackFinderTC();
@@ -57,13 +58,14 @@ public:
    void SetAtriplet(float a) { inputParams.a = a; }
    void SetTcluster(float t) { inputParams.t = t; }
    void SetPadding(size_t padding) { inputParams._padding = padding; }
+   void SetNumThreads(size_t numThreads) { fNumThreads = numThreads; }
 
 private:
    void eventToClusters(AtEvent &event, PointCloud &cloud);
    std::unique_ptr<AtPatternEvent>
    clustersToTrack(PointCloud &cloud, const std::vector<cluster_t> &clusters, AtEvent &event);
 
-   ClassDefOverride(AtTrackFinderTC, 1);
+   ClassDefOverride(AtTrackFinderTC, 2);
 };
 
 } // namespace AtPATTERN
@@ -0,0 +1,58 @@
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtEvent.h"
+#include "AtHit.h"
+#include "AtSpatialIndex.h"
+
+#include <benchmark/benchmark.h>
+
+#include "cluster.h"
+#include "dnn.h"
+#include "option.h"
+#include "pointcloud.h"
+#include "triplet.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/// Hierarchical clustering of the triplets of the fission hit cloud (step 3 of AtTrackFinderTC)
+void BM_TriplclustComputeHC(benchmark::State &state)
+{
+   auto event = AtBenchmark::MakeHitCloud();
+
+   // Same parameters and steps as AtTrackFinderTC with its default parameters
+   Opt opt;
+   opt.set_parameters(0.3, 19, 2, 15, 2, 0.03, 4.0);
+
+   PointCloud cloud;
+   for (auto &hit : event.GetHits()) {
+      auto pos = hit->GetPosition();
+      cloud.emplace_back(pos.X(), pos.Y(), pos.Z());
+   }
+   auto kdtree = build_kdtree(cloud);
+   if (opt.needs_dnn())
+      opt.set_dnn(std::sqrt(first_quartile(cloud, kdtree)));
+
+   PointCloud smoothCloud;
+   smoothen_cloud(cloud, smoothCloud, opt.get_r(), kdtree);
+   std::vector<triplet> triplets;
+   auto smoothKdtree = build_kdtree(smoothCloud);
+   generate_triplets(smoothCloud, smoothKdtree, triplets, opt.get_k(), opt.get_n(), opt.get_a());
+
+   cluster_group clusters;
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      clusters.clear();
+      compute_hc(smoothCloud, clusters, triplets, opt.get_s(), opt.get_t(), opt.is_tauto(), opt.get_dmax(),
+                 opt.is_dmax(), opt.get_linkage(), 0);
+   }
+   counter.SetCounters();
+
+   state.counters["triplets"] = triplets.size();
+   state.counters["clusters"] = clusters.size();
+}
+BENCHMARK(BM_TriplclustComputeHC);
+
+} // namespace
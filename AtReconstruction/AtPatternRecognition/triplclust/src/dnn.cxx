@@ -17,42 +17,31 @@
 #include <numeric>
 #include <vector>
 
-#include "kdtree/kdtree.hpp"
+#include "AtSpatialIndex.h"
 
 //-------------------------------------------------------------------
 // Compute mean squared distances.
 // the distances is computed for every point in *cloud* to its *k*
-// nearest neighbours. The distances are returned in *msd*.
+// nearest neighbours using the kd-tree *kdtree* built from *cloud*.
+// The distances are returned in *msd*.
 //-------------------------------------------------------------------
-void compute_mean_square_distance(const PointCloud &cloud, std::vector<double> &msd, int k)
+void compute_mean_square_distance(const PointCloud &cloud, const AtTools::AtSpatialIndex &kdtree,
+                                  std::vector<double> &msd, int k)
 {
-   // compute mean square distances for every point to its k nearest neighbours
-   Kdtree::KdNodeVector nodes, result;
-   double sum;
-
-   // build kdtree
-   for (size_t i = 0; i < cloud.size(); ++i) {
-      nodes.push_back(cloud[i].as_vector());
-   }
-   Kdtree::KdTree kdtree(&nodes);
+   std::vector<AtTools::AtSpatialIndex::Neighbor> neighbors;
 
    k++; // k must be one higher because the first point found by the kdtree is
         // the point itself
 
+   msd.reserve(msd.size() + cloud.size());
    for (size_t i = 0; i < cloud.size(); ++i) {
-      // compute
-      std::vector<double> squared_distances;
-      kdtree.k_nearest_neighbors(cloud[i].as_vector(), k, &result, &squared_distances);
+      kdtree.KNearest({cloud[i].x, cloud[i].y, cloud[i].z}, k, neighbors);
 
-      squared_distances.erase(squared_distances.begin()); // The first value
-                                                          // must be deleted
-                                                          // because it is
-                                                          // the distance
-                                                          // with the point
-                                                          // itself
-
-      sum = std::accumulate(squared_distances.begin(), squared_distances.end(), 0.0);
-      msd.push_back(sum / squared_distances.size());
+      // The first value is skipped because it is the distance with the point itself
+      double sum = 0;
+      for (size_t j = 1; j < neighbors.size(); ++j)
+         sum += neighbors[j].dist2;
+      msd.push_back(sum / (neighbors.size() - 1));
    }
 }
 
@@ -61,9 +50,18 @@ void compute_mean_square_distance(const PointCloud &cloud, std::vector<double> &
 // in *cloud*
 //-------------------------------------------------------------------
 double first_quartile(const PointCloud &cloud)
+{
+   return first_quartile(cloud, build_kdtree(cloud));
+}
+
+//-------------------------------------------------------------------
+// Compute first quartile of the mean squared distance of all points
+// in *cloud* reusing the kd-tree *kdtree* built from *cloud*
+//-------------------------------------------------------------------
+double first_quartile(const PointCloud &cloud, const AtTools::AtSpatialIndex &kdtree)
 {
    std::vector<double> msd;
-   compute_mean_square_distance(cloud, msd, 1);
+   compute_mean_square_distance(cloud, kdtree, msd, 1);
    const double q1 = msd.size() / 4;
    std::nth_element(msd.begin(), msd.begin() + q1, msd.end());
    return msd[q1];
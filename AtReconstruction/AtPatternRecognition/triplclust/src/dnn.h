@@ -10,8 +10,13 @@
 #ifndef DNN_H
 #define DNN_H
 class PointCloud;
+namespace AtTools {
+class AtSpatialIndex;
+}
 
 // compute first quartile of the mean squared distance from the points
 double first_quartile(const PointCloud &cloud);
+// same as above, but with a kd-tree already built from *cloud*
+double first_quartile(const PointCloud &cloud, const AtTools::AtSpatialIndex &kdtree);
 
 #endif
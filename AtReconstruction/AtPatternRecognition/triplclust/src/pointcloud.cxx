@@ -20,7 +20,9 @@
 #include <stdexcept>
 #include <string>
 
-#include "kdtree/kdtree.hpp"
+#include "AtSpatialIndex.h"
+
+#include <Math/Point3D.h>
 
 // a single 3D point
 Point::Point(const std::vector<double> &point)
@@ -243,6 +245,19 @@ void load_csv_file(const char *fname, PointCloud &cloud, const char delimiter, s
    }
 }
 
+//-------------------------------------------------------------------
+// Builds the kd-tree of the points of *cloud*. The results of its
+// queries refer to the points by their index in *cloud*.
+//-------------------------------------------------------------------
+AtTools::AtSpatialIndex build_kdtree(const PointCloud &cloud)
+{
+   std::vector<ROOT::Math::XYZPoint> points;
+   points.reserve(cloud.size());
+   for (const auto &point : cloud)
+      points.emplace_back(point.x, point.y, point.z);
+   return AtTools::AtSpatialIndex(points);
+}
+
 //-------------------------------------------------------------------
 // Smoothing of the PointCloud *cloud*.
 // For every point the nearest neighbours in the radius *r* is searched
@@ -253,45 +268,42 @@ void load_csv_file(const char *fname, PointCloud &cloud, const char delimiter, s
 //-------------------------------------------------------------------
 void smoothen_cloud(const PointCloud &cloud, PointCloud &result_cloud, double r)
 {
-   Kdtree::KdNodeVector nodes;
-
    // If the smooth-radius is zero return the unsmoothed pointcloud
    if (r == 0) {
       result_cloud = cloud;
       return;
    }
 
-   // build kdtree
-   for (size_t i = 0; i < cloud.size(); ++i) {
-      nodes.push_back(cloud[i].as_vector());
-   }
-   Kdtree::KdTree kdtree(&nodes);
+   smoothen_cloud(cloud, result_cloud, r, build_kdtree(cloud));
+}
 
-   for (size_t i = 0; i < cloud.size(); ++i) {
-      size_t result_size;
-      Point new_point, point = cloud[i];
-      Kdtree::KdNodeVector result;
+//-------------------------------------------------------------------
+// Smoothing of the PointCloud *cloud* reusing the kd-tree *kdtree*
+// built from *cloud*. The neighbours are summed up in index order,
+// so the result does not depend on the tree layout.
+//-------------------------------------------------------------------
+void smoothen_cloud(const PointCloud &cloud, PointCloud &result_cloud, double r, const AtTools::AtSpatialIndex &kdtree)
+{
+   // If the smooth-radius is zero return the unsmoothed pointcloud
+   if (r == 0) {
+      result_cloud = cloud;
+      return;
+   }
 
-      kdtree.range_nearest_neighbors(point.as_vector(), r, &result);
-      result_size = result.size();
+   std::vector<size_t> result;
+   result_cloud.reserve(result_cloud.size() + cloud.size());
+   for (const auto &point : cloud) {
+      kdtree.Radius({point.x, point.y, point.z}, r, result, true);
 
       // compute the centroid with mean
-      std::vector<double> x_list;
-      std::vector<double> y_list;
-      std::vector<double> z_list;
-
-      for (Kdtree::KdNodeVector::iterator it = result.begin(); it != result.end(); ++it) {
-         x_list.push_back(it->point[0]);
-         y_list.push_back(it->point[1]);
-         z_list.push_back(it->point[2]);
+      double x = 0, y = 0, z = 0;
+      for (auto index : result) {
+         x += cloud[index].x;
+         y += cloud[index].y;
+         z += cloud[index].z;
       }
 
-      new_point.x = std::accumulate(x_list.begin(), x_list.end(), 0.0) / result_size;
-
-      new_point.y = std::accumulate(y_list.begin(), y_list.end(), 0.0) / result_size;
-
-      new_point.z = std::accumulate(z_list.begin(), z_list.end(), 0.0) / result_size;
-
-      result_cloud.push_back(new_point);
+      size_t result_size = result.size();
+      result_cloud.push_back(Point(x / result_size, y / result_size, z / result_size));
    }
 }
@@ -14,6 +14,11 @@
 #include <fstream>
 #include <set>
 #include <vector>
+
+namespace AtTools {
+class AtSpatialIndex;
+}
+
 // 3D point class.
 class Point {
 public:
@@ -67,9 +72,14 @@ public:
    PointCloud();
 };
 
+// kd-tree of the points of *cloud*
+AtTools::AtSpatialIndex build_kdtree(const PointCloud &cloud);
 // Load csv file.
 void load_csv_file(const char *fname, PointCloud &cloud, const char delimiter, size_t skip = 0);
 // Smoothing of the PointCloud *cloud*. The result is returned in *result_cloud*
 void smoothen_cloud(const PointCloud &cloud, PointCloud &result_cloud, double radius);
+// same as above, but with a kd-tree already built from *cloud*
+void smoothen_cloud(const PointCloud &cloud, PointCloud &result_cloud, double radius,
+                    const AtTools::AtSpatialIndex &kdtree);
 
 #endif
@@ -12,58 +12,48 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
+#include <thread>
 
-#include "kdtree/kdtree.hpp"
+#include "AtSpatialIndex.h"
 
+namespace {
 //-------------------------------------------------------------------
-// Generates triplets from the PointCloud *cloud*.
-// The resulting triplets are returned in *triplets*. *k* is the number
-// of neighbores from a point, which are used for triplet generation.
-// *n* is the number of the best triplet candidates to use. This can
-// be lesser than *n*. *a* is the max error (1-angle) for the triplet
-// to be a triplet candidate.
+// Generates the triplets with the center point b in the index range
+// [*begin*, *end*) of *cloud* and appends them to *triplets*. All
+// scratch space is local, so disjoint ranges can be processed
+// concurrently with the same *kdtree*.
 //-------------------------------------------------------------------
-void generate_triplets(const PointCloud &cloud, std::vector<triplet> &triplets, size_t k, size_t n, double a)
+void generate_triplets_range(const PointCloud &cloud, const AtTools::AtSpatialIndex &kdtree,
+                             std::vector<triplet> &triplets, size_t k, size_t n, double a, size_t begin, size_t end)
 {
-   std::vector<double> distances;
-   Kdtree::KdNodeVector nodes, result;
-   std::vector<size_t> indices; // save the indices so that they can be used
-                                // for the KdNode constructor
-   indices.resize(cloud.size(), 0);
-
-   // build kdtree
-   for (size_t i = 0; i < cloud.size(); ++i) {
-      indices[i] = i;
-      nodes.push_back(Kdtree::KdNode(cloud[i].as_vector(), (void *)&indices[i]));
-   }
-   Kdtree::KdTree kdtree(&nodes);
+   std::vector<AtTools::AtSpatialIndex::Neighbor> neighbors;
+   std::vector<triplet> triplet_candidates;
 
-   for (size_t point_index_b = 0; point_index_b < cloud.size(); ++point_index_b) {
-      distances.clear();
-      Point point_b = cloud[point_index_b];
+   for (size_t point_index_b = begin; point_index_b < end; ++point_index_b) {
+      const Point &point_b = cloud[point_index_b];
+      triplet_candidates.clear();
 
-      std::vector<triplet> triplet_candidates;
+      kdtree.KNearest({point_b.x, point_b.y, point_b.z}, k, neighbors);
 
-      kdtree.k_nearest_neighbors(cloud[point_index_b].as_vector(), k, &result, &distances);
-
-      for (size_t result_index_a = 1; result_index_a < result.size(); ++result_index_a) {
+      for (size_t result_index_a = 1; result_index_a < neighbors.size(); ++result_index_a) {
          // When the distance is 0, we have the same point as point_b
-         if (distances[result_index_a] == 0)
+         if (neighbors[result_index_a].dist2 == 0)
             continue;
-         Point point_a(result[result_index_a].point);
-         size_t point_index_a = *(size_t *)result[result_index_a].data;
+         size_t point_index_a = neighbors[result_index_a].index;
+         const Point &point_a = cloud[point_index_a];
 
          Point direction_ab = point_b - point_a;
          double ab_norm = direction_ab.norm();
          direction_ab = direction_ab / ab_norm;
 
-         for (size_t result_index_c = result_index_a + 1; result_index_c < result.size(); ++result_index_c) {
+         for (size_t result_index_c = result_index_a + 1; result_index_c < neighbors.size(); ++result_index_c) {
             // When the distance is 0, we have the same point as point_b
-            if (distances[result_index_c] == 0)
+            if (neighbors[result_index_c].dist2 == 0)
                continue;
-            Point point_c = Point(result[result_index_c].point);
-            size_t point_index_c = *(size_t *)result[result_index_c].data;
+            size_t point_index_c = neighbors[result_index_c].index;
+            const Point &point_c = cloud[point_index_c];
 
             Point direction_bc = point_c - point_b;
             double bc_norm = direction_bc.norm();
@@ -75,20 +65,13 @@ void generate_triplets(const PointCloud &cloud, std::vector<triplet> &triplets,
             const double error = 1.0f - angle;
 
             if (error <= a) {
-               // calculate center
-               Point center = (point_a + point_b + point_c) / 3.0f;
-
-               // calculate direction
-               Point direction = point_c - point_b;
-               direction = direction / direction.norm();
-
                triplet new_triplet;
 
                new_triplet.point_index_a = point_index_a;
                new_triplet.point_index_b = point_index_b;
                new_triplet.point_index_c = point_index_c;
-               new_triplet.center = center;
-               new_triplet.direction = direction;
+               new_triplet.center = (point_a + point_b + point_c) / 3.0f;
+               new_triplet.direction = direction_bc;
                new_triplet.error = error;
 
                triplet_candidates.push_back(new_triplet);
@@ -96,14 +79,60 @@ void generate_triplets(const PointCloud &cloud, std::vector<triplet> &triplets,
          }
       }
 
-      // order triplet candidates
-      std::sort(triplet_candidates.begin(), triplet_candidates.end());
+      // use the n best candidates (only these have to be ordered)
+      auto n_best = triplet_candidates.begin() + std::min(n, triplet_candidates.size());
+      std::partial_sort(triplet_candidates.begin(), n_best, triplet_candidates.end());
+      triplets.insert(triplets.end(), triplet_candidates.begin(), n_best);
+   }
+}
+} // namespace
 
-      // use the n best candidates
-      for (size_t i = 0; i < std::min(n, triplet_candidates.size()); ++i) {
-         triplets.push_back(triplet_candidates[i]);
-      }
+//-------------------------------------------------------------------
+// Generates triplets from the PointCloud *cloud*.
+// The resulting triplets are returned in *triplets*. *k* is the number
+// of neighbores from a point, which are used for triplet generation.
+// *n* is the number of the best triplet candidates to use. This can
+// be lesser than *n*. *a* is the max error (1-angle) for the triplet
+// to be a triplet candidate.
+//-------------------------------------------------------------------
+void generate_triplets(const PointCloud &cloud, std::vector<triplet> &triplets, size_t k, size_t n, double a)
+{
+   generate_triplets(cloud, build_kdtree(cloud), triplets, k, n, a);
+}
+
+//-------------------------------------------------------------------
+// Generates triplets from the PointCloud *cloud* using the kd-tree
+// *kdtree* built from *cloud*. The points are split into contiguous
+// ranges processed by *n_threads* threads into separate buffers that
+// are concatenated in order afterwards, so the result does not depend
+// on the number of threads.
+//-------------------------------------------------------------------
+void generate_triplets(const PointCloud &cloud, const AtTools::AtSpatialIndex &kdtree, std::vector<triplet> &triplets,
+                       size_t k, size_t n, double a, size_t n_threads)
+{
+   if (n_threads <= 1 || cloud.size() < 2 * n_threads) {
+      generate_triplets_range(cloud, kdtree, triplets, k, n, a, 0, cloud.size());
+      return;
+   }
+
+   std::vector<std::vector<triplet>> buffers(n_threads);
+   std::vector<std::thread> threads;
+   size_t chunk = (cloud.size() + n_threads - 1) / n_threads;
+   for (size_t i = 0; i < n_threads; ++i) {
+      size_t begin = std::min(i * chunk, cloud.size());
+      size_t end = std::min(begin + chunk, cloud.size());
+      threads.emplace_back(generate_triplets_range, std::cref(cloud), std::cref(kdtree), std::ref(buffers[i]), k, n, a,
+                           begin, end);
    }
+   for (auto &th : threads)
+      th.join();
+
+   size_t total = triplets.size();
+   for (const auto &buffer : buffers)
+      total += buffer.size();
+   triplets.reserve(total);
+   for (const auto &buffer : buffers)
+      triplets.insert(triplets.end(), buffer.begin(), buffer.end());
 }
 
 // initialization of scale factor for triplet dissimilarity
@@ -16,6 +16,10 @@
 #include <cstddef>
 #include <vector>
 
+namespace AtTools {
+class AtSpatialIndex;
+}
+
 // triplet of three points
 struct triplet {
    size_t point_index_a;
@@ -40,4 +44,8 @@ public:
 
 // generates triplets from PointCloud
 void generate_triplets(const PointCloud &cloud, std::vector<triplet> &triplets, size_t k, size_t n, double a);
+// same as above, but with a kd-tree already built from *cloud* and
+// the points distributed over *n_threads* threads
+void generate_triplets(const PointCloud &cloud, const AtTools::AtSpatialIndex &kdtree, std::vector<triplet> &triplets,
+                       size_t k, size_t n, double a, size_t n_threads = 1);
 #endif
@@ -0,0 +1,39 @@
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtEvent.h"
+#include "AtPSA.h"
+#include "AtPSAFull.h"
+#include "AtPSAMax.h"
+#include "AtPSASpectrum.h"
+#include "AtRawEvent.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+/// Run the PSA on the fission raw event
+template <typename PSA>
+void BM_PSAAnalyze(benchmark::State &state)
+{
+   AtBenchmark::GetDigiPar(); // The PSA gets the parameters from the FairRun
+   auto rawEvent = AtBenchmark::MakeFissionRawEvent();
+   PSA psa;
+   psa.SetThreshold(45);
+   psa.Init();
+
+   AtEvent event;
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      event.Clear();
+      psa.Analyze(&rawEvent, &event);
+   }
+   counter.SetCounters();
+
+   state.counters["pads"] = rawEvent.GetNumPads();
+   state.counters["hits"] = event.GetNumHits();
+}
+BENCHMARK_TEMPLATE(BM_PSAAnalyze, AtPSAMax);
+BENCHMARK_TEMPLATE(BM_PSAAnalyze, AtPSAFull);
+BENCHMARK_TEMPLATE(BM_PSAAnalyze, AtPSASpectrum);
+
+} // namespace
@@ -108,6 +108,10 @@ const AtPadFFT &AtPSADeconv::GetResponseFFT(int padNum)
  */
 const AtPadFFT &AtPSADeconv::GetResponseFilter(int padNum)
 {
+   auto cached = fFilterCache.find(padNum);
+   if (cached != fFilterCache.end())
+      return *cached->second;
+
    auto &pad = GetResponse(padNum);
    auto &fft = GetResponseFFT(padNum);
    auto filter = dynamic_cast<AtPadFFT *>(pad.GetAugment("filter"));
@@ -117,6 +121,7 @@ const AtPadFFT &AtPSADeconv::GetResponseFilter(int padNum)
       filter = dynamic_cast<AtPadFFT *>(pad.AddAugment("filter", std::make_unique<AtPadFFT>()));
       updateFilter(fft, filter);
    }
+   fFilterCache[padNum] = filter;
    return *filter;
 }
 void AtPSADeconv::updateFilter(const AtPadFFT &fft, AtPadFFT *filter)
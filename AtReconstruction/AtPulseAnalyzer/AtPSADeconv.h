@@ -11,6 +11,7 @@
 #include <functional>
 #include <memory> // for unique_ptr, make_unique
 #include <string> // for string
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -55,6 +56,8 @@ protected:
     * fEventResponse if the pad does not already exist within that event.
     */
    ResponseFunc fResponse{nullptr};
+   /// Filter augment of each pad in fEventResponse that has been used, so analyzing a pad does not search the event
+   std::unordered_map<int, const AtPadFFT *> fFilterCache;
 
    std::unique_ptr<TVirtualFFT> fFFT{nullptr};
    std::unique_ptr<TVirtualFFT> fFFTbackward{nullptr};
@@ -84,7 +87,11 @@ public:
     * Copy an AtRawEvent to use as the response function. If the pad number requested does
     * not exist in the AtRawEvent it will use the callable object stored in fResponse.
     */
-   void SetResponse(AtRawEvent response) { fEventResponse = std::move(response); }
+   void SetResponse(AtRawEvent response)
+   {
+      fEventResponse = std::move(response);
+      fFilterCache.clear();
+   }
    /**
     * Response function to use if the AtRawEvent representation of the response function does not
     * contain the pad we are looking for. When this is used to get the response function, it is cached
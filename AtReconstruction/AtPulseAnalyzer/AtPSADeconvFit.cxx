@@ -22,13 +22,127 @@
 #include <Fit/FitConfig.h>   // for FitConfig
 #include <Fit/Fitter.h>
 #include <algorithm>  // for max_element
+#include <array>      // for array
 #include <cmath>      // for sqrt
 #include <functional> // for hash
 #include <iterator>   // for begin, distance, end
+#include <limits>     // for numeric_limits
 #include <memory>     // for allocator, unique_ptr
 #include <thread>
+
 thread_local std::unique_ptr<TH1F> AtPSADeconvFit::fHist = nullptr;
 
+namespace {
+using Vec3 = std::array<double, 3>;
+using Mat3 = std::array<Vec3, 3>;
+
+/// Solve a*x = b for a symmetric positive definite matrix a (Cholesky decomposition)
+bool SolveSym3(const Mat3 &a, const Vec3 &b, Vec3 &x)
+{
+   if (!(a[0][0] > 0))
+      return false;
+   double l00 = std::sqrt(a[0][0]);
+   double l10 = a[1][0] / l00;
+   double l20 = a[2][0] / l00;
+   double d1 = a[1][1] - l10 * l10;
+   if (!(d1 > 0))
+      return false;
+   double l11 = std::sqrt(d1);
+   double l21 = (a[2][1] - l20 * l10) / l11;
+   double d2 = a[2][2] - l20 * l20 - l21 * l21;
+   if (!(d2 > 0))
+      return false;
+   double l22 = std::sqrt(d2);
+
+   double y0 = b[0] / l00;
+   double y1 = (b[1] - l10 * y0) / l11;
+   double y2 = (b[2] - l20 * y0 - l21 * y1) / l22;
+   x[2] = y2 / l22;
+   x[1] = (y1 - l21 * x[2]) / l11;
+   x[0] = (y0 - l10 * x[1] - l20 * x[2]) / l00;
+   return true;
+}
+
+/**
+ * Chi2 of the Gaussian par = (amp, mean, sigma) to the samples [first, last] of charge, where sample i is at
+ * x = i + 0.5 and has an uncertainty sqrt(|q_i|). Samples with no charge are skipped. If hess and grad are not
+ * null, they are filled with J^T W J and J^T W r used by the Gauss-Newton step.
+ */
+double Chi2(const AtPad::trace &charge, int first, int last, const Vec3 &par, Mat3 *hess, Vec3 *grad)
+{
+   if (par[2] == 0)
+      return std::numeric_limits<double>::infinity();
+
+   if (hess) {
+      *hess = {};
+      *grad = {};
+   }
+
+   double invSig2 = 1. / (par[2] * par[2]);
+   double chi2 = 0;
+   for (int i = first; i <= last; ++i) {
+      if (charge[i] == 0)
+         continue;
+      double w = 1. / std::fabs(charge[i]);
+      double d = i + 0.5 - par[1];
+      double g = std::exp(-0.5 * d * d * invSig2);
+      double r = charge[i] - par[0] * g;
+      chi2 += w * r * r;
+
+      if (hess) {
+         Vec3 jac = {g, par[0] * g * d * invSig2, par[0] * g * d * d * invSig2 / par[2]};
+         for (int j = 0; j < 3; ++j) {
+            (*grad)[j] += w * jac[j] * r;
+            for (int k = 0; k <= j; ++k)
+               (*hess)[j][k] += w * jac[j] * jac[k];
+         }
+      }
+   }
+
+   if (hess)
+      for (int j = 0; j < 3; ++j)
+         for (int k = j + 1; k < 3; ++k)
+            (*hess)[j][k] = (*hess)[k][j];
+   return chi2;
+}
+
+/**
+ * Closed form estimate of the Gaussian from a parabola fit to the log of the positive samples in [first, last],
+ * weighted by q^2 (Caruana's method with the weighting of Guo). Returns false if the samples do not describe
+ * a peak.
+ */
+bool LogParabolaEstimate(const AtPad::trace &charge, int first, int last, Vec3 &par)
+{
+   // Fit ln(q) = a + b*u + c*u^2 with u = x - par[1] to keep the system well conditioned
+   Mat3 norm{};
+   Vec3 rhs{};
+   for (int i = first; i <= last; ++i) {
+      if (charge[i] <= 0)
+         continue;
+      double w = charge[i] * charge[i];
+      double u = i + 0.5 - par[1];
+      Vec3 basis = {1, u, u * u};
+      for (int j = 0; j < 3; ++j) {
+         rhs[j] += w * basis[j] * std::log(charge[i]);
+         for (int k = 0; k < 3; ++k)
+            norm[j][k] += w * basis[j] * basis[k];
+      }
+   }
+
+   Vec3 coef;
+   if (!SolveSym3(norm, rhs, coef) || !(coef[2] < 0))
+      return false;
+
+   Vec3 est = {std::exp(coef[0] - coef[1] * coef[1] / (4 * coef[2])), par[1] - coef[1] / (2 * coef[2]),
+               std::sqrt(-1 / (2 * coef[2]))};
+   if (!std::isfinite(est[0]) || est[1] < first || est[1] > last + 1)
+      return false;
+
+   par = est;
+   return true;
+}
+} // namespace
+
 void AtPSADeconvFit::Init()
 {
    AtPSADeconv::Init();
@@ -59,41 +173,123 @@ AtPSADeconv::HitData AtPSADeconvFit::getZandQ(const AtPad::trace &charge)
       return {};
    }
 
-   // Create a historgram to fit and fit to range mean +- 4 sigma.
-   auto id = std::hash<std::thread::id>{}(std::this_thread::get_id());
-   if (fHist)
-      ContainerManip::SetHistFromData(*fHist, charge);
-   else
-      fHist = ContainerManip::CreateHistFromData<TH1F>(TString::Format("%lu", id).Data(), charge);
-
-   // Add an addition +-2 for when we are close to the pad plane and diffusion is small
+   // Fit to range mean +- 3 sigma. Add an addition +-2 for when we are close to the pad plane and diffusion is small
    auto fitRange = 3 * sigTB + 2;
    if (fitRange < 3)
       fitRange = 3;
 
-   TF1 gauss(TString::Format("fitGauss%lu", id), "gaus(0)", zTB - fitRange, zTB + fitRange, TF1::EAddToList::kNo);
-   gauss.SetParameter(0, *maxTB); // Set initial height of gaussian
-   gauss.SetParameter(1, zTB);    // Set initial position of gaussian
-   gauss.SetParameter(2, sigTB);  // Set initial sigma of gaussian
-
-   // Fit without graphics and saving everything in the result ptr
-   // auto resultPtr = hist->Fit(&gauss, "SQNR");
-   auto result = FitHistorgramParallel(*fHist, gauss);
-   if (!result.IsValid()) {
+   GaussPar par{*maxTB, zTB, sigTB};
+   bool goodFit = fUseMinuit ? FitMinuit(charge, zTB - fitRange, zTB + fitRange, par)
+                             : FitGaussian(charge, zTB - fitRange, zTB + fitRange, par);
+   if (!goodFit) {
       LOG(info) << "Fit did not converge using initial conditions:"
                 << " mean: " << zTB << " sig:" << sigTB << " max:" << *maxTB;
       return {};
    }
 
-   auto amp = result.GetParams()[0];
-   auto z = result.GetParams()[1];
-   auto sig = result.GetParams()[2];
-
-   auto Q = amp * sig * std::sqrt(2 * TMath::Pi());
+   auto Q = par.amp * par.sigma * std::sqrt(2 * TMath::Pi());
    LOG(debug) << "Initial: " << *maxTB << " " << zTB << " " << sigTB;
-   LOG(debug) << "Fit: " << amp << " " << z << " " << sig;
+   LOG(debug) << "Fit: " << par.amp << " " << par.mean << " " << par.sigma;
+
+   return {{par.mean, par.sigma * par.sigma, Q, 0}};
+}
+
+/**
+ * @brief Least squares fit of a Gaussian to the charge in [xMin, xMax].
+ *
+ * Minimizes the same chi2 as the Minuit2 fit of the charge histogram: sample i is the bin centered at
+ * x = i + 0.5 with an uncertainty sqrt(|q_i|), and samples without charge are ignored. The initial estimate
+ * is refined with a closed form log-parabola fit when the samples describe a peak, then minimized with
+ * Levenberg-Marquardt steps on the 3x3 normal equations. Nothing is allocated, so it is safe to call from
+ * many threads.
+ *
+ * @param[in,out] par Initial guess of the parameters, set to the fit result on success.
+ * @return If the fit converged. False if no step could be taken from the initial guess.
+ */
+bool AtPSADeconvFit::FitGaussian(const AtPad::trace &charge, double xMin, double xMax, GaussPar &par)
+{
+   constexpr int maxIterations = 100;
+   constexpr double tolerance = 1e-10;
+
+   // Samples whose bin center is in the range
+   int first = std::max<int>(std::ceil(xMin - 0.5), 0);
+   int last = std::min<int>(std::floor(xMax - 0.5), charge.size() - 1);
+   if (first > last || std::count_if(charge.begin() + first, charge.begin() + last + 1,
+                                     [](double q) { return q != 0; }) < 3)
+      return false;
+
+   Vec3 p = {par.amp, par.mean, par.sigma};
+   LogParabolaEstimate(charge, first, last, p);
+
+   Mat3 hess;
+   Vec3 grad;
+   double chi2 = Chi2(charge, first, last, p, &hess, &grad);
+   if (!std::isfinite(chi2))
+      return false;
+
+   double lambda = 1e-3;
+   bool converged = false;
+   bool accepted = false; // If a step was taken (otherwise p is the unfitted initial guess)
+   for (int iter = 0; iter < maxIterations && !converged; ++iter) {
+      Mat3 a = hess;
+      for (int j = 0; j < 3; ++j)
+         a[j][j] *= 1 + lambda;
+
+      Vec3 step;
+      Vec3 trial = p;
+      bool solved = SolveSym3(a, grad, step);
+      if (solved)
+         for (int j = 0; j < 3; ++j)
+            trial[j] += step[j];
+
+      Mat3 trialHess;
+      Vec3 trialGrad;
+      double trialChi2 = solved ? Chi2(charge, first, last, trial, &trialHess, &trialGrad) : chi2;
+      if (solved && trialChi2 <= chi2) {
+         // A null step means p is already at the minimum
+         converged = chi2 - trialChi2 <= tolerance * chi2;
+         accepted = true;
+         p = trial;
+         chi2 = trialChi2;
+         hess = trialHess;
+         grad = trialGrad;
+         lambda = std::max(lambda / 10, 1e-12);
+      } else {
+         // No step along the gradient reduces the chi2 anymore, we are at the minimum
+         lambda *= 10;
+         converged = lambda > 1e10;
+      }
+   }
+
+   if (!converged || !accepted || !std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2]))
+      return false;
+
+   par = {p[0], p[1], std::fabs(p[2])};
+   return true;
+}
+
+bool AtPSADeconvFit::FitMinuit(const AtPad::trace &charge, double xMin, double xMax, GaussPar &par)
+{
+   // Create a historgram to fit
+   auto id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+   if (fHist)
+      ContainerManip::SetHistFromData(*fHist, charge);
+   else
+      fHist = ContainerManip::CreateHistFromData<TH1F>(TString::Format("%lu", id).Data(), charge);
+
+   TF1 gauss(TString::Format("fitGauss%lu", id), "gaus(0)", xMin, xMax, TF1::EAddToList::kNo);
+   gauss.SetParameter(0, par.amp);   // Set initial height of gaussian
+   gauss.SetParameter(1, par.mean);  // Set initial position of gaussian
+   gauss.SetParameter(2, par.sigma); // Set initial sigma of gaussian
+
+   // Fit without graphics and saving everything in the result ptr
+   // auto resultPtr = hist->Fit(&gauss, "SQNR");
+   auto result = FitHistorgramParallel(*fHist, gauss);
+   if (!result.IsValid())
+      return false;
 
-   return {{z, sig * sig, Q, 0}};
+   par = {result.GetParams()[0], result.GetParams()[1], result.GetParams()[2]};
+   return true;
 }
 
 const ROOT::Fit::FitResult AtPSADeconvFit::FitHistorgramParallel(TH1F &hist, TF1 &func)
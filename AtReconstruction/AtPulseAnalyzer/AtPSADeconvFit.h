@@ -10,15 +10,38 @@ class AtPSA;
 
 class TH1F;
 class TF1;
+
+/**
+ * @brief Deconvolution PSA fitting the reconstructed charge of each pad with a Gaussian.
+ *
+ * By default the Gaussian is fit with FitGaussian, a least squares estimator working directly on
+ * the charge array. The original fit of a TH1F using Minuit2 can be selected with SetUseMinuit.
+ */
 class AtPSADeconvFit : public AtPSADeconv {
+public:
+   /// Parameters of the Gaussian amp * exp(-(x-mean)^2 / (2 sigma^2))
+   struct GaussPar {
+      double amp;
+      double mean;
+      double sigma;
+   };
+
 protected:
-   double fDiffLong; //< Longitudinal diffusion coefficient
+   double fDiffLong;       //< Longitudinal diffusion coefficient
+   bool fUseMinuit{false}; //< Fit using Minuit2 instead of FitGaussian
    static thread_local std::unique_ptr<TH1F> fHist;
 
 public:
    virtual void Init() override;
    virtual std::unique_ptr<AtPSA> Clone() override { return std::make_unique<AtPSADeconvFit>(*this); }
 
+   /// Fit using Minuit2 on a TH1F like previous versions (much slower, kept for validation)
+   void SetUseMinuit(bool useMinuit) { fUseMinuit = useMinuit; }
+
+   static bool FitGaussian(const AtPad::trace &charge, double xMin, double xMax, GaussPar &par);
+   /// Fit of the charge histogram in [xMin, xMax] using Minuit2 (see SetUseMinuit)
+   bool FitMinuit(const AtPad::trace &charge, double xMin, double xMax, GaussPar &par);
+
 protected:
    HitData getZandQ(const AtPad::trace &charge) override;
 
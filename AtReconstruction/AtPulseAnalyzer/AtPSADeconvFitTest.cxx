@@ -0,0 +1,68 @@
+#include "AtPSADeconvFit.h"
+
+#include "AtPad.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+/// Gaussian charge sampled at the bin centers i + 0.5, with noise of the size of the uncertainty of the fit
+AtPad::trace MakeCharge(const AtPSADeconvFit::GaussPar &par, std::mt19937 &rng, bool noise)
+{
+   AtPad::trace charge{};
+   for (int i = 0; i < static_cast<int>(charge.size()); ++i) {
+      double x = i + 0.5;
+      double q = par.amp * std::exp(-0.5 * (x - par.mean) * (x - par.mean) / (par.sigma * par.sigma));
+      if (q < 0.5)
+         continue;
+      if (noise)
+         q += std::normal_distribution<double>(0, std::sqrt(std::max(q, 1.)))(rng);
+      charge[i] = q;
+   }
+   return charge;
+}
+} // namespace
+
+TEST(AtPSADeconvFitTest, FitGaussianMatchesMinuit)
+{
+   AtPSADeconvFit psa;
+   std::mt19937 rng(17);
+   std::uniform_real_distribution<double> uni(0, 1);
+
+   for (int i = 0; i < 50; ++i) {
+      AtPSADeconvFit::GaussPar truth{50 + 2000 * uni(rng), 50 + 400 * uni(rng), 1 + 7 * uni(rng)};
+      auto charge = MakeCharge(truth, rng, i % 2 == 1);
+
+      // Initial guess like AtPSADeconvFit::getZandQ: the max of the charge and a sigma off by 50%
+      double range = 3 * truth.sigma + 2;
+      AtPSADeconvFit::GaussPar fast{truth.amp * 1.1, std::floor(truth.mean), truth.sigma * 1.5};
+      AtPSADeconvFit::GaussPar minuit = fast;
+      ASSERT_TRUE(AtPSADeconvFit::FitGaussian(charge, fast.mean - range, fast.mean + range, fast));
+      ASSERT_TRUE(psa.FitMinuit(charge, minuit.mean - range, minuit.mean + range, minuit));
+
+      // Both minimize the same chi2
+      EXPECT_NEAR(fast.amp, minuit.amp, 1e-2 * minuit.amp) << "Gaussian " << i;
+      EXPECT_NEAR(fast.mean, minuit.mean, 1e-2) << "Gaussian " << i;
+      EXPECT_NEAR(fast.sigma, std::fabs(minuit.sigma), 1e-2 * std::fabs(minuit.sigma)) << "Gaussian " << i;
+   }
+}
+
+TEST(AtPSADeconvFitTest, FitGaussianWithoutStep)
+{
+   // No charge to constrain the mean and sigma of a null Gaussian, so no step can be taken
+   AtPad::trace charge{};
+   std::fill(charge.begin() + 100, charge.begin() + 110, -5);
+   AtPSADeconvFit::GaussPar par{0, 105, 2};
+   EXPECT_FALSE(AtPSADeconvFit::FitGaussian(charge, 95, 115, par));
+   EXPECT_EQ(par.mean, 105);
+
+   // Too few samples with charge
+   charge = {};
+   charge[200] = 10;
+   charge[201] = 10;
+   par = {10, 200, 2};
+   EXPECT_FALSE(AtPSADeconvFit::FitGaussian(charge, 190, 210, par));
+}
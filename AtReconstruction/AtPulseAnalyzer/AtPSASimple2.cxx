@@ -12,7 +12,6 @@
 #include <Math/Point3D.h>    // for PositionVector3D
 #include <Math/Point3Dfwd.h> // for XYZPoint
 #include <Math/Rotation3D.h>
-#include <TSpectrum.h>
 
 #include <algorithm>
 #include <array> // for array
@@ -95,17 +94,14 @@ void AtPSASimple2::Analyze(AtRawEvent *rawEvent, AtEvent *event)
          bg[iTb] = adc[iTb];
       }
 
-      auto PeakFinder = std::make_unique<TSpectrum>();
       if (fIsPeakFinder)
-         numPeaks = PeakFinder->SearchHighRes(floatADC.data(), dummy.data(), fNumTbs, 4.7, 5, fBackGroundSuppression, 3,
-                                              kTRUE, 3);
+         numPeaks =
+            fSpectrum.SearchHighRes(floatADC.data(), dummy.data(), fNumTbs, 4.7, 5, fBackGroundSuppression, 3, kTRUE, 3);
       if (fIsMaxFinder)
          numPeaks = 1;
 
-      auto BGInter = std::make_unique<TSpectrum>();
       if (fBackGroundInterp) {
-         BGInter->Background(bg.data(), fNumTbs, 6, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, kTRUE,
-                             TSpectrum::kBackSmoothing7, kTRUE);
+         fSpectrum.Background(bg.data(), fNumTbs, 6, AtTools::AtTraceSpectrum::kDecreasingWindow, kTRUE, 7, kTRUE);
          for (Int_t iTb = 1; iTb < fNumTbs; iTb++) {
             floatADC[iTb] = floatADC[iTb] - bg[iTb];
             if (floatADC[iTb] < 0)
@@ -126,7 +122,7 @@ void AtPSASimple2::Analyze(AtRawEvent *rawEvent, AtEvent *event)
             Int_t maxTime = 0;
 
             if (fIsPeakFinder) {
-               maxAdcIdx = (Int_t)(ceil((PeakFinder->GetPositionX())[iPeak]));
+               maxAdcIdx = (Int_t)(ceil((fSpectrum.GetPositionX())[iPeak]));
                if (maxAdcIdx < 3 || maxAdcIdx > 509)
                   continue; // excluding the first and last 3 tb
             }
@@ -3,6 +3,7 @@
 
 #include "AtCalibration.h" // for AtCalibration
 #include "AtPSA.h"
+#include "AtTraceSpectrum.h"
 
 #include <Rtypes.h>  // for Bool_t, THashConsistencyHolder, ClassDefOverride
 #include <TString.h> // for TString
@@ -27,6 +28,8 @@ private:
    Bool_t fIsBaseCorr{false};
    Bool_t fIsTimeCorr{false};
 
+   AtTools::AtTraceSpectrum fSpectrum; //!
+
 public:
    void Analyze(AtRawEvent *rawEvent, AtEvent *event) override;
    HitVector AnalyzePad(AtPad *pad) override { return {}; };
@@ -41,7 +44,7 @@ public:
    void SetBaseCorrection(Bool_t value);
    void SetTimeCorrection(Bool_t value);
 
-   ClassDefOverride(AtPSASimple2, 2)
+   ClassDefOverride(AtPSASimple2, 3)
 };
 
 #endif
@@ -7,7 +7,6 @@
 
 #include <Math/Point3D.h>    // for PositionVector3D
 #include <Math/Point3Dfwd.h> // for XYZPoint
-#include <TSpectrum.h>
 
 #include <array> // for array
 #include <cmath>
@@ -41,14 +40,11 @@ AtPSASpectrum::HitVector AtPSASpectrum::AnalyzePad(AtPad *pad)
    auto adc = pad->GetADC();
    std::array<double, 512> floatADC = adc;
    std::array<double, 512> dummy{};
-   floatADC.fill(0);
-   dummy.fill(0);
 
    double traceIntegral = std::accumulate(adc.begin(), adc.end(), 0.0);
 
-   auto PeakFinder = std::make_unique<TSpectrum>();
    auto numPeaks =
-      PeakFinder->SearchHighRes(floatADC.data(), dummy.data(), fNumTbs, 4.7, 5, fBackGroundSuppression, 3, kTRUE, 3);
+      fSpectrum.SearchHighRes(floatADC.data(), dummy.data(), fNumTbs, 4.7, 5, fBackGroundSuppression, 3, kTRUE, 3);
 
    if (fBackGroundInterp) {
       subtractBackground(floatADC);
@@ -57,7 +53,7 @@ AtPSASpectrum::HitVector AtPSASpectrum::AnalyzePad(AtPad *pad)
    // Create a hit for each peak
    for (Int_t iPeak = 0; iPeak < numPeaks; iPeak++) {
 
-      auto maxAdcIdx = (Int_t)(ceil((PeakFinder->GetPositionX())[iPeak]));
+      auto maxAdcIdx = (Int_t)(ceil((fSpectrum.GetPositionX())[iPeak]));
       if (maxAdcIdx < 3 || maxAdcIdx > 509)
          continue; // excluding the first and last 3 tb
 
@@ -93,14 +89,13 @@ AtPSASpectrum::HitVector AtPSASpectrum::AnalyzePad(AtPad *pad)
 }
 
 /**
- * Perform a background subtraction using TSpectrum
+ * Perform a background subtraction (as TSpectrum::Background with a decreasing window, second order clipping and
+ * smoothing over 7 buckets)
  */
 void AtPSASpectrum::subtractBackground(std::array<Double_t, 512> &adc)
 {
    auto bg = adc;
-   auto BGInter = std::make_unique<TSpectrum>();
-   BGInter->Background(bg.data(), fNumTbs, 6, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, kTRUE,
-                       TSpectrum::kBackSmoothing7, kTRUE);
+   fSpectrum.Background(bg.data(), fNumTbs, 6, AtTools::AtTraceSpectrum::kDecreasingWindow, kTRUE, 7, kTRUE);
 
    for (Int_t iTb = 1; iTb < fNumTbs; iTb++) {
       adc[iTb] = adc[iTb] - bg[iTb];
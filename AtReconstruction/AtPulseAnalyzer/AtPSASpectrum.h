@@ -2,6 +2,7 @@
 #define AtPSASPECTRUM_H
 
 #include "AtPSA.h"
+#include "AtTraceSpectrum.h"
 
 #include <Rtypes.h> // for Bool_t, THashConsistencyHolder, ClassDefOverride
 
@@ -15,17 +16,21 @@ class TClass;
 class TMemberInspector;
 
 /**
- * @brief PSA method using TSpectrum.
+ * @brief PSA method using the peak search of TSpectrum.
  *
- * Can use TSpectrum both to identify peaks, and to do a background subtraction
+ * Can use the peak search (TSpectrum::SearchHighRes) both to identify peaks, and to do a background subtraction
+ * (TSpectrum::Background). Both are done by an AtTools::AtTraceSpectrum owned by the PSA, so no memory is allocated
+ * per pad and each clone can run on its own thread.
  */
 class AtPSASpectrum : public AtPSA {
 
 private:
-   Bool_t fBackGroundSuppression{false}; //< Flag to pass to TSpectrum
+   Bool_t fBackGroundSuppression{false}; //< Flag to pass to the peak search
    Bool_t fBackGroundInterp{false};
    Bool_t fIsTimeCorr{false};
 
+   AtTools::AtTraceSpectrum fSpectrum; //! Peak search and background, with its working space
+
 public:
    HitVector AnalyzePad(AtPad *pad) override;
    std::unique_ptr<AtPSA> Clone() override { return std::make_unique<AtPSASpectrum>(*this); }
@@ -39,7 +44,7 @@ protected:
    double calcTbCorrection(const std::array<Double_t, 512> &adc, int idxPeak);
    std::unique_ptr<AtHit> getHit(int idx);
 
-   ClassDefOverride(AtPSASpectrum, 1)
+   ClassDefOverride(AtPSASpectrum, 2)
 };
 
 #endif
@@ -53,6 +53,7 @@ InitStatus AtSpaceChargeCorrectionTask::Init()
 
    auto fPar = (AtDigiPar *)db->getContainer("AtDigiPar"); // NOLINT
    fSCModel->LoadParameters(fPar);
+   fSCModel->BakeField();
    return kSUCCESS;
 }
 
@@ -68,13 +69,15 @@ void AtSpaceChargeCorrectionTask::Exec(Option_t *opt)
    auto inputEvent = dynamic_cast<AtEvent *>(fInputEventArray->At(0));
    auto outputEvent = dynamic_cast<AtEvent *>(fOutputEventArray.ConstructedAt(0));
    *outputEvent = *inputEvent;
-   outputEvent->ClearHits();
-
-   for (auto &inHit : inputEvent->GetHits()) {
-      XYZPoint newPosition;
-      newPosition = fSCModel->CorrectSpaceCharge(inHit->GetPosition());
-      auto &newHit = outputEvent->AddHit(inHit->Clone());
-      newHit.SetPosition(newPosition);
-      LOG(debug) << inHit->GetPosition() << " " << outputEvent->GetHits().back()->GetPosition();
-   }
+
+   // Correct the positions of the copied hits in place
+   const auto &hits = outputEvent->GetHits();
+   fPositions.clear();
+   for (const auto &hit : hits)
+      fPositions.push_back(hit->GetPosition());
+
+   fSCModel->CorrectPositions(fPositions);
+
+   for (size_t i = 0; i < hits.size(); ++i)
+      hits[i]->SetPosition(fPositions[i]);
 }
@@ -10,11 +10,13 @@
 
 #include <FairTask.h>
 
+#include <Math/Point3D.h>
 #include <Rtypes.h>
 #include <TClonesArray.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class TBuffer;
 class TClass;
@@ -33,6 +35,8 @@ private:
    TClonesArray fOutputEventArray;
    SCModelPtr fSCModel;
 
+   std::vector<ROOT::Math::XYZPoint> fPositions; //! Hit positions of the event being corrected
+
 public:
    AtSpaceChargeCorrectionTask(SCModelPtr &&model);
    virtual ~AtSpaceChargeCorrectionTask() = default;
@@ -46,7 +50,7 @@ public:
    virtual void Exec(Option_t *opt) override;
    // virtual void FinishEvent() override;
 
-   ClassDefOverride(AtSpaceChargeCorrectionTask, 1);
+   ClassDefOverride(AtSpaceChargeCorrectionTask, 2);
 };
 
 #endif //_ATSPACECHARGETASK_H_
@@ -6,11 +6,8 @@
 #include <FairRootManager.h>
 #include <FairTask.h>
 
-#include <Math/ParamFunctor.h>
 #include <TClonesArray.h>
-#include <TF1.h>
 #include <TFile.h>
-#include <TGraph.h>
 #include <TObject.h>
 #include <TTreeReader.h>
 #include <TTreeReaderValue.h>
@@ -44,8 +41,9 @@ AtMergeTask::AtMergeTask() : fLogger(FairLogger::GetLogger()), fS800CalcBr(new S
 
 AtMergeTask::~AtMergeTask()
 {
-   fS800TsGraph->Delete();
-   fS800TsFunc->Delete();
+   // The readers must be destroyed before the file they read from
+   fS800CalcReaderValue.reset();
+   fS800Reader.reset();
    fS800CalcBr->Delete();
    fRawEventArray->Delete();
    delete fS800file;
@@ -152,10 +150,10 @@ InitStatus AtMergeTask::Init()
    TTreeReaderValue<Long64_t> ts(reader1, "fts");
 
    LOG(info) << cBLUE << "Loading S800 timestamps..." << cNORMAL;
+   fS800Ts.clear();
    while (reader1.Next()) {
       fS800Ts.push_back((Long64_t)*ts);
       // fS800Ts.push_back((Long64_t) *ts - fTsDelta);//special for run180 e18027
-      fS800Evt.push_back((Double_t)fTsEvtS800Size);
       //------- Special for using internal AT-TPC TS (ex: runs 144 to 168), comment if run149 (but keep the second
       // special part uncommented)
       if (fUseATTPCClock) {
@@ -170,18 +168,12 @@ InitStatus AtMergeTask::Init()
    }
    ioMan->Register("s800cal", "S800", fS800CalcBr, fIsPersistence);
 
-   vector<Double_t> S800_ts(fS800Ts.begin(), fS800Ts.end());
-   // auto c1 = new TCanvas("c1", "c1", 800, 800);
-   // gROOT->SetBatch(kTRUE);//kTRUE not display the plots
-   fS800TsGraph =                                            // NOLINT
-      new TGraph(fTsEvtS800Size, &S800_ts[0], &fS800Evt[0]); // fTsEvtS800Size instead of 80 (just for the test file)
-   // make a function of S800Evt vs S800TS, used then to search the S800 matching TS only among few S800 events, faster
-   // than looping on all the events.
-   fS800TsFunc = new TF1( // NOLINT
-      "fS800TsFunc", [&](double *x, double *) { return fS800TsGraph->Eval(x[0]); }, 0, S800_ts.back(), 0);
-   // c1->cd();
-   // fS800TsGraph->Draw("AL");
-   // fS800TsFunc->Draw("same");
+   // fTsDelta constant offset likely from the length of the sync signal between S800 and At-TPC
+   fMatcher = std::make_unique<AtTools::AtTimestampMatcher>(fS800Ts, fGlom, fTsDelta);
+
+   // Reader used to get the matching S800 events
+   fS800Reader = std::make_unique<TTreeReader>("caltree", fS800file);
+   fS800CalcReaderValue = std::make_unique<TTreeReaderValue<S800Calc>>(*fS800Reader, "s800calc");
 
    fS800Ana.SetPID1cut(fcutPID1File);
    fS800Ana.SetPID2cut(fcutPID2File);
@@ -227,58 +219,43 @@ void AtMergeTask::Exec(Option_t *opt)
          AtTPCTs += 429521035;
       fATTPCTsPrev = AtTPCTs;
    }
-   int minj = 0, maxj = 0;
-   Double_t S800EvtMatch = -1;
-   minj = (int)fS800TsFunc->Eval(AtTPCTs) - fEvtDelta; // define the AtTPC entries range where the matching timestamp
-                                                       // should be, to not loop over all the AtTPC entries.
-   maxj = (int)fS800TsFunc->Eval(AtTPCTs) + fEvtDelta;
-
-   std::cout << " TS AtTPC " << AtTPCTs << std::endl;
-
-   for (int i = minj; i < maxj; i++) {
-      if (i >= 0 && i < fTsEvtS800Size) {
-         if (i > 0 && isInGlom(fS800Ts.at(i - 1), fS800Ts.at(i)))
-            std::cout << " -- Warning -- Timestamp of consecutive entries from S800 root file within the glom"
-                      << std::endl;
-         else {
-            // Is there a way to check that with the At-TPC "event by event" processing?
-            /*if(isInGlom(TsEvtAtTPC.at(i-1),TsEvtAtTPC.at(i)) )
-            {
-            cout<<" -- Warning -- Timestamp of consecutive entries from AtTPC root file within the glom"<<endl;
-          }
-          else*/
-            if (isInGlom(fS800Ts.at(i) + fTsDelta, AtTPCTs)) { // fTsDelta constant offset likely from the length of the
-                                                               // sync signal between S800 and At-TPC
-               // if(isInGlom(fS800Ts.at(i),AtTPCTs) ){//special run180
-               S800EvtMatch = (int)fS800Evt.at(i);
-               std::cout << " in glom " << minj << " " << maxj << " " << i << " " << fS800Ts.at(i) << " " << AtTPCTs
-                         << " " << S800EvtMatch << " " << fS800TsFunc->Eval(AtTPCTs) << " " << AtTPCTs - fS800Ts.at(i)
-                         << std::endl;
-               fEvtMerged++;
-               break;
-            } else
-               S800EvtMatch = -1;
-            // std::cout<<" NOT in glom "<<minj<<" "<<maxj<<" "<<i<<" "<<fS800Ts.at(i)<<" "<<AtTPCTs<<"
-            // "<<fS800Ts.at(i)-AtTPCTs<<" "<<S800EvtMatch<<std::endl;
-         }
-      }
-   }
+   LOG(debug) << " TS AtTPC " << AtTPCTs;
 
-   if (S800EvtMatch < 0)
-      LOG(warning) << cRED << "NO TS MATCHING !" << cNORMAL;
+   auto S800EvtMatch = fMatcher->Match(AtTPCTs);
+   if (S800EvtMatch < 0) {
+      LOG(debug) << "No S800 timestamp matching " << AtTPCTs;
+      return;
+   }
+   LOG(debug) << " in glom " << S800EvtMatch << " " << fS800Ts.at(S800EvtMatch) << " " << AtTPCTs << " "
+              << AtTPCTs - fS800Ts.at(S800EvtMatch);
+   fEvtMerged++;
 
-   if (S800EvtMatch > 0) {
-      TTreeReader reader2("caltree", fS800file);
-      TTreeReaderValue<S800Calc> *readerValueS800Calc = nullptr;
-      readerValueS800Calc = new TTreeReaderValue<S800Calc>(reader2, "s800calc"); // NOLINT
+   if (fS800Reader->SetEntry(S800EvtMatch) != TTreeReader::kEntryValid) {
+      LOG(error) << "Failed to read S800 entry " << S800EvtMatch;
+      return;
+   }
+   *fS800CalcBr = *fS800CalcReaderValue->Get();
 
-      reader2.SetEntry(S800EvtMatch);
+   Bool_t isIn = kFALSE;
+   isIn = fS800Ana.isInPID(fS800CalcBr);
+   fS800CalcBr->SetIsInCut(isIn);
+   rawEvent->SetIsExtGate(isIn);
+}
 
-      *fS800CalcBr = (S800Calc)*readerValueS800Calc->Get();
+void AtMergeTask::Finish()
+{
+   if (fMatcher == nullptr)
+      return;
 
-      Bool_t isIn = kFALSE;
-      isIn = fS800Ana.isInPID(fS800CalcBr);
-      fS800CalcBr->SetIsInCut(isIn);
-      rawEvent->SetIsExtGate(isIn);
-   }
+   const auto &stats = fMatcher->GetStats();
+   LOG(info) << cGREEN << "Merged " << stats.matched << " of " << stats.matched + stats.unmatched
+             << " AT-TPC events with " << fTsEvtS800Size << " S800 events." << cNORMAL;
+   if (stats.unmatched > 0)
+      LOG(warning) << cRED << stats.unmatched << " events had no matching S800 timestamp." << cNORMAL;
+   if (stats.ambiguous > 0)
+      LOG(warning) << cYELLOW << stats.ambiguous
+                   << " candidate S800 timestamps were skipped because they are within the glom of the previous entry."
+                   << cNORMAL;
+   if (stats.outOfOrder > 0)
+      LOG(warning) << cYELLOW << stats.outOfOrder << " AT-TPC events were not in time order." << cNORMAL;
 }
@@ -6,8 +6,13 @@
 #include <Rtypes.h>
 #include <TString.h>
 
+#include "AtTimestampMatcher.h"
 #include "S800Ana.h"
 
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+
+#include <memory>
 #include <vector>
 
 class FairLogger;
@@ -15,11 +20,17 @@ class S800Calc;
 class TBuffer;
 class TClass;
 class TClonesArray;
-class TF1;
 class TFile;
-class TGraph;
 class TMemberInspector;
 
+/**
+ * Task to merge the S800 data into the AT-TPC events by timestamp.
+ *
+ * The S800 timestamps are loaded at Init into an AtTools::AtTimestampMatcher, which keeps a cursor
+ * into them as the (time ordered) AT-TPC events are processed. The matching S800Calc is read with a
+ * reader on the S800 tree that is kept open for the entire run. Unmatched events and ambiguous S800
+ * timestamps are counted and reported in Finish.
+ */
 class AtMergeTask : public FairTask {
 
 public:
@@ -29,6 +40,7 @@ public:
    void SetPersistence(Bool_t value = kTRUE);
    void SetS800File(TString file);
    void SetGlom(Double_t glom);
+   /// Not used: every S800 timestamp is considered when matching (kept for old macros).
    void SetOptiEvtDelta(Int_t EvtDelta);
    void SetPID1cut(TString file);
    void SetPID2cut(TString file);
@@ -50,6 +62,7 @@ public:
    virtual InitStatus Init();
    //    virtual void SetParContainers();
    virtual void Exec(Option_t *opt);
+   virtual void Finish();
 
 private:
    FairLogger *fLogger;
@@ -62,13 +75,11 @@ private:
    TString fS800File;
    Long64_t fATTPCTs0{}, fATTPCTsPrev{};
    std::vector<Long64_t> fS800Ts;
-   std::vector<Double_t> fS800Evt;
    std::vector<Double_t> fParameters;
    std::vector<Double_t> fTofObjCorr;
    std::vector<Double_t> fMTDCObjRange;
    std::vector<Double_t> fMTDCXfRange;
 
-   TF1 *fS800TsFunc{};
    Double_t fGlom{2};
    Double_t fATTPCClockFreq{};
 
@@ -81,9 +92,11 @@ private:
 
    S800Ana fS800Ana;
 
-   TGraph *fS800TsGraph{};
+   std::unique_ptr<AtTools::AtTimestampMatcher> fMatcher;             //!
+   std::unique_ptr<TTreeReader> fS800Reader;                          //!
+   std::unique_ptr<TTreeReaderValue<S800Calc>> fS800CalcReaderValue; //!
 
-   ClassDef(AtMergeTask, 1);
+   ClassDef(AtMergeTask, 2);
 };
 
 #endif
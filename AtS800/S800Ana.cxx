@@ -52,7 +52,8 @@ void S800Ana::Reset()
    return;
 }
 
-void S800Ana::SetPID1cut(std::vector<TString> files)
+void S800Ana::LoadCuts(const std::vector<TString> &files, const char *name, std::vector<TCutG *> &cuts,
+                       std::vector<AtTools::AtPolygonGate> &gates)
 {
    for (auto &w : files) {
       TFile f(w);
@@ -60,36 +61,37 @@ void S800Ana::SetPID1cut(std::vector<TString> files)
       TKey *key = nullptr;
 
       while ((key = dynamic_cast<TKey *>(next()))) {
-         LOG(info) << "PID1 Loading Cut file:  " << key->GetName();
-         fcutPID1.push_back(dynamic_cast<TCutG *>(f.Get(key->GetName())));
+         LOG(info) << name << " Loading Cut file:  " << key->GetName();
+         cuts.push_back(dynamic_cast<TCutG *>(f.Get(key->GetName())));
       }
    }
+   MakeGates(cuts, gates);
+}
+void S800Ana::MakeGates(const std::vector<TCutG *> &cuts, std::vector<AtTools::AtPolygonGate> &gates)
+{
+   gates.clear();
+   for (auto cut : cuts)
+      if (cut != nullptr)
+         gates.emplace_back(cut->GetN(), cut->GetX(), cut->GetY(), fGateBins);
+}
+void S800Ana::SetPID1cut(std::vector<TString> files)
+{
+   LoadCuts(files, "PID1", fcutPID1, fGatePID1);
 }
 void S800Ana::SetPID2cut(std::vector<TString> files)
 {
-   for (auto &w : files) {
-      TFile f(w);
-      TIter next(f.GetListOfKeys());
-      TKey *key = nullptr;
-
-      while ((key = dynamic_cast<TKey *>(next()))) {
-         LOG(info) << "PID2 Loading Cut file:  " << key->GetName();
-         fcutPID2.push_back(dynamic_cast<TCutG *>(f.Get(key->GetName())));
-      }
-   }
+   LoadCuts(files, "PID2", fcutPID2, fGatePID2);
 }
 void S800Ana::SetPID3cut(std::vector<TString> files)
 {
-   for (auto &w : files) {
-      TFile f(w);
-      TIter next(f.GetListOfKeys());
-      TKey *key = nullptr;
-
-      while ((key = dynamic_cast<TKey *>(next()))) {
-         LOG(info) << "PID3 Loading Cut file:  " << key->GetName();
-         fcutPID3.push_back(dynamic_cast<TCutG *>(f.Get(key->GetName())));
-      }
-   }
+   LoadCuts(files, "PID3", fcutPID3, fGatePID3);
+}
+void S800Ana::SetGateResolution(Int_t nBins)
+{
+   fGateBins = nBins;
+   MakeGates(fcutPID1, fGatePID1);
+   MakeGates(fcutPID2, fGatePID2);
+   MakeGates(fcutPID3, fGatePID3);
 }
 void S800Ana::SetParameters(std::vector<Double_t> vec)
 {
@@ -220,14 +222,15 @@ Bool_t S800Ana::isInPID(S800Calc *s800calc)
    // std::cout << " S800Ana : Test var  " << fObjCorr_ToF << " " << fXfObj_ToF << " " << fX0 << " "
    //           << fAfp << " " << fObjCorr_ToF << " " << fICSum_E << '\n';
 
-   for (auto &w : fcutPID1)
-      if (fObjCorr_ToF != -999 && w->IsInside(fObjCorr_ToF, fXfObj_ToF))
+   // The rasterized gates give the same answer as TCutG::IsInside
+   for (auto &w : fGatePID1)
+      if (fObjCorr_ToF != -999 && w.IsInside(fObjCorr_ToF, fXfObj_ToF))
          InCondition1 += 1; // or of PID1
-   for (auto &w : fcutPID2)
-      if (fObjCorr_ToF != -999 && w->IsInside(fX0, fAfp))
+   for (auto &w : fGatePID2)
+      if (fObjCorr_ToF != -999 && w.IsInside(fX0, fAfp))
          InCondition2 += 1; // or of PID2
-   for (auto &w : fcutPID3)
-      if (fObjCorr_ToF != -999 && w->IsInside(fObjCorr_ToF, fICSum_E))
+   for (auto &w : fGatePID3)
+      if (fObjCorr_ToF != -999 && w.IsInside(fObjCorr_ToF, fICSum_E))
          InCondition3 += 1; // or of PID3
 
    if (fcutPID1.size() == 0)
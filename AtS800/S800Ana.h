@@ -4,6 +4,8 @@
 #include <Rtypes.h>
 #include <TObject.h>
 
+#include "AtPolygonGate.h"
+
 #include <vector>
 
 // AtTPCROOT classes
@@ -29,6 +31,12 @@ private:
    std::vector<TCutG *> fcutPID2;
    std::vector<TCutG *> fcutPID3;
 
+   // Rasterized copies of the cuts used by isInPID
+   Int_t fGateBins{256};
+   std::vector<AtTools::AtPolygonGate> fGatePID1; //!
+   std::vector<AtTools::AtPolygonGate> fGatePID2; //!
+   std::vector<AtTools::AtPolygonGate> fGatePID3; //!
+
    Double_t fXfObj_ToF;
    Double_t fObjCorr_ToF;
    Double_t fICSum_E;
@@ -50,6 +58,8 @@ public:
    void SetTofObjCorr(std::vector<Double_t> vec);
    void SetMTDCObjRange(std::vector<Double_t> vec);
    void SetMTDCXfRange(std::vector<Double_t> vec);
+   /// Number of cells along each axis of the rasterized PID gates (default 256)
+   void SetGateResolution(Int_t nBins);
 
    std::vector<Double_t> GetParameters();
    std::vector<Double_t> GetTofObjCorr();
@@ -59,6 +69,9 @@ public:
    Double_t GetObjCorr_ToF();
    Double_t GetICSum_E();
    std::vector<Double_t> GetFpVariables();
+   const std::vector<AtTools::AtPolygonGate> &GetPID1Gates() const { return fGatePID1; }
+   const std::vector<AtTools::AtPolygonGate> &GetPID2Gates() const { return fGatePID2; }
+   const std::vector<AtTools::AtPolygonGate> &GetPID3Gates() const { return fGatePID3; }
 
    Bool_t isInPID(S800Calc *s800calc);
    void Calc(S800Calc *s800calc);
@@ -68,8 +81,11 @@ public:
 
 private:
    void Reset();
+   void LoadCuts(const std::vector<TString> &files, const char *name, std::vector<TCutG *> &cuts,
+                 std::vector<AtTools::AtPolygonGate> &gates);
+   void MakeGates(const std::vector<TCutG *> &cuts, std::vector<AtTools::AtPolygonGate> &gates);
 
-   ClassDef(S800Ana, 1);
+   ClassDef(S800Ana, 2);
 };
 
 #endif
@@ -109,7 +109,7 @@ public:
    Float_t GetTAC() { return ftac; }
    Float_t GetAnode() { return fanode; }
    Float_t GetCathode() { return fcathode; }
-   std::vector<Float_t> GetCal() { return fcal; }
+   const std::vector<Float_t> &GetCal() { return fcal; }
    std::vector<Int_t> GetChan() { return fchan; }
    Short_t GetMaxPad() { return fmaxpad; }
    Float_t GetMaxChg() { return fmaxchg; }
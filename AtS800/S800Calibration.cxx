@@ -12,11 +12,139 @@
 #include "lmfit.h"
 #include "lmmin.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 using namespace std;
 
+namespace {
+// Width scale of the sechs model: q = A / cosh^2(kSechs * (x - mu) / w)
+const Double_t kSechs = std::log(std::sqrt(2.) + 1) / std::sqrt(2 * std::log(2.));
+
+/// Model (sechs or gauss from lmfit) and its derivatives with respect to (A, mu, w)
+Double_t Model(Double_t x, const Double_t *par, Bool_t sech2, Double_t *grad)
+{
+   Double_t u = (x - par[1]) / par[2];
+   if (sech2) {
+      Double_t t = kSechs * u;
+      Double_t sech = 1. / std::cosh(t);
+      Double_t f = par[0] * sech * sech;
+      Double_t dfdt = -2 * f * std::tanh(t);
+      grad[0] = sech * sech;
+      grad[1] = -dfdt * kSechs / par[2];
+      grad[2] = -dfdt * t / par[2];
+      return f;
+   }
+   Double_t e = std::exp(-0.5 * u * u);
+   Double_t f = par[0] * e;
+   grad[0] = e;
+   grad[1] = f * u / par[2];
+   grad[2] = f * u * u / par[2];
+   return f;
+}
+
+/**
+ * Closed-form estimate of (A, mu, w) from the max pad (qcal[m]) and its two neighbours.
+ *
+ * With s = sqrt(q0/q) at the neighbours the sech^2 model gives s+ + s- = 2 cosh(b) and
+ * s+ - s- = 2 sinh(b) tanh(b (xm - mu)), b = kSechs / w. The Gaussian is a parabola in log(q).
+ * Returns false (leaving par untouched) if the max pad is not a peak with both neighbours in the cluster.
+ */
+Bool_t ThreePoint(const Double_t *xpad, const Double_t *qcal, Int_t n, Int_t m, Bool_t sech2, Double_t *par)
+{
+   if (m < 1 || m > n - 2 || xpad[m] - xpad[m - 1] != 1 || xpad[m + 1] - xpad[m] != 1)
+      return false;
+   Double_t q0 = qcal[m], qm = qcal[m - 1], qp = qcal[m + 1];
+   if (!(qm > 0 && qp > 0 && q0 > qm && q0 > qp))
+      return false;
+
+   if (sech2) {
+      Double_t sm = std::sqrt(q0 / qm), sp = std::sqrt(q0 / qp);
+      Double_t b = std::acosh(0.5 * (sp + sm));
+      Double_t th = (sp - sm) / (2 * std::sinh(b));
+      if (!(b > 0) || std::fabs(th) >= 1)
+         return false;
+      Double_t d = std::atanh(th) / b; // xm - mu
+      Double_t c = std::cosh(b * d);
+      par[0] = q0 * c * c;
+      par[1] = xpad[m] - d;
+      par[2] = kSechs / b;
+   } else {
+      Double_t l0 = std::log(q0), lm = std::log(qm), lp = std::log(qp);
+      Double_t curv = 2 * l0 - lm - lp; // 1/w^2
+      Double_t d = 0.5 * (lp - lm) / curv;
+      par[0] = std::exp(l0 + 0.5 * d * d * curv);
+      par[1] = xpad[m] + d;
+      par[2] = 1. / std::sqrt(curv);
+   }
+   return true;
+}
+
+/// Sum of the squared residuals of the model over the cluster
+Double_t Chi2(const Double_t *xpad, const Double_t *qcal, Int_t n, const Double_t *par, Bool_t sech2)
+{
+   Double_t grad[3];
+   Double_t chi2 = 0;
+   for (Int_t i = 0; i < n; i++) {
+      Double_t r = qcal[i] - Model(xpad[i], par, sech2, grad);
+      chi2 += r * r;
+   }
+   return chi2;
+}
+
+/**
+ * Fast replacement for lmcurve_fit: the three-point estimate (or the initial guess in par if it
+ * fails) followed by at most nIter unweighted Gauss-Newton steps over the cluster. A step is only
+ * kept if it lowers the chi2, so the cost is bounded by (nIter + 1) passes over the cluster.
+ * Returns the norm of the residual vector like lm_status_struct::fnorm.
+ */
+Double_t FastFit(const Double_t *xpad, const Double_t *qcal, Int_t n, Bool_t sech2, Int_t nIter, Double_t *par)
+{
+   Int_t m = std::max_element(qcal, qcal + n) - qcal;
+   ThreePoint(xpad, qcal, n, m, sech2, par);
+
+   Double_t chi2 = Chi2(xpad, qcal, n, par, sech2);
+   for (Int_t it = 0; it < nIter && n > 3; it++) {
+      // Normal equations (J^T J) step = J^T r, solved with Cramer's rule
+      Double_t a[3][3] = {}, g[3] = {}, grad[3];
+      for (Int_t i = 0; i < n; i++) {
+         Double_t r = qcal[i] - Model(xpad[i], par, sech2, grad);
+         for (Int_t k = 0; k < 3; k++) {
+            g[k] += grad[k] * r;
+            for (Int_t l = 0; l <= k; l++)
+               a[k][l] += grad[k] * grad[l];
+         }
+      }
+      a[0][1] = a[1][0];
+      a[0][2] = a[2][0];
+      a[1][2] = a[2][1];
+
+      auto det3 = [](Double_t c0[3], Double_t c1[3], Double_t c2[3]) {
+         return c0[0] * (c1[1] * c2[2] - c1[2] * c2[1]) - c1[0] * (c0[1] * c2[2] - c0[2] * c2[1]) +
+                c2[0] * (c0[1] * c1[2] - c0[2] * c1[1]);
+      };
+      Double_t det = det3(a[0], a[1], a[2]);
+      if (!(std::fabs(det) > 0))
+         break;
+
+      Double_t trial[3];
+      trial[0] = par[0] + det3(g, a[1], a[2]) / det;
+      trial[1] = par[1] + det3(a[0], g, a[2]) / det;
+      trial[2] = par[2] + det3(a[0], a[1], g) / det;
+      if (!(trial[2] > 0))
+         break;
+
+      Double_t trialChi2 = Chi2(xpad, qcal, n, trial, sech2);
+      if (!(trialChi2 < chi2))
+         break;
+      std::copy(trial, trial + 3, par);
+      chi2 = trialChi2;
+   }
+   return std::sqrt(chi2);
+}
+} // namespace
+
 S800Calibration::S800Calibration()
 {
    // S800
@@ -64,6 +192,8 @@ S800Calibration::~S800Calibration()
    fcrdccal.clear();
    fICoffset.clear();
    fICslope.clear();
+   if (fXFitValidation[0].n > 0 || fXFitValidation[1].n > 0)
+      PrintXFitValidation();
    // std::cout << "destructor" << std::endl;
 }
 
@@ -352,38 +482,8 @@ Float_t S800Calibration::CalcX()
    fcrdc.SetXcog((Float_t)xcog);
    fcrdc.SetCathode((Float_t)sum_q);
 
-   if (fSett->XFit()) {
-
-      // Do fit
-      Double_t xfit;
-      Double_t par[3];
-      Int_t n_par = 3; // number of parameters in model function f
-
-      lm_status_struct status;
-      lm_control_struct control = lm_control_double;
-      control.printflags = 0; // monitor status (+1) and parameters (+2)
-
-      // Initial guess
-      par[0] = (Double_t)maxchg[gclstr];
-      par[1] = xcog;
-      par[2] = sigma;
-
-      if (fSett->XFitFunc() == 1) {
-         // Secant Hyperbolic Squared
-         lmcurve_fit(n_par, par, j, xpad, qcal, sechs, &control, &status);
-      } else if (fSett->XFitFunc() == 2) {
-         // gaussian
-         // lmcurve_fit( n_par, par, j, xpad, qcal, gauss, &control, &status );
-      }
-
-      xfit = par[1];
-      fcrdc.SetXfit((Float_t)xfit);
-      fcrdc.SetFitPrm(0, (Float_t)par[0]);
-      fcrdc.SetFitPrm(1, (Float_t)par[1]);
-      fcrdc.SetFitPrm(2, (Float_t)par[2]);
-      fcrdc.SetFnorm(status.fnorm);
-      return (Float_t)xfit;
-   }
+   if (fSett->XFit())
+      return FitX(&fcrdc, xpad, qcal, j, maxchg[gclstr], xcog, sigma);
 
    // If we do not do fit, return xcog
    return (Float_t)xcog;
@@ -394,8 +494,7 @@ Float_t S800Calibration::CalcX()
 Float_t S800Calibration::CalcX2(CRDC *theCRDC)
 {
 
-   vector<Float_t> theCalibratedPads = theCRDC->GetCal();
-   vector<Float_t> thePedSubtractedPads = theCRDC->GetPedSubtractedPads();
+   const auto &theCalibratedPads = theCRDC->GetCal();
    // Cluster search
    Bool_t flg_clstr = kFALSE;
    Int_t iclstr = -1; // Counter keeping track of the clusters.  Used as the first index in clstr[][]
@@ -517,43 +616,76 @@ Float_t S800Calibration::CalcX2(CRDC *theCRDC)
    theCRDC->SetXcog((Float_t)xcog);
    theCRDC->SetCathode((Float_t)sum_q);
 
-   if (fSett->XFit()) {
+   if (fSett->XFit())
+      return FitX(theCRDC, xpad, qcal, j, maxchg[gclstr], xcog, sigma);
 
-      // Do fit
-      Double_t xfit;
-      Double_t par[3];
-      Int_t n_par = 3; // number of parameters in model function f
+   // If we do not do fit, return xcog
+   return (Float_t)xcog;
+}
+
+Float_t S800Calibration::FitX(CRDC *theCRDC, const Double_t *xpad, const Double_t *qcal, Int_t n, Double_t maxchg,
+                              Double_t xcog, Double_t sigma)
+{
+   // Initial guess
+   Double_t par[3] = {maxchg, xcog, sigma};
+   Double_t fnorm = sqrt(-1.0); // Not fit
+   Int_t mode = fSett->XFit();
+   Bool_t sech2 = fSett->XFitFunc() != 2;
+
+   if (mode == S800Settings::kXFitFast) {
+      fnorm = FastFit(xpad, qcal, n, sech2, fSett->XFitIterations(), par);
+   } else {
+      Double_t parFast[3] = {maxchg, xcog, sigma};
+      if (mode == S800Settings::kXFitValidate)
+         FastFit(xpad, qcal, n, sech2, fSett->XFitIterations(), parFast);
 
+      Int_t n_par = 3; // number of parameters in model function f
       lm_status_struct status;
       lm_control_struct control = lm_control_double;
       control.printflags = 0; // monitor status (+1) and parameters (+2)
 
-      // Initial guess
-      par[0] = (Double_t)maxchg[gclstr];
-      par[1] = xcog;
-      par[2] = sigma;
-
       // sechs is a function defined in lmfit.h
       // xpad and qcal are pad numbers and charges for the "good" cluster
       if (fSett->XFitFunc() == 1) {
          // Secant Hyperbolic Squared
-         lmcurve_fit(n_par, par, j, xpad, qcal, sechs, &control, &status);
+         lmcurve_fit(n_par, par, n, xpad, qcal, sechs, &control, &status);
+         fnorm = status.fnorm;
       } else if (fSett->XFitFunc() == 2) {
          // gaussian
-         // lmcurve_fit( n_par, par, j, xpad, qcal, gauss, &control, &status );
+         // lmcurve_fit( n_par, par, n, xpad, qcal, gauss, &control, &status );
       }
 
-      xfit = par[1]; // the [1] parameter is the position
-      theCRDC->SetXfit((Float_t)xfit);
-      theCRDC->SetFitPrm(0, (Float_t)par[0]);
-      theCRDC->SetFitPrm(1, (Float_t)par[1]);
-      theCRDC->SetFitPrm(2, (Float_t)par[2]);
-      theCRDC->SetFnorm(status.fnorm);
-      return (Float_t)xfit;
+      Int_t id = theCRDC->GetID();
+      Double_t res = parFast[1] - par[1];
+      if (mode == S800Settings::kXFitValidate && (id == 0 || id == 1) && std::isfinite(fnorm) && std::isfinite(res)) {
+         auto &val = fXFitValidation[id];
+         val.n++;
+         val.sum += res;
+         val.sum2 += res * res;
+         val.maxAbs = std::max(val.maxAbs, std::fabs(res));
+      }
    }
 
-   // If we do not do fit, return xcog
-   return (Float_t)xcog;
+   Double_t xfit = par[1]; // the [1] parameter is the position
+   theCRDC->SetXfit((Float_t)xfit);
+   theCRDC->SetFitPrm(0, (Float_t)par[0]);
+   theCRDC->SetFitPrm(1, (Float_t)par[1]);
+   theCRDC->SetFitPrm(2, (Float_t)par[2]);
+   theCRDC->SetFnorm(fnorm);
+   return (Float_t)xfit;
+}
+
+void S800Calibration::PrintXFitValidation() const
+{
+   for (int id = 0; id < 2; id++) {
+      const auto &val = fXFitValidation[id];
+      if (val.n == 0)
+         continue;
+      Double_t mean = val.sum / val.n;
+      Double_t rms = std::sqrt(val.sum2 / val.n);
+      Info(__FUNCTION__, "CRDC %d: fast - LM x position over %lld clusters: mean %g, rms %g, max |res| %g pads", id,
+           val.n, mean, rms, val.maxAbs);
+   }
 }
 
 Float_t S800Calibration::TimeOffset(Float_t time1, Float_t time2)
@@ -88,7 +88,25 @@ public:
 
    std::vector<Float_t> GetCRDCCal() { return fcrdccal; }
 
+   /**Residual (fast - LM) of the fast CRDC x position against the LM fit, accumulated for each
+      CRDC when Crdc.X.Fit is 3 (S800Settings::kXFitValidate).
+   */
+   struct XFitValidation {
+      Long64_t n{0};      //< Number of clusters fit by both methods
+      Double_t sum{0};    //< Sum of the residuals (pads)
+      Double_t sum2{0};   //< Sum of the squared residuals (pads^2)
+      Double_t maxAbs{0}; //< Largest absolute residual (pads)
+   };
+   const XFitValidation &GetXFitValidation(Int_t id) const { return fXFitValidation[id]; }
+   void PrintXFitValidation() const;
+
 private:
+   /**Fit the x position of the good cluster (n pads at xpad with charge qcal) according to
+      Crdc.X.Fit, setting the fit parameters in theCRDC.
+   */
+   Float_t FitX(CRDC *theCRDC, const Double_t *xpad, const Double_t *qcal, Int_t n, Double_t maxchg, Double_t xcog,
+                Double_t sigma);
+
    S800Settings *fSett{};
    std::vector<std::vector<Float_t>> fped;
    std::vector<std::vector<Float_t>> fslope;
@@ -104,6 +122,8 @@ private:
 
    CRDC fcrdc;
    TOF ftof;
+
+   XFitValidation fXFitValidation[2];
 };
 
 #endif
@@ -0,0 +1,111 @@
+#include "S800Calibration.h"
+
+#include "S800Calc.h"
+#include "S800Settings.h"
+#include "S800defs.h"
+#include "lmcurve.h"
+#include "lmfit.h"
+#include "lmmin.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+/// Settings using the x fit mode mode, without any calibration file
+std::unique_ptr<S800Settings> MakeSettings(int mode)
+{
+   std::string file = "S800CalibrationTest.settings";
+   std::ofstream out(file);
+   out << "Crdc.X.Fit: " << mode << "\nCrdc.X.FitFunc: 1\nCrdc.X.FitIterations: 2\n";
+   out.close();
+   auto settings = std::make_unique<S800Settings>(file.c_str());
+   std::remove(file.c_str());
+   return settings;
+}
+
+/// Calibrated pads of a sech^2 cluster with parameters par, NaN outside the cluster
+std::vector<Float_t> MakeCluster(const double *par, std::mt19937 &rng, double noise)
+{
+   std::normal_distribution<double> dist(0, noise);
+   std::vector<Float_t> cal(S800_FP_CRDC_CHANNELS, sqrt(-1.0));
+   for (int i = 0; i < S800_FP_CRDC_CHANNELS; i++) {
+      double q = sechs(i, par) + (noise > 0 ? dist(rng) : 0);
+      if (q > 1)
+         cal[i] = q;
+   }
+   return cal;
+}
+
+/// Position of the cluster from lmcurve_fit, with the same pads and initial guess as S800Calibration::CalcX2
+double FitLM(const std::vector<Float_t> &cal)
+{
+   std::vector<double> xpad, qcal;
+   double sum = 0, sumx = 0, sumxx = 0;
+   for (int i = 0; i < S800_FP_CRDC_CHANNELS; i++) {
+      if (std::isnan(cal[i]) || cal[i] < 8.)
+         continue;
+      xpad.push_back(i);
+      qcal.push_back(cal[i]);
+      sum += cal[i];
+      sumx += cal[i] * i;
+      sumxx += cal[i] * i * i;
+   }
+   double cog = sumx / sum;
+   double par[3] = {*std::max_element(qcal.begin(), qcal.end()), cog, std::sqrt(sumxx / sum - cog * cog)};
+
+   lm_status_struct status;
+   lm_control_struct control = lm_control_double;
+   control.printflags = 0;
+   lmcurve_fit(3, par, xpad.size(), xpad.data(), qcal.data(), sechs, &control, &status);
+   return par[1];
+}
+} // namespace
+
+TEST(S800CalibrationTest, FastXFitMatchesLM)
+{
+   auto settings = MakeSettings(S800Settings::kXFitFast);
+   S800Calibration calibration(settings.get());
+   std::mt19937 rng(42);
+   std::uniform_real_distribution<double> uni(0, 1);
+
+   for (int i = 0; i < 20; i++) {
+      double par[3] = {300 + 500 * uni(rng), 60 + 100 * uni(rng), 2 + 2 * uni(rng)};
+      for (double noise : {0., 2.}) {
+         CRDC crdc;
+         crdc.SetID(0);
+         crdc.SetCal(MakeCluster(par, rng, noise));
+
+         Float_t x = calibration.CalcX2(&crdc);
+         EXPECT_NEAR(x, FitLM(crdc.GetCal()), noise > 0 ? 1e-2 : 1e-4) << "Cluster at " << par[1];
+         EXPECT_TRUE(std::isfinite(crdc.GetFnorm()));
+      }
+   }
+}
+
+TEST(S800CalibrationTest, ValidationAccumulatesResidual)
+{
+   auto settings = MakeSettings(S800Settings::kXFitValidate);
+   S800Calibration calibration(settings.get());
+   std::mt19937 rng(7);
+
+   double par[3] = {500, 101.3, 3};
+   CRDC crdc;
+   crdc.SetID(1);
+   crdc.SetCal(MakeCluster(par, rng, 2));
+
+   // The validation mode returns the LM fit
+   EXPECT_NEAR(calibration.CalcX2(&crdc), FitLM(crdc.GetCal()), 1e-4);
+
+   const auto &val = calibration.GetXFitValidation(1);
+   EXPECT_EQ(val.n, 1);
+   EXPECT_LT(val.maxAbs, 1e-2);
+   EXPECT_EQ(calibration.GetXFitValidation(0).n, 0);
+}
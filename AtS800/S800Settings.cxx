@@ -3,6 +3,7 @@
 #include <TEnv.h>
 #include <TString.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -26,6 +27,7 @@ void S800Settings::ReadSettings()
    for (int i = 0; i < 2; i++) {
       fXFit = set->GetValue("Crdc.X.Fit", 0);
       fXFitFunc = set->GetValue("Crdc.X.FitFunc", 1);
+      fXFitIterations = std::clamp(set->GetValue("Crdc.X.FitIterations", 2), 0, 5);
       fxOffset[i] = set->GetValue(Form("Crdc.X.Offset.%d", i), 0.0);
       fxSlope[i] = set->GetValue(Form("Crdc.X.Slope.%d", i), 1.0);
       fyOffset[i] = set->GetValue(Form("Crdc.Y.Offset.%d", i), 0.0);
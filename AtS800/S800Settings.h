@@ -12,6 +12,14 @@ class TMemberInspector;
 
 class S800Settings : public TObject {
 public:
+   /// CRDC x position reconstruction selected with Crdc.X.Fit
+   enum XFitMode {
+      kXFitCog = 0,     //< Center of gravity of the cluster
+      kXFitLM = 1,      //< Levenberg-Marquardt fit of the cluster (lmcurve_fit)
+      kXFitFast = 2,    //< Three-point estimator around the max pad, refined with Crdc.X.FitIterations Gauss-Newton steps
+      kXFitValidate = 3 //< LM fit, accumulating the residual of the fast estimator against it
+   };
+
    S800Settings();
    S800Settings(const char *);
    ~S800Settings();
@@ -23,6 +31,7 @@ public:
 
    int XFit() { return fXFit; }
    int XFitFunc() { return fXFitFunc; }
+   int XFitIterations() { return fXFitIterations; }
    Float_t XOffset(int ch) { return fxOffset[ch]; }
    Float_t XSlope(int ch) { return fxSlope[ch]; }
    Float_t YOffset(int ch) { return fyOffset[ch]; }
@@ -41,12 +50,13 @@ protected:
 
    Int_t fXFit{};
    Int_t fXFitFunc{};
+   Int_t fXFitIterations{};
    Float_t fxOffset[2]{};
    Float_t fxSlope[2]{};
    Float_t fyOffset[2]{};
    Float_t fySlope[2]{};
 
-   ClassDef(S800Settings, 1)
+   ClassDef(S800Settings, 2)
 };
 
 #endif
@@ -10,8 +10,10 @@
 #include <cstring>
 #include <fstream> // IWYU pragma: keep
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <sstream> // IWYU pragma: keep
+#include <string>
 #include <utility>
 
 std::unique_ptr<TInverseMap> TInverseMap::fInverseMap = nullptr;
@@ -89,6 +91,37 @@ bool TInverseMap::ReadMapFile(const char *filename)
 
       // printf("%i\t%s\n",index,line.c_str());
    }
+   return Compile(fMap, fTerms);
+}
+
+/**
+ * Compile the map into terms, checking that every exponent can be taken from a PowerTable.
+ */
+bool TInverseMap::Compile(const std::map<int, std::vector<InvMapRow>> &map, std::vector<std::vector<Term>> &terms)
+{
+   terms.clear();
+   if (map.empty())
+      return true;
+   terms.resize(map.rbegin()->first + 1);
+
+   for (auto &[par, rows] : map) {
+      if (par < 0) {
+         printf("inverse map has an invalid parameter index %i.\n", par);
+         return false;
+      }
+      for (auto &row : rows) {
+         Term term{row.coefficient, row.order, {}};
+         for (int y = 0; y < 6; ++y) {
+            if (row.exp[y] < 0 || row.exp[y] > kMaxExp) {
+               printf("inverse map exponent %i is not in [0,%i].\n", row.exp[y], kMaxExp);
+               terms.clear();
+               return false;
+            }
+            term.exp[y] = row.exp[y];
+         }
+         terms[par].push_back(term);
+      }
+   }
    return true;
 }
 
@@ -108,45 +141,26 @@ bool TInverseMap::ReadMultiMapFile(std::vector<std::string> &mapfile_v)
          std::cout << "! Inv map file not read : " << i << std::endl;
    }
 
-   std::vector<InvMapRow> invrow_v;
-   std::vector<std::vector<double>> coeff_v;
+   // The z-dependent map has the terms of the first map with each coefficient interpolated between the maps
+   fSplines.clear();
+   fSplineZ = std::numeric_limits<double>::quiet_NaN();
+   if (fMap_v.empty() || fMap_v.at(0).empty() || !Compile(fMap_v.at(0), fTermsZ))
+      return false;
+
    Int_t icoeff = 0;
-   TSpline3 *spline[fsize]; // NOLINT TODO:This plus code below looks like a memory leak...
-   // TGraph *graph[fsize];
-
-   if (fMap_v.size() > 0)
-      for (int j = 0; j < fMap_v.at(0).size();
-           j++) { // loop on par//assuming the first map has the same format as the following maps
-         for (int k = 0; k < fMap_v.at(0).at(j).size(); k++) { // loop on coeff in par
-            std::vector<double> buff_v;
-            std::vector<InvMapRowS> blabla;
-            InvMapRowS invrow_s{};
-            for (auto &i : fMap_v) { // loop on maps
-               // std::cout<<"mapcoeff : "<<i<<" "<<j<<" "<<k<<" "<<fMap_v.at(i).at(j).at(k).coefficient<<std::endl;
-               buff_v.push_back((Double_t)i.at(j).at(k).coefficient);
-               // std::cout<<"invrow : "<<j<<" "<<invrow_v.at(j).coefficient<<std::endl;
-            }
-            coeff_v.push_back(buff_v);
-            char fname[20];
-            sprintf(fname, "f_%d", icoeff);
-            spline[icoeff] = new TSpline3(fname, &fMapDist_v[0], &buff_v[0], fMap_v.size()); // NOLINT
-            // graph[icoeff] = new TGraph(fMap_v.size(),&mapdist_v[0], &buff_v[0]);
-            // std::cout<<"debug  : "<<j<<" "<<k<<" "<<fMap_v.size()<<" "<<fMapDist_v.back()<<"
-            // "<<spline[icoeff]->Eval(0.35)<<std::endl;
-            invrow_s.coefficient = spline[icoeff];
-            invrow_s.order = fMap_v.at(0).at(j).at(k).order;
-            invrow_s.exp[0] = fMap_v.at(0).at(j).at(k).exp[0];
-            invrow_s.exp[1] = fMap_v.at(0).at(j).at(k).exp[1];
-            invrow_s.exp[2] = fMap_v.at(0).at(j).at(k).exp[2];
-            invrow_s.exp[3] = fMap_v.at(0).at(j).at(k).exp[3];
-            invrow_s.exp[4] = fMap_v.at(0).at(j).at(k).exp[4];
-            invrow_s.exp[5] = fMap_v.at(0).at(j).at(k).exp[5];
-            fMap_s[j].push_back(invrow_s);
-            icoeff++;
-         }
-         // fMap_s[j].push_back(invrow_s);
+   fSplines.resize(fTermsZ.size());
+   // loop on par//assuming the first map has the same format as the following maps
+   for (auto &[par, rows] : fMap_v.at(0)) {
+      for (int k = 0; k < rows.size(); k++) { // loop on coeff in par
+         std::vector<double> buff_v;
+         for (auto &i : fMap_v) // loop on maps
+            buff_v.push_back((Double_t)i.at(par).at(k).coefficient);
+
+         auto fname = "f_" + std::to_string(icoeff++);
+         fSplines[par].push_back(
+            std::make_unique<TSpline3>(fname.c_str(), fMapDist_v.data(), buff_v.data(), fMap_v.size()));
       }
-   // std::cout << "eval func " << fMap_s[0].at(0).coefficient->Eval(0.5) << " " << spline[0]->Eval(0.5) << std::endl;
+   }
    return true;
 }
 
@@ -342,37 +356,114 @@ float TInverseMap::Dta(int order, const TS800 *s800) {
 
 float TInverseMap::MapCalc(int order, int par, float *input) const
 {
-   float cumul = 0.0;
-   float multiplicator = 0.0;
-   std::vector<InvMapRow> vec = fMap.at(par);
-   for (auto &x : vec) {
-      if (order < x.order)
-         break;
-      multiplicator = 1.0;
-      for (int y = 0; y < 6; y++) {
-         if (x.exp[y] != 0)
-            multiplicator *= pow(input[y], x.exp[y]);
-      }
-      cumul += multiplicator * x.coefficient;
-   }
-   return cumul;
+   PowerTable pows;
+   FillPowers(input, pows);
+   return Eval(fTerms.at(par), order, pows);
 }
 
 float TInverseMap::MapCalc_s(int order, int par, float *input, double z)
 {
-   float cumul = 0.0;
-   float multiplicator = 0.0;
-   std::vector<InvMapRowS> vec = fMap_s.at(par);
-   for (auto &x : vec) {
+   UpdateSplineCoefficients(z);
+   PowerTable pows;
+   FillPowers(input, pows);
+   return Eval(fTermsZ.at(par), order, pows);
+}
+
+/**
+ * Evaluate every parameter of the map for a single event. The powers of the inputs are only
+ * calculated once and shared by the four parameters.
+ */
+TInverseMap::MapResult TInverseMap::MapAll(int order, double xfp, double afp, double yfp, double bfp) const
+{
+   PowerTable pows;
+   FillPowers(xfp, afp, yfp, bfp, pows);
+   MapResult result;
+   for (size_t par = 0; par < result.size(); ++par)
+      result[par] = Eval(fTerms.at(par), order, pows);
+   return result;
+}
+
+TInverseMap::MapResult TInverseMap::MapAll(int order, double xfp, double afp, double yfp, double bfp, double z)
+{
+   UpdateSplineCoefficients(z);
+   PowerTable pows;
+   FillPowers(xfp, afp, yfp, bfp, pows);
+   MapResult result;
+   for (size_t par = 0; par < result.size(); ++par)
+      result[par] = Eval(fTermsZ.at(par), order, pows);
+   return result;
+}
+
+std::vector<TInverseMap::MapResult> TInverseMap::MapAll(int order, const std::vector<FocalPlane> &events) const
+{
+   std::vector<MapResult> results;
+   results.reserve(events.size());
+   for (auto &fp : events)
+      results.push_back(MapAll(order, fp[0], fp[1], fp[2], fp[3]));
+   return results;
+}
+
+/**
+ * Evaluate the z-dependent map for many events at the same z, so the splines are evaluated only once.
+ */
+std::vector<TInverseMap::MapResult>
+TInverseMap::MapAll(int order, const std::vector<FocalPlane> &events, double z)
+{
+   std::vector<MapResult> results;
+   results.reserve(events.size());
+   for (auto &fp : events)
+      results.push_back(MapAll(order, fp[0], fp[1], fp[2], fp[3], z));
+   return results;
+}
+
+/**
+ * Set the coefficients of the z-dependent map to their value at z. The splines are only evaluated
+ * when z changes.
+ */
+void TInverseMap::UpdateSplineCoefficients(double z)
+{
+   if (z == fSplineZ)
+      return;
+   for (int par = 0; par < fTermsZ.size(); ++par)
+      for (int k = 0; k < fTermsZ[par].size(); ++k)
+         fTermsZ[par][k].coefficient = fSplines[par][k]->Eval(z);
+   fSplineZ = z;
+}
+
+void TInverseMap::FillPowers(double xfp, double afp, double yfp, double bfp, PowerTable &pows)
+{
+   float input[6];
+   input[0] = -xfp / 1000.0;
+   input[1] = -afp;
+   input[2] = yfp / 1000.0;
+   input[3] = bfp;
+   input[4] = 0.0;
+   input[5] = 0.0;
+   FillPowers(input, pows);
+}
+
+void TInverseMap::FillPowers(const float *input, PowerTable &pows)
+{
+   for (int y = 0; y < 6; y++) {
+      pows[y][0] = 1;
+      for (int e = 1; e <= kMaxExp; ++e)
+         pows[y][e] = pows[y][e - 1] * input[y];
+   }
+}
+
+/**
+ * Sum the terms up to the given order. The terms are sorted by order in the map file.
+ */
+float TInverseMap::Eval(const std::vector<Term> &terms, int order, const PowerTable &pows)
+{
+   double cumul = 0.0;
+   for (auto &x : terms) {
       if (order < x.order)
          break;
-      multiplicator = 1.0;
-      for (int y = 0; y < 6; y++) {
-         if (x.exp[y] != 0)
-            multiplicator *= pow(input[y], x.exp[y]);
-      }
-      cumul += multiplicator * x.coefficient->Eval(z);
+      double multiplicator = x.coefficient;
+      for (int y = 0; y < 6; y++)
+         multiplicator *= pows[y][x.exp[y]];
+      cumul += multiplicator;
    }
-
    return cumul;
 }
@@ -5,7 +5,9 @@
 #include <TNamed.h>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -44,6 +46,17 @@ public:
    float MapCalc(int, int, float *) const;
    float MapCalc_s(int order, int par, float *input, double z);
 
+   /// Value of every parameter of the map, indexed like the map file (0: ata, 1: yta, 2: bta, 3: dta)
+   using MapResult = std::array<float, 4>;
+   /// Position and angles at the focal plane (xfp, afp, yfp, bfp) of a single event
+   using FocalPlane = std::array<double, 4>;
+
+   /// Same as calling Ata, Yta, Bta and Dta, but the powers of the inputs are only calculated once
+   MapResult MapAll(int degree, double xfp, double afp, double yfp, double bfp) const;
+   MapResult MapAll(int degree, double xfp, double afp, double yfp, double bfp, double z);
+   std::vector<MapResult> MapAll(int degree, const std::vector<FocalPlane> &events) const;
+   std::vector<MapResult> MapAll(int degree, const std::vector<FocalPlane> &events, double z);
+
    void SetDistPivotTarget(std::vector<Double_t> vec)
    {
       std::cout << "check setDistPivotTarget " << vec.size() << " " << vec.at(2) << std::endl;
@@ -67,16 +80,36 @@ private:
       int exp[6];
    };
 
-   struct InvMapRowS {
-      TSpline3 *coefficient;
+   /// Largest exponent of an input variable supported by the compiled map
+   static constexpr int kMaxExp = 20;
+   /// Powers 0 to kMaxExp of each of the six input variables
+   using PowerTable = std::array<std::array<double, kMaxExp + 1>, 6>;
+
+   /**
+    * Term of the map compiled for evaluation. The coefficient is either stored directly or, for the
+    * z-dependent map, taken from the spline at the same position in fSplines.
+    */
+   struct Term {
+      double coefficient;
       int order;
-      int exp[6];
+      std::array<int, 6> exp;
    };
 
    // data cleared on reset; i.e. Read new inverse map.
    std::map<int, std::vector<InvMapRow>> fMap;
-   std::map<int, std::vector<InvMapRowS>> fMap_s;
    std::vector<std::map<int, std::vector<InvMapRow>>> fMap_v;
+
+   std::vector<std::vector<Term>> fTerms;                        //! Compiled fMap (fTerms[par][term])
+   std::vector<std::vector<Term>> fTermsZ;                       //! Compiled z-dependent map
+   std::vector<std::vector<std::unique_ptr<TSpline3>>> fSplines; //! Coefficient vs z of each term of fTermsZ
+   double fSplineZ{std::numeric_limits<double>::quiet_NaN()};    //! z the coefficients of fTermsZ are evaluated at
+
+   bool Compile(const std::map<int, std::vector<InvMapRow>> &map, std::vector<std::vector<Term>> &terms);
+   void UpdateSplineCoefficients(double z);
+   static void FillPowers(double xfp, double afp, double yfp, double bfp, PowerTable &pows);
+   static void FillPowers(const float *input, PowerTable &pows);
+   static float Eval(const std::vector<Term> &terms, int order, const PowerTable &pows);
+
    std::vector<Double_t> fMapDist_v;
    float fBrho{};
    int fMass{};
@@ -0,0 +1,154 @@
+#include "TInverseMap.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+struct Row {
+   double coefficient;
+   int order;
+   std::array<int, 6> exp;
+};
+/// Terms of each parameter of a map (0: ata, 1: yta, 2: bta, 3: dta)
+using Map = std::array<std::vector<Row>, 4>;
+
+/// Every term up to fifth order in the four focal plane variables, with random coefficients
+Map MakeMap(std::mt19937 &rng)
+{
+   std::uniform_real_distribution<double> coef(-1, 1);
+   Map map;
+   for (auto &rows : map)
+      for (int order = 1; order <= 5; ++order)
+         for (int e0 = order; e0 >= 0; --e0)
+            for (int e1 = order - e0; e1 >= 0; --e1)
+               for (int e2 = order - e0 - e1; e2 >= 0; --e2)
+                  rows.push_back({coef(rng), order, {e0, e1, e2, order - e0 - e1 - e2, 0, 0}});
+   return map;
+}
+
+/// Write the map in the format of the map files of the S800
+std::string WriteMap(const Map &map, const std::string &fileName)
+{
+   std::ofstream out(fileName);
+   out << "S800 inverse map - Brho=2.32 - M=3 - Q=2\n";
+   for (auto &rows : map) {
+      out << "     I  COEFFICIENT            ORDER EXPONENTS\n";
+      int index = 1;
+      for (auto &row : rows) {
+         char line[100];
+         snprintf(line, sizeof(line), "%6d  %.16E %3d   %d %d  %d %d  %d %d\n", index++, row.coefficient, row.order,
+                  row.exp[0], row.exp[1], row.exp[2], row.exp[3], row.exp[4], row.exp[5]);
+         out << line;
+      }
+      out << "------------------------------------------------------\n";
+   }
+   return fileName;
+}
+
+/// Sum of the terms up to order, each calculated on its own with pow
+double EvalTerms(const std::vector<Row> &rows, int order, double xfp, double afp, double yfp, double bfp)
+{
+   float input[6] = {static_cast<float>(-xfp / 1000.0), static_cast<float>(-afp), static_cast<float>(yfp / 1000.0),
+                     static_cast<float>(bfp), 0, 0};
+   double sum = 0;
+   for (auto &row : rows) {
+      if (row.order > order)
+         continue;
+      double term = row.coefficient;
+      for (int i = 0; i < 6; ++i)
+         term *= std::pow(input[i], row.exp[i]);
+      sum += term;
+   }
+   return sum;
+}
+
+void ExpectMap(TInverseMap &invMap, const Map &map, std::mt19937 &rng, double z = std::nan(""))
+{
+   std::uniform_real_distribution<double> pos(-250, 250);
+   std::uniform_real_distribution<double> angle(-0.1, 0.1);
+   std::vector<TInverseMap::FocalPlane> events;
+   std::vector<TInverseMap::MapResult> expectedAll;
+   for (int i = 0; i < 100; ++i) {
+      double xfp = pos(rng), afp = angle(rng), yfp = pos(rng), bfp = angle(rng);
+      events.push_back({xfp, afp, yfp, bfp});
+      for (int order = 1; order <= 5; ++order) {
+         std::array<double, 4> result;
+         if (std::isnan(z))
+            result = {invMap.Ata(order, xfp, afp, yfp, bfp), invMap.Yta(order, xfp, afp, yfp, bfp),
+                      invMap.Bta(order, xfp, afp, yfp, bfp), invMap.Dta(order, xfp, afp, yfp, bfp)};
+         else
+            result = {invMap.Ata(order, xfp, afp, yfp, bfp, z), invMap.Yta(order, xfp, afp, yfp, bfp, z),
+                      invMap.Bta(order, xfp, afp, yfp, bfp, z), invMap.Dta(order, xfp, afp, yfp, bfp, z)};
+
+         for (int par = 0; par < 4; ++par) {
+            double expected = EvalTerms(map[par], order, xfp, afp, yfp, bfp);
+            EXPECT_NEAR(result[par], expected, 1e-6 + 1e-6 * std::fabs(expected))
+               << "Parameter " << par << " order " << order;
+         }
+
+         // Evaluating the four parameters together gives the same floats
+         auto all =
+            std::isnan(z) ? invMap.MapAll(order, xfp, afp, yfp, bfp) : invMap.MapAll(order, xfp, afp, yfp, bfp, z);
+         for (int par = 0; par < 4; ++par)
+            EXPECT_EQ(all[par], static_cast<float>(result[par])) << "Parameter " << par << " order " << order;
+         if (order == 5)
+            expectedAll.push_back(all);
+      }
+   }
+
+   auto batch = std::isnan(z) ? invMap.MapAll(5, events) : invMap.MapAll(5, events, z);
+   EXPECT_EQ(batch, expectedAll);
+}
+} // namespace
+
+TEST(TInverseMapTest, MatchesTermByTerm)
+{
+   std::mt19937 rng(3);
+   auto map = MakeMap(rng);
+   auto fileName = WriteMap(map, "TInverseMapTest.inv");
+
+   TInverseMap invMap(fileName.c_str());
+   EXPECT_EQ(invMap.Size(), 4);
+   ExpectMap(invMap, map, rng);
+   std::remove(fileName.c_str());
+}
+
+TEST(TInverseMapTest, MultiMapMatchesTermByTermAtEachMap)
+{
+   std::mt19937 rng(5);
+   std::vector<Map> maps;
+   std::vector<std::string> files;
+   for (int i = 0; i < 3; ++i) {
+      maps.push_back(MakeMap(rng));
+      files.push_back(WriteMap(maps.back(), "TInverseMapTest" + std::to_string(i) + ".inv"));
+   }
+
+   TInverseMap invMap;
+   std::vector<Double_t> dist = {0.1, 0.5, 0.9};
+   invMap.SetDistPivotTarget(dist);
+   ASSERT_TRUE(invMap.ReadMultiMapFile(files));
+
+   // The splines go through the coefficients of each map
+   for (int i = 0; i < 3; ++i)
+      ExpectMap(invMap, maps[i], rng, dist[i]);
+
+   for (auto &file : files)
+      std::remove(file.c_str());
+}
+
+TEST(TInverseMapTest, MultiMapWithoutMaps)
+{
+   TInverseMap invMap;
+   std::vector<std::string> files;
+   EXPECT_FALSE(invMap.ReadMultiMapFile(files));
+
+   files = {"TInverseMapTest.missing.inv"};
+   EXPECT_FALSE(invMap.ReadMultiMapFile(files));
+}
@@ -13,6 +13,7 @@
  * Homepage: joachimwuttke.de/lmfit
  */
 
+#include "lmcurve.h"
 #include "lmmin.h"
 
 using lmcurve_data_struct = struct {
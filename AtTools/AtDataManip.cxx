@@ -71,22 +71,31 @@ std::unique_ptr<TF1> AtTools::GetHitFunction(const AtHit &hit, const AtDigiPar *
    return func;
 }
 
-std::unique_ptr<TF1> AtTools::GetHitFunctionTB(const AtHit &hit, const AtDigiPar *fPar)
+bool AtTools::GetHitParametersTB(const AtHit &hit, std::array<double, 3> &gaus, const AtDigiPar *fPar)
 {
    if (hit.GetPositionSigma().Z() == 0) {
       LOG(error) << "Hits that are points (sig_z = 0) are not supported yet!";
-      return nullptr;
+      return false;
    }
    if (fPar == nullptr)
       fPar = dynamic_cast<const AtDigiPar *>(FairRun::Instance()->GetRuntimeDb()->getContainer("AtDigiPar"));
 
+   auto sigma = GetDriftTB(hit.GetPositionSigma().Z(), fPar);
+   gaus[0] = hit.GetCharge() / (sigma * std::sqrt(2 * TMath::Pi()));
+   gaus[1] = GetTB(hit.GetPosition().Z(), fPar);
+   gaus[2] = sigma;
+   return true;
+}
+
+std::unique_ptr<TF1> AtTools::GetHitFunctionTB(const AtHit &hit, const AtDigiPar *fPar)
+{
+   std::array<double, 3> gaus;
+   if (!GetHitParametersTB(hit, gaus, fPar))
+      return nullptr;
+
    // Create the function we are going to set and make sure it isn't added to the global list
    auto func = std::make_unique<TF1>("hitFuncTB", "gaus", 0, 512, TF1::EAddToList::kNo);
-
-   auto ampl = hit.GetCharge() / (GetDriftTB(hit.GetPositionSigma().Z(), fPar) * std::sqrt(2 * TMath::Pi()));
-   func->SetParameter(0, ampl);
-   func->SetParameter(1, GetTB(hit.GetPosition().Z(), fPar));
-   func->SetParameter(2, GetDriftTB(hit.GetPositionSigma().Z(), fPar));
+   func->SetParameters(gaus.data());
 
    return func;
 }
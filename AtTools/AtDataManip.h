@@ -1,5 +1,6 @@
 #ifndef ATDATAMANIP_H
 #define ATDATAMANIP_H
+#include <array>
 #include <memory>
 class TF1;
 class AtHit;
@@ -17,6 +18,14 @@ namespace AtTools {
  */
 std::unique_ptr<TF1> GetHitFunctionTB(const AtHit &hit, const AtDigiPar *par = nullptr);
 
+/**
+ * @brief Get the parameters (amplitude, mean, sigma) of the gaussian returned by GetHitFunctionTB.
+ *
+ * Evaluating amp * exp(-0.5*((tb-mean)/sigma)^2) directly avoids creating a TF1 for every hit.
+ * @return false if the hit is a point (sig_z = 0).
+ */
+bool GetHitParametersTB(const AtHit &hit, std::array<double, 3> &gaus, const AtDigiPar *par = nullptr);
+
 /**
  * @brief Get charge as a function of z (mm).
  */
@@ -2,86 +2,303 @@
 
 #include <Rtypes.h>
 #include <TGraph.h>
+#include <TSystem.h>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream> // IWYU pragma: keep
+#include <functional>
 #include <iostream>
+#include <sstream>
 
 ClassImp(AtTools::AtELossManager);
 
+namespace {
+constexpr char kCacheTag[8] = "ELOSS02";  // Identifies (and versions) the binary cache of a table
+constexpr Int_t kIndexBinsPerPoint = 4;   // log(E) bins of the segment index per point of the table
+constexpr Int_t kNodesPerDecade = 1000;   // Nodes of the range and time of flight tables
+constexpr Double_t kMinEnergy = 0.01;     // The ion does not lose energy below 10 keV
+} // namespace
+
 AtTools::AtELossManager::AtELossManager()
 {
    EvD = std::make_shared<TGraph>();
 }
 
-AtTools::AtELossManager::AtELossManager(std::string Eloss_file, Double_t Mass)
+AtTools::AtELossManager::AtELossManager(std::string Eloss_file, Double_t Mass, std::string cacheDir)
 {
-   Double_t _IonEnergy = 0;
-   Double_t _dEdx_e = 0, _dEdx_n = 0;
-   Double_t _Range = 0;
-   Double_t _Stragg_lon = 0, _Stragg_lat = 0;
-   std::string aux;
-
-   std::ifstream Read(Eloss_file.c_str());
-
-   // cout << " Opening " << Eloss_file <<endl;
-   if (!Read.is_open()) {
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(Eloss_file.c_str(), stat) != 0) {
       std::cout << "*** EnergyLoss Error: File " << Eloss_file << " was not found."
                 << "\n";
       GoodELossFile = false;
-   } else {
-      GoodELossFile = true;
-      Read >> aux >> aux >> aux >> aux >> aux >> aux; // The first line has 6 strings (columns' description).
-      points = 0;
+      return;
+   }
 
-      do {
-         Read >> _IonEnergy >> _dEdx_e >> _dEdx_n >> _Range >> _Stragg_lon >> _Stragg_lat;
-         points++;
+   // Tables with the same name in different directories get different cache files
+   std::string cacheFile;
+   if (!cacheDir.empty())
+      cacheFile = cacheDir + "/" + gSystem->BaseName(Eloss_file.c_str()) + "." +
+                  std::to_string(std::hash<std::string>{}(Eloss_file)) + ".bin";
+
+   GoodELossFile = !cacheFile.empty() && ReadCache(cacheFile, stat.fMtime, stat.fSize);
+   if (!GoodELossFile) {
+      GoodELossFile = ReadTable(Eloss_file);
+      if (GoodELossFile && !cacheFile.empty())
+         WriteCache(cacheDir, cacheFile, stat.fMtime, stat.fSize);
+   }
+   if (!GoodELossFile)
+      return;
 
-      } while (!Read.eof());
+   Energy_in_range = true;
+   IonMass = Mass; // In MeV/c^2
+   c = 29.9792458; // Speed of light in cm/ns.
+   EvD = std::make_shared<TGraph>();
 
-      Read.close();
+   BuildIndex();
+   BuildRangeTables();
+}
 
-      // Go to the begining of the file and read it again to now save the info in the newly created arrays.
-      Read.open(Eloss_file.c_str());
-      Read >> aux >> aux >> aux >> aux;
+AtTools::AtELossManager::~AtELossManager() = default;
 
-      for (int p = 0; p < points; p++) {
-         Read >> _IonEnergy >> _dEdx_e >> _dEdx_n >> _Range;
+Bool_t AtTools::AtELossManager::ReadTable(const std::string &fileName)
+{
+   std::ifstream Read(fileName);
+   if (!Read.is_open()) {
+      std::cout << "*** EnergyLoss Error: File " << fileName << " was not found."
+                << "\n";
+      return false;
+   }
 
-         IonEnergy.push_back(_IonEnergy);
-         dEdx_e.push_back(_dEdx_e);
-         dEdx_n.push_back(_dEdx_n);
-         Range.push_back(_Range);
-      }
+   IonEnergy.clear();
+   dEdx_e.clear();
+   dEdx_n.clear();
+   Range.clear();
+
+   // The first line has the columns' description. Only the first four columns of each row are used
+   // (Energy, dEdx_e, dEdx_n, Range) so the straggling columns are optional.
+   std::string line;
+   std::getline(Read, line);
+   while (std::getline(Read, line)) {
+      std::istringstream row(line);
+      Double_t _IonEnergy = 0, _dEdx_e = 0, _dEdx_n = 0, _Range = 0;
+      if (!(row >> _IonEnergy >> _dEdx_e >> _dEdx_n >> _Range))
+         continue;
+
+      IonEnergy.push_back(_IonEnergy);
+      dEdx_e.push_back(_dEdx_e);
+      dEdx_n.push_back(_dEdx_n);
+      Range.push_back(_Range);
+   }
+   points = IonEnergy.size();
 
-      Energy_in_range = true;
-      IonMass = Mass; // In MeV/c^2
-      c = 29.9792458; // Speed of light in cm/ns.
-      EvD = std::make_shared<TGraph>();
+   if (points < 3 || IonEnergy.front() <= 0) {
+      std::cout << "*** EnergyLoss Error: File " << fileName << " needs at least 3 rows with positive energies."
+                << "\n";
+      return false;
    }
+   return true;
 }
 
-AtTools::AtELossManager::~AtELossManager() = default;
+Bool_t AtTools::AtELossManager::ReadCache(const std::string &fileName, Long_t mtime, Long64_t size)
+{
+   std::ifstream cache(fileName, std::ios::binary);
+   if (!cache.is_open())
+      return false;
+
+   char tag[sizeof(kCacheTag)];
+   Long_t cacheMtime = 0;
+   Long64_t cacheSize = 0;
+   Int_t cachePoints = 0;
+   cache.read(tag, sizeof(tag));
+   cache.read(reinterpret_cast<char *>(&cacheMtime), sizeof(cacheMtime));
+   cache.read(reinterpret_cast<char *>(&cacheSize), sizeof(cacheSize));
+   cache.read(reinterpret_cast<char *>(&cachePoints), sizeof(cachePoints));
+   if (!cache || std::memcmp(tag, kCacheTag, sizeof(tag)) != 0 || cacheMtime != mtime || cacheSize != size ||
+       cachePoints < 3)
+      return false;
+
+   for (auto *column : {&IonEnergy, &dEdx_e, &dEdx_n, &Range}) {
+      column->resize(cachePoints);
+      cache.read(reinterpret_cast<char *>(column->data()), cachePoints * sizeof(Double_t));
+   }
+   if (!cache)
+      return false;
 
-Double_t AtTools::AtELossManager::GetEnergyLossLinear(Double_t energy, Double_t distance)
+   points = cachePoints;
+   return true;
+}
+
+// Caching is optional, so nothing is reported if the cache can't be written. The cache is written to a
+// temporary file first so a concurrent or failed write never leaves a truncated cache behind.
+void AtTools::AtELossManager::WriteCache(const std::string &cacheDir, const std::string &fileName, Long_t mtime,
+                                         Long64_t size) const
 {
+   gSystem->mkdir(cacheDir.c_str(), true);
+   auto tmpName = fileName + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+   {
+      std::ofstream cache(tmpName, std::ios::binary);
+      if (!cache.is_open())
+         return;
+
+      cache.write(kCacheTag, sizeof(kCacheTag));
+      cache.write(reinterpret_cast<const char *>(&mtime), sizeof(mtime));
+      cache.write(reinterpret_cast<const char *>(&size), sizeof(size));
+      cache.write(reinterpret_cast<const char *>(&points), sizeof(points));
+      for (const auto *column : {&IonEnergy, &dEdx_e, &dEdx_n, &Range})
+         cache.write(reinterpret_cast<const char *>(column->data()), points * sizeof(Double_t));
+      cache.close();
+      if (cache)
+         std::rename(tmpName.c_str(), fileName.c_str());
+   }
+   std::remove(tmpName.c_str());
+}
 
-   int i = -1;
-   if (energy >= 0.01) {
-      // Look for two points for which the initial energy lays in between.  This for-loop should find the points
-      // unless there was a big jump from the energy used in the last point and the energy used now.
+void AtTools::AtELossManager::BuildIndex()
+{
+   Int_t nBins = kIndexBinsPerPoint * points;
+   fIndexLogE0 = log(IonEnergy.front());
+   fIndexBinWidth = (log(IonEnergy.back()) - fIndexLogE0) / nBins;
+   fSegmentIndex.assign(nBins, 0);
+
+   Int_t p = 0;
+   for (Int_t b = 0; b < nBins; b++) {
+      Double_t lowEdge = exp(fIndexLogE0 + b * fIndexBinWidth);
+      while (p < points - 2 && IonEnergy[p + 1] <= lowEdge)
+         p++;
+      fSegmentIndex[b] = p;
+   }
+}
+
+// Returns p such that IonEnergy[p] <= energy < IonEnergy[p + 1], or -1 if the energy is out of the table
+Int_t AtTools::AtELossManager::FindPoint(Double_t energy) const
+{
+   if (points < 3 || !(energy >= IonEnergy.front() && energy < IonEnergy.back()))
+      return -1;
+
+   Int_t b = (Int_t)((log(energy) - fIndexLogE0) / fIndexBinWidth);
+   Int_t p = fSegmentIndex[std::max(0, std::min(b, (Int_t)fSegmentIndex.size() - 1))];
+
+   // The bin only gives a starting point, this corrects for rounding and for more than one point per bin
+   while (p > 0 && energy < IonEnergy[p])
+      p--;
+   while (energy >= IonEnergy[p + 1])
+      p++;
+   return p;
+}
+
+// Range (cm) and time of flight (ns) are integrated with Simpson's rule on a grid uniform in log(E)
+void AtTools::AtELossManager::BuildRangeTables()
+{
+   fNodeE.clear();
+   fRangeTab.clear();
+   fTimeTab.clear();
+   fRangeSlope.clear();
+   fTimeSlope.clear();
+
+   fELow = std::max(IonEnergy.front(), kMinEnergy);
+   fEHigh = IonEnergy[points - 2]; // The stopping power of the last segment needs the point after it
+   if (fEHigh <= fELow)
+      return;
+
+   Int_t nNodes = std::max(2, (Int_t)ceil(kNodesPerDecade * log10(fEHigh / fELow)) + 1);
+   fNodeLogWidth = log(fEHigh / fELow) / (nNodes - 1);
+   fNodeE.resize(nNodes);
+   for (Int_t k = 0; k < nNodes; k++)
+      fNodeE[k] = fELow * exp(k * fNodeLogWidth);
+   fNodeE.back() = fEHigh;
+
+   // dx/dE in cm/MeV and dt/dE in ns/MeV
+   auto dXdE = [this](Double_t energy) {
+      Int_t p = std::min(FindPoint(energy), points - 3);
+      return 1. / (10 * StoppingPower(p + 1, energy));
+   };
+   auto dTdE = [this, &dXdE](Double_t energy) { return dXdE(energy) / (sqrt(2 * energy / IonMass) * c); };
+   Bool_t withTime = IonMass > 0;
+
+   fRangeTab.assign(nNodes, 0);
+   fRangeSlope.resize(nNodes);
+   for (Int_t k = 0; k < nNodes; k++)
+      fRangeSlope[k] = dXdE(fNodeE[k]);
+   if (withTime) {
+      fTimeTab.assign(nNodes, 0);
+      fTimeSlope.resize(nNodes);
+      for (Int_t k = 0; k < nNodes; k++)
+         fTimeSlope[k] = dTdE(fNodeE[k]);
+   }
+
+   for (Int_t k = 1; k < nNodes; k++) {
+      Double_t h = fNodeE[k] - fNodeE[k - 1];
+      Double_t mid = 0.5 * (fNodeE[k] + fNodeE[k - 1]);
+      fRangeTab[k] = fRangeTab[k - 1] + h / 6 * (fRangeSlope[k - 1] + 4 * dXdE(mid) + fRangeSlope[k]);
+      if (withTime)
+         fTimeTab[k] = fTimeTab[k - 1] + h / 6 * (fTimeSlope[k - 1] + 4 * dTdE(mid) + fTimeSlope[k]);
+   }
+}
+
+Int_t AtTools::AtELossManager::FindNode(Double_t energy) const
+{
+   Int_t k = (Int_t)(log(energy / fELow) / fNodeLogWidth);
+   return std::max(0, std::min(k, (Int_t)fNodeE.size() - 2));
+}
+
+// Cubic Hermite interpolation between fNodeE[k] and fNodeE[k + 1] of a table and its derivative (slope).
+// If dydE is not null, it is set to the derivative of the interpolation.
+Double_t AtTools::AtELossManager::Hermite(const std::vector<Double_t> &tab, const std::vector<Double_t> &slope,
+                                          Int_t k, Double_t energy, Double_t *dydE) const
+{
+   Double_t h = fNodeE[k + 1] - fNodeE[k];
+   Double_t t = (energy - fNodeE[k]) / h;
+   Double_t t2 = t * t;
+   Double_t t3 = t2 * t;
+   if (dydE)
+      *dydE = (6 * t2 - 6 * t) / h * (tab[k] - tab[k + 1]) + (3 * t2 - 4 * t + 1) * slope[k] +
+              (3 * t2 - 2 * t) * slope[k + 1];
+   return (2 * t3 - 3 * t2 + 1) * tab[k] + (t3 - 2 * t2 + t) * h * slope[k] + (3 * t2 - 2 * t3) * tab[k + 1] +
+          (t3 - t2) * h * slope[k + 1];
+}
 
-      for (int p = 0; p < points - 1; p++) {
+// Interpolation of a table tabulated at fNodeE. Below fELow it is the first entry
+Double_t AtTools::AtELossManager::InterpolateNodes(const std::vector<Double_t> &tab, const std::vector<Double_t> &slope,
+                                                   Double_t energy) const
+{
+   if (energy <= fELow)
+      return tab.front();
+   return Hermite(tab, slope, FindNode(energy), energy);
+}
 
-         if (energy >= IonEnergy[p] && energy < IonEnergy[p + 1]) {
+// Inverse of InterpolateNodes(fRangeTab, fRangeSlope, energy), by Newton's method within the node interval
+Double_t AtTools::AtELossManager::EnergyFromRange(Double_t range) const
+{
+   if (range <= 0)
+      return fELow;
+   Int_t k = std::upper_bound(fRangeTab.begin(), fRangeTab.end(), range) - fRangeTab.begin() - 1;
+   k = std::max(0, std::min(k, (Int_t)fNodeE.size() - 2));
+
+   Double_t energy =
+      fNodeE[k] + (range - fRangeTab[k]) / (fRangeTab[k + 1] - fRangeTab[k]) * (fNodeE[k + 1] - fNodeE[k]);
+   for (Int_t i = 0; i < 4; i++) {
+      Double_t dRdE = 0;
+      Double_t diff = Hermite(fRangeTab, fRangeSlope, k, energy, &dRdE) - range;
+      if (dRdE <= 0)
+         break;
+      energy -= diff / dRdE;
+   }
+   return energy;
+}
 
-            i = p + 1;
-            last_point = p;
+Double_t AtTools::AtELossManager::GetEnergyLossLinear(Double_t energy, Double_t distance)
+{
 
-            break;
-         }
+   int i = -1;
+   if (energy >= 0.01) {
+      // Look for two points for which the initial energy lays in between.
+      int p = FindPoint(energy);
+      if (p >= 0) {
+         i = p + 1;
+         last_point = p;
       }
 
       // If after this two loop i is still -1 it means the energy was out of range.
@@ -121,45 +338,34 @@ Double_t AtTools::AtELossManager::GetEnergyLossLinear(Double_t energy, Double_t
 /////////////////////////////////// SPLINE INTERPOLATION ////////////////////////////////////////////
 double AtTools::AtELossManager::GetEnergyLoss(double energy /*MeV*/, double distance /*cm*/)
 {
-   Float_t a11 = 0.0, a12 = 0.0, a21 = 0.0, a22 = 0.0, a23 = 0.0, a32 = 0.0, a33 = 0.0;
-   Float_t b11 = 0.0, b22 = 0.0, b33 = 0.0;
-   Float_t a1 = 0.0, a2 = 0.0, b1 = 0.0, b2 = 0.0;
-   Float_t K0 = 0.0, K1 = 0.0, K2 = 0.0;
-   Float_t N1 = 0.0, N2 = 0.0, N3 = 0.0;
-   Float_t T1 = 0.0, T2 = 0.0, q1 = 0.0, q2 = 0.0;
-
-   int i = -1;
    if (energy < 0.01)
       return (0);
 
-   // if(energy < 0.01){
-   // break;
-   // }
-
    // Look for two points for which the initial energy lies in between.
-   // This for-loop should find the points
-   // unless there was a big jump from the energy used in the
-   // last point and the energy used now.
+   int p = FindPoint(energy);
 
-   for (int p = 0; p < points - 1; p++) {
-
-      if (energy >= IonEnergy[p] && energy < IonEnergy[p + 1]) {
-
-         i = p + 1;
-         last_point = p;
-
-         break;
-      }
-   }
-   // If after this two loop i is still -1 it means the energy was out of range.
-
-   if (i == -1) {
+   // If p is -1 (or the last segment, which has no point after it) the energy was out of range.
+   if (p < 0 || p + 2 >= points) {
 
       std::cout << "*** EnergyLoss Error: energy not within range: " << energy << "\n";
 
       Energy_in_range = false;
       return 0;
    }
+   last_point = p;
+
+   return (StoppingPower(p + 1, energy) * 10 * distance);
+}
+
+// Total stopping power (MeV/mm) interpolated with a cubic spline between IonEnergy[i-1] and IonEnergy[i]
+Double_t AtTools::AtELossManager::StoppingPower(Int_t i, Double_t energy) const
+{
+   Float_t a11 = 0.0, a12 = 0.0, a21 = 0.0, a22 = 0.0, a23 = 0.0, a32 = 0.0, a33 = 0.0;
+   Float_t b11 = 0.0, b22 = 0.0, b33 = 0.0;
+   Float_t a1 = 0.0, a2 = 0.0, b1 = 0.0, b2 = 0.0;
+   Float_t K0 = 0.0, K1 = 0.0, K2 = 0.0;
+   Float_t N1 = 0.0, N2 = 0.0, N3 = 0.0;
+   Float_t T1 = 0.0, T2 = 0.0, q1 = 0.0, q2 = 0.0;
 
    // Ion Energy
    Float_t x0 = IonEnergy[i - 1];
@@ -210,89 +416,68 @@ double AtTools::AtELossManager::GetEnergyLoss(double energy /*MeV*/, double dist
 
    // cout<<"q1="<<q1<<" q2="<<q2<<endl;
 
-   return (q1 * 10 * distance);
+   return q1;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The energy of the ion after the path length is the energy whose remaining range is R(FinalEnergy) + PathLength.
 Double_t AtTools::AtELossManager::GetInitialEnergy(Double_t FinalEnergy /*MeV*/, Double_t PathLength /*cm*/ /*dist*/,
                                                    Double_t StepSize /*cm*/)
 {
-   Double_t Energy = FinalEnergy;
-   int Steps = (int)floor(PathLength / StepSize);
    last_point = 0;
+   Energy_in_range = !fRangeTab.empty() && FinalEnergy <= fEHigh;
 
-   // The function starts by assuming FinalEnergy is within the energy range,
-   // but this could be changed in the GetEnergyLoss() function.
-
-   Energy_in_range = true;
-
-   for (int s = 0; s < Steps; s++) {
+   if (Energy_in_range && PathLength <= 0)
+      return FinalEnergy;
 
-      Energy = Energy + GetEnergyLoss(Energy, PathLength / Steps);
-
-      if (!Energy_in_range) {
-         break;
-      }
-   }
-   Energy = Energy + GetEnergyLoss(Energy, PathLength - Steps * StepSize);
+   Double_t range = Energy_in_range ? InterpolateNodes(fRangeTab, fRangeSlope, FinalEnergy) + PathLength : 0;
+   if (range > fRangeTab.back())
+      Energy_in_range = false;
 
    if (!Energy_in_range)
-      Energy = -1000; // Return an unrealistic value.
+      return -1000; // Return an unrealistic value.
 
-   return Energy;
+   return EnergyFromRange(range);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 Double_t AtTools::AtELossManager::GetFinalEnergy(Double_t InitialEnergy /*MeV*/, Double_t PathLength /*cm*/,
                                                  Double_t StepSize /*cm*/)
 {
-
-   Double_t Energy = InitialEnergy;
-   int Steps = (int)floor(PathLength / StepSize);
-
-   // The function starts by assuming InitialEnergy is within the energy range, but
-   // this could be changes in the GetEnergyLoss() function.
-
    Energy_in_range = true;
 
-   for (int s = 0; s < Steps; s++) {
-
-      Energy = Energy - GetEnergyLoss(Energy, PathLength / Steps);
+   // There is no energy loss below 10 keV
+   if (InitialEnergy < kMinEnergy || PathLength <= 0)
+      return InitialEnergy;
 
-      if (!Energy_in_range) {
-         break;
-      }
-      // cout<<"1: ="<<Energy<< "  "<<s*StepSize<<endl;
+   if (fRangeTab.empty() || InitialEnergy < IonEnergy.front() || InitialEnergy > fEHigh) {
+      Energy_in_range = false;
+      return -1000;
    }
 
-   Energy = Energy - GetEnergyLoss(Energy, PathLength - Steps * StepSize);
+   Double_t range = InterpolateNodes(fRangeTab, fRangeSlope, InitialEnergy) - PathLength;
+   if (range >= 0)
+      return EnergyFromRange(range);
 
-   if (!Energy_in_range) {
-      Energy = -1000;
+   // The ion stops. If the table doesn't go down to 10 keV it left the table first.
+   if (IonEnergy.front() > kMinEnergy) {
+      Energy_in_range = false;
+      return -1000;
    }
-
-   //  if (PathLength == 6.0){
-   //  cout << " Get Final Energy :"<< InitialEnergy << " " << PathLength << " " << Energy << endl;
-   //}
-   return Energy;
+   return 0;
 }
 
 Double_t AtTools::AtELossManager::GetDistance(Double_t InitialE, Double_t FinalE, Double_t StepSize)
 {
-
-   Double_t dist = 0;
-   Double_t E = 0, Elast = 0;
-   // Double_t  Tolerance = 0.01;
-
-   E = InitialE;
-
-   while (E > FinalE) {
-      dist += StepSize;
-      Elast = E;
-      E = E - GetEnergyLoss(E, StepSize);
+   if (fRangeTab.empty() || InitialE > fEHigh) {
+      std::cout << "*** EnergyLoss Error: energy not within range: " << InitialE << "\n";
+      Energy_in_range = false;
+      return 0;
    }
+   if (InitialE <= FinalE)
+      return 0;
 
-   return ((dist - StepSize) - (StepSize * (Elast - FinalE) / (E - Elast)));
+   return InterpolateNodes(fRangeTab, fRangeSlope, InitialE) - InterpolateNodes(fRangeTab, fRangeSlope, FinalE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -301,82 +486,27 @@ Double_t AtTools::AtELossManager::GetDistance(Double_t InitialE, Double_t FinalE
 Double_t AtTools::AtELossManager::GetPathLength(Float_t InitialEnergy /*MeV*/, Float_t FinalEnergy /*MeV*/,
                                                 Float_t DeltaT /*ns*/)
 {
-   Double_t L = 0, DeltaX = 0;
-   Double_t Kn = InitialEnergy;
-   Double_t Kn1 = InitialEnergy;
-   Int_t n = 0;
-
-   if (IonMass == 0)
+   if (IonMass == 0) {
       std::cout << "*** EnergyLoss Error: Path length cannot be calculated for IonMass = 0."
                 << "\n";
-   else {
-
-      // The path length (L) is proportional to sqrt(Kn).
-      // After the sum, L will be multiplied by the proportionality factor.
-
-      while (Kn > FinalEnergy && Kn1 > FinalEnergy && n < (int)pow(10.0, 6)) {
-
-         // L += sqrt(Kn); // 2016-06-15 changed
-         L += sqrt((Kn + Kn1) / 2) * sqrt(2 / IonMass) * DeltaT * c; // DeltaL going from point n to n+1.
-         // cout<<"1 = "<<Kn<<"  "<<Kn1<<endl;
-
-         ////DeltaX = sqrt(2*Kn/IonMass)*DeltaT*c; // dx = v*dt// 2016-06-15 changed
-         DeltaX = sqrt((Kn + Kn1) / IonMass) * DeltaT * c;
-
-         Kn1 = Kn;
-         // Kn -= GetEnergyLoss(Kn,DeltaX); // 2016-06-15 changed
-         Kn -= GetEnergyLoss((Kn + Kn1) / 2, DeltaX); // After L is incremented the kinetic energy at n+1 is calculated.
-         // cout<<"2 = "<<Kn<<"  "<<Kn1<<endl;
-         // outfile4 << Kn << "\t" << L << endl;
-         n++;
-      }
-      if (n >= (int)pow(10.0, 6)) {
-         std::cout << "*** EnergyLoss Warning: Full path length wasn't reached after 10^6 iterations."
-                   << "\n";
-         L = 0;
-      } else
-         // L *= sqrt(2/IonMass)*DeltaT*c;
-         L *= 1.0;
+      return 0;
    }
-   return L;
+   return GetDistance(InitialEnergy, FinalEnergy, 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
 Double_t AtTools::AtELossManager::LoadRange(Float_t energy1)
 {
-   Int_t i = -1;
-   Double_t Range1 = 0;
-
-   if (energy1 >= 0.01) { // greater than= 10 keV
-
-      for (Int_t p = last_point1 - 1; p < points1 - 1; p++) {
-         if (last_point1 >= 0)
-            if (energy1 >= IonEnergy[p] && energy1 < IonEnergy[p + 1]) {
-               i = p + 1;
-               last_point1 = p;
-               break;
-            }
-      }
-
-      if (i == -1) {
-         for (Int_t p = 0; p < last_point1 - 1; p++) {
-            if (energy1 >= IonEnergy[p] && energy1 < IonEnergy[p + 1]) {
-               i = p + 1;
-               last_point1 = p;
-               break;
-            }
-         }
-      }
+   if (energy1 < 0.01) // less than 10 keV
+      return 0;
 
-      if (i == -1) {
-         std::cout << "*** EnergyLoss Error: energy not within range: " << energy1 << "\n";
-         Energy_in_range = false;
-         return 0;
-      }
-      Range1 = Range[i];
-      return Range1;
+   Int_t p = FindPoint(energy1);
+   if (p < 0) {
+      std::cout << "*** EnergyLoss Error: energy not within range: " << energy1 << "\n";
+      Energy_in_range = false;
+      return 0;
    }
-   return (0);
+   return Range[p + 1];
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -385,31 +515,29 @@ Double_t AtTools::AtELossManager::LoadRange(Float_t energy1)
 
 Double_t AtTools::AtELossManager::GetTimeOfFlight(Double_t InitialEnergy, Double_t PathLength, Double_t StepSize)
 {
-   Double_t TOF = 0;
-   Double_t Kn = InitialEnergy;
-   int Steps = (int)(PathLength / StepSize);
-
    if (IonMass == 0) {
       std::cout << "Error: Time of flight cannot be calculated because mass is zero."
                 << "\n";
+      return 0;
    }
-
-   else {
-
-      for (int n = 0; n < Steps; n++) {
-
-         TOF += sqrt(IonMass / (2 * Kn)) * StepSize / c; // DeltaT going from point n to n+1.
-         Kn -= GetEnergyLoss(Kn, StepSize);              // After the TOF is added the K.E. at point n+1 is calc.}
-      }
-      return TOF;
+   if (fTimeTab.empty() || InitialEnergy > fEHigh) {
+      std::cout << "*** EnergyLoss Error: energy not within range: " << InitialEnergy << "\n";
+      Energy_in_range = false;
+      return 0;
    }
-   return (0);
+
+   Double_t range = InterpolateNodes(fRangeTab, fRangeSlope, InitialEnergy) - PathLength;
+   Double_t FinalEnergy = EnergyFromRange(range);
+   return InterpolateNodes(fTimeTab, fTimeSlope, InitialEnergy) - InterpolateNodes(fTimeTab, fTimeSlope, FinalEnergy);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void AtTools::AtELossManager::SetIonMass(Double_t Mass)
 {
    IonMass = Mass;
+   // The time of flight table depends on the mass
+   if (GoodELossFile)
+      BuildRangeTables();
 }
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Lookup Table Extension
@@ -21,11 +21,23 @@ class TMemberInspector;
 
 namespace AtTools {
 
+/**
+ * Energy loss from a SRIM/LISE table (Energy, dEdx_e, dEdx_n, Range, ...) in MeV and MeV/mm.
+ *
+ * The table segment containing an energy is found in constant time through an index binned in log(E).
+ * The range and time of flight are integrated once over a log(E) grid when the table is loaded so the
+ * final/initial energy, distance, path length and time of flight come from interpolating (or inverting)
+ * these cumulative tables instead of stepping through the material. The StepSize/DeltaT arguments are
+ * kept for compatibility and no longer used.
+ *
+ * If a cache directory is given, the parsed table is cached there in a binary file and reused as long as
+ * the text file is not modified. The cache is skipped without notice if it can't be read or written.
+ */
 class AtELossManager : public TObject {
 
 public:
    AtELossManager();
-   AtELossManager(std::string Eloss_file, Double_t Mass);
+   AtELossManager(std::string Eloss_file, Double_t Mass, std::string cacheDir = "");
    ~AtELossManager();
 
    Double_t GetEnergyLossLinear(Double_t energy, Double_t distance);
@@ -62,12 +74,40 @@ private:
 
    Int_t points{0};
    Int_t last_point{0};
-   Int_t points1{0};
-   Int_t last_point1{0};
    Bool_t Energy_in_range{true};
    Bool_t GoodELossFile{false};
 
-   ClassDef(AtELossManager, 1)
+   // Index of the table segment containing the low edge of each log(E) bin
+   std::vector<Int_t> fSegmentIndex; //!
+   Double_t fIndexLogE0{0};          //!
+   Double_t fIndexBinWidth{1};       //!
+
+   // Range (cm) and time of flight (ns) to slow down to fELow, and their derivatives with respect to the energy,
+   // tabulated at fNodeE (uniform in log(E))
+   std::vector<Double_t> fNodeE;      //!
+   std::vector<Double_t> fRangeTab;   //!
+   std::vector<Double_t> fTimeTab;    //!
+   std::vector<Double_t> fRangeSlope; //!
+   std::vector<Double_t> fTimeSlope;  //!
+   Double_t fELow{0};                 //!
+   Double_t fEHigh{0};                //!
+   Double_t fNodeLogWidth{1};         //!
+
+   Bool_t ReadTable(const std::string &fileName);
+   Bool_t ReadCache(const std::string &fileName, Long_t mtime, Long64_t size);
+   void WriteCache(const std::string &cacheDir, const std::string &fileName, Long_t mtime, Long64_t size) const;
+   void BuildIndex();
+   void BuildRangeTables();
+   Int_t FindPoint(Double_t energy) const;
+   Double_t StoppingPower(Int_t i, Double_t energy) const;
+   Int_t FindNode(Double_t energy) const;
+   Double_t Hermite(const std::vector<Double_t> &tab, const std::vector<Double_t> &slope, Int_t k, Double_t energy,
+                    Double_t *dydE = nullptr) const;
+   Double_t InterpolateNodes(const std::vector<Double_t> &tab, const std::vector<Double_t> &slope,
+                             Double_t energy) const;
+   Double_t EnergyFromRange(Double_t range) const;
+
+   ClassDef(AtELossManager, 2)
 };
 } // namespace AtTools
 
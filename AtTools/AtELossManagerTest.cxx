@@ -0,0 +1,114 @@
+#include "AtELossManager.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+constexpr double kMass = 938.272;   // Proton [MeV/c^2]
+constexpr double kC = 29.9792458;   // [cm/ns]
+constexpr double kEulerStep = 1e-6; // [cm]
+
+/// Table of a proton in a gas, with a Bragg peak at about 60 keV [MeV, MeV/mm, MeV/mm, mm]
+std::string WriteTable(const std::string &fileName)
+{
+   std::ofstream out(fileName);
+   out << "Energy dEdx_e dEdx_n Range\n";
+   double range = 0;
+   double lastE = 0;
+   for (double E = 0.001; E < 30; E *= 1.1) {
+      double dEdx_e = 0.02 * E / (std::pow(E, 1.75) + std::pow(0.05, 1.75));
+      double dEdx_n = 1e-4 * std::exp(-E / 0.01);
+      range += (E - lastE) / (dEdx_e + dEdx_n);
+      lastE = E;
+      out << E << " " << dEdx_e << " " << dEdx_n << " " << range << "\n";
+   }
+   return fileName;
+}
+
+/// Euler stepping through the material, like AtELossManager did before the range tables
+double EulerFinalEnergy(AtTools::AtELossManager &eloss, double energy, double distance)
+{
+   auto steps = std::lround(distance / kEulerStep);
+   for (long s = 0; s < steps; ++s)
+      energy -= eloss.GetEnergyLoss(energy, kEulerStep);
+   return energy;
+}
+
+double EulerDistance(AtTools::AtELossManager &eloss, double initialE, double finalE)
+{
+   double dist = 0;
+   double E = initialE;
+   double last = E;
+   while (E > finalE) {
+      dist += kEulerStep;
+      last = E;
+      E -= eloss.GetEnergyLoss(E, kEulerStep);
+   }
+   return dist - kEulerStep * (E - finalE) / (E - last);
+}
+
+double EulerTimeOfFlight(AtTools::AtELossManager &eloss, double energy, double distance)
+{
+   double tof = 0;
+   auto steps = std::lround(distance / kEulerStep);
+   for (long s = 0; s < steps; ++s) {
+      tof += std::sqrt(kMass / (2 * energy)) * kEulerStep / kC;
+      energy -= eloss.GetEnergyLoss(energy, kEulerStep);
+   }
+   return tof;
+}
+
+class AtELossManagerTest : public ::testing::Test {
+protected:
+   std::string fFile;
+
+   void SetUp() override { fFile = WriteTable("AtELossManagerTest.txt"); }
+   void TearDown() override { std::remove(fFile.c_str()); }
+};
+} // namespace
+
+TEST_F(AtELossManagerTest, RangeTablesMatchEulerStepping)
+{
+   AtTools::AtELossManager eloss(fFile, kMass);
+
+   for (double E : {0.5, 2., 8.}) {
+      for (double distance : {0.1, 0.5, 2.}) {
+         double finalE = EulerFinalEnergy(eloss, E, distance);
+         if (finalE < 0.1)
+            continue;
+         EXPECT_NEAR(eloss.GetFinalEnergy(E, distance, 0.01), finalE, 1e-6) << E << " MeV over " << distance << " cm";
+         EXPECT_NEAR(eloss.GetInitialEnergy(finalE, distance, 0.01), E, 1e-6) << E << " MeV over " << distance << " cm";
+         EXPECT_NEAR(eloss.GetTimeOfFlight(E, distance, 0.01), EulerTimeOfFlight(eloss, E, distance),
+                     1e-6 * EulerTimeOfFlight(eloss, E, distance))
+            << E << " MeV over " << distance << " cm";
+      }
+      EXPECT_NEAR(eloss.GetDistance(E, 0.9 * E, 0.01), EulerDistance(eloss, E, 0.9 * E), 1e-6) << E << " MeV";
+   }
+}
+
+TEST_F(AtELossManagerTest, Cache)
+{
+   auto dir = std::filesystem::temp_directory_path() / "AtELossManagerTest";
+   std::filesystem::remove_all(dir);
+
+   AtTools::AtELossManager noCache(fFile, kMass);
+   AtTools::AtELossManager written(fFile, kMass, dir.string());
+   ASSERT_TRUE(std::filesystem::is_directory(dir));
+   EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 1);
+
+   // The table is the same when read from the cache, or from the text file if the cache can't be used
+   std::filesystem::path unusable = "/proc/AtELossManagerTest";
+   AtTools::AtELossManager read(fFile, kMass, dir.string());
+   AtTools::AtELossManager skipped(fFile, kMass, unusable.string());
+   for (auto *eloss : {&written, &read, &skipped}) {
+      EXPECT_EQ(eloss->GetFinalEnergy(3, 2, 0.01), noCache.GetFinalEnergy(3, 2, 0.01));
+      EXPECT_EQ(eloss->GetEnergyLoss(1, 0.1), noCache.GetEnergyLoss(1, 0.1));
+      EXPECT_EQ(eloss->LoadRange(1), noCache.LoadRange(1));
+   }
+   std::filesystem::remove_all(dir);
+}
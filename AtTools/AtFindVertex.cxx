@@ -16,7 +16,6 @@ Move this to Fitter folder, the vertex determination will go with the fitter
 #include <cmath>    // for sqrt
 #include <iostream> // for operator<<, basic_ostream::operator<<
 #include <iterator> // for back_insert_iterator, back_inserter
-#include <memory>   // for shared_ptr, __shared_ptr_access, __sha...
 #include <utility>  // for pair
 
 constexpr auto cRED = "\033[1;31m";
@@ -24,22 +23,21 @@ constexpr auto cYELLOW = "\033[1;33m";
 constexpr auto cNORMAL = "\033[0m";
 constexpr auto cGREEN = "\033[1;32m";
 
+namespace {
+AtFindVertex::Line ToLine(const std::vector<Double_t> &par)
+{
+   return {par.at(0), par.at(1), par.at(2), par.at(3), par.at(4), par.at(5)};
+}
+} // namespace
+
 AtFindVertex::AtFindVertex(Double_t lineDistThreshold) : fLineDistThreshold(lineDistThreshold), fTracksFromVertex(0)
 {
-   fBeamPoint.SetXYZ(0, 0, 500);
-   fBeamDir.SetXYZ(0, 0, 1);
-   fBeamLine.resize(6);
-   fBeamLine[0] = fBeamPoint.X();
-   fBeamLine[1] = fBeamPoint.Y();
-   fBeamLine[2] = fBeamPoint.Z();
-   fBeamLine[3] = fBeamDir.X();
-   fBeamLine[4] = fBeamDir.Y();
-   fBeamLine[5] = fBeamDir.Z();
+   SetBeam({0, 0, 500}, {0, 0, 1});
 }
 
 AtFindVertex::~AtFindVertex() = default;
 
-void AtFindVertex::FindVertex(std::vector<AtTrack> tracks, Int_t nbTracksPerVtx)
+void AtFindVertex::FindVertex(const std::vector<AtTrack> &tracks, Int_t nbTracksPerVtx)
 {
    if (tracks.size() < nbTracksPerVtx)
       return;
@@ -49,62 +47,57 @@ void AtFindVertex::FindVertex(std::vector<AtTrack> tracks, Int_t nbTracksPerVtx)
    }
 }
 
-void AtFindVertex::FindVertexSingleLine(std::vector<AtTrack> tracks)
+void AtFindVertex::FindVertexSingleLine(const std::vector<AtTrack> &tracks)
 {
-   std::vector<std::vector<Double_t>> lines;
-   std::vector<Int_t> itracks;
-   Int_t it = -1;
-   for (auto track : tracks) {
-      it++;
-      auto ransacLine = dynamic_cast<const AtPatterns::AtPatternLine *>(track.GetPattern());
-      std::vector<Double_t> patternPar;
-      patternPar = ransacLine->GetPatternPar();
+   fLines.clear();
+   fTrackIdx.clear();
+   for (Int_t it = 0; it < tracks.size(); it++) {
+      auto ransacLine = dynamic_cast<const AtPatterns::AtPatternLine *>(tracks[it].GetPattern());
+      const auto &patternPar = ransacLine->GetPatternPar();
       if (patternPar.size() == 0)
          continue;
-      lines.push_back(patternPar);
-      itracks.push_back(it);
+      fLines.push_back(ToLine(patternPar));
+      fTrackIdx.push_back(it);
    }
    std::vector<std::pair<Int_t, XYZVector>> cogVtx;
-   cogVtx = CoGVtxSingleTrack(lines, itracks);
+   cogVtx = CoGVtxSingleTrack(fLines, fTrackIdx);
    // for(Int_t i =0; i<cogVtx.size(); i++)std::cout<<cogVtx.size()<<" check cogVtx size "<<cogVtx.at(i).second.X()<<"
    // "<<cogVtx.at(i).second.Y()<<" "<<cogVtx.at(i).second.Z()<<std::endl;
 
    for (auto &[num, pos] : cogVtx) {
       if (pos.Z() <= 0 || pos.Z() >= 1000 || sqrt(pos.Perp2()) > 30)
          continue;
-      std::vector<AtTrack> tracksVtx;
-      tracksVtx.push_back(tracks.at(num));
       tracksFromVertex tv;
       tv.vertex = pos;
-      tv.tracks = tracksVtx;
-      SetTracksVertex(tv);
+      tv.tracks.push_back(&tracks.at(num));
+      SetTracksVertex(std::move(tv));
    }
 }
 
-void AtFindVertex::FindVertexMultipleLines(std::vector<AtTrack> tracks, Int_t nbTracksPerVtx)
+void AtFindVertex::FindVertexMultipleLines(const std::vector<AtTrack> &tracks, Int_t nbTracksPerVtx)
 {
-   std::vector<std::vector<Double_t>> lines;
-   std::vector<Double_t> wlines; // weights for CoG (ex: Chi2, chargeTot, nbInliners...)
-   for (auto track : tracks) {
-      auto ransacLine = dynamic_cast<const AtPatterns::AtPatternLine *>(track.GetPattern());
-      std::vector<Double_t> patternPar;
-      patternPar = ransacLine->GetPatternPar();
+   fLines.clear();
+   fWeights.clear(); // weights for CoG (ex: Chi2, chargeTot, nbInliners...)
+   fTrackIdx.clear();
+   for (Int_t it = 0; it < tracks.size(); it++) {
+      auto ransacLine = dynamic_cast<const AtPatterns::AtPatternLine *>(tracks[it].GetPattern());
+      const auto &patternPar = ransacLine->GetPatternPar();
       if (patternPar.size() == 0)
          continue;
-      lines.push_back(patternPar);
-      wlines.push_back(ransacLine->GetChi2());
-      // wlines.push_back(ransacLine->GetNumPoints());
-      // wlines.push_back(1.);
+      fLines.push_back(ToLine(patternPar));
+      fWeights.push_back(ransacLine->GetChi2());
+      fTrackIdx.push_back(it);
+      // fWeights.push_back(ransacLine->GetNumPoints());
+      // fWeights.push_back(1.);
    }
 
-   std::vector<AtTrack> tracksFromSameVtx;  // save tracks coming from a common vertex
    std::vector<std::vector<Int_t>> vtxCand; // save track ID of tracks coming from a common vertex
-   vtxCand = SortTrackSameVtx(lines);
+   vtxCand = SortTrackSameVtx(fLines);
    for (Int_t i = 0; i < vtxCand.size(); i++)
       std::cout << vtxCand.size() << " check vtxCand size " << vtxCand.at(i).size() << std::endl;
 
    std::vector<XYZVector> cogVtx;
-   cogVtx = CoGVtx(vtxCand, lines, wlines);
+   cogVtx = CoGVtx(vtxCand, fLines, fWeights);
    // for(Int_t i =0; i<cogVtx.size(); i++)std::cout<<cogVtx.size()<<" check cogVtx size "<<cogVtx.at(i).X()<<"
    // "<<cogVtx.at(i).Y()<<" "<<cogVtx.at(i).Z()<<std::endl;
 
@@ -120,58 +113,127 @@ void AtFindVertex::FindVertexMultipleLines(std::vector<AtTrack> tracks, Int_t nb
       if (vtxCand.at(i).size() > nbTracksPerVtx)
          std::cout << cYELLOW << " vtx with more than " << nbTracksPerVtx << " tracks(" << vtxCand.at(i).size() << ")"
                    << cNORMAL << std::endl;
-      std::vector<AtTrack> tracksVtx;
-      for (auto vtxInd : vtxCand.at(i)) {
-         tracksVtx.push_back(tracks.at(vtxInd));
-      }
       tracksFromVertex tv;
       tv.vertex = cogVtx.at(i);
-      tv.tracks = tracksVtx;
-      SetTracksVertex(tv);
+      for (auto vtxInd : vtxCand.at(i))
+         tv.tracks.push_back(&tracks.at(fTrackIdx.at(vtxInd)));
+      SetTracksVertex(std::move(tv));
+   }
+}
+
+void AtFindVertex::FillLinePairs(const std::vector<Line> &lines)
+{
+   const size_t n = lines.size();
+   fNumLines = n;
+
+   // Store the lines by component so the inner loop of the kernel runs over contiguous arrays
+   fComp.resize(7 * n);
+   Double_t *px = fComp.data();
+   Double_t *py = px + n;
+   Double_t *pz = py + n;
+   Double_t *dx = pz + n;
+   Double_t *dy = dx + n;
+   Double_t *dz = dy + n;
+   Double_t *dMag = dz + n;
+   for (size_t i = 0; i < n; i++) {
+      px[i] = lines[i][0];
+      py[i] = lines[i][1];
+      pz[i] = lines[i][2];
+      dx[i] = lines[i][3];
+      dy[i] = lines[i][4];
+      dz[i] = lines[i][5];
+      dMag[i] = sqrt(dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i]);
    }
+
+   // Same operations as distLines and angLines so the results are identical
+   fPairDist.assign(n * n, 0);
+   fPairAng.assign(n * n, 0);
+   for (size_t i = 0; i < n; i++) {
+      Double_t *dist = fPairDist.data() + i * n;
+      Double_t *ang = fPairAng.data() + i * n;
+      for (size_t j = i + 1; j < n; j++) {
+         Double_t nx = dy[i] * dz[j] - dz[i] * dy[j];
+         Double_t ny = dz[i] * dx[j] - dx[i] * dz[j];
+         Double_t nz = dx[i] * dy[j] - dy[i] * dx[j];
+         Double_t dot = nx * (px[i] - px[j]) + ny * (py[i] - py[j]) + nz * (pz[i] - pz[j]);
+         dist[j] = fabs(dot / sqrt(nx * nx + ny * ny + nz * nz));
+         Double_t cosAng = (dx[i] * dx[j] + dy[i] * dy[j] + dz[i] * dz[j]) / (dMag[i] * dMag[j]);
+         ang[j] = acos(cosAng) * 180. / 3.1415;
+      }
+   }
+   for (size_t i = 0; i < n; i++) {
+      for (size_t j = i + 1; j < n; j++) {
+         fPairDist[j * n + i] = fPairDist[i * n + j];
+         fPairAng[j * n + i] = fPairAng[i * n + j];
+      }
+   }
+
+   fBeamDist.resize(n);
+   fBeamProj.resize(n);
+   for (size_t i = 0; i < n; i++) {
+      fBeamDist[i] = distLines(lines[i], fBeamLine);
+      fBeamProj[i] = ClosestPointProjOnLines(lines[i], fBeamLine);
+   }
+
+   fPairLines = lines;
+   fPairsValid = true;
 }
 
-std::vector<std::vector<Int_t>> AtFindVertex::SortTrackSameVtx(std::vector<std::vector<Double_t>> lines)
+void AtFindVertex::UpdateLinePairs(const std::vector<Line> &lines)
+{
+   // CoGVtx runs on the lines just sorted by SortTrackSameVtx, so the tables are only filled once per event
+   if (!fPairsValid || lines != fPairLines)
+      FillLinePairs(lines);
+}
+
+std::vector<std::vector<Int_t>> AtFindVertex::SortTrackSameVtx(const std::vector<Line> &lines)
 {
    std::vector<std::vector<Int_t>> result;
    std::vector<Int_t> paired;
    std::vector<XYZVector> vtx;
+   if (lines.size() < 2)
+      return result;
+
+   UpdateLinePairs(lines);
+   fPaired.assign(lines.size(), false);
+   auto addPaired = [this, &paired](Int_t i) {
+      paired.push_back(i);
+      fPaired[i] = true;
+   };
 
    // Test lines against each others
    for (Int_t i = 0; i < lines.size() - 1; i++) {
-      if (std::find(paired.begin(), paired.end(), i) != paired.end())
+      if (fPaired[i])
          continue;
-      std::vector<Double_t> line = lines.at(i);
 
       for (Int_t j = i + 1; j < lines.size(); j++) {
-         if (std::find(paired.begin(), paired.end(), j) != paired.end())
+         if (fPaired[j])
             continue;
 
          XYZVector buffVtx(0., 0., 9999.);
-         std::vector<Double_t> line_f = lines.at(j);
 
          if (vtx.size() == 0) { // if no vertex found
-            Double_t angle = angLines(line, line_f);
-            Double_t dist = distLines(line, line_f);
+            Double_t angle = PairAng(i, j);
+            Double_t dist = PairDist(i, j);
 
             if (dist < fLineDistThreshold) { // lines.at(i) and lines.at(j) close enough to make a new vertex
                if (angle < 10 || angle > 170) {
-                  XYZVector vtxLines1 = ClosestPoint2Lines(line, fBeamLine);
-                  XYZVector vtxLines2 = ClosestPoint2Lines(line_f, fBeamLine);
+                  XYZVector vtxLines1 = 0.5 * (fBeamProj[i][0] + fBeamProj[i][1]);
+                  XYZVector vtxLines2 = 0.5 * (fBeamProj[j][0] + fBeamProj[j][1]);
                   buffVtx = 0.5 * (vtxLines1 + vtxLines2);
                } else {
-                  buffVtx = ClosestPoint2Lines(line, line_f);
+                  buffVtx = ClosestPoint2Lines(lines[i], lines[j]);
                }
                // std::cout<<" paired size "<<paired.size()<<" "<<i<<" "<<j<<" "<<std::endl;
-               paired.push_back(i);
-               paired.push_back(j);
+               addPaired(i);
+               addPaired(j);
                vtx.push_back(buffVtx);
             }
          } else { // if already a vertex
             // std::cout<<" paired size "<<paired.size()<<" "<<i<<" "<<j<<" "<<std::endl;
             XYZVector projVtx;
-            projVtx = ptOnLine(
-               line_f, vtx.back()); // vtx.back() assumes one only wants events with one vertex, but it can be modified
+            // vtx.back() assumes one only wants events with one vertex, but it can be modified
+            projVtx = ptOnLine(lines[j], vtx.back());
             Double_t dist1 =
                sqrt((vtx.back() - projVtx).Mag2()); // distance between saved vtx and its projection on the new line
             Double_t radProjVtx = sqrt((0.5 * (vtx.back() + projVtx)).Perp2());
@@ -179,10 +241,9 @@ std::vector<std::vector<Int_t>> AtFindVertex::SortTrackSameVtx(std::vector<std::
             // "<<vtx.back().Z()<<" "<<projVtx.X()<<" "<<projVtx.Y()<<" "<<projVtx.Z()<<std::endl;
             if (dist1 < fLineDistThreshold &&
                 radProjVtx <= 30.) { // more than 2 lines from a same vertex in the beam region
-               if (std::find(paired.begin(), paired.end(), i) == paired.end()) {
-                  paired.push_back(i);
-               }
-               paired.push_back(j);
+               if (!fPaired[i])
+                  addPaired(i);
+               addPaired(j);
             }
          }
       } // j loop lines
@@ -190,72 +251,56 @@ std::vector<std::vector<Int_t>> AtFindVertex::SortTrackSameVtx(std::vector<std::
    if (paired.size() > 1)
       result.push_back(paired);
 
-   // for (size_t ipaired = 0; ipaired < paired.size(); ipaired++) {
-   //   std::cout<<paired.at(ipaired)<<std::endl;
-   // }
-
    return result;
 }
 
 std::vector<std::pair<Int_t, XYZVector>>
-AtFindVertex::CoGVtxSingleTrack(std::vector<std::vector<Double_t>> lines, std::vector<Int_t> itracks)
+AtFindVertex::CoGVtxSingleTrack(const std::vector<Line> &lines, const std::vector<Int_t> &itracks)
 {
    std::vector<std::pair<Int_t, XYZVector>> result;
+   UpdateLinePairs(lines);
    for (Int_t i = 0; i < lines.size(); i++) {
-      XYZVector vtx(0, 0, 0);
-      // std::cout<<lines.size()<<" check lines size "<<std::endl;
-      std::vector<Double_t> line = lines.at(i);
-      // Double_t angle = angLines(line, fBeamLine);
-      Double_t dist = distLines(line, fBeamLine);
-      if (dist < fLineDistThreshold) {
-         std::vector<XYZVector> projVtxOnLines1 = ClosestPointProjOnLines(line, fBeamLine);
-         vtx = projVtxOnLines1.at(
-            0); // this way the track angle is better than taking the CoG, the uncertainty on the range is not improved
-         auto p = std::make_pair(itracks.at(i), vtx);
-         result.push_back(p);
+      // Double_t angle = angLines(lines[i], fBeamLine);
+      if (fBeamDist[i] < fLineDistThreshold) {
+         // this way the track angle is better than taking the CoG, the uncertainty on the range is not improved
+         result.emplace_back(itracks.at(i), fBeamProj[i][0]);
       }
    } // loop i
 
    return result;
 }
 
-std::vector<XYZVector> AtFindVertex::CoGVtx(std::vector<std::vector<Int_t>> vtxCand,
-                                            std::vector<std::vector<Double_t>> lines, std::vector<Double_t> wlines)
+std::vector<XYZVector> AtFindVertex::CoGVtx(const std::vector<std::vector<Int_t>> &vtxCand,
+                                            const std::vector<Line> &lines, const std::vector<Double_t> &wlines)
 {
    std::vector<XYZVector> result;
+   UpdateLinePairs(lines);
+
+   // sum of points corresponding to where are the closest distances between each lines
+   std::vector<XYZVector> sumVtx;
 
    // loop on vtx Candidates
-   for (auto iv : vtxCand) {
+   for (const auto &iv : vtxCand) {
 
       XYZVector CoG(0, 0, 0);
-
-      std::vector<XYZVector> sumVtx; // sum of points corresponding to where are the closest distances between each
-                                     // lines
-      XYZVector buffVec1(0, 0, 0);
-      sumVtx.resize(iv.size(), buffVec1);
+      sumVtx.assign(iv.size(), XYZVector(0, 0, 0));
 
       for (Int_t i = 0; i < iv.size() - 1; i++) {
          Int_t ii = iv.at(i);
-         std::vector<Double_t> line = lines.at(ii);
 
          for (Int_t j = i + 1; j < iv.size(); j++) {
             Int_t jj = iv.at(j);
-            std::vector<Double_t> line_f = lines.at(jj);
 
-            Double_t angle = angLines(line, line_f);
-            Double_t dist = distLines(line, line_f);
+            Double_t angle = PairAng(ii, jj);
+            Double_t dist = PairDist(ii, jj);
             if (dist < fLineDistThreshold) {
                if (angle < 10 || angle > 170) {
-                  std::vector<XYZVector> projVtxOnLines1 = ClosestPointProjOnLines(line, fBeamLine);
-                  std::vector<XYZVector> projVtxOnLines2 = ClosestPointProjOnLines(line_f, fBeamLine);
-                  sumVtx.at(i) += projVtxOnLines1.at(0);
-                  sumVtx.at(j) += projVtxOnLines2.at(0);
+                  sumVtx.at(i) += fBeamProj[ii][0];
+                  sumVtx.at(j) += fBeamProj[jj][0];
                } else {
-                  std::vector<XYZVector> projVtxOnLines = ClosestPointProjOnLines(line, line_f);
-                  sumVtx.at(i) += projVtxOnLines.at(0);
-                  sumVtx.at(j) += projVtxOnLines.at(1);
-                  // std::cout<<"check CoG "<<line.at(0)<<" "<<line.at(1)<<" "<<line_f.at(0)<<"
-                  // "<<line_f.at(1)<<std::endl;
+                  auto projVtxOnLines = ClosestPointProjOnLines(lines[ii], lines[jj]);
+                  sumVtx.at(i) += projVtxOnLines[0];
+                  sumVtx.at(j) += projVtxOnLines[1];
                }
             }
          } // End of track_f (for loop j)
@@ -278,49 +323,37 @@ std::vector<XYZVector> AtFindVertex::CoGVtx(std::vector<std::vector<Int_t>> vtxC
 }
 
 // returns the mean point at the closest distance between two lines
-XYZVector AtFindVertex::ClosestPoint2Lines(std::vector<Double_t> line1, std::vector<Double_t> line2)
+XYZVector AtFindVertex::ClosestPoint2Lines(const Line &line1, const Line &line2)
 {
-   XYZVector p1(line1.at(0), line1.at(1), line1.at(2));
-   XYZVector d1(line1.at(3), line1.at(4), line1.at(5));
-   XYZVector p2(line2.at(0), line2.at(1), line2.at(2));
-   XYZVector d2(line2.at(3), line2.at(4), line2.at(5));
-   XYZVector n1 = d1.Cross(d2.Cross(d1));
-   XYZVector n2 = d2.Cross(d1.Cross(d2));
-   Double_t t1 = (p2 - p1).Dot(n2) / (d1.Dot(n2));
-   Double_t t2 = (p1 - p2).Dot(n1) / (d2.Dot(n1));
-   XYZVector c1 = p1 + t1 * d1;
-   XYZVector c2 = p2 + t2 * d2;
-   XYZVector meanpoint = 0.5 * (c1 + c2);
+   auto proj = ClosestPointProjOnLines(line1, line2);
+   XYZVector meanpoint = 0.5 * (proj[0] + proj[1]);
 
    return meanpoint;
 }
 
 // returns the projections on each lines of the mean point at the closest distance between two lines
-std::vector<XYZVector> AtFindVertex::ClosestPointProjOnLines(std::vector<Double_t> line1, std::vector<Double_t> line2)
+std::array<XYZVector, 2> AtFindVertex::ClosestPointProjOnLines(const Line &line1, const Line &line2)
 {
-   std::vector<XYZVector> result;
-   XYZVector p1(line1.at(0), line1.at(1), line1.at(2));
-   XYZVector d1(line1.at(3), line1.at(4), line1.at(5));
-   XYZVector p2(line2.at(0), line2.at(1), line2.at(2));
-   XYZVector d2(line2.at(3), line2.at(4), line2.at(5));
+   XYZVector p1(line1[0], line1[1], line1[2]);
+   XYZVector d1(line1[3], line1[4], line1[5]);
+   XYZVector p2(line2[0], line2[1], line2[2]);
+   XYZVector d2(line2[3], line2[4], line2[5]);
    XYZVector n1 = d1.Cross(d2.Cross(d1));
    XYZVector n2 = d2.Cross(d1.Cross(d2));
    Double_t t1 = (p2 - p1).Dot(n2) / (d1.Dot(n2));
    Double_t t2 = (p1 - p2).Dot(n1) / (d2.Dot(n1));
    XYZVector c1 = p1 + t1 * d1;
    XYZVector c2 = p2 + t2 * d2;
-   result.push_back(c1);
-   result.push_back(c2);
 
-   return result;
+   return {c1, c2};
 }
 
 // returns the projection of a point on the parametric line
-XYZVector AtFindVertex::ptOnLine(std::vector<Double_t> line, XYZVector pointToProj)
+XYZVector AtFindVertex::ptOnLine(const Line &line, XYZVector pointToProj)
 {
    XYZVector result(-999, -999, -999);
-   XYZVector posOn(line.at(0), line.at(1), line.at(2));
-   XYZVector dir(line.at(3), line.at(4), line.at(5));
+   XYZVector posOn(line[0], line[1], line[2]);
+   XYZVector dir(line[3], line[4], line[5]);
    XYZVector vop1 = ((dir.Cross(pointToProj - posOn)).Cross(dir)).Unit();
    Double_t paraVar1 = pointToProj.Dot(dir.Unit()) - posOn.Dot(dir.Unit());
    Double_t paraVar2 = posOn.Dot(vop1) - pointToProj.Dot(vop1);
@@ -339,22 +372,22 @@ Double_t AtFindVertex::distPtLine(XYZVector dir, XYZVector ptLine, XYZVector pt)
 }
 
 // returns the distance between two lines
-Double_t AtFindVertex::distLines(std::vector<Double_t> line1, std::vector<Double_t> line2)
+Double_t AtFindVertex::distLines(const Line &line1, const Line &line2)
 {
-   XYZVector p1(line1.at(0), line1.at(1), line1.at(2));
-   XYZVector d1(line1.at(3), line1.at(4), line1.at(5));
-   XYZVector p2(line2.at(0), line2.at(1), line2.at(2));
-   XYZVector d2(line2.at(3), line2.at(4), line2.at(5));
+   XYZVector p1(line1[0], line1[1], line1[2]);
+   XYZVector d1(line1[3], line1[4], line1[5]);
+   XYZVector p2(line2[0], line2[1], line2[2]);
+   XYZVector d2(line2[3], line2[4], line2[5]);
    XYZVector n = d1.Cross(d2);
 
    return fabs(n.Dot(p1 - p2) / sqrt(n.Mag2()));
 }
 
 // returns the angle between two lines
-Double_t AtFindVertex::angLines(std::vector<Double_t> line1, std::vector<Double_t> line2)
+Double_t AtFindVertex::angLines(const Line &line1, const Line &line2)
 {
-   XYZVector d1(line1.at(3), line1.at(4), line1.at(5));
-   XYZVector d2(line2.at(3), line2.at(4), line2.at(5));
+   XYZVector d1(line1[3], line1[4], line1[5]);
+   XYZVector d2(line2[3], line2[4], line2[5]);
 
    return acos(d1.Dot(d2) / (sqrt(d1.Mag2()) * sqrt(d2.Mag2()))) * 180. / 3.1415;
 }
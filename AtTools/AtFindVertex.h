@@ -9,39 +9,47 @@
 #include <Rtypes.h>
 
 #include <algorithm> // for max
+#include <array>     // for array
 #include <utility>   // for pair
 #include <vector>    // for vector
 
 using XYZVector = ROOT::Math::XYZVector;
 
+/**
+ * Tracks coming from a common vertex. The tracks are not owned and point into the vector passed
+ * to AtFindVertex::FindVertex, so they are only valid as long as that vector is.
+ */
 struct tracksFromVertex {
    XYZVector vertex;
-   std::vector<AtTrack> tracks;
+   std::vector<const AtTrack *> tracks;
 };
 
 class AtFindVertex {
 
 public:
+   /// Parametric line: a point (0-2) and a direction (3-5)
+   using Line = std::array<Double_t, 6>;
+
    AtFindVertex(Double_t lineDistThreshold = 15);
    virtual ~AtFindVertex();
 
-   void FindVertex(std::vector<AtTrack> tracks, Int_t nbTracksPerVtx);
-   void FindVertexSingleLine(std::vector<AtTrack> tracks);
-   void FindVertexMultipleLines(std::vector<AtTrack> tracks, Int_t nbTracksPerVtx);
-   XYZVector ClosestPoint2Lines(std::vector<Double_t> line1, std::vector<Double_t> line2);
-   std::vector<XYZVector> ClosestPointProjOnLines(std::vector<Double_t> line1, std::vector<Double_t> line2);
-   std::vector<std::vector<Int_t>> SortTrackSameVtx(std::vector<std::vector<Double_t>> lines);
-   std::vector<XYZVector> CoGVtx(std::vector<std::vector<Int_t>> vtxCand, std::vector<std::vector<Double_t>> lines,
-                                 std::vector<Double_t> wlines);
+   void FindVertex(const std::vector<AtTrack> &tracks, Int_t nbTracksPerVtx);
+   void FindVertexSingleLine(const std::vector<AtTrack> &tracks);
+   void FindVertexMultipleLines(const std::vector<AtTrack> &tracks, Int_t nbTracksPerVtx);
+   XYZVector ClosestPoint2Lines(const Line &line1, const Line &line2);
+   std::array<XYZVector, 2> ClosestPointProjOnLines(const Line &line1, const Line &line2);
+   std::vector<std::vector<Int_t>> SortTrackSameVtx(const std::vector<Line> &lines);
+   std::vector<XYZVector> CoGVtx(const std::vector<std::vector<Int_t>> &vtxCand, const std::vector<Line> &lines,
+                                 const std::vector<Double_t> &wlines);
    std::vector<std::pair<Int_t, XYZVector>>
-   CoGVtxSingleTrack(std::vector<std::vector<Double_t>> lines, std::vector<Int_t> itracks);
-   XYZVector ptOnLine(std::vector<Double_t> line, XYZVector pointToProj);
+   CoGVtxSingleTrack(const std::vector<Line> &lines, const std::vector<Int_t> &itracks);
+   XYZVector ptOnLine(const Line &line, XYZVector pointToProj);
    Double_t distPtLine(XYZVector dir, XYZVector ptLine, XYZVector pt);
-   Double_t distLines(std::vector<Double_t> line1, std::vector<Double_t> line2);
-   Double_t angLines(std::vector<Double_t> line1, std::vector<Double_t> line2);
+   Double_t distLines(const Line &line1, const Line &line2);
+   Double_t angLines(const Line &line1, const Line &line2);
    Bool_t checkExclusivity(std::vector<Int_t> v1, std::vector<Int_t> v2);
 
-   void SetTracksVertex(tracksFromVertex val) { fTracksFromVertex.push_back(val); }
+   void SetTracksVertex(tracksFromVertex val) { fTracksFromVertex.push_back(std::move(val)); }
 
    void SetLineDistThreshold(Double_t val) { fLineDistThreshold = val; }
 
@@ -49,25 +57,45 @@ public:
    {
       fBeamPoint = pos;
       fBeamDir = dir;
-      fBeamLine.resize(6);
-      fBeamLine[0] = fBeamPoint.X();
-      fBeamLine[1] = fBeamPoint.Y();
-      fBeamLine[2] = fBeamPoint.Z();
-      fBeamLine[3] = fBeamDir.X();
-      fBeamLine[4] = fBeamDir.Y();
-      fBeamLine[5] = fBeamDir.Z();
+      fBeamLine = {fBeamPoint.X(), fBeamPoint.Y(), fBeamPoint.Z(), fBeamDir.X(), fBeamDir.Y(), fBeamDir.Z()};
+      fPairsValid = false;
    }
 
-   std::vector<tracksFromVertex> GetTracksVertex() { return fTracksFromVertex; }
+   const std::vector<tracksFromVertex> &GetTracksVertex() const { return fTracksFromVertex; }
 
 private:
+   /**
+    * Fill the distance and angle between every pair of lines, and the distance to and closest points on
+    * the beam of every line. All later decisions only read these tables.
+    */
+   void FillLinePairs(const std::vector<Line> &lines);
+   /// Fill the tables with FillLinePairs, unless they were already filled for these lines and beam
+   void UpdateLinePairs(const std::vector<Line> &lines);
+   Double_t PairDist(size_t i, size_t j) const { return fPairDist[i * fNumLines + j]; }
+   Double_t PairAng(size_t i, size_t j) const { return fPairAng[i * fNumLines + j]; }
+
    std::vector<tracksFromVertex> fTracksFromVertex;
 
    Double_t fLineDistThreshold;
    XYZVector fBeamPoint;
    XYZVector fBeamDir;
-   std::vector<Double_t> fBeamLine;
-   std::vector<std::vector<Double_t>> fLineCand;
+   Line fBeamLine;
+
+   // Scratch space reused between events
+   std::vector<Line> fLines;
+   std::vector<Double_t> fWeights;
+   std::vector<Int_t> fTrackIdx;
+   std::vector<char> fPaired;
+
+   // Tables filled by FillLinePairs
+   size_t fNumLines{0};
+   std::vector<Double_t> fComp;                     //< Lines by component (x, y, z, dx, dy, dz, |d|)
+   std::vector<Double_t> fPairDist;                 //< Distance between lines i and j at [i * fNumLines + j]
+   std::vector<Double_t> fPairAng;                  //< Angle (deg) between lines i and j at [i * fNumLines + j]
+   std::vector<Double_t> fBeamDist;                 //< Distance between each line and the beam
+   std::vector<std::array<XYZVector, 2>> fBeamProj; //< Closest points on each line and on the beam
+   std::vector<Line> fPairLines;                    //< Lines the tables were filled for
+   Bool_t fPairsValid{false};                       //< If the tables match fPairLines and the beam
 };
 
 #endif // #ifndef AtFindVertex_H
@@ -0,0 +1,232 @@
+#include "AtFindVertex.h"
+
+#include "AtPatternLine.h"
+#include "AtTrack.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+using Line = AtFindVertex::Line;
+
+constexpr double kThreshold = 12;
+
+/**
+ * Vertices found by AtFindVertex before the line pair tables: every distance, angle and closest point is computed
+ * for each pair of lines where it is needed with the geometric functions of AtFindVertex.
+ */
+class AtFindVertexReference {
+   AtFindVertex fGeo{kThreshold};
+   Line fBeamLine{0, 0, 500, 0, 0, 1};
+
+public:
+   void SetBeam(XYZVector pos, XYZVector dir) { fBeamLine = {pos.X(), pos.Y(), pos.Z(), dir.X(), dir.Y(), dir.Z()}; }
+
+   std::vector<tracksFromVertex> FindVertex(const std::vector<AtTrack> &tracks, Int_t nbTracksPerVtx)
+   {
+      std::vector<tracksFromVertex> result;
+      if (tracks.size() < nbTracksPerVtx)
+         return result;
+
+      std::vector<Line> lines;
+      std::vector<Double_t> weights;
+      std::vector<Int_t> trackIdx;
+      for (Int_t it = 0; it < tracks.size(); it++) {
+         auto par = tracks[it].GetPattern()->GetPatternPar();
+         if (par.empty())
+            continue;
+         lines.push_back({par[0], par[1], par[2], par[3], par[4], par[5]});
+         weights.push_back(tracks[it].GetPattern()->GetChi2());
+         trackIdx.push_back(it);
+      }
+
+      if (nbTracksPerVtx == 1) {
+         for (Int_t i = 0; i < lines.size(); i++) {
+            if (fGeo.distLines(lines[i], fBeamLine) >= kThreshold)
+               continue;
+            auto pos = fGeo.ClosestPointProjOnLines(lines[i], fBeamLine)[0];
+            if (pos.Z() <= 0 || pos.Z() >= 1000 || sqrt(pos.Perp2()) > 30)
+               continue;
+            result.push_back({pos, {&tracks[trackIdx[i]]}});
+         }
+         return result;
+      }
+
+      auto paired = SortTrackSameVtx(lines);
+      if (paired.size() < 2)
+         return result;
+      auto pos = CoGVtx(paired, lines, weights);
+      if (pos.X() != pos.X() || pos.Y() != pos.Y() || pos.Z() != pos.Z())
+         return result;
+      if (pos.Z() <= 0 || pos.Z() >= 1000 || sqrt(pos.Perp2()) > 30)
+         return result;
+
+      tracksFromVertex tv{pos, {}};
+      for (auto i : paired)
+         tv.tracks.push_back(&tracks[trackIdx[i]]);
+      result.push_back(tv);
+      return result;
+   }
+
+private:
+   std::vector<Int_t> SortTrackSameVtx(const std::vector<Line> &lines)
+   {
+      std::vector<Int_t> paired;
+      std::vector<XYZVector> vtx;
+      auto isPaired = [&paired](Int_t i) { return std::find(paired.begin(), paired.end(), i) != paired.end(); };
+
+      for (Int_t i = 0; i + 1 < lines.size(); i++) {
+         if (isPaired(i))
+            continue;
+         for (Int_t j = i + 1; j < lines.size(); j++) {
+            if (isPaired(j))
+               continue;
+
+            if (vtx.empty()) {
+               if (fGeo.distLines(lines[i], lines[j]) >= kThreshold)
+                  continue;
+               Double_t angle = fGeo.angLines(lines[i], lines[j]);
+               if (angle < 10 || angle > 170)
+                  vtx.push_back(0.5 * (fGeo.ClosestPoint2Lines(lines[i], fBeamLine) +
+                                       fGeo.ClosestPoint2Lines(lines[j], fBeamLine)));
+               else
+                  vtx.push_back(fGeo.ClosestPoint2Lines(lines[i], lines[j]));
+               paired.push_back(i);
+               paired.push_back(j);
+            } else {
+               auto projVtx = fGeo.ptOnLine(lines[j], vtx.back());
+               Double_t dist = sqrt((vtx.back() - projVtx).Mag2());
+               if (dist < kThreshold && sqrt((0.5 * (vtx.back() + projVtx)).Perp2()) <= 30) {
+                  if (!isPaired(i))
+                     paired.push_back(i);
+                  paired.push_back(j);
+               }
+            }
+         }
+      }
+      return paired;
+   }
+
+   XYZVector CoGVtx(const std::vector<Int_t> &iv, const std::vector<Line> &lines, const std::vector<Double_t> &weights)
+   {
+      std::vector<XYZVector> sumVtx(iv.size(), XYZVector(0, 0, 0));
+      for (Int_t i = 0; i + 1 < iv.size(); i++) {
+         for (Int_t j = i + 1; j < iv.size(); j++) {
+            const auto &line = lines[iv[i]];
+            const auto &lineF = lines[iv[j]];
+            if (fGeo.distLines(line, lineF) >= kThreshold)
+               continue;
+            Double_t angle = fGeo.angLines(line, lineF);
+            if (angle < 10 || angle > 170) {
+               sumVtx[i] += fGeo.ClosestPointProjOnLines(line, fBeamLine)[0];
+               sumVtx[j] += fGeo.ClosestPointProjOnLines(lineF, fBeamLine)[0];
+            } else {
+               auto proj = fGeo.ClosestPointProjOnLines(line, lineF);
+               sumVtx[i] += proj[0];
+               sumVtx[j] += proj[1];
+            }
+         }
+      }
+
+      XYZVector CoG(0, 0, 0);
+      Double_t sumW = 0;
+      for (Int_t i = 0; i < iv.size(); i++) {
+         CoG += sumVtx[i] * (1. / weights[iv[i]]);
+         sumW += 1. / weights[iv[i]];
+      }
+      return CoG * (1. / (iv.size() - 1)) * (1. / sumW);
+   }
+};
+
+/**
+ * Tracks from a vertex close to the beam axis, a track nearly parallel to the first one in some events, a track
+ * from somewhere else and a track without a fitted line.
+ */
+std::vector<AtTrack> MakeTracks(std::mt19937 &rng, int event)
+{
+   std::uniform_real_distribution<double> uni(-1, 1);
+   std::normal_distribution<double> gaus(0, 1);
+   XYZVector vertex(3 * gaus(rng), 3 * gaus(rng), 500 + 400 * uni(rng));
+
+   std::vector<Line> lines;
+   for (int i = 0; i < 1 + event % 5; ++i) {
+      XYZVector dir(uni(rng), uni(rng), uni(rng));
+      auto point = vertex + 100 * uni(rng) * dir + XYZVector(gaus(rng), gaus(rng), gaus(rng));
+      lines.push_back({point.X(), point.Y(), point.Z(), dir.X(), dir.Y(), dir.Z()});
+   }
+   if (event % 3 == 0) {
+      auto line = lines.front();
+      for (int c = 3; c < 6; ++c)
+         line[c] += 0.05 * uni(rng);
+      lines.push_back(line);
+   }
+   if (event % 4 == 0)
+      lines.push_back({200 * uni(rng), 200 * uni(rng), 500 + 400 * uni(rng), uni(rng), uni(rng), uni(rng)});
+
+   std::vector<AtTrack> tracks;
+   for (auto &line : lines) {
+      auto pattern = std::make_unique<AtPatterns::AtPatternLine>();
+      pattern->SetPatternPar({line.begin(), line.end()});
+      pattern->SetChi2(1 + 0.5 * uni(rng));
+      tracks.emplace_back();
+      tracks.back().SetPattern(std::move(pattern));
+   }
+   if (event % 7 == 0) {
+      auto track = tracks.emplace(tracks.begin() + tracks.size() / 2);
+      track->SetPattern(std::make_unique<AtPatterns::AtPatternLine>());
+   }
+   return tracks;
+}
+
+void ExpectSameVertices(const std::vector<tracksFromVertex> &expected, const std::vector<tracksFromVertex> &found,
+                        size_t firstFound, int event)
+{
+   ASSERT_EQ(found.size() - firstFound, expected.size()) << "Event " << event;
+   for (size_t i = 0; i < expected.size(); ++i) {
+      const auto &vtx = found[firstFound + i];
+      EXPECT_EQ(vtx.vertex.X(), expected[i].vertex.X()) << "Event " << event;
+      EXPECT_EQ(vtx.vertex.Y(), expected[i].vertex.Y()) << "Event " << event;
+      EXPECT_EQ(vtx.vertex.Z(), expected[i].vertex.Z()) << "Event " << event;
+      EXPECT_EQ(vtx.tracks, expected[i].tracks) << "Event " << event;
+   }
+}
+} // namespace
+
+TEST(AtFindVertexTest, SameVerticesAsPairByPair)
+{
+   std::mt19937 rng(5);
+   AtFindVertexReference reference;
+   AtFindVertex finder(kThreshold);
+
+   int numVertices = 0;
+   for (int event = 0; event < 600; ++event) {
+      auto tracks = MakeTracks(rng, event);
+      int nbTracksPerVtx = 1 + event % 3;
+      auto expected = reference.FindVertex(tracks, nbTracksPerVtx);
+
+      // The same finder is used for every event, so the tables must be refilled for each new set of lines
+      auto firstFound = finder.GetTracksVertex().size();
+      finder.FindVertex(tracks, nbTracksPerVtx);
+      ExpectSameVertices(expected, finder.GetTracksVertex(), firstFound, event);
+      numVertices += expected.size();
+
+      // and for a new beam, even with the same lines
+      if (event % 100 == 50) {
+         XYZVector beamPoint(1 + event / 100, -1, 500);
+         XYZVector beamDir(0.01 * (event / 100), 0, 1);
+         reference.SetBeam(beamPoint, beamDir);
+         finder.SetBeam(beamPoint, beamDir);
+
+         expected = reference.FindVertex(tracks, nbTracksPerVtx);
+         firstFound = finder.GetTracksVertex().size();
+         finder.FindVertex(tracks, nbTracksPerVtx);
+         ExpectSameVertices(expected, finder.GetTracksVertex(), firstFound, event);
+      }
+   }
+   EXPECT_GT(numVertices, 300);
+}
@@ -38,6 +38,9 @@ public:
 
 public:
    double getDist2(double dZ);
+
+protected:
+   bool IsSymmetricAroundBeam() const override { return true; }
 };
 
 #endif
@@ -0,0 +1,130 @@
+#include "AtPolygonGate.h"
+
+#include <algorithm>
+#include <cmath>
+
+using AtTools::AtPolygonGate;
+
+AtPolygonGate::AtPolygonGate(Int_t n, const Double_t *x, const Double_t *y, Int_t nBins)
+   : fNx(std::max(nBins, 1)), fNy(std::max(nBins, 1))
+{
+   fCells.assign(fNx * fNy, kOutside);
+   fRowStart.assign(fNy + 1, 0);
+   if (n <= 0) {
+      // Empty grid, every point is outside
+      fXLo = 1;
+      fXHi = 0;
+      return;
+   }
+
+   auto xRange = std::minmax_element(x, x + n);
+   auto yRange = std::minmax_element(y, y + n);
+
+   // Pad the grid so points outside it are far from the polygon compared to the rounding of the crossing test,
+   // and mark cells within a margin of each edge as boundary.
+   auto setAxis = [nBins = fNx](Double_t min, Double_t max, Double_t &lo, Double_t &hi, Double_t &invStep) {
+      Double_t scale = std::max(std::fabs(min), std::fabs(max));
+      Double_t span = max > min ? max - min : std::max(scale, 1.);
+      Double_t pad = 1e-6 * span + 1e-12 * scale;
+      lo = min - pad;
+      hi = max + pad;
+      invStep = nBins / (hi - lo);
+      return 1e-3 / invStep + 1e-12 * scale;
+   };
+   Double_t xMargin = setAxis(*xRange.first, *xRange.second, fXLo, fXHi, fXInvStep);
+   Double_t yMargin = setAxis(*yRange.first, *yRange.second, fYLo, fYHi, fYInvStep);
+
+   std::vector<std::vector<Edge>> rows(fNy);
+   for (Int_t i = 0, j = n - 1; i < n; j = i++) {
+      Edge edge{x[i], y[i], x[j], y[j]};
+      Double_t yMin = std::min(edge.yi, edge.yj);
+      Double_t yMax = std::max(edge.yi, edge.yj);
+
+      for (Int_t iy = YBin(std::max(yMin - yMargin, fYLo)); iy <= YBin(std::min(yMax + yMargin, fYHi)); ++iy) {
+         // Part of the edge within the row (and margin)
+         Double_t y0 = std::max(fYLo + iy / fYInvStep - yMargin, yMin);
+         Double_t y1 = std::min(fYLo + (iy + 1) / fYInvStep + yMargin, yMax);
+         Double_t x0 = std::min(edge.xi, edge.xj);
+         Double_t x1 = std::max(edge.xi, edge.xj);
+         if (edge.yi != edge.yj) {
+            // A horizontal edge never satisfies the crossing condition, so it is only needed to mark cells
+            rows[iy].push_back(edge);
+            Double_t slope = (edge.xj - edge.xi) / (edge.yj - edge.yi);
+            x0 = edge.xi + (y0 - edge.yi) * slope;
+            x1 = edge.xi + (y1 - edge.yi) * slope;
+            if (x0 > x1)
+               std::swap(x0, x1);
+         }
+
+         for (Int_t ix = XBin(std::max(x0 - xMargin, fXLo)); ix <= XBin(std::min(x1 + xMargin, fXHi)); ++ix)
+            fCells[ix + fNx * iy] = kBoundary;
+      }
+   }
+
+   for (Int_t iy = 0; iy < fNy; ++iy) {
+      fRowStart[iy + 1] = fRowStart[iy] + rows[iy].size();
+      fRowEdges.insert(fRowEdges.end(), rows[iy].begin(), rows[iy].end());
+   }
+
+   // Every point of a cell off the boundary has the same answer as its center
+   for (Int_t iy = 0; iy < fNy; ++iy) {
+      const Edge *begin = fRowEdges.data() + fRowStart[iy];
+      const Edge *end = fRowEdges.data() + fRowStart[iy + 1];
+      Double_t yCenter = fYLo + (iy + 0.5) / fYInvStep;
+      for (Int_t ix = 0; ix < fNx; ++ix) {
+         auto &cell = fCells[ix + fNx * iy];
+         if (cell != kBoundary)
+            cell = Crossings(begin, end, fXLo + (ix + 0.5) / fXInvStep, yCenter) ? kInside : kOutside;
+      }
+   }
+}
+
+Int_t AtPolygonGate::XBin(Double_t x) const
+{
+   return std::min(static_cast<Int_t>((x - fXLo) * fXInvStep), fNx - 1);
+}
+
+Int_t AtPolygonGate::YBin(Double_t y) const
+{
+   return std::min(static_cast<Int_t>((y - fYLo) * fYInvStep), fNy - 1);
+}
+
+/**
+ * Crossing rule of TMath::IsInside over the edges [begin, end), written with the same operations so it rounds
+ * the same way.
+ */
+Bool_t AtPolygonGate::Crossings(const Edge *begin, const Edge *end, Double_t xp, Double_t yp)
+{
+   Bool_t oddNodes = kFALSE;
+   for (auto edge = begin; edge != end; ++edge) {
+      if ((edge->yi < yp && edge->yj >= yp) || (edge->yj < yp && edge->yi >= yp)) {
+         if (edge->xi + (yp - edge->yi) / (edge->yj - edge->yi) * (edge->xj - edge->xi) < xp)
+            oddNodes = !oddNodes;
+      }
+   }
+   return oddNodes;
+}
+
+Bool_t AtPolygonGate::IsInside(Double_t x, Double_t y) const
+{
+   // Also rejects NaN
+   if (!(x >= fXLo && x <= fXHi && y >= fYLo && y <= fYHi))
+      return kFALSE;
+
+   auto iy = YBin(y);
+   auto cell = fCells[XBin(x) + fNx * iy];
+   if (cell != kBoundary)
+      return cell == kInside;
+   return Crossings(fRowEdges.data() + fRowStart[iy], fRowEdges.data() + fRowStart[iy + 1], x, y);
+}
+
+void AtPolygonGate::IsInside(std::size_t n, const Double_t *x, const Double_t *y, Bool_t *inside) const
+{
+   for (std::size_t i = 0; i < n; ++i)
+      inside[i] = IsInside(x[i], y[i]);
+}
+
+std::size_t AtPolygonGate::GetNumBoundaryCells() const
+{
+   return std::count(fCells.begin(), fCells.end(), kBoundary);
+}
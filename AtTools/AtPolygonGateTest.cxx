@@ -0,0 +1,89 @@
+#include "AtPolygonGate.h"
+
+#include <TMath.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using AtTools::AtPolygonGate;
+
+namespace {
+/// Star shaped (and, with twist, self-intersecting) polygon like a hand drawn PID cut
+void MakePolygon(Int_t n, Double_t twist, std::vector<Double_t> &x, std::vector<Double_t> &y)
+{
+   std::mt19937 gen(n);
+   std::uniform_real_distribution<Double_t> radius(0.5, 1.);
+   x.clear();
+   y.clear();
+   for (Int_t i = 0; i < n; ++i) {
+      Double_t phi = 2 * TMath::Pi() * i / n + twist * std::sin(7. * i);
+      Double_t r = radius(gen);
+      x.push_back(250 + 40 * r * std::cos(phi));
+      y.push_back(-3 + 0.2 * r * std::sin(phi));
+   }
+}
+
+void CompareToTMath(const AtPolygonGate &gate, std::vector<Double_t> &x, std::vector<Double_t> &y)
+{
+   std::mt19937 gen(42);
+   std::uniform_real_distribution<Double_t> px(200, 300);
+   std::uniform_real_distribution<Double_t> py(-3.3, -2.7);
+   for (int i = 0; i < 200000; ++i) {
+      Double_t xp = px(gen);
+      Double_t yp = py(gen);
+      ASSERT_EQ(gate.IsInside(xp, yp), TMath::IsInside(xp, yp, x.size(), x.data(), y.data())) << xp << " " << yp;
+   }
+
+   // Points on the vertices and edges, and on the horizontal line through each vertex
+   for (size_t i = 0; i < x.size(); ++i) {
+      size_t j = (i + 1) % x.size();
+      for (Double_t t : {0., 0.25, 0.5, 1.}) {
+         Double_t xp = x[i] + t * (x[j] - x[i]);
+         Double_t yp = y[i] + t * (y[j] - y[i]);
+         EXPECT_EQ(gate.IsInside(xp, yp), TMath::IsInside(xp, yp, x.size(), x.data(), y.data()));
+      }
+      Double_t xp = px(gen);
+      EXPECT_EQ(gate.IsInside(xp, y[i]), TMath::IsInside(xp, y[i], x.size(), x.data(), y.data()));
+   }
+}
+} // namespace
+
+TEST(AtPolygonGateTest, SimplePolygon)
+{
+   std::vector<Double_t> x;
+   std::vector<Double_t> y;
+   MakePolygon(500, 0, x, y);
+   AtPolygonGate gate(x.size(), x.data(), y.data());
+
+   CompareToTMath(gate, x, y);
+   EXPECT_LT(gate.GetNumBoundaryCells(), 256 * 256 / 4);
+}
+
+TEST(AtPolygonGateTest, SelfIntersecting)
+{
+   std::vector<Double_t> x;
+   std::vector<Double_t> y;
+   MakePolygon(300, 0.3, x, y);
+   AtPolygonGate gate(x.size(), x.data(), y.data(), 64);
+
+   CompareToTMath(gate, x, y);
+}
+
+TEST(AtPolygonGateTest, Batch)
+{
+   std::vector<Double_t> x = {0, 2, 2, 1, 0};
+   std::vector<Double_t> y = {0, 0, 2, 1, 2};
+   AtPolygonGate gate(x.size(), x.data(), y.data(), 8);
+
+   std::vector<Double_t> px = {1, 1, 3, 0.5, NAN};
+   std::vector<Double_t> py = {0.5, 1.5, 1, 1.2, 1};
+   Bool_t inside[5];
+   gate.IsInside(px.size(), px.data(), py.data(), inside);
+   for (size_t i = 0; i < px.size(); ++i)
+      EXPECT_EQ(inside[i], TMath::IsInside(px[i], py[i], x.size(), x.data(), y.data())) << i;
+   EXPECT_TRUE(inside[0]);
+   EXPECT_FALSE(inside[1]);
+}
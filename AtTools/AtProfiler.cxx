@@ -0,0 +1,120 @@
+#include "AtProfiler.h"
+
+#include <TString.h>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+
+using AtTools::AtProfiler;
+
+bool AtProfiler::fEnabled = false;
+
+AtProfiler::Usage AtProfiler::Usage::Now()
+{
+   Usage usage;
+   usage.wall = std::chrono::steady_clock::now();
+
+   rusage ru{};
+   getrusage(RUSAGE_SELF, &ru);
+   usage.cpu = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+   usage.maxRSS = ru.ru_maxrss;
+   return usage;
+}
+
+AtProfiler &AtProfiler::Instance()
+{
+   static AtProfiler profiler;
+   return profiler;
+}
+
+AtProfiler::Stats &AtProfiler::GetOrCreate(const std::string &name, bool isTask)
+{
+   auto it = fIndex.find(name);
+   if (it == fIndex.end()) {
+      it = fIndex.emplace(name, fStats.size()).first;
+      fStats.emplace_back(name, Stats{});
+      fStats.back().second.isTask = isTask;
+   }
+   return fStats[it->second].second;
+}
+
+void AtProfiler::Register(const std::string &name, bool isTask)
+{
+   std::lock_guard<std::mutex> lk(fMutex);
+   GetOrCreate(name, isTask);
+}
+
+void AtProfiler::Add(const std::string &name, const Usage &start, const Usage &stop, bool isTask)
+{
+   double wall = std::chrono::duration<double>(stop.wall - start.wall).count();
+
+   std::lock_guard<std::mutex> lk(fMutex);
+   auto &stats = GetOrCreate(name, isTask);
+   stats.calls++;
+   stats.wall += wall;
+   stats.cpu += stop.cpu - start.cpu;
+   stats.rssDelta += stop.maxRSS - start.maxRSS;
+   stats.eventWall += wall;
+}
+
+void AtProfiler::EndEvent()
+{
+   std::lock_guard<std::mutex> lk(fMutex);
+   fNumEvents++;
+   for (auto &[name, stats] : fStats)
+      stats.eventWall = 0;
+}
+
+void AtProfiler::Reset()
+{
+   std::lock_guard<std::mutex> lk(fMutex);
+   fStats.clear();
+   fIndex.clear();
+   fNumEvents = 0;
+}
+
+std::vector<std::pair<std::string, AtProfiler::Stats>> AtProfiler::GetStats() const
+{
+   std::lock_guard<std::mutex> lk(fMutex);
+   return fStats;
+}
+
+void AtProfiler::Print(std::ostream &out) const
+{
+   auto allStats = GetStats();
+   double totalWall = 0;
+   std::size_t width = 5;
+   for (auto &[name, stats] : allStats) {
+      if (stats.isTask)
+         totalWall += stats.wall;
+      width = std::max(width, name.size());
+   }
+
+   out << "Profile of " << fNumEvents << " events (" << TString::Format("%.3f", totalWall) << " s in tasks)"
+       << std::endl;
+   auto printRow = [&out, width](const std::string &name, const std::string &row) {
+      out << "  " << name << std::string(width - name.size(), ' ') << row << std::endl;
+   };
+   auto header = TString::Format("%10s %10s %10s %8s %13s %10s %12s %7s", "calls", "wall [s]", "CPU [s]", "CPU/wall",
+                                 "peak RSS [MB]", "ms/call", "calls/s", "% time");
+
+   for (bool tasks : {true, false}) {
+      bool first = true;
+      for (auto &[name, stats] : allStats) {
+         if (stats.isTask != tasks)
+            continue;
+         if (first) {
+            out << (tasks ? "Tasks:" : "Stages:") << std::endl;
+            printRow("", header.Data());
+            first = false;
+         }
+         double perCall = stats.calls > 0 ? stats.wall / stats.calls : 0;
+         auto row = TString::Format("%10lld %10.3f %10.3f %8.2f %+13.1f %10.3f %12.1f %7.1f", stats.calls, stats.wall,
+                                    stats.cpu, stats.wall > 0 ? stats.cpu / stats.wall : 0., stats.rssDelta / 1024.,
+                                    perCall * 1e3, perCall > 0 ? 1 / perCall : 0.,
+                                    totalWall > 0 ? 100 * stats.wall / totalWall : 0.);
+         printRow(name, row.Data());
+      }
+   }
+}
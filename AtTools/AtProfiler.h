@@ -0,0 +1,108 @@
+#ifndef ATPROFILER_H
+#define ATPROFILER_H
+
+#include <Rtypes.h> // for Long64_t
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AtTools {
+
+/**
+ * @brief Accounting of the time and memory used by the tasks of a run and the stages of their algorithms.
+ *
+ * The wall time, CPU time (user + system of the process, so it includes every thread) and growth of the peak
+ * resident set size of each task or stage are summed over the run, along with the number of times it ran. The
+ * tasks are measured by AtRunAna (see AtRunAna::SetProfiling) and the stages by placing a Scope in the code:
+ *
+ * @code
+ * AtTools::AtProfiler::Scope scope("AtPSA::Analyze");
+ * fPSA->Analyze(rawEvent, event);
+ * @endcode
+ *
+ * Profiling is disabled by default, in which case a Scope only checks a flag. A stage nested in a task (or another
+ * stage) is also counted in the time of its parent.
+ */
+class AtProfiler {
+public:
+   /// Resources used by the process at one point in time
+   struct Usage {
+      std::chrono::steady_clock::time_point wall;
+      double cpu{};  //< User + system CPU time of the process (s)
+      long maxRSS{}; //< Peak resident set size of the process (kB)
+
+      static Usage Now();
+   };
+
+   struct Stats {
+      bool isTask{false};
+      Long64_t calls{0};
+      double wall{0};      //< Wall time (s)
+      double cpu{0};       //< CPU time (s)
+      long rssDelta{0};    //< Growth of the peak resident set size (kB)
+      double eventWall{0}; //< Wall time since the end of the last event (s)
+   };
+
+   /// Measure a stage from construction to destruction, if profiling is enabled when constructed.
+   class Scope {
+   private:
+      const char *fName{nullptr};
+      Usage fStart;
+
+   public:
+      Scope(const char *name)
+      {
+         if (AtProfiler::IsEnabled()) {
+            fName = name;
+            fStart = Usage::Now();
+         }
+      }
+      ~Scope()
+      {
+         if (fName)
+            AtProfiler::Instance().Add(fName, fStart, Usage::Now());
+      }
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+   };
+
+private:
+   static bool fEnabled;
+
+   mutable std::mutex fMutex;
+   std::vector<std::pair<std::string, Stats>> fStats; //< In the order they were first measured
+   std::unordered_map<std::string, std::size_t> fIndex;
+   Long64_t fNumEvents{0};
+
+public:
+   static AtProfiler &Instance();
+   static bool IsEnabled() { return fEnabled; }
+   static void SetEnabled(bool val) { fEnabled = val; }
+
+   /// List name (a task if isTask, otherwise a stage) before it is first measured
+   void Register(const std::string &name, bool isTask = false);
+   /// Add the resources used between start and stop to name (a task if isTask, otherwise a stage)
+   void Add(const std::string &name, const Usage &start, const Usage &stop, bool isTask = false);
+   /// Count an event and restart the wall time per event of every task and stage
+   void EndEvent();
+   void Reset();
+
+   Long64_t GetNumEvents() const { return fNumEvents; }
+   /// Names and stats of every task and stage, in the order they were first measured
+   std::vector<std::pair<std::string, Stats>> GetStats() const;
+
+   /// Print a table of the tasks then of the stages, with their share of the time and throughput
+   void Print(std::ostream &out = std::cout) const;
+
+private:
+   Stats &GetOrCreate(const std::string &name, bool isTask);
+};
+
+} // namespace AtTools
+
+#endif // ATPROFILER_H
@@ -0,0 +1,54 @@
+#include "AtProfiler.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using AtTools::AtProfiler;
+
+TEST(AtProfilerTest, DisabledScope)
+{
+   auto &profiler = AtProfiler::Instance();
+   profiler.Reset();
+   AtProfiler::SetEnabled(false);
+   {
+      AtProfiler::Scope scope("stage");
+   }
+   EXPECT_TRUE(profiler.GetStats().empty());
+}
+
+TEST(AtProfilerTest, TasksAndStages)
+{
+   auto &profiler = AtProfiler::Instance();
+   profiler.Reset();
+   AtProfiler::SetEnabled(true);
+
+   for (int i = 0; i < 3; ++i) {
+      auto start = AtProfiler::Usage::Now();
+      {
+         AtProfiler::Scope scope("stage");
+         volatile double sum = 0;
+         for (int j = 0; j < 100000; ++j)
+            sum = sum + j;
+      }
+      profiler.Add("task", start, AtProfiler::Usage::Now(), true);
+      if (i < 2)
+         profiler.EndEvent();
+   }
+   AtProfiler::SetEnabled(false);
+
+   auto stats = profiler.GetStats();
+   ASSERT_EQ(stats.size(), 2u);
+   EXPECT_EQ(stats[0].first, "stage");
+   EXPECT_FALSE(stats[0].second.isTask);
+   EXPECT_EQ(stats[1].first, "task");
+   EXPECT_TRUE(stats[1].second.isTask);
+
+   EXPECT_EQ(profiler.GetNumEvents(), 2);
+   EXPECT_EQ(stats[1].second.calls, 3);
+   EXPECT_GE(stats[1].second.wall, stats[0].second.wall);
+   EXPECT_GT(stats[0].second.wall, 0);
+   EXPECT_LT(stats[1].second.eventWall, stats[1].second.wall);
+   EXPECT_GT(stats[1].second.eventWall, 0);
+   profiler.Reset();
+}
@@ -46,6 +46,9 @@ public:
    void SetDriftVelocity(double v);
    void LoadParameters(const AtDigiPar *par) override;
 
+protected:
+   bool IsSymmetricAroundBeam() const override { return true; }
+
 private:
    XYZPoint SolveEqn(XYZPoint ele, bool correction);
 };
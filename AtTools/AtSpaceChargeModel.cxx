@@ -1,9 +1,15 @@
 #include "AtSpaceChargeModel.h"
 
+#include <FairLogger.h>
+
 #include <Math/Point3D.h>
 #include <Math/Vector3D.h>
 
+#include <algorithm>
+#include <cmath>
+
 using XYZPoint = ROOT::Math::XYZPoint;
+using RZPPoint = ROOT::Math::RhoZPhiPoint;
 
 XYZPoint AtSpaceChargeModel::OffsetForBeam(XYZPoint point)
 {
@@ -17,3 +23,131 @@ XYZPoint AtSpaceChargeModel::UndoOffsetForBeam(XYZPoint point)
 
    return {point.X() + fOffset.X(), point.Y() + fOffset.Y(), point.Z()};
 }
+
+void AtSpaceChargeModel::SetFieldGrid(double rhoMax, double zMax, double dRho, double dZ)
+{
+   fGridNRho = std::max(2, (int)std::ceil(rhoMax / dRho) + 1);
+   fGridNZ = std::max(2, (int)std::ceil(zMax / dZ) + 1);
+   fGridDRho = dRho;
+   fGridDZ = dZ;
+   fGridRhoMax = (fGridNRho - 1) * dRho;
+   fGridZMax = (fGridNZ - 1) * dZ;
+   fCorrectField.clear();
+   fApplyField.clear();
+   fFieldCurrent = false;
+}
+
+void AtSpaceChargeModel::BakeField()
+{
+   std::lock_guard<std::mutex> lock(fFieldMutex);
+   TabulateField();
+   fFieldCurrent.store(true, std::memory_order_release);
+}
+
+void AtSpaceChargeModel::TabulateFieldOnce()
+{
+   if (fFieldCurrent.load(std::memory_order_acquire))
+      return;
+   std::lock_guard<std::mutex> lock(fFieldMutex);
+   if (fFieldCurrent.load(std::memory_order_relaxed))
+      return;
+   TabulateField();
+   fFieldCurrent.store(true, std::memory_order_release);
+}
+
+void AtSpaceChargeModel::TabulateField()
+{
+   fCorrectField.clear();
+   fApplyField.clear();
+   if (fGridDRho <= 0 || fGridDZ <= 0)
+      return;
+   if (!IsSymmetricAroundBeam()) {
+      LOG(warning) << "Space charge model is not symmetric around the beam, it will not be tabulated.";
+      return;
+   }
+
+   LOG(info) << "Tabulating space charge on " << fGridNRho << "x" << fGridNZ << " (rho, z) grid up to ("
+             << fGridRhoMax << ", " << fGridZMax << ") mm";
+
+   // The angle of a point moved onto the beam axis is arbitrary, so it is taken as unchanged
+   auto toNode = [this](const XYZPoint &pos) -> FieldNode {
+      auto offset = OffsetForBeam(pos);
+      return {offset.Rho(), offset.Z(), offset.Rho() > 1e-9 ? offset.Phi() : 0.};
+   };
+
+   fCorrectField.resize(fGridNRho * fGridNZ);
+   fApplyField.resize(fGridNRho * fGridNZ);
+   for (int iRho = 0; iRho < fGridNRho; ++iRho) {
+      for (int iZ = 0; iZ < fGridNZ; ++iZ) {
+         auto node = UndoOffsetForBeam({iRho * fGridDRho, 0, iZ * fGridDZ});
+
+         fCorrectField[iRho * fGridNZ + iZ] = toNode(CorrectSpaceCharge(node));
+         fApplyField[iRho * fGridNZ + iZ] = toNode(ApplySpaceCharge(node));
+      }
+   }
+}
+
+bool AtSpaceChargeModel::Interpolate(const std::vector<FieldNode> &field, const XYZPoint &position, XYZPoint &result)
+{
+   if (field.empty())
+      return false;
+
+   auto input = OffsetForBeam(position);
+   double rho = input.Rho();
+   double z = input.Z();
+   if (rho > fGridRhoMax || z < 0 || z > fGridZMax)
+      return false;
+
+   // Bilinear interpolation between the four surrounding nodes
+   double xRho = rho / fGridDRho;
+   double xZ = z / fGridDZ;
+   int iRho = std::min((int)xRho, fGridNRho - 2);
+   int iZ = std::min((int)xZ, fGridNZ - 2);
+   double fRho = xRho - iRho;
+   double fZ = xZ - iZ;
+
+   const auto &n00 = field[iRho * fGridNZ + iZ];
+   const auto &n01 = field[iRho * fGridNZ + iZ + 1];
+   const auto &n10 = field[(iRho + 1) * fGridNZ + iZ];
+   const auto &n11 = field[(iRho + 1) * fGridNZ + iZ + 1];
+   auto lerp = [fRho, fZ](double v00, double v01, double v10, double v11) {
+      return (1 - fRho) * ((1 - fZ) * v00 + fZ * v01) + fRho * ((1 - fZ) * v10 + fZ * v11);
+   };
+
+   double newRho = lerp(n00.rho, n01.rho, n10.rho, n11.rho);
+   double newZ = lerp(n00.z, n01.z, n10.z, n11.z);
+   double dPhi = lerp(n00.phi, n01.phi, n10.phi, n11.phi);
+
+   result = UndoOffsetForBeam(XYZPoint(RZPPoint(newRho, newZ, input.Phi() + dPhi)));
+   return true;
+}
+
+XYZPoint AtSpaceChargeModel::CorrectPosition(const XYZPoint &position)
+{
+   TabulateFieldOnce();
+   XYZPoint result;
+   if (Interpolate(fCorrectField, position, result))
+      return result;
+   return CorrectSpaceCharge(position);
+}
+
+XYZPoint AtSpaceChargeModel::ApplyPosition(const XYZPoint &position)
+{
+   TabulateFieldOnce();
+   XYZPoint result;
+   if (Interpolate(fApplyField, position, result))
+      return result;
+   return ApplySpaceCharge(position);
+}
+
+void AtSpaceChargeModel::CorrectPositions(std::vector<XYZPoint> &positions)
+{
+   for (auto &pos : positions)
+      pos = CorrectPosition(pos);
+}
+
+void AtSpaceChargeModel::ApplyPositions(std::vector<XYZPoint> &positions)
+{
+   for (auto &pos : positions)
+      pos = ApplyPosition(pos);
+}
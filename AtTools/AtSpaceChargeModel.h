@@ -4,6 +4,10 @@
 
 #include <Math/Point3D.h>
 #include <Math/Point3Dfwd.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
 class AtDigiPar;
 
 class AtSpaceChargeModel {
@@ -13,6 +17,24 @@ protected:
    XYZPoint fWindow{0, 0, 0};      //<Beam location at window in mm
    XYZPoint fPadPlane{0, 0, 1000}; //<Beam location at pad plane in mm
 
+   /// Position (relative to the beam) a point at (rho, z, phi = 0) is moved to
+   struct FieldNode {
+      double rho;
+      double z;
+      double phi;
+   };
+
+   double fGridRhoMax{0}; //< Extent of the tabulated field in rho [mm]
+   double fGridZMax{0};   //< Extent of the tabulated field in z [mm]
+   double fGridDRho{0};   //< Spacing of the tabulated field in rho [mm]
+   double fGridDZ{0};     //< Spacing of the tabulated field in z [mm]
+   int fGridNRho{0};
+   int fGridNZ{0};
+   std::vector<FieldNode> fCorrectField;   //< Tabulated CorrectSpaceCharge, index [iRho * fGridNZ + iZ]
+   std::vector<FieldNode> fApplyField;     //< Tabulated ApplySpaceCharge, index [iRho * fGridNZ + iZ]
+   std::atomic<bool> fFieldCurrent{false}; //< If the tables were filled for the current grid
+   std::mutex fFieldMutex;                 //< Tabulates the field once when it is first used by several threads
+
 public:
    virtual ~AtSpaceChargeModel() = default;
    /**
@@ -47,9 +69,49 @@ public:
       fPadPlane = padPlane;
    }
 
+   /**
+    * @brief Set the (rho, z) grid BakeField tabulates the model on.
+    *
+    * rho is measured from the beam and z from the pad plane [mm]. Points outside of the grid
+    * are evaluated using the model directly. The field is tabulated the first time CorrectPosition
+    * or ApplyPosition is called, so the parameters of the model should be set before that.
+    */
+   void SetFieldGrid(double rhoMax, double zMax, double dRho, double dZ);
+
+   /**
+    * @brief Tabulate the correction and distortion of the model on the field grid.
+    *
+    * Does nothing if no grid was set or the model is not symmetric around the beam. Must be
+    * called again if the parameters of the model change after the field was used (tasks call it
+    * in Init after LoadParameters). Not safe to call while other threads use the field.
+    */
+   void BakeField();
+   bool IsFieldBaked() const { return !fCorrectField.empty(); }
+
+   /// CorrectSpaceCharge interpolated from the baked field (if there is one).
+   XYZPoint CorrectPosition(const XYZPoint &position);
+   /// ApplySpaceCharge interpolated from the baked field (if there is one).
+   XYZPoint ApplyPosition(const XYZPoint &position);
+   /// Correct every position in place (see CorrectPosition).
+   void CorrectPositions(std::vector<XYZPoint> &positions);
+   /// Apply the space charge to every position in place (see ApplyPosition).
+   void ApplyPositions(std::vector<XYZPoint> &positions);
+
 protected:
+   /**
+    * @brief If the model only depends on the distance from the beam and z.
+    *
+    * Only these models can be tabulated by BakeField.
+    */
+   virtual bool IsSymmetricAroundBeam() const { return false; }
+
    XYZPoint OffsetForBeam(XYZPoint point);
    XYZPoint UndoOffsetForBeam(XYZPoint point);
+
+private:
+   void TabulateField();
+   void TabulateFieldOnce();
+   bool Interpolate(const std::vector<FieldNode> &field, const XYZPoint &position, XYZPoint &result);
 };
 
 #endif // #ifndef ATSPACECHARGEMODEL_H
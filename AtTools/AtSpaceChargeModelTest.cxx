@@ -0,0 +1,88 @@
+#include "AtLineChargeModel.h"
+
+#include <Math/Point3D.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+using XYZPoint = ROOT::Math::XYZPoint;
+
+namespace {
+/// Line charge model with a beam that is tilted, and a field grid up to 120 mm from the beam
+class AtSpaceChargeModelTest : public ::testing::Test {
+protected:
+   AtLineChargeModel fModel;
+
+   void SetUp() override
+   {
+      fModel.SetLambda(1.54e-9);
+      fModel.SetBeamLocation({2, -3, 0}, {-1, 4, 1000});
+      fModel.SetFieldGrid(120, 1000, 1, 10);
+   }
+
+   /// Random point between 25 and 100 mm from the beam (outside of the beam radius)
+   XYZPoint RandomPoint(std::mt19937 &rng)
+   {
+      std::uniform_real_distribution<double> rho(25, 100);
+      std::uniform_real_distribution<double> phi(-M_PI, M_PI);
+      std::uniform_real_distribution<double> z(0, 1000);
+
+      double zPos = z(rng);
+      double r = rho(rng);
+      double p = phi(rng);
+      // Beam position at this z
+      double x = 2 - 3 * zPos / 1000;
+      double y = -3 + 7 * zPos / 1000;
+      return {x + r * std::cos(p), y + r * std::sin(p), zPos};
+   }
+
+   static double Distance(const XYZPoint &a, const XYZPoint &b)
+   {
+      return std::sqrt((a.X() - b.X()) * (a.X() - b.X()) + (a.Y() - b.Y()) * (a.Y() - b.Y()) +
+                       (a.Z() - b.Z()) * (a.Z() - b.Z()));
+   }
+};
+} // namespace
+
+TEST_F(AtSpaceChargeModelTest, BakedFieldMatchesModel)
+{
+   // The field is tabulated the first time it is used
+   EXPECT_FALSE(fModel.IsFieldBaked());
+
+   std::mt19937 rng(11);
+   for (int i = 0; i < 1000; ++i) {
+      auto pos = RandomPoint(rng);
+      EXPECT_LT(Distance(fModel.ApplyPosition(pos), fModel.ApplySpaceCharge(pos)), 1e-2) << "At " << pos;
+      EXPECT_LT(Distance(fModel.CorrectPosition(pos), fModel.CorrectSpaceCharge(pos)), 1e-2) << "At " << pos;
+   }
+   EXPECT_TRUE(fModel.IsFieldBaked());
+}
+
+TEST_F(AtSpaceChargeModelTest, OutsideGridUsesModel)
+{
+   XYZPoint pos(200, 0, 500);
+   auto applied = fModel.ApplyPosition(pos);
+   auto expected = fModel.ApplySpaceCharge(pos);
+   EXPECT_DOUBLE_EQ(applied.X(), expected.X());
+   EXPECT_DOUBLE_EQ(applied.Y(), expected.Y());
+   EXPECT_DOUBLE_EQ(applied.Z(), expected.Z());
+}
+
+TEST_F(AtSpaceChargeModelTest, BakedFieldFollowsParameters)
+{
+   XYZPoint pos(30, 0, 900);
+
+   // Parameters changed after the grid was set but before the field was used
+   fModel.SetLambda(3e-9);
+   EXPECT_LT(Distance(fModel.ApplyPosition(pos), fModel.ApplySpaceCharge(pos)), 1e-2);
+   EXPECT_TRUE(fModel.IsFieldBaked());
+
+   // Parameters changed after the field was used need a new bake
+   fModel.SetLambda(1e-9);
+   EXPECT_GT(Distance(fModel.ApplyPosition(pos), fModel.ApplySpaceCharge(pos)), 1);
+   fModel.BakeField();
+   EXPECT_LT(Distance(fModel.ApplyPosition(pos), fModel.ApplySpaceCharge(pos)), 1e-2);
+   EXPECT_LT(Distance(fModel.CorrectPosition(pos), fModel.CorrectSpaceCharge(pos)), 1e-2);
+}
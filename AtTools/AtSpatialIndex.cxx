@@ -0,0 +1,221 @@
+#include "AtSpatialIndex.h"
+
+#include "AtHit.h"
+
+#include <algorithm>
+#include <utility>
+
+using XYZPoint = ROOT::Math::XYZPoint;
+using XYZVector = ROOT::Math::XYZVector;
+
+AtTools::AtSpatialIndex::AtSpatialIndex(const std::vector<XYZPoint> &points, XYZVector scale) : fScale(scale)
+{
+   std::vector<double> coords;
+   coords.reserve(3 * points.size());
+   for (const auto &point : points) {
+      coords.push_back(point.X() * fScale.X());
+      coords.push_back(point.Y() * fScale.Y());
+      coords.push_back(point.Z() * fScale.Z());
+   }
+   Build(std::move(coords));
+}
+
+AtTools::AtSpatialIndex::AtSpatialIndex(const std::vector<std::unique_ptr<AtHit>> &hits, XYZVector scale)
+   : fScale(scale)
+{
+   std::vector<double> coords;
+   coords.reserve(3 * hits.size());
+   for (const auto &hit : hits) {
+      const auto &pos = hit->GetPosition();
+      coords.push_back(pos.X() * fScale.X());
+      coords.push_back(pos.Y() * fScale.Y());
+      coords.push_back(pos.Z() * fScale.Z());
+   }
+   Build(std::move(coords));
+}
+
+AtTools::AtSpatialIndex::AtSpatialIndex(const std::vector<AtHit> &hits, XYZVector scale) : fScale(scale)
+{
+   std::vector<double> coords;
+   coords.reserve(3 * hits.size());
+   for (const auto &hit : hits) {
+      const auto &pos = hit.GetPosition();
+      coords.push_back(pos.X() * fScale.X());
+      coords.push_back(pos.Y() * fScale.Y());
+      coords.push_back(pos.Z() * fScale.Z());
+   }
+   Build(std::move(coords));
+}
+
+void AtTools::AtSpatialIndex::Build(std::vector<double> coords)
+{
+   auto n = coords.size() / 3;
+   std::vector<std::size_t> perm(n);
+   for (std::size_t i = 0; i < n; ++i)
+      perm[i] = i;
+   fCutDim.assign(n, 0);
+   BuildTree(perm, coords, 0, n);
+
+   fCoords.resize(3 * n);
+   for (std::size_t i = 0; i < n; ++i)
+      for (int d = 0; d < 3; ++d)
+         fCoords[3 * i + d] = coords[3 * perm[i] + d];
+   fIndex = std::move(perm);
+}
+
+/**
+ * Recursively build the subtree of the slots [a,b). The node is the median slot along the dimension with the
+ * largest extent.
+ */
+void AtTools::AtSpatialIndex::BuildTree(std::vector<std::size_t> &perm, const std::vector<double> &coords,
+                                        std::size_t a, std::size_t b)
+{
+   if (b - a <= fLeafSize)
+      return;
+
+   double lo[3], hi[3];
+   for (int d = 0; d < 3; ++d)
+      lo[d] = hi[d] = coords[3 * perm[a] + d];
+   for (auto i = a + 1; i < b; ++i) {
+      for (int d = 0; d < 3; ++d) {
+         lo[d] = std::min(lo[d], coords[3 * perm[i] + d]);
+         hi[d] = std::max(hi[d], coords[3 * perm[i] + d]);
+      }
+   }
+   unsigned char cutDim = 0;
+   for (unsigned char d = 1; d < 3; ++d)
+      if (hi[d] - lo[d] > hi[cutDim] - lo[cutDim])
+         cutDim = d;
+
+   auto m = (a + b) / 2;
+   std::nth_element(perm.begin() + a, perm.begin() + m, perm.begin() + b, [&coords, cutDim](size_t i, size_t j) {
+      return coords[3 * i + cutDim] < coords[3 * j + cutDim];
+   });
+   fCutDim[m] = cutDim;
+
+   BuildTree(perm, coords, a, m);
+   BuildTree(perm, coords, m + 1, b);
+}
+
+void AtTools::AtSpatialIndex::ScalePoint(const XYZPoint &point, double *q) const
+{
+   q[0] = point.X() * fScale.X();
+   q[1] = point.Y() * fScale.Y();
+   q[2] = point.Z() * fScale.Z();
+}
+
+void AtTools::AtSpatialIndex::KNearest(const XYZPoint &point, std::size_t k, std::vector<Neighbor> &result,
+                                       double minDist2) const
+{
+   result.clear();
+   if (k == 0 || fIndex.empty())
+      return;
+
+   double q[3];
+   ScalePoint(point, q);
+   KNearest(q, 0, fIndex.size(), k, minDist2, result);
+   std::sort_heap(result.begin(), result.end());
+}
+
+std::vector<AtTools::AtSpatialIndex::Neighbor>
+AtTools::AtSpatialIndex::KNearest(const XYZPoint &point, std::size_t k, double minDist2) const
+{
+   std::vector<Neighbor> result;
+   result.reserve(k);
+   KNearest(point, k, result, minDist2);
+   return result;
+}
+
+/**
+ * Search the slots [a,b) for neighbors of q. heap is a max heap of the (at most k) best neighbors so far.
+ */
+void AtTools::AtSpatialIndex::KNearest(const double *q, std::size_t a, std::size_t b, std::size_t k, double minDist2,
+                                       std::vector<Neighbor> &heap) const
+{
+   auto consider = [this, q, k, minDist2, &heap](std::size_t slot) {
+      const double *p = &fCoords[3 * slot];
+      double dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+      Neighbor candidate{dx * dx + dy * dy + dz * dz, fIndex[slot]};
+      if (candidate.dist2 <= minDist2)
+         return;
+      if (heap.size() < k) {
+         heap.push_back(candidate);
+         std::push_heap(heap.begin(), heap.end());
+      } else if (candidate < heap.front()) {
+         std::pop_heap(heap.begin(), heap.end());
+         heap.back() = candidate;
+         std::push_heap(heap.begin(), heap.end());
+      }
+   };
+
+   if (b - a <= fLeafSize) {
+      for (auto slot = a; slot < b; ++slot)
+         consider(slot);
+      return;
+   }
+
+   auto m = (a + b) / 2;
+   double diff = q[fCutDim[m]] - fCoords[3 * m + fCutDim[m]];
+   consider(m);
+
+   // Search the side of the cut containing the point first, then the other one if it can still contain a closer
+   // neighbor
+   if (diff < 0)
+      KNearest(q, a, m, k, minDist2, heap);
+   else
+      KNearest(q, m + 1, b, k, minDist2, heap);
+
+   if (heap.size() < k || diff * diff <= heap.front().dist2) {
+      if (diff < 0)
+         KNearest(q, m + 1, b, k, minDist2, heap);
+      else
+         KNearest(q, a, m, k, minDist2, heap);
+   }
+}
+
+void AtTools::AtSpatialIndex::Radius(const XYZPoint &point, double radius, std::vector<std::size_t> &result,
+                                     bool inclusive) const
+{
+   result.clear();
+   if (fIndex.empty())
+      return;
+
+   double q[3];
+   ScalePoint(point, q);
+   Radius(q, 0, fIndex.size(), radius * radius, inclusive, result);
+   std::sort(result.begin(), result.end());
+}
+
+std::vector<std::size_t> AtTools::AtSpatialIndex::Radius(const XYZPoint &point, double radius, bool inclusive) const
+{
+   std::vector<std::size_t> result;
+   Radius(point, radius, result, inclusive);
+   return result;
+}
+
+void AtTools::AtSpatialIndex::Radius(const double *q, std::size_t a, std::size_t b, double r2, bool inclusive,
+                                     std::vector<std::size_t> &result) const
+{
+   auto consider = [this, q, r2, inclusive, &result](std::size_t slot) {
+      const double *p = &fCoords[3 * slot];
+      double dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+      double d2 = dx * dx + dy * dy + dz * dz;
+      if (d2 < r2 || (inclusive && d2 == r2))
+         result.push_back(fIndex[slot]);
+   };
+
+   if (b - a <= fLeafSize) {
+      for (auto slot = a; slot < b; ++slot)
+         consider(slot);
+      return;
+   }
+
+   auto m = (a + b) / 2;
+   double diff = q[fCutDim[m]] - fCoords[3 * m + fCutDim[m]];
+   consider(m);
+
+   if (diff <= 0 || diff * diff <= r2)
+      Radius(q, a, m, r2, inclusive, result);
+   if (diff >= 0 || diff * diff <= r2)
+      Radius(q, m + 1, b, r2, inclusive, result);
+}
@@ -0,0 +1,90 @@
+#ifndef ATSPATIALINDEX_H
+#define ATSPATIALINDEX_H
+
+#include <Math/Point3D.h>
+#include <Math/Point3Dfwd.h>  // for XYZPoint
+#include <Math/Vector3D.h>    // for DisplacementVector3D
+#include <Math/Vector3Dfwd.h> // for XYZVector
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class AtHit;
+
+namespace AtTools {
+
+/**
+ * @brief Spatial index (kd-tree) over a set of 3D positions.
+ *
+ * Supports k-nearest-neighbor and fixed-radius queries in O(log N) per query after an O(N log N) build.
+ * The positions are stored in a single flat array in tree order and the tree structure is implicit,
+ * so building does not allocate per node and queries are const and thread-safe.
+ *
+ * Distances can be made anisotropic by passing a scale for each axis (e.g. to weight the drift
+ * direction differently from the pad plane). All distances taken and returned by the queries are
+ * then measured in the scaled space, i.e. d^2 = sum_i (scale_i*(a_i-b_i))^2.
+ *
+ * Results refer to points by their index in the container the index was built from.
+ */
+class AtSpatialIndex {
+public:
+   using XYZPoint = ROOT::Math::XYZPoint;
+   using XYZVector = ROOT::Math::XYZVector;
+
+   struct Neighbor {
+      double dist2;      //< Squared (scaled) distance to the query point
+      std::size_t index; //< Index of the point in the original container
+
+      bool operator<(const Neighbor &other) const
+      {
+         return dist2 < other.dist2 || (dist2 == other.dist2 && index < other.index);
+      }
+   };
+
+private:
+   static constexpr std::size_t fLeafSize = 8; //< Ranges of at most this many points are scanned linearly
+
+   XYZVector fScale;
+   std::vector<double> fCoords;        //< Scaled coordinates in tree order (x,y,z of slot i at 3*i)
+   std::vector<std::size_t> fIndex;    //< Index in the original container of each slot
+   std::vector<unsigned char> fCutDim; //< Cutting dimension of the node in each slot
+
+public:
+   AtSpatialIndex(const std::vector<XYZPoint> &points, XYZVector scale = {1, 1, 1});
+   AtSpatialIndex(const std::vector<std::unique_ptr<AtHit>> &hits, XYZVector scale = {1, 1, 1});
+   AtSpatialIndex(const std::vector<AtHit> &hits, XYZVector scale = {1, 1, 1});
+
+   std::size_t Size() const { return fIndex.size(); }
+   const XYZVector &GetScale() const { return fScale; }
+
+   /**
+    * @brief Fill result with the k nearest neighbors of point, sorted by increasing distance.
+    *
+    * Points with a squared distance <= minDist2 are skipped (e.g. to exclude the query point itself).
+    * Fewer than k neighbors are returned if there are not enough points.
+    */
+   void KNearest(const XYZPoint &point, std::size_t k, std::vector<Neighbor> &result, double minDist2 = -1) const;
+   std::vector<Neighbor> KNearest(const XYZPoint &point, std::size_t k, double minDist2 = -1) const;
+
+   /**
+    * @brief Fill result with the indices of all points strictly closer than radius to point, sorted by index.
+    *
+    * If inclusive is true, the points at exactly radius from point are included too.
+    */
+   void Radius(const XYZPoint &point, double radius, std::vector<std::size_t> &result, bool inclusive = false) const;
+   std::vector<std::size_t> Radius(const XYZPoint &point, double radius, bool inclusive = false) const;
+
+private:
+   void Build(std::vector<double> coords);
+   void BuildTree(std::vector<std::size_t> &perm, const std::vector<double> &coords, std::size_t a, std::size_t b);
+   void KNearest(const double *q, std::size_t a, std::size_t b, std::size_t k, double minDist2,
+                 std::vector<Neighbor> &heap) const;
+   void Radius(const double *q, std::size_t a, std::size_t b, double r2, bool inclusive,
+               std::vector<std::size_t> &result) const;
+   void ScalePoint(const XYZPoint &point, double *q) const;
+};
+
+} // namespace AtTools
+
+#endif // ATSPATIALINDEX_H
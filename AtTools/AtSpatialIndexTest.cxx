@@ -0,0 +1,86 @@
+#include "AtSpatialIndex.h"
+
+#include <Math/Point3D.h>
+#include <Math/Vector3D.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using XYZPoint = ROOT::Math::XYZPoint;
+using XYZVector = ROOT::Math::XYZVector;
+using AtTools::AtSpatialIndex;
+
+namespace {
+std::vector<AtSpatialIndex::Neighbor>
+BruteForce(const std::vector<XYZPoint> &points, const XYZPoint &point, const XYZVector &scale)
+{
+   std::vector<AtSpatialIndex::Neighbor> ret;
+   for (size_t i = 0; i < points.size(); ++i) {
+      auto diff = points[i] - point;
+      XYZVector scaled(diff.X() * scale.X(), diff.Y() * scale.Y(), diff.Z() * scale.Z());
+      ret.push_back({scaled.Mag2(), i});
+   }
+   std::sort(ret.begin(), ret.end());
+   return ret;
+}
+} // namespace
+
+TEST(AtSpatialIndexTest, SmallCloud)
+{
+   std::vector<XYZPoint> points = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 3}};
+   AtSpatialIndex index(points);
+
+   auto neighbors = index.KNearest({0, 0, 0}, 2);
+   ASSERT_EQ(neighbors.size(), 2u);
+   EXPECT_EQ(neighbors[0].index, 0u);
+   EXPECT_EQ(neighbors[1].index, 1u);
+   EXPECT_DOUBLE_EQ(neighbors[1].dist2, 1);
+
+   // Exclude the query point itself
+   neighbors = index.KNearest({0, 0, 0}, 10, 0.01);
+   ASSERT_EQ(neighbors.size(), 3u);
+   EXPECT_EQ(neighbors[2].index, 3u);
+
+   EXPECT_EQ(index.Radius({0, 0, 0}, 1), std::vector<size_t>({0}));
+   EXPECT_EQ(index.Radius({0, 0, 0}, 1.01), std::vector<size_t>({0, 1, 2}));
+   // The points at exactly the radius
+   EXPECT_EQ(index.Radius({0, 0, 0}, 1, true), std::vector<size_t>({0, 1, 2}));
+
+   // Shrinking z brings the last point closer than the others
+   AtSpatialIndex scaled(points, {1, 1, 0.1});
+   neighbors = scaled.KNearest({0, 0, 0}, 2, 0.01);
+   ASSERT_EQ(neighbors.size(), 2u);
+   EXPECT_EQ(neighbors[0].index, 3u);
+}
+
+TEST(AtSpatialIndexTest, MatchesBruteForce)
+{
+   std::mt19937 gen(42);
+   std::uniform_real_distribution<double> dist(-100, 100);
+   std::vector<XYZPoint> points;
+   for (int i = 0; i < 2000; ++i)
+      points.emplace_back(dist(gen), dist(gen), dist(gen));
+
+   XYZVector scale(1, 1, 0.5);
+   AtSpatialIndex index(points, scale);
+
+   for (int i = 0; i < 50; ++i) {
+      XYZPoint point(dist(gen), dist(gen), dist(gen));
+      auto expected = BruteForce(points, point, scale);
+
+      auto neighbors = index.KNearest(point, 10);
+      ASSERT_EQ(neighbors.size(), 10u);
+      for (int j = 0; j < 10; ++j) {
+         EXPECT_EQ(neighbors[j].index, expected[j].index);
+         EXPECT_NEAR(neighbors[j].dist2, expected[j].dist2, 1e-9);
+      }
+
+      auto inRange = index.Radius(point, 15);
+      auto nExpected = std::count_if(expected.begin(), expected.end(), [](auto &n) { return n.dist2 < 15 * 15; });
+      EXPECT_EQ(inRange.size(), static_cast<size_t>(nExpected));
+      EXPECT_TRUE(std::is_sorted(inRange.begin(), inRange.end()));
+   }
+}
@@ -0,0 +1,61 @@
+#include "AtTimestampMatcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using AtTools::AtTimestampMatcher;
+
+AtTimestampMatcher::AtTimestampMatcher(const std::vector<Long64_t> &timestamps, double glom, Long64_t offset)
+   : fGlom(glom), fOffset(offset)
+{
+   std::vector<std::size_t> order(timestamps.size());
+   std::iota(order.begin(), order.end(), 0);
+   std::stable_sort(order.begin(), order.end(),
+                    [&timestamps](std::size_t a, std::size_t b) { return timestamps[a] < timestamps[b]; });
+
+   fTs.reserve(order.size());
+   fEntry.reserve(order.size());
+   for (auto entry : order) {
+      fTs.push_back(timestamps[entry]);
+      fEntry.push_back(entry);
+   }
+
+   fAmbiguous.resize(fTs.size(), false);
+   for (std::size_t i = 1; i < fTs.size(); ++i)
+      fAmbiguous[i] = IsInGlom(fTs[i - 1], fTs[i]);
+}
+
+bool AtTimestampMatcher::IsInGlom(Long64_t ts1, Long64_t ts2) const
+{
+   return ts1 > 0 && ts2 > 0 && std::fabs(ts1 - ts2) < fGlom;
+}
+
+Long64_t AtTimestampMatcher::Match(Long64_t ts)
+{
+   // Skip the reference timestamps too early to match this (or any later) event
+   if (ts < fLastTs) {
+      fStats.outOfOrder++;
+      fCursor = std::lower_bound(fTs.begin(), fTs.end(), ts,
+                                 [this](Long64_t ref, Long64_t evt) { return ref + fOffset <= evt - fGlom; }) -
+                fTs.begin();
+   } else {
+      while (fCursor < fTs.size() && fTs[fCursor] + fOffset <= ts - fGlom)
+         ++fCursor;
+   }
+   fLastTs = ts;
+
+   for (auto i = fCursor; i < fTs.size() && fTs[i] + fOffset < ts + fGlom; ++i) {
+      if (!IsInGlom(fTs[i] + fOffset, ts))
+         continue;
+      if (fAmbiguous[i]) {
+         fStats.ambiguous++;
+         continue;
+      }
+      fStats.matched++;
+      return fEntry[i];
+   }
+
+   fStats.unmatched++;
+   return -1;
+}
@@ -0,0 +1,67 @@
+#ifndef ATTIMESTAMPMATCHER_H
+#define ATTIMESTAMPMATCHER_H
+
+#include <Rtypes.h> // for Long64_t
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace AtTools {
+
+/**
+ * @brief Match the timestamps of a stream of events to a list of reference timestamps.
+ *
+ * Used to merge the data of two DAQs (e.g. the AT-TPC and the S800). The reference timestamps are
+ * sorted once and a cursor into them follows the stream as events are matched. When the events are
+ * in time order every reference timestamp is visited a constant number of times, so merging a run
+ * is linear in its length. If an event goes back in time the cursor is placed with a binary search.
+ *
+ * An event matches a reference timestamp if they differ by less than the glom, after adding the
+ * offset to the reference timestamp. Timestamps must be positive to match. A reference timestamp within
+ * the glom of the previous one is ambiguous and is never matched. The number of matched and unmatched
+ * events, skipped ambiguous timestamps and events out of time order are counted rather than
+ * reported for each event.
+ */
+class AtTimestampMatcher {
+public:
+   struct Stats {
+      Long64_t matched{0};
+      Long64_t unmatched{0};
+      Long64_t ambiguous{0};  //< Ambiguous reference timestamps skipped while looking for a match
+      Long64_t outOfOrder{0}; //< Events with a timestamp before the previous event
+   };
+
+private:
+   std::vector<Long64_t> fTs;    //< Sorted reference timestamps
+   std::vector<Long64_t> fEntry; //< Entry of each sorted reference timestamp
+   std::vector<bool> fAmbiguous; //< If each sorted reference timestamp is within the glom of the previous one
+   double fGlom;                 //< Maximum difference between matching timestamps
+   Long64_t fOffset;             //< Offset to add to the reference timestamps
+   std::size_t fCursor{0};       //< First reference timestamp that could match the next event
+   Long64_t fLastTs{std::numeric_limits<Long64_t>::min()}; //< Timestamp of the previous event
+   Stats fStats;
+
+public:
+   /**
+    * @param[in] timestamps Reference timestamp of each entry (does not need to be sorted).
+    * @param[in] glom Maximum difference between matching timestamps.
+    * @param[in] offset Added to every reference timestamp before comparing it to an event.
+    */
+   AtTimestampMatcher(const std::vector<Long64_t> &timestamps, double glom, Long64_t offset = 0);
+
+   /**
+    * @brief Get the entry of the reference timestamp matching ts, or -1 if there is none.
+    */
+   Long64_t Match(Long64_t ts);
+
+   std::size_t Size() const { return fTs.size(); }
+   const Stats &GetStats() const { return fStats; }
+
+private:
+   bool IsInGlom(Long64_t ts1, Long64_t ts2) const;
+};
+
+} // namespace AtTools
+
+#endif // ATTIMESTAMPMATCHER_H
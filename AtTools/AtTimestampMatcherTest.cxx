@@ -0,0 +1,43 @@
+#include "AtTimestampMatcher.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using AtTools::AtTimestampMatcher;
+
+TEST(AtTimestampMatcherTest, InOrder)
+{
+   AtTimestampMatcher matcher({100, 200, 300, 400}, 2, 10);
+
+   EXPECT_EQ(matcher.Match(111), 0);
+   EXPECT_EQ(matcher.Match(250), -1);
+   EXPECT_EQ(matcher.Match(309), 2);
+   EXPECT_EQ(matcher.Match(411), 3);
+
+   EXPECT_EQ(matcher.GetStats().matched, 3);
+   EXPECT_EQ(matcher.GetStats().unmatched, 1);
+   EXPECT_EQ(matcher.GetStats().outOfOrder, 0);
+}
+
+TEST(AtTimestampMatcherTest, UnsortedAndOutOfOrder)
+{
+   AtTimestampMatcher matcher({300, 100, 200}, 2);
+
+   EXPECT_EQ(matcher.Match(300), 0);
+   EXPECT_EQ(matcher.Match(101), 1);
+   EXPECT_EQ(matcher.Match(199), 2);
+   EXPECT_EQ(matcher.GetStats().outOfOrder, 1);
+}
+
+TEST(AtTimestampMatcherTest, Ambiguous)
+{
+   // The second timestamp is within the glom of the first so it is never matched
+   AtTimestampMatcher matcher({100, 101, 200}, 2);
+
+   EXPECT_EQ(matcher.Match(102), -1);
+   EXPECT_EQ(matcher.GetStats().ambiguous, 1);
+   EXPECT_EQ(matcher.Match(0), -1);
+   EXPECT_EQ(matcher.Match(99), 0);
+   EXPECT_EQ(matcher.Match(200), 2);
+}
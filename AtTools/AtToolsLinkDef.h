@@ -55,8 +55,14 @@
 #pragma link C++ class tk::spline - !;
 
 #pragma link C++ class AtFindVertex - !;
+#pragma link C++ class AtTools::AtSpatialIndex - !;
+#pragma link C++ class AtTools::AtTimestampMatcher - !;
+#pragma link C++ class AtTools::AtPolygonGate - !;
+#pragma link C++ class AtTools::AtTraceSpectrum - !;
+#pragma link C++ class AtTools::AtProfiler - !;
 
 #pragma link C++ function AtTools::GetHitFunctionTB;
+#pragma link C++ function AtTools::GetHitParametersTB;
 #pragma link C++ function AtTools::GetHitFunction;
 #pragma link C++ function AtTools::GetTB;
 #pragma link C++ function AtTools::GetDriftTB;
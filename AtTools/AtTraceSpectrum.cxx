@@ -0,0 +1,393 @@
+#include "AtTraceSpectrum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using AtTools::AtTraceSpectrum;
+
+namespace {
+/// Mean of ws[offset + w] over the buckets w of [center - halfWidth, center + halfWidth] within [0, size)
+Double_t WindowMean(const Double_t *ws, Int_t offset, Int_t size, Int_t center, Int_t halfWidth)
+{
+   Double_t sum = 0;
+   Double_t n = 0;
+   for (Int_t w = center - halfWidth; w <= center + halfWidth; w++) {
+      if (w >= 0 && w < size) {
+         sum += ws[offset + w];
+         n += 1;
+      }
+   }
+   return sum / n;
+}
+
+/**
+ * One pass of the second order clipping filter with a window of i buckets over the trace in ws[offset, offset +
+ * size), using ws[0, size) as scratch. If halfWidth > 0 the buckets are averaged over 2 * halfWidth + 1 buckets.
+ */
+void ClipPass(Double_t *ws, Int_t offset, Int_t size, Int_t i, Int_t halfWidth, Bool_t smoothing)
+{
+   for (Int_t j = i; j < size - i; j++) {
+      Double_t a = ws[offset + j];
+      if (!smoothing) {
+         Double_t b = (ws[offset + j - i] + ws[offset + j + i]) / 2.0;
+         if (b < a)
+            a = b;
+         ws[j] = a;
+      } else {
+         Double_t av = WindowMean(ws, offset, size, j, halfWidth);
+         Double_t b = WindowMean(ws, offset, size, j - i, halfWidth);
+         Double_t c = WindowMean(ws, offset, size, j + i, halfWidth);
+         b = (b + c) / 2;
+         if (b < a)
+            av = b;
+         ws[j] = av;
+      }
+   }
+   for (Int_t j = i; j < size - i; j++)
+      ws[offset + j] = ws[j];
+}
+} // namespace
+
+/**
+ * The steps, and the order of the arithmetic in each of them, are the ones of TSpectrum::SearchHighRes so the
+ * positions are the same. The working space is laid out the same way, in blocks of sizeExt buckets: the trace
+ * extended by shift buckets on both sides is in block 1, a copy of it in block 6, and blocks 0 and 2 to 4 are used
+ * by the smoothing and the deconvolution.
+ */
+Int_t AtTraceSpectrum::SearchHighRes(const Double_t *source, Double_t *destVector, Int_t ssize, Double_t sigma,
+                                     Double_t threshold, Bool_t backgroundRemove, Int_t deconIterations,
+                                     Bool_t markov, Int_t averWindow)
+{
+   fNPeaks = 0;
+   if (ssize <= 0 || ssize > kMaxSize)
+      throw std::invalid_argument("AtTraceSpectrum: invalid trace size " + std::to_string(ssize));
+   if (sigma < 1)
+      throw std::invalid_argument("AtTraceSpectrum: sigma must be greater than or equal to 1");
+   if (threshold <= 0 || threshold >= 100)
+      throw std::invalid_argument("AtTraceSpectrum: threshold must be positive and less than 100");
+   const Int_t numberIterations = static_cast<Int_t>(7 * sigma + 0.5);
+   if (numberIterations > kMaxShift)
+      throw std::invalid_argument("AtTraceSpectrum: sigma is too large");
+   if (markov && averWindow <= 0)
+      throw std::invalid_argument("AtTraceSpectrum: averaging window must be positive");
+   if (backgroundRemove && ssize < 2 * numberIterations + 1)
+      throw std::invalid_argument("AtTraceSpectrum: clipping window is too large");
+
+   const Int_t shift = numberIterations;
+   const Int_t sizeExt = ssize + 2 * numberIterations;
+   Double_t *ws = fWork.data();
+   std::fill_n(ws, 7 * sizeExt, 0.);
+
+   // Slope of the start of the trace, used to extend it to the left
+   Double_t l1low = 0;
+   Int_t k = static_cast<Int_t>(2 * sigma + 0.5);
+   if (k >= 2) {
+      Double_t m0low = 0, m1low = 0, m2low = 0, l0low = 0;
+      for (Int_t i = 0; i < k; i++) {
+         Double_t a = i, b = source[i];
+         m0low += 1, m1low += a, m2low += a * a, l0low += b, l1low += a * b;
+      }
+      Double_t detlow = m0low * m2low - m1low * m1low;
+      if (detlow != 0)
+         l1low = (-l0low * m1low + l1low * m0low) / detlow;
+      else
+         l1low = 0;
+      if (l1low > 0)
+         l1low = 0;
+   }
+
+   auto extended = [&](Int_t i) {
+      if (i < shift) {
+         Double_t b = source[0] + l1low * (i - shift);
+         return b < 0 ? 0. : b;
+      }
+      if (i >= ssize + shift)
+         return source[ssize - 1] < 0 ? 0. : source[ssize - 1];
+      return source[i - shift];
+   };
+   for (Int_t i = 0; i < sizeExt; i++)
+      ws[i + sizeExt] = extended(i);
+
+   const Int_t bw = 2;
+   if (backgroundRemove) {
+      for (Int_t i = 1; i <= numberIterations; i++)
+         ClipPass(ws, sizeExt, sizeExt, i, bw, markov);
+      for (Int_t j = 0; j < sizeExt; j++)
+         ws[sizeExt + j] = extended(j) - ws[sizeExt + j];
+      for (Int_t j = 0; j < sizeExt; j++)
+         if (ws[sizeExt + j] < 0)
+            ws[sizeExt + j] = 0;
+   }
+
+   for (Int_t i = 0; i < sizeExt; i++)
+      ws[i + 6 * sizeExt] = ws[i + sizeExt];
+
+   if (markov) {
+      for (Int_t j = 0; j < sizeExt; j++)
+         ws[2 * sizeExt + j] = ws[sizeExt + j];
+      Int_t xmin = 0, xmax = sizeExt - 1;
+      Double_t maxch = 0;
+      Double_t plocha = 0;
+      for (Int_t i = 0; i < sizeExt; i++) {
+         ws[i] = 0;
+         if (maxch < ws[2 * sizeExt + i])
+            maxch = ws[2 * sizeExt + i];
+         plocha += ws[2 * sizeExt + i];
+      }
+      if (maxch == 0)
+         return 0;
+
+      Double_t nom = 1;
+      ws[xmin] = 1;
+      for (Int_t i = xmin; i < xmax; i++) {
+         Double_t nip = ws[2 * sizeExt + i] / maxch;
+         Double_t nim = ws[2 * sizeExt + i + 1] / maxch;
+         Double_t sp = 0, sm = 0;
+         for (Int_t l = 1; l <= averWindow; l++) {
+            Double_t a = (i + l > xmax) ? ws[2 * sizeExt + xmax] / maxch : ws[2 * sizeExt + i + l] / maxch;
+            Double_t b = a - nip;
+            a = (a + nip <= 0) ? 1 : std::sqrt(a + nip);
+            sp = sp + std::exp(b / a);
+
+            a = (i - l + 1 < xmin) ? ws[2 * sizeExt + xmin] / maxch : ws[2 * sizeExt + i - l + 1] / maxch;
+            b = a - nim;
+            a = (a + nim <= 0) ? 1 : std::sqrt(a + nim);
+            sm = sm + std::exp(b / a);
+         }
+         Double_t a = ws[i + 1] = ws[i] * (sp / sm);
+         nom = nom + a;
+      }
+      for (Int_t i = xmin; i <= xmax; i++)
+         ws[i] = ws[i] / nom;
+      for (Int_t j = 0; j < sizeExt; j++)
+         ws[sizeExt + j] = ws[j] * plocha;
+      for (Int_t j = 0; j < sizeExt; j++)
+         ws[2 * sizeExt + j] = ws[sizeExt + j];
+      if (backgroundRemove) {
+         for (Int_t i = 1; i <= numberIterations; i++)
+            ClipPass(ws, sizeExt, sizeExt, i, 0, false);
+         for (Int_t j = 0; j < sizeExt; j++)
+            ws[sizeExt + j] = ws[2 * sizeExt + j] - ws[sizeExt + j];
+      }
+   }
+
+   // Gold deconvolution. Response: gaussian of sigma centered at 3 sigma, rounded to a per mil of its maximum
+   Double_t area = 0;
+   Double_t maximum = 0;
+   Int_t lhGold = -1;
+   Int_t posit = 0;
+   for (Int_t i = 0; i < sizeExt; i++) {
+      Double_t lda = i - 3 * sigma;
+      lda = lda * lda / (2 * sigma * sigma);
+      lda = static_cast<Int_t>(1000 * std::exp(-lda));
+      if (lda != 0)
+         lhGold = i + 1;
+      ws[i] = lda;
+      area = area + lda;
+      if (lda > maximum) {
+         maximum = lda;
+         posit = i;
+      }
+   }
+   for (Int_t i = 0; i < sizeExt; i++)
+      ws[2 * sizeExt + i] = std::abs(ws[sizeExt + i]);
+
+   // Autocorrelation of the response
+   Int_t imin = -std::min(lhGold - 1, sizeExt);
+   Int_t imax = -imin;
+   for (Int_t i = imin; i <= imax; i++) {
+      Double_t lda = 0;
+      Int_t jmin = i < 0 ? -i : 0;
+      Int_t jmax = std::min(lhGold - 1 - i, lhGold - 1);
+      for (Int_t j = jmin; j <= jmax; j++)
+         lda = lda + ws[j] * ws[i + j];
+      ws[sizeExt + i - imin] = lda;
+   }
+
+   // Correlation of the response and the trace
+   imin = -(lhGold - 1);
+   imax = sizeExt + lhGold - 2;
+   for (Int_t i = imin; i <= imax; i++) {
+      Double_t lda = 0;
+      for (Int_t j = 0; j <= lhGold - 1; j++) {
+         Int_t kk = i + j;
+         if (kk >= 0 && kk < sizeExt)
+            lda = lda + ws[j] * ws[2 * sizeExt + kk];
+      }
+      ws[4 * sizeExt + i - imin] = lda;
+   }
+   for (Int_t i = imin; i <= imax; i++)
+      ws[2 * sizeExt + i - imin] = ws[4 * sizeExt + i - imin];
+
+   for (Int_t i = 0; i < sizeExt; i++)
+      ws[i] = 1;
+   for (Int_t iter = 0; iter < deconIterations; iter++) {
+      for (Int_t i = 0; i < sizeExt; i++) {
+         if (std::abs(ws[2 * sizeExt + i]) > 0.00001 && std::abs(ws[i]) > 0.00001) {
+            Double_t lda = 0;
+            Int_t jmin = -std::min(lhGold - 1, i);
+            Int_t jmax = std::min(lhGold - 1, sizeExt - 1 - i);
+            for (Int_t j = jmin; j <= jmax; j++)
+               lda = lda + ws[j + lhGold - 1 + sizeExt] * ws[i + j];
+            Double_t ldb = ws[2 * sizeExt + i];
+            if (lda != 0)
+               lda = ldb / lda;
+            else
+               lda = 0;
+            ws[3 * sizeExt + i] = lda * ws[i];
+         }
+      }
+      for (Int_t i = 0; i < sizeExt; i++)
+         ws[i] = ws[3 * sizeExt + i];
+   }
+
+   // Shift the result to the position of the maximum of the response
+   for (Int_t i = 0; i < sizeExt; i++)
+      ws[sizeExt + (i + posit) % sizeExt] = ws[i];
+
+   maximum = 0;
+   Double_t maximumDecon = 0;
+   Int_t j0 = lhGold - 1;
+   for (Int_t i = 0; i < sizeExt - j0; i++) {
+      if (i >= shift && i < ssize + shift) {
+         ws[i] = area * ws[sizeExt + i + j0];
+         if (maximumDecon < ws[i])
+            maximumDecon = ws[i];
+         if (maximum < ws[6 * sizeExt + i])
+            maximum = ws[6 * sizeExt + i];
+      } else {
+         ws[i] = 0;
+      }
+   }
+   Double_t lda = std::min(1., threshold) / 100;
+
+   // Local maxima of the deconvolved trace, kept ordered by the height of the (background subtracted) trace
+   Int_t peakIndex = 0;
+   for (Int_t i = 1; i < sizeExt - 1; i++) {
+      if (!(ws[i] > ws[i - 1] && ws[i] > ws[i + 1]) || i < shift || i >= ssize + shift)
+         continue;
+      if (!(ws[i] > lda * maximumDecon && ws[6 * sizeExt + i] > threshold * maximum / 100.0))
+         continue;
+
+      Double_t a = 0, b = 0;
+      for (Int_t j = i - 1; j <= i + 1; j++) {
+         a += static_cast<Double_t>(j - shift) * ws[j];
+         b += ws[j];
+      }
+      a = a / b;
+      if (a < 0)
+         a = 0;
+      if (a >= ssize)
+         a = ssize - 1;
+
+      if (peakIndex == 0) {
+         fPositionX[0] = a;
+         peakIndex = 1;
+         continue;
+      }
+      Int_t j = 0;
+      Bool_t priz = false;
+      for (; j < peakIndex && !priz; j++) {
+         if (ws[6 * sizeExt + shift + static_cast<Int_t>(a)] >
+             ws[6 * sizeExt + shift + static_cast<Int_t>(fPositionX[j])])
+            priz = true;
+      }
+      if (!priz) {
+         if (j < kMaxPeaks)
+            fPositionX[j] = a;
+      } else {
+         for (Int_t kk = peakIndex; kk >= j; kk--)
+            if (kk < kMaxPeaks)
+               fPositionX[kk] = fPositionX[kk - 1];
+         fPositionX[j - 1] = a;
+      }
+      if (peakIndex < kMaxPeaks)
+         peakIndex += 1;
+   }
+
+   for (Int_t i = 0; i < ssize; i++)
+      destVector[i] = ws[i + shift];
+   fNPeaks = peakIndex;
+   return fNPeaks;
+}
+
+/**
+ * SNIP algorithm as in TSpectrum::Background. The trace being clipped is in the second half of the working space,
+ * the first half is scratch.
+ */
+void AtTraceSpectrum::Background(Double_t *spectrum, Int_t ssize, Int_t numberIterations, Direction direction,
+                                 Bool_t smoothing, Int_t smoothWindow, Bool_t compton)
+{
+   if (ssize <= 0 || ssize > kMaxSize)
+      throw std::invalid_argument("AtTraceSpectrum: invalid trace size " + std::to_string(ssize));
+   if (numberIterations < 1)
+      throw std::invalid_argument("AtTraceSpectrum: width of the clipping window must be positive");
+   if (ssize < 2 * numberIterations + 1)
+      throw std::invalid_argument("AtTraceSpectrum: clipping window is too large");
+   if (smoothing && (smoothWindow < 3 || smoothWindow > 15 || smoothWindow % 2 == 0))
+      throw std::invalid_argument("AtTraceSpectrum: smoothing window must be an odd number from 3 to 15");
+
+   Double_t *ws = fWork.data();
+   for (Int_t i = 0; i < ssize; i++) {
+      ws[i] = spectrum[i];
+      ws[i + ssize] = spectrum[i];
+   }
+
+   Int_t bw = (smoothWindow - 1) / 2;
+   if (direction == kIncreasingWindow) {
+      for (Int_t i = 1; i <= numberIterations; i++)
+         ClipPass(ws, ssize, ssize, i, bw, smoothing);
+   } else {
+      for (Int_t i = numberIterations; i >= 1; i--)
+         ClipPass(ws, ssize, ssize, i, bw, smoothing);
+   }
+
+   if (compton) {
+      for (Int_t i = 0, b2 = 0; i < ssize; i++) {
+         Double_t a = ws[i], b = spectrum[i];
+         if (std::abs(a - b) < 1)
+            continue;
+
+         Int_t b1 = std::max(i - 1, 0);
+         Double_t yb1 = ws[b1];
+         Bool_t priz = false;
+         for (b2 = b1 + 1; !priz && b2 < ssize; b2++) {
+            a = ws[b2], b = spectrum[b2];
+            if (std::abs(a - b) < 1)
+               priz = true;
+         }
+         if (b2 == ssize)
+            b2 -= 1;
+         Double_t yb2 = ws[b2];
+
+         Double_t c = 0, d = 0;
+         if (yb1 <= yb2) {
+            for (Int_t j = b1; j <= b2; j++)
+               c = c + spectrum[j] - yb1;
+            if (c > 1) {
+               c = (yb2 - yb1) / c;
+               for (Int_t j = b1; j <= b2 && j < ssize; j++) {
+                  d = d + spectrum[j] - yb1;
+                  ws[ssize + j] = c * d + yb1;
+               }
+            }
+         } else {
+            for (Int_t j = b2; j >= b1; j--)
+               c = c + spectrum[j] - yb2;
+            if (c > 1) {
+               c = (yb1 - yb2) / c;
+               for (Int_t j = b2; j >= b1 && j >= 0; j--) {
+                  d = d + spectrum[j] - yb2;
+                  ws[ssize + j] = c * d + yb2;
+               }
+            }
+         }
+         i = b2;
+      }
+   }
+
+   for (Int_t j = 0; j < ssize; j++)
+      spectrum[j] = ws[ssize + j];
+}
@@ -0,0 +1,72 @@
+#ifndef ATTRACESPECTRUM_H
+#define ATTRACESPECTRUM_H
+
+#include <Rtypes.h> // for Double_t, Int_t, Bool_t
+
+#include <array>
+
+namespace AtTools {
+
+/**
+ * @brief Peak search and background estimation of pad traces, giving the same results as TSpectrum.
+ *
+ * Reimplements TSpectrum::SearchHighRes (Markov smoothing and Gold deconvolution) and TSpectrum::Background (SNIP
+ * clipping filter of second order) for traces of at most kMaxSize buckets. All the working space is held by the
+ * object, so nothing is allocated per trace, and no ROOT globals are used. Different objects can then be used from
+ * different threads (one per AtPSA clone for example).
+ *
+ * The arguments and results are the ones of TSpectrum, so
+ * @code
+ * TSpectrum spectrum;
+ * spectrum.SearchHighRes(source, dest, 512, 4.7, 5, kFALSE, 3, kTRUE, 3);
+ * @endcode
+ * is replaced by the same call on an AtTraceSpectrum. Invalid arguments throw std::invalid_argument instead of
+ * returning 0.
+ */
+class AtTraceSpectrum {
+public:
+   static constexpr Int_t kMaxSize = 512;   //< Maximum number of buckets of a trace
+   static constexpr Int_t kMaxPeaks = 100;  //< Maximum number of peaks (as the default TSpectrum)
+   static constexpr Int_t kMaxShift = 64;   //< Maximum extension of the trace in SearchHighRes, 7 * sigma + 0.5
+   enum Direction { kIncreasingWindow, kDecreasingWindow }; //< As TSpectrum::kBackIncreasingWindow etc.
+
+private:
+   std::array<Double_t, 7 * (kMaxSize + 2 * kMaxShift)> fWork{};
+   std::array<Double_t, kMaxPeaks> fPositionX{};
+   Int_t fNPeaks{0};
+
+public:
+   /**
+    * @brief Search for peaks in source, as TSpectrum::SearchHighRes.
+    *
+    * @param[in] source Trace of ssize buckets (it is not modified).
+    * @param[out] destVector Deconvolved trace (ssize buckets).
+    * @param[in] sigma Sigma of the searched peaks, at most (kMaxShift - 0.5) / 7.
+    * @param[in] threshold Peaks lower than threshold % of the highest peak are discarded.
+    * @param[in] backgroundRemove Remove the background before deconvolution.
+    * @param[in] deconIterations Number of iterations of the Gold deconvolution.
+    * @param[in] markov Smooth the trace with a Markov chain before deconvolution.
+    * @param[in] averWindow Averaging window of the Markov smoothing.
+    * @return Number of peaks found. Their positions are in GetPositionX(), ordered by decreasing height.
+    */
+   Int_t SearchHighRes(const Double_t *source, Double_t *destVector, Int_t ssize, Double_t sigma, Double_t threshold,
+                       Bool_t backgroundRemove, Int_t deconIterations, Bool_t markov, Int_t averWindow);
+
+   /**
+    * @brief Replace spectrum by its background, as TSpectrum::Background with TSpectrum::kBackOrder2.
+    *
+    * @param[in,out] spectrum Trace of ssize buckets.
+    * @param[in] numberIterations Maximum width of the clipping window.
+    * @param[in] smoothing Average the trace over smoothWindow buckets (3 to 15) while clipping.
+    * @param[in] compton Estimate the Compton edges.
+    */
+   void Background(Double_t *spectrum, Int_t ssize, Int_t numberIterations, Direction direction, Bool_t smoothing,
+                   Int_t smoothWindow, Bool_t compton);
+
+   Int_t GetNPeaks() const { return fNPeaks; }
+   const Double_t *GetPositionX() const { return fPositionX.data(); }
+};
+
+} // namespace AtTools
+
+#endif // ATTRACESPECTRUM_H
@@ -0,0 +1,95 @@
+#include "AtTraceSpectrum.h"
+
+#include <TSpectrum.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+using AtTools::AtTraceSpectrum;
+
+namespace {
+/// Pad trace with a sloped baseline, noise and a few pulses (two of them overlapping)
+std::array<Double_t, 512> MakeTrace(unsigned int seed)
+{
+   std::mt19937 gen(seed);
+   std::normal_distribution<Double_t> noise(0, 3);
+   std::uniform_real_distribution<Double_t> tb(20, 480);
+   std::uniform_real_distribution<Double_t> amp(100, 3000);
+
+   std::array<Double_t, 512> trace{};
+   for (int i = 0; i < 512; ++i)
+      trace[i] = 20 + 0.02 * i + noise(gen);
+   std::array<Double_t, 3> mean{};
+   mean[0] = tb(gen);
+   mean[1] = mean[0] + 20;
+   mean[2] = tb(gen);
+   for (auto tb0 : mean) {
+      Double_t height = amp(gen);
+      for (int i = 0; i < 512; ++i)
+         trace[i] += height * std::exp(-0.5 * std::pow((i - tb0) / 4., 2));
+   }
+   return trace;
+}
+} // namespace
+
+TEST(AtTraceSpectrumTest, SearchHighResMatchesTSpectrum)
+{
+   AtTraceSpectrum spectrum;
+   for (unsigned int seed = 0; seed < 50; ++seed) {
+      auto trace = MakeTrace(seed);
+      for (Bool_t background : {kFALSE, kTRUE}) {
+         std::array<Double_t, 512> dest{};
+         std::array<Double_t, 512> rootDest{};
+         auto rootTrace = trace;
+         TSpectrum rootSpectrum;
+         auto numPeaks = spectrum.SearchHighRes(trace.data(), dest.data(), 512, 4.7, 5, background, 3, kTRUE, 3);
+         auto rootNumPeaks =
+            rootSpectrum.SearchHighRes(rootTrace.data(), rootDest.data(), 512, 4.7, 5, background, 3, kTRUE, 3);
+
+         ASSERT_EQ(numPeaks, rootNumPeaks) << "seed " << seed;
+         for (int i = 0; i < numPeaks; ++i)
+            EXPECT_NEAR(spectrum.GetPositionX()[i], rootSpectrum.GetPositionX()[i], 1e-6) << "seed " << seed;
+         for (int i = 0; i < 512; ++i)
+            EXPECT_NEAR(dest[i], rootDest[i], 1e-6 * (1 + std::abs(rootDest[i])));
+      }
+   }
+}
+
+TEST(AtTraceSpectrumTest, BackgroundMatchesTSpectrum)
+{
+   AtTraceSpectrum spectrum;
+   for (unsigned int seed = 0; seed < 50; ++seed) {
+      auto bg = MakeTrace(seed);
+      auto rootBg = bg;
+      spectrum.Background(bg.data(), 512, 6, AtTraceSpectrum::kDecreasingWindow, kTRUE, 7, kTRUE);
+      TSpectrum rootSpectrum;
+      rootSpectrum.Background(rootBg.data(), 512, 6, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, kTRUE,
+                              TSpectrum::kBackSmoothing7, kTRUE);
+      for (int i = 0; i < 512; ++i)
+         EXPECT_NEAR(bg[i], rootBg[i], 1e-9 * (1 + std::abs(rootBg[i]))) << "seed " << seed << " tb " << i;
+   }
+}
+
+TEST(AtTraceSpectrumTest, FindsPulses)
+{
+   std::array<Double_t, 512> trace{};
+   std::array<Double_t, 512> dest{};
+   for (int i = 0; i < 512; ++i)
+      trace[i] = 800 * std::exp(-0.5 * std::pow((i - 150) / 4., 2)) + 300 * std::exp(-0.5 * std::pow((i - 400) / 4., 2));
+
+   AtTraceSpectrum spectrum;
+   ASSERT_EQ(spectrum.SearchHighRes(trace.data(), dest.data(), 512, 4.7, 5, kFALSE, 3, kTRUE, 3), 2);
+   // Ordered by height
+   EXPECT_NEAR(spectrum.GetPositionX()[0], 150, 1);
+   EXPECT_NEAR(spectrum.GetPositionX()[1], 400, 1);
+
+   // Nothing above an empty trace
+   trace.fill(0);
+   EXPECT_EQ(spectrum.SearchHighRes(trace.data(), dest.data(), 512, 4.7, 5, kFALSE, 3, kTRUE, 3), 0);
+   EXPECT_THROW(spectrum.SearchHighRes(trace.data(), dest.data(), 1024, 4.7, 5, kFALSE, 3, kTRUE, 3),
+                std::invalid_argument);
+}
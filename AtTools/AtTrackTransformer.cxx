@@ -2,20 +2,18 @@
 // IWYU pragma: no_include <ext/alloc_traits.h>
 
 #include "AtHit.h"        // for AtHit, AtHit::XYZPoint
-#include "AtHitCluster.h" // for AtHitCluster
-#include "AtTrack.h"      // for XYZPoint, AtTrack
+#include "AtHitCluster.h"   // for AtHitCluster
+#include "AtSpatialIndex.h" // for AtSpatialIndex
+#include "AtTrack.h"        // for XYZPoint, AtTrack
 
 #include <Math/Point3D.h> // for PositionVector3D, Cart...
 #include <Math/Point3Dfwd.h>
 #include <Math/Vector3D.h>  // for DisplacementVector3D
 #include <TMath.h>          // for Power, Sqrt, ATan2, Pi
-#include <TMatrixDSymfwd.h> // for TMatrixDSym
-#include <TMatrixTSym.h>    // for TMatrixTSym
 #include <TVector3.h>       // for TVector3
 
-#include <algorithm> // for max, for_each, copy_if
-#include <iterator>  // for back_insert_iterator
-#include <memory>    // for shared_ptr, __shared_p...
+#include <algorithm> // for max
+#include <utility>   // for move
 #include <vector>    // for vector
 
 AtTools::AtTrackTransformer::AtTrackTransformer() = default;
@@ -24,8 +22,8 @@ using XYZPoint = ROOT::Math::XYZPoint;
 
 void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t radius, Float_t distance)
 {
-   std::vector<AtHit> hitArray = track.GetHitArrayObject();
-   std::vector<AtHit> hitTBArray;
+   const auto &hitArray = track.GetHitArray();
+   std::vector<std::size_t> hitTBArray; // Indices of the hits in hitArray close to the reference point
    int clusterID = 0;
 
    // std::cout<<" ================================================================= "<<"\n";
@@ -49,12 +47,15 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
 
    if (hitArray.size() > 0) {
 
-      auto refPos = hitArray.at(0).GetPosition(); // First hit
+      // Index of the track hits for the radius queries
+      AtSpatialIndex hitIndex(hitArray);
+
+      auto refPos = hitArray.at(0)->GetPosition(); // First hit
       // TODO: Create a clustered hit from the very first hit (test)
 
       for (auto iHit = 0; iHit < hitArray.size(); ++iHit) {
 
-         auto hit = hitArray.at(iHit);
+         const auto &hit = *hitArray.at(iHit);
 
          // Check distance with respect to reference Hit
          Double_t distRef = TMath::Sqrt((hit.GetPosition() - refPos).Mag2());
@@ -71,10 +72,7 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
             // "<<refPos.Mag()<<"\n";
 
             Double_t clusterQ = 0.0;
-            hitTBArray.clear();
-            std::copy_if(
-               hitArray.begin(), hitArray.end(), std::back_inserter(hitTBArray),
-               [&refPos, radius](AtHit &hitIn) { return TMath::Sqrt((hitIn.GetPosition() - refPos).Mag2()) < radius; });
+            hitIndex.Radius(refPos, radius, hitTBArray);
 
             // std::cout<<" Clustered "<<hitTBArray.size()<<" Hits "<<"\n";
 
@@ -82,13 +80,14 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
                double x = 0, y = 0, z = 0;
                double sigma_x = 0, sigma_y = 0, sigma_z = 0;
 
-               int timeStamp;
-               std::shared_ptr<AtHitCluster> hitCluster = std::make_shared<AtHitCluster>();
-               hitCluster->SetClusterID(clusterID);
+               int timeStamp = 0;
+               AtHitCluster hitCluster;
+               hitCluster.SetClusterID(clusterID);
                Double_t hitQ = 0.0;
                std::for_each(hitTBArray.begin(), hitTBArray.end(),
                              [&x, &y, &z, &hitQ, &timeStamp, &sigma_x, &sigma_y, &sigma_z, &D_T, &D_L, &driftVel,
-                              &samplingRate](AtHit &hitInQ) {
+                              &samplingRate, &hitArray](std::size_t idx) {
+                                const AtHit &hitInQ = *hitArray[idx];
                                 XYZPoint pos = hitInQ.GetPosition();
                                 x += pos.X() * hitInQ.GetCharge();
                                 y += pos.Y() * hitInQ.GetCharge();
@@ -118,7 +117,7 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
                Bool_t checkDistance = kTRUE;
 
                // Check distance with respect to existing clusters
-               for (auto iClusterHit : *track.GetHitClusterArray()) {
+               for (const auto &iClusterHit : *track.GetHitClusterArray()) {
                   if (TMath::Sqrt((iClusterHit.GetPosition() - clustPos).Mag2()) < distance) {
                      // std::cout<<" Cluster with less than  : "<<distance<<" found "<<"\n";
                      checkDistance = kFALSE;
@@ -127,20 +126,17 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
                }
 
                if (checkDistance) {
-                  hitCluster->SetCharge(hitQ);
-                  hitCluster->SetPosition({x, y, z});
-                  hitCluster->SetTimeStamp(timeStamp);
-                  TMatrixDSym cov(3); // TODO: Setting covariant matrix based on pad size and drift time resolution.
-                                      // Using estimations for the moment.
-                  cov(0, 1) = 0;
-                  cov(1, 2) = 0;
-                  cov(2, 0) = 0;
+                  hitCluster.SetCharge(hitQ);
+                  hitCluster.SetPosition({x, y, z});
+                  hitCluster.SetTimeStamp(timeStamp);
+                  AtHitCluster::CovMatrix cov; // TODO: Setting covariant matrix based on pad size and drift time
+                                               // resolution. Using estimations for the moment.
                   cov(0, 0) = TMath::Power(sigma_x, 2); // 0.04;
                   cov(1, 1) = TMath::Power(sigma_y, 2); // 0.04;
                   cov(2, 2) = TMath::Power(sigma_z, 2); // 0.01;
-                  hitCluster->SetCovMatrix(cov);
+                  hitCluster.SetCovMatrix(cov);
                   ++clusterID;
-                  track.AddClusterHit(hitCluster);
+                  track.AddClusterHit(std::move(hitCluster));
                }
             }
          }
@@ -158,7 +154,7 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
     }
          std::cout<<"=================================================="<<"\n";*/
 
-         refPos = hitArray.at(iHit).GetPosition();
+         refPos = hitArray.at(iHit)->GetPosition();
 
          //} // if distance
 
@@ -167,7 +163,7 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
       // Smoothing track
       std::vector<AtHitCluster> *hitClusterArray = track.GetHitClusterArray();
       radius /= 2.0;
-      std::vector<std::shared_ptr<AtHitCluster>> hitClusterBuffer;
+      std::vector<AtHitCluster> hitClusterBuffer;
 
       // std::cout<<" Hit cluster array size "<<hitClusterArray->size()<<"\n";
 
@@ -186,24 +182,21 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
                renormClus.push_back(clusForw);
 
             // Create a new cluster and renormalize the charge of the other with half the radius.
-            for (auto iClus : renormClus) {
-               hitTBArray.clear();
-               std::copy_if(hitArray.begin(), hitArray.end(), std::back_inserter(hitTBArray),
-                            [&iClus, radius](AtHit &hitIn) {
-                               return TMath::Sqrt((hitIn.GetPosition() - iClus).Mag2()) < radius;
-                            });
+            for (const auto &iClus : renormClus) {
+               hitIndex.Radius(iClus, radius, hitTBArray);
 
                if (hitTBArray.size() > 0) {
                   double x = 0, y = 0, z = 0;
                   double sigma_x = 0, sigma_y = 0, sigma_z = 0;
 
                   int timeStamp = 0;
-                  std::shared_ptr<AtHitCluster> hitCluster = std::make_shared<AtHitCluster>();
-                  hitCluster->SetClusterID(clusterID);
+                  AtHitCluster hitCluster;
+                  hitCluster.SetClusterID(clusterID);
                   Double_t hitQ = 0.0;
                   std::for_each(hitTBArray.begin(), hitTBArray.end(),
                                 [&x, &y, &z, &hitQ, &timeStamp, &sigma_x, &sigma_y, &sigma_z, &D_T, &D_L, &driftVel,
-                                 &samplingRate](AtHit &hitInQ) {
+                                 &samplingRate, &hitArray](std::size_t idx) {
+                                   const AtHit &hitInQ = *hitArray[idx];
                                    auto pos = hitInQ.GetPosition();
                                    x += pos.X() * hitInQ.GetCharge();
                                    y += pos.Y() * hitInQ.GetCharge();
@@ -231,20 +224,17 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
                   sigma_z /= hitTBArray.size();
 
                   TVector3 clustPos(x, y, z);
-                  hitCluster->SetCharge(hitQ);
-                  hitCluster->SetPosition({x, y, z});
-                  hitCluster->SetTimeStamp(timeStamp);
-                  TMatrixDSym cov(3); // TODO: Setting covariant matrix based on pad size and drift time resolution.
-                                      // Using estimations for the moment.
-                  cov(0, 1) = 0;
-                  cov(1, 2) = 0;
-                  cov(2, 0) = 0;
+                  hitCluster.SetCharge(hitQ);
+                  hitCluster.SetPosition({x, y, z});
+                  hitCluster.SetTimeStamp(timeStamp);
+                  AtHitCluster::CovMatrix cov; // TODO: Setting covariant matrix based on pad size and drift time
+                                               // resolution. Using estimations for the moment.
                   cov(0, 0) = TMath::Power(sigma_x, 2); // 0.04;
                   cov(1, 1) = TMath::Power(sigma_y, 2); // 0.04;
                   cov(2, 2) = TMath::Power(sigma_z, 2); // 0.01;
-                  hitCluster->SetCovMatrix(cov);
+                  hitCluster.SetCovMatrix(cov);
                   ++clusterID;
-                  hitClusterBuffer.push_back(hitCluster);
+                  hitClusterBuffer.push_back(std::move(hitCluster));
 
                } // hitTBArray size
 
@@ -252,14 +242,8 @@ void AtTools::AtTrackTransformer::ClusterizeSmooth3D(AtTrack &track, Float_t rad
 
          } // for HitArray
 
-         // Remove previous clusters
-         track.ResetHitClusterArray();
-
-         // Adding new clusters
-         for (auto iHitClusterRe : hitClusterBuffer) {
-
-            track.AddClusterHit(iHitClusterRe);
-         }
+         // Replace the previous clusters by the new ones
+         *hitClusterArray = std::move(hitClusterBuffer);
 
       } // Cluster array size
 
@@ -0,0 +1,62 @@
+#include "AtBenchmark.h"
+
+#include <FairLogger.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::size_t> gNumAllocations{0};
+} // namespace
+
+// Replace the global allocation functions to count the allocations (the array and nothrow versions call these)
+void *operator new(std::size_t size)
+{
+   gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+   if (auto ptr = std::malloc(size == 0 ? 1 : size))
+      return ptr;
+   throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+   std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+   std::free(ptr);
+}
+
+std::size_t AtBenchmark::GetNumAllocations()
+{
+   return gNumAllocations.load(std::memory_order_relaxed);
+}
+
+AtBenchmark::EventCounter::EventCounter(benchmark::State &state, int eventsPerIteration)
+   : fState(state), fStartAllocations(GetNumAllocations()), fEventsPerIteration(eventsPerIteration)
+{
+}
+
+void AtBenchmark::EventCounter::SetCounters()
+{
+   auto numEvents = static_cast<double>(fState.iterations()) * fEventsPerIteration;
+   auto numAllocations = static_cast<double>(GetNumAllocations() - fStartAllocations);
+
+   fState.counters["events/s"] = benchmark::Counter(numEvents, benchmark::Counter::kIsRate);
+   fState.counters["allocs/event"] = numEvents > 0 ? numAllocations / numEvents : 0;
+}
+
+int main(int argc, char **argv)
+{
+   // Only report problems, the benchmarks run the reconstruction many times
+   fair::Logger::SetConsoleSeverity("error");
+
+   benchmark::Initialize(&argc, argv);
+   if (benchmark::ReportUnrecognizedArguments(argc, argv))
+      return 1;
+   benchmark::RunSpecifiedBenchmarks();
+   benchmark::Shutdown();
+   return 0;
+}
@@ -0,0 +1,49 @@
+#ifndef ATBENCHMARK_H
+#define ATBENCHMARK_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+/**
+ * @defgroup Benchmarks Benchmarks
+ *
+ * @brief Micro-benchmarks of the reconstruction hot paths, built with -DBUILD_BENCHMARKS=ON.
+ *
+ * Each benchmark runs on the fixtures of AtBenchmarkFixtures.h (no input files or network needed) and reports the
+ * number of events processed per second ("events/s") and the number of heap allocations per event ("allocs/event").
+ * They are registered in the CMakeLists.txt of their module with attpcroot_generate_benchmarks() and built with
+ * the target "benchmarks" in ${CMAKE_BINARY_DIR}/benchmarks.
+ */
+namespace AtBenchmark {
+
+/// Number of calls to operator new since the start of the program
+std::size_t GetNumAllocations();
+
+/**
+ * @brief Counts the events processed and the allocations made in a benchmark loop.
+ * @ingroup Benchmarks
+ *
+ * Create it just before the benchmark loop, and call SetCounters() after it.
+ * @code
+ * AtBenchmark::EventCounter counter(state);
+ * for (auto _ : state)
+ *    psa.Analyze(&rawEvent, &event);
+ * counter.SetCounters();
+ * @endcode
+ */
+class EventCounter {
+private:
+   benchmark::State &fState;
+   std::size_t fStartAllocations;
+   int fEventsPerIteration;
+
+public:
+   EventCounter(benchmark::State &state, int eventsPerIteration = 1);
+   /// Set the events/s and allocs/event counters of the benchmark
+   void SetCounters();
+};
+
+} // namespace AtBenchmark
+
+#endif // ATBENCHMARK_H
@@ -0,0 +1,170 @@
+#include "AtBenchmarkFixtures.h"
+
+#include "AtDigiPar.h"
+#include "AtHit.h"
+#include "AtMCPoint.h"
+#include "AtMap.h"
+#include "AtPad.h"
+#include "AtTpcMap.h"
+
+#include <FairParAsciiFileIo.h>
+#include <FairRunAna.h>
+#include <FairRuntimeDb.h>
+
+#include <Math/Point2D.h>
+#include <Math/Point3D.h>
+#include <Math/Vector3D.h>
+#include <TClonesArray.h>
+#include <TMath.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+using XYZPoint = ROOT::Math::XYZPoint;
+using XYZVector = ROOT::Math::XYZVector;
+
+namespace {
+/// Straight track, with the charge deposited per mm going linearly from chargeStart to chargeEnd
+struct Track {
+   XYZPoint start;
+   XYZVector dir;
+   double length;
+   double chargeStart;
+   double chargeEnd;
+
+   XYZPoint At(double d) const { return start + d * dir.Unit(); }
+   double ChargeAt(double d) const { return chargeStart + (chargeEnd - chargeStart) * d / length; }
+};
+
+/// Beam along the axis fissioning at z = 500 mm in two fragments [mm]
+std::vector<Track> FissionTracks()
+{
+   XYZPoint vertex(2, -1, 500);
+   XYZVector beam = vertex - XYZPoint(0, 0, 0);
+   return {{{0, 0, 0}, beam, std::sqrt(beam.Mag2()), 10, 10},
+           {vertex, {0.61, 0.35, 0.71}, 150, 150, 30},
+           {vertex, {-0.56, -0.32, 0.77}, 160, 150, 30}};
+}
+
+// Drift of ATTPC.e12014.par: the entrance (z = 0) is at TB 457, and the electrons drift 2.608 mm per TB
+constexpr double kEntranceTB = 457;
+constexpr double kMMPerTB = 8.15 * 0.32;
+double ZToTB(double z)
+{
+   return kEntranceTB - z / kMMPerTB;
+}
+} // namespace
+
+std::shared_ptr<AtMap> AtBenchmark::GetMap()
+{
+   static std::shared_ptr<AtMap> map = [] {
+      auto tpcMap = std::make_shared<AtTpcMap>();
+      tpcMap->ParseXMLMap(ATTPCROOT_SOURCE_DIR "/scripts/e12014_pad_mapping.xml");
+      tpcMap->GeneratePadPlane();
+      return tpcMap;
+   }();
+   return map;
+}
+
+const AtDigiPar *AtBenchmark::GetDigiPar()
+{
+   static const AtDigiPar *par = [] {
+      auto run = FairRunAna::Instance() ? FairRunAna::Instance() : new FairRunAna(); // NOLINT
+      auto rtdb = run->GetRuntimeDb();
+      auto parIo = new FairParAsciiFileIo(); // NOLINT
+      parIo->open(ATTPCROOT_SOURCE_DIR "/parameters/ATTPC.e12014.par", "in");
+      rtdb->setFirstInput(parIo);
+      auto digiPar = dynamic_cast<AtDigiPar *>(rtdb->getContainer("AtDigiPar"));
+      rtdb->initContainers(0);
+      return digiPar;
+   }();
+   return par;
+}
+
+AtRawEvent AtBenchmark::MakeFissionRawEvent(unsigned int seed)
+{
+   auto map = GetMap();
+   std::mt19937 gen(seed);
+   std::normal_distribution<double> diffusion(0, 3);
+   std::normal_distribution<double> noise(0, 4);
+
+   // Spread the charge of every mm of the tracks on the pads (with some transverse diffusion) as a gaussian pulse
+   std::map<int, std::array<double, 512>> traces;
+   for (const auto &track : FissionTracks())
+      for (double d = 0; d < track.length; d += 1) {
+         auto pos = track.At(d);
+         auto tb0 = ZToTB(pos.Z());
+         for (int i = 0; i < 4; ++i) {
+            auto x = pos.X() + diffusion(gen);
+            auto y = pos.Y() + diffusion(gen);
+            auto padNum = map->GetPadNum(ROOT::Math::XYPoint(x, y));
+            if (padNum < 0)
+               continue;
+            auto &trace = traces[padNum];
+            for (int tb = std::max(0, int(tb0) - 15); tb < std::min(512, int(tb0) + 15); ++tb)
+               trace[tb] += track.ChargeAt(d) / 4 * std::exp(-0.5 * std::pow((tb - tb0) / 3, 2));
+         }
+      }
+
+   AtRawEvent event;
+   for (auto &[padNum, trace] : traces) {
+      auto pad = event.AddPad(padNum);
+      pad->SetPadCoord(map->CalcPadCenter(padNum));
+      pad->SetSizeID(map->GetPadSize(padNum));
+      for (int tb = 0; tb < 512; ++tb) {
+         auto adc = trace[tb] + noise(gen);
+         pad->SetADC(tb, adc);
+         pad->SetRawADC(tb, static_cast<int>(std::round(adc + 400)));
+      }
+      pad->SetPedestalSubtracted(true);
+   }
+   return event;
+}
+
+AtEvent AtBenchmark::MakeHitCloud(unsigned int seed)
+{
+   auto map = GetMap();
+   std::mt19937 gen(seed);
+   std::normal_distribution<double> resolution(0, 1);
+   std::uniform_real_distribution<double> uniform(0, 1);
+
+   AtEvent event;
+   for (const auto &track : FissionTracks())
+      for (double d = 0; d < track.length; d += 1) {
+         auto dx = resolution(gen);
+         auto dy = resolution(gen);
+         auto dz = resolution(gen);
+         auto pos = track.At(d) + XYZVector(dx, dy, dz);
+         event.AddHit(map->GetPadNum(ROOT::Math::XYPoint(pos.X(), pos.Y())), pos, track.ChargeAt(d));
+      }
+
+   // Noise hits uniformly distributed in the detector
+   for (int i = 0; i < 50; ++i) {
+      auto r = 250 * std::sqrt(uniform(gen));
+      auto phi = TMath::TwoPi() * uniform(gen);
+      auto z = 1000 * uniform(gen);
+      XYZPoint pos(r * std::cos(phi), r * std::sin(phi), z);
+      event.AddHit(map->GetPadNum(ROOT::Math::XYPoint(pos.X(), pos.Y())), pos, 20 * uniform(gen));
+   }
+   return event;
+}
+
+void AtBenchmark::FillMCPoints(TClonesArray &array, unsigned int seed)
+{
+   std::mt19937 gen(seed);
+   std::normal_distribution<double> straggling(1, 0.1);
+
+   array.Delete();
+   const auto track = FissionTracks().at(1);
+   for (int i = 0; i <= track.length; ++i) {
+      auto pos = track.At(i) / 10.;                      // cm
+      auto eLoss = i == 0 ? 0 : 20e-6 * straggling(gen); // GeV, nothing when entering the volume
+      auto point = new (array[i]) AtMCPoint(1, 0, pos, track.dir.Unit(), 0, i / 10., eLoss); // NOLINT
+      point->SetVolName("drift_volume");
+   }
+}
@@ -0,0 +1,47 @@
+#ifndef ATBENCHMARKFIXTURES_H
+#define ATBENCHMARKFIXTURES_H
+
+#include "AtEvent.h"
+#include "AtRawEvent.h"
+
+#include <memory>
+
+class AtDigiPar;
+class AtMap;
+class TClonesArray;
+
+/**
+ * Fixtures used by the benchmarks. Everything is generated from the files of the repository and a fixed seed, so
+ * every run of a benchmark processes exactly the same data. The detector is the AT-TPC as in e12014
+ * (scripts/e12014_pad_mapping.xml and parameters/ATTPC.e12014.par).
+ *
+ * The events are a fission event: a beam track along the axis of the detector that fissions half-way in two
+ * heavy fragments.
+ * @ingroup Benchmarks
+ */
+namespace AtBenchmark {
+
+/// AT-TPC map with its pad plane generated
+std::shared_ptr<AtMap> GetMap();
+
+/**
+ * AtDigiPar of the detector. It is loaded in the runtime database of a FairRunAna (created the first time this is
+ * called), so anything that gets it from FairRun::Instance() in its Init() (AtPSA for example) also works.
+ */
+const AtDigiPar *GetDigiPar();
+
+/// Raw event of the fission event, with pedestal subtracted traces including noise (a few hundred pads)
+AtRawEvent MakeFissionRawEvent(unsigned int seed = 0);
+
+/// Hit cloud of the fission event, with some noise hits (about 900 hits)
+AtEvent MakeHitCloud(unsigned int seed = 0);
+
+/**
+ * Fill array (of AtMCPoint) with the MC points (as produced by the simulation, in cm and GeV) of a track from the
+ * vertex of the fission event, one point every mm depositing about 20 keV each.
+ */
+void FillMCPoints(TClonesArray &array, unsigned int seed = 0);
+
+} // namespace AtBenchmark
+
+#endif // ATBENCHMARKFIXTURES_H
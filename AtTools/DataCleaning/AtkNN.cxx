@@ -1,14 +1,20 @@
 #include "AtkNN.h"
 
 #include "AtHit.h"
+#include "AtSpatialIndex.h"
+
+#include <cmath>
+#include <vector>
+
 namespace AtTools {
 namespace DataCleaning {
 
 HitCloud AtkNN::CleanData(const HitCloud &hits)
 {
    HitCloud ret;
+   AtSpatialIndex index(hits);
    for (const auto &hit : hits) {
-      if (kNN(hits, *hit))
+      if (kNN(index, *hit))
          ret.push_back(std::make_unique<AtHit>(*hit));
    }
    return ret;
@@ -21,45 +27,37 @@ HitCloud AtkNN::CleanData(const HitCloud &hits)
  */
 bool AtkNN::kNN(const std::vector<std::unique_ptr<AtHit>> &hits, AtHit &hitRef)
 {
-   int k = fkNN;
-   std::vector<Double_t> distances;
-   distances.reserve(hits.size());
-
-   std::for_each(hits.begin(), hits.end(), [&distances, &hitRef](const std::unique_ptr<AtHit> &hit) {
-      auto dist = (hitRef.GetPosition() - hit->GetPosition()).Mag2();
-      if (dist > 0.01) // Ignore self
-         distances.push_back(std::sqrt(dist));
-   });
-
-   std::sort(distances.begin(), distances.end(), [](Double_t a, Double_t b) { return a < b; });
-
-   /*
-  for (auto i = 0; i < distances.size(); ++i)
-     std::cout << distances.at(i) << " ";
-  std::cout << "\n";
-  */
+   return kNN(AtSpatialIndex(hits), hitRef);
+}
 
-   Double_t mean = 0.0;
-   Double_t stdDev = 0.0;
+/**
+ * @brief kNN algorithm to clean data.
+ *
+ * Returns true of k-nearest neighbors to hitRef, in the hits indexed by index, are within a threshold distance.
+ */
+bool AtkNN::kNN(const AtSpatialIndex &index, const AtHit &hitRef)
+{
+   std::size_t k = fkNN;
+   if (k > index.Size())
+      k = index.Size();
 
-   if (k > hits.size())
-      k = hits.size();
+   // Ignore self (and any hit closer than 0.1 mm)
+   std::vector<AtSpatialIndex::Neighbor> neighbors;
+   index.KNearest(hitRef.GetPosition(), k, neighbors, 0.01);
+   if (neighbors.empty())
+      return false;
 
    // Compute mean distance of kNN
-   for (auto i = 0; i < k; ++i)
-      mean += distances.at(i);
-
-   mean /= k;
+   Double_t mean = 0.0;
+   for (const auto &neighbor : neighbors)
+      mean += std::sqrt(neighbor.dist2);
+   mean /= neighbors.size();
 
    // Compute threshold
    Double_t T = mean;
-   /*
-   std::cout << "For hit at " << hitRef.GetPosition() << " T: " << T << " fkNNDist: " << fkNNDist << " k: " << k
-             << "\n";
-             */
 
    return T < fkNNDist;
 }
 
 } // namespace DataCleaning
-} // namespace AtTools
\ No newline at end of file
+} // namespace AtTools
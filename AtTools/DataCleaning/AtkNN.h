@@ -5,12 +5,15 @@
 
 namespace AtTools {
 
+class AtSpatialIndex;
+
 namespace DataCleaning {
 
 /**
  * kNN algorithm as implemented in AtPRA class.
  *
  * Will reject any point whose average distance to its k nearest neighbors is greater than a threshold.
+ * The neighbors are found using an AtSpatialIndex built once per hit cloud.
  */
 class AtkNN : public AtDataCleaner {
 protected:
@@ -21,6 +24,7 @@ public:
    HitCloud CleanData(const HitCloud &hits) override;
 
    bool kNN(const HitCloud &hits, AtHit &hitRef);
+   bool kNN(const AtSpatialIndex &index, const AtHit &hitRef);
 };
 
 } // namespace DataCleaning
@@ -6,7 +6,7 @@
 #include <TFile.h>
 #include <TObject.h>
 
-#include <utility> // for move
+#include <memory> // for unique_ptr
 
 using namespace ElectronicResponse;
 
@@ -18,16 +18,26 @@ AtRootResponse::AtRootResponse(double tbTime, std::string filePath, std::string
    auto *event = dynamic_cast<AtRawEvent *>(file.FindObject(objectName.data()));
    if (event == nullptr)
       throw std::invalid_argument("objectName");
-   fResponse = *event;
+   SetResponse(*event);
+}
+AtRootResponse::AtRootResponse(double tbTime, AtRawEvent response) : fTBTime(tbTime)
+{
+   SetResponse(response);
+}
+
+void AtRootResponse::SetResponse(const AtRawEvent &response)
+{
+   fResponse.clear();
+   for (const auto &pad : response.GetPads())
+      fResponse.emplace(pad->GetPadNum(), pad->GetADC());
 }
-AtRootResponse::AtRootResponse(double tbTime, AtRawEvent response) : fTBTime(tbTime), fResponse(std::move(response)) {}
 
 double AtRootResponse::GetResponse(int padNum, double time) const
 {
    int tb = time / fTBTime;
-   auto pad = fResponse.GetPad(padNum);
-   if (pad == nullptr)
+   auto it = fResponse.find(padNum);
+   if (it == fResponse.end())
       throw std::invalid_argument("padNum");
 
-   return pad->GetADC(tb);
+   return it->second[tb];
 }
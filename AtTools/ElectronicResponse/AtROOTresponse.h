@@ -2,19 +2,24 @@
 #define ATROOTRESPONSE_H
 
 #include "AtElectronicResponse.h"
+#include "AtPad.h"
 #include "AtRawEvent.h"
 
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 
 namespace ElectronicResponse {
 /**
  * @brief Response function is represended by an AtEvent in a root file.
+ *
+ * The trace of every pad is copied into a hash map on construction so evaluating the response
+ * does not have to search the event for the pad.
  * @ingroup elecResponse
  */
 class AtRootResponse : public AtElectronicResponse {
 protected:
-   AtRawEvent fResponse;
+   std::unordered_map<int, AtPad::trace> fResponse; //< Response trace of each pad number
    double fTBTime;
 
 public:
@@ -26,6 +31,9 @@ public:
       throw std::invalid_argument("A pad number must be specified to use this response function");
    }
    virtual double GetResponse(int padNum, double time) const override;
+
+protected:
+   void SetResponse(const AtRawEvent &response);
 };
 } // namespace ElectronicResponse
 
@@ -28,7 +28,8 @@
 #include <utility>
 
 AtGRAWUnpacker::AtGRAWUnpacker(mapPtr map, Int_t numGrawFiles)
-   : AtUnpacker(map), fNumFiles(numGrawFiles), fCurrentEventID(fNumFiles, 0), fIsSeparatedData(fNumFiles > 1)
+   : AtUnpacker(map), fNumFiles(numGrawFiles), fConditioner(fNumFiles), fCurrentEventID(fNumFiles, 0),
+     fIsSeparatedData(fNumFiles > 1)
 {
    for (int i = 0; i < fNumFiles; ++i) {
       fDecoder.push_back(std::make_unique<GETDecoder2>());
@@ -124,6 +125,10 @@ void AtGRAWUnpacker::FillRawEvent(AtRawEvent &event)
       for (auto &fileThread : file)
          fileThread.join();
 
+      for (auto &conditioner : fConditioner)
+         if (!conditioner.IsGoodEvent())
+            event.SetIsGood(kFALSE);
+
       // NB: Do not delete. To be refactored using functors
       /* for (Int_t iFile = 0; iFile < fNumFiles; iFile++){
    file[iFile] = std::thread([this](Int_t fileIdx) { this->ProcessFile(fileIdx); }, iFile);
@@ -289,6 +294,10 @@ void AtGRAWUnpacker::ProcessBasicFile(Int_t fileIdx)
    Int_t iCobo = basicFrame->GetCoboID();
    Int_t iAsad = basicFrame->GetAsadID();
 
+   fConditioner[fileIdx].Clear();
+   if (fConditioner[fileIdx].IsEnabled())
+      addReferences(*basicFrame, fileIdx);
+
    for (Int_t iAget = 0; iAget < 4; iAget++) {
       for (Int_t iCh = 0; iCh < 68; iCh++) {
          AtPadReference PadRef = {iCobo, iAsad, iAget, iCh};
@@ -311,27 +320,62 @@ void AtGRAWUnpacker::ProcessBasicFile(Int_t fileIdx)
 void AtGRAWUnpacker::savePad(GETBasicFrame &frame, AtPadReference PadRef, AtRawEvent *event, Int_t fileIdx)
 {
    auto PadRefNum = fMap->GetPadNum(PadRef);
-   auto PadCenterCoord = fMap->CalcPadCenter(PadRefNum);
+   auto pad = std::make_unique<AtPad>(PadRefNum);
+   fillPad(frame, PadRef, *pad, fileIdx);
 
-   AtPad *pad = nullptr;
-   {
-      // Ensure the threads aren't both trying to create pads at the same time
-      std::lock_guard<std::mutex> lk(fRawEventMutex);
-      pad = fRawEvent->AddPad(PadRefNum);
-   }
+   auto &conditioner = fConditioner[fileIdx];
+   if (conditioner.IsEnabled() && !conditioner.Condition(PadRef, pad->fAdc, pad->IsPedestalSubtracted()))
+      return;
 
-   pad->SetPadCoord(PadCenterCoord);
+   pad->SetPadCoord(fMap->CalcPadCenter(PadRefNum));
    pad->SetValidPad(true);
-   fillPadAdc(frame, PadRef, pad);
+   if (fIsSaveLastCell) {
+      saveLastCell(*pad, frame.GetLastCell(PadRef.aget));
+   }
+
+   // Ensure the threads aren't both trying to add pads at the same time
+   std::lock_guard<std::mutex> lk(fRawEventMutex);
+   fRawEvent->AddPad(std::move(pad));
+}
+
+/// Fill the raw and pedestal subtracted traces of the pad
+void AtGRAWUnpacker::fillPad(GETBasicFrame &frame, AtPadReference PadRef, AtPad &pad, Int_t fileIdx)
+{
+   fillPadAdc(frame, PadRef, &pad);
 
    if (fIsSubtractFPN)
-      doFPNSubtraction(frame, *fPedestal[fileIdx], *pad, fMap->GetNearestFPN(PadRef));
+      doFPNSubtraction(frame, *fPedestal[fileIdx], pad, fMap->GetNearestFPN(PadRef));
    else if (fIsBaseLineSubtraction)
-      doBaselineSubtraction(*pad);
+      doBaselineSubtraction(pad);
+}
 
-   if (fIsSaveLastCell) {
-      saveLastCell(*pad, frame.GetLastCell(PadRef.aget));
-   }
+/// Add the FPN channels and ch0 pads of the frame to the references of its conditioner
+void AtGRAWUnpacker::addReferences(GETBasicFrame &frame, Int_t fileIdx)
+{
+   auto &conditioner = fConditioner[fileIdx];
+
+   if (conditioner.IsSubtractFPN())
+      for (Int_t iAget = 0; iAget < 4; iAget++)
+         for (Int_t iCh = 0; iCh < 68; iCh++) {
+            AtPadReference PadRef = {frame.GetCoboID(), frame.GetAsadID(), iAget, iCh};
+            if (!fMap->IsFPNchannel(PadRef))
+               continue;
+            AtPad pad;
+            fillPadAdc(frame, PadRef, &pad);
+            doBaselineSubtraction(pad);
+            conditioner.AddFPN(PadRef, pad.fAdc);
+         }
+
+   if (conditioner.IsSubtractCh0())
+      for (Int_t iAget = 0; iAget < 4; iAget++) {
+         AtPadReference PadRef = {frame.GetCoboID(), frame.GetAsadID(), iAget, 0};
+         auto PadNum = fMap->GetPadNum(PadRef);
+         if (PadNum != -1 && fMap->IsInhibited(PadNum) == AtMap::InhibitType::kNone) {
+            AtPad pad;
+            fillPad(frame, PadRef, pad, fileIdx);
+            conditioner.AddCh0(PadRef, pad.fAdc);
+         }
+      }
 }
 
 void AtGRAWUnpacker::fillPadAdc(GETBasicFrame &frame, AtPadReference PadRef, AtPad *pad)
@@ -379,6 +423,16 @@ void AtGRAWUnpacker::doBaselineSubtraction(AtPad &pad)
    pad.SetPedestalSubtracted(true);
 }
 
+void AtGRAWUnpacker::SetConditioning(const AtTraceConditioner &conditioner)
+{
+   if (!fIsSeparatedData) {
+      LOG(error) << "Conditioning is only supported for separated data (one file per AsAd), ignoring it.";
+      return;
+   }
+   for (auto &fileConditioner : fConditioner)
+      fileConditioner = conditioner;
+}
+
 void AtGRAWUnpacker::SetPseudoTopologyFrame(Int_t asadMask, Bool_t check)
 {
    for (auto &decoder : fDecoder)
@@ -11,6 +11,7 @@
 #ifndef _ATGRAWUNPACKER_H_
 #define _ATGRAWUNPACKER_H_
 
+#include "AtTraceConditioner.h"
 #include "AtUnpacker.h"
 
 #include <Rtypes.h>
@@ -47,6 +48,7 @@ protected:
 
    std::vector<GETDecoder2Ptr> fDecoder;
    std::vector<AtPedestalPtr> fPedestal;
+   std::vector<AtTraceConditioner> fConditioner; //! One per file, conditioning the AsAd frame it unpacks
    std::vector<Int_t> fCurrentEventID;
 
    Double_t fFPNSigmaThreshold = 5;
@@ -86,6 +88,15 @@ public:
    void SetBaseLineSubtraction(Bool_t val) { fIsBaseLineSubtraction = val; }
    void SetMutantOneRun(Bool_t val) { fIsMutantOneRun = val; }
    void SetCheckNumEvents() { fCheckNumEvents = true; }
+   /**
+    * @brief Condition the traces of each AsAd frame while unpacking it.
+    *
+    * The ch0 subtraction and zero suppression of the conditioner are applied to each pad after the FPN or
+    * baseline subtraction of this unpacker, replacing AtFilterSubtraction. The FPN averaging uses the FPN
+    * channels of the frame with their baseline subtracted, and is meant to be used with SetSubtractFPN(false) and
+    * SetBaseLineSubtraction(true). Only for separated data (one file per AsAd), ignored otherwise.
+    */
+   void SetConditioning(const AtTraceConditioner &conditioner);
    // AtUnpacker interface
    virtual void Init() override;
    virtual void FillRawEvent(AtRawEvent &event) override; // Pass by ref to ensure it's a valid object
@@ -111,11 +122,13 @@ private:
    void doBaselineSubtraction(AtPad &pad);
    void saveFPN(GETBasicFrame &frame, AtPadReference PadRef, AtRawEvent *event);
    void savePad(GETBasicFrame &frame, AtPadReference PadRef, AtRawEvent *event, Int_t fileIdx);
+   void fillPad(GETBasicFrame &frame, AtPadReference PadRef, AtPad &pad, Int_t fileIdx);
+   void addReferences(GETBasicFrame &frame, Int_t fileIdx);
    void fillPadAdc(GETBasicFrame &frame, AtPadReference PadRef, AtPad *pad);
    void saveLastCell(AtPad &pad, Double_t lastCell);
    void FindAndSetNumEvents();
 
-   ClassDefOverride(AtGRAWUnpacker, 1)
+   ClassDefOverride(AtGRAWUnpacker, 2)
 };
 
 #endif // #ifndef _ATGRAWUNPACKER_H_
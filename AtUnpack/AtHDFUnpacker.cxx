@@ -53,9 +53,10 @@ void AtHDFUnpacker::FillRawEvent(AtRawEvent &event)
    LOG(debug) << " Unpacking event ID: " << fEventID << " with internal ID " << fDataEventID;
    fRawEvent = &event;
    setEventIDAndTimestamps();
+   fConditioner.Clear();
    processData();
 
-   fRawEvent->SetIsGood(kTRUE);
+   fRawEvent->SetIsGood(fConditioner.IsGoodEvent());
    LOG(debug) << " Unpacked " << fRawEvent->GetNumPads() << " pads";
    fEventID++;
    fDataEventID++;
@@ -95,8 +96,11 @@ void AtHDFUnpacker::processData()
    LOG(debug) << fRawEvent->GetEventName() << "\n";
    std::size_t npads = n_pads(event_name.Data());
 
-   for (auto ipad = 0; ipad < npads; ++ipad)
-      processPad(ipad);
+   if (fConditioner.IsEnabled())
+      processConditionedData(npads);
+   else
+      for (auto ipad = 0; ipad < npads; ++ipad)
+         processPad(ipad);
 
    end_raw_event(); // Close dataset
 }
@@ -110,6 +114,61 @@ void AtHDFUnpacker::processPad(std::size_t ipad)
    setDimensions(pad);
    setAdc(pad, rawadc);
 }
+
+/**
+ * Read every channel of the event at once, and fill the pads with the conditioned traces. The references (FPN
+ * channels and ch0 pads) are added to the conditioner first, so each pad is then filled in a single pass.
+ */
+void AtHDFUnpacker::processConditionedData(std::size_t npads)
+{
+   constexpr std::size_t rowSize = 517; // First 5 words are electronic id
+   fEventData.resize(npads * rowSize);
+   hsize_t counts[2] = {npads, rowSize};
+   hsize_t offsets[2] = {0, 0};
+   hsize_t dims_out[2] = {npads, rowSize};
+   read_slab<int16_t>(_dataset, counts, offsets, dims_out, fEventData.data());
+
+   AtTraceConditioner::trace adc{};
+   auto refOf = [this](std::size_t ipad) {
+      const int16_t *row = &fEventData[ipad * rowSize];
+      return AtPadReference{row[0], row[1], row[2], row[3]};
+   };
+
+   fConditioner.ClearBlock();
+   if (fConditioner.IsSubtractFPN())
+      for (std::size_t ipad = 0; ipad < npads; ++ipad)
+         if (fMap->IsFPNchannel(refOf(ipad))) {
+            fillTrace(&fEventData[ipad * rowSize], adc);
+            fConditioner.AddFPN(refOf(ipad), adc);
+         }
+   if (fConditioner.IsSubtractCh0())
+      for (std::size_t ipad = 0; ipad < npads; ++ipad) {
+         auto ref = refOf(ipad);
+         if (ref.ch == 0 && !fMap->IsFPNchannel(ref) && !fMap->IsAuxPad(ref) && fMap->GetPadNum(ref) != -1) {
+            fillTrace(&fEventData[ipad * rowSize], adc);
+            fConditioner.AddCh0(ref, adc);
+         }
+      }
+
+   for (std::size_t ipad = 0; ipad < npads; ++ipad) {
+      const int16_t *row = &fEventData[ipad * rowSize];
+      auto ref = refOf(ipad);
+      fillTrace(row, adc);
+
+      // Saved FPN channels and aux pads are not conditioned (see createPadAndSetIsAux)
+      bool isPad = !(fSaveFPN && fMap->IsFPNchannel(ref)) && !fMap->IsAuxPad(ref);
+      if (isPad && !fConditioner.Condition(ref, adc, fIsBaseLineSubtraction))
+         continue;
+
+      auto pad = createPadAndSetIsAux(ref);
+      setDimensions(pad);
+      for (Int_t iTb = 0; iTb < 512; iTb++)
+         pad->SetRawADC(iTb, row[iTb + 5]);
+      pad->SetADC(adc);
+      pad->SetPedestalSubtracted(fIsBaseLineSubtraction);
+   }
+}
+
 AtPad *AtHDFUnpacker::createPadAndSetIsAux(const AtPadReference &padRef)
 {
    if (fSaveFPN && fMap->IsFPNchannel(padRef))
@@ -134,6 +193,11 @@ void AtHDFUnpacker::setAdc(AtPad *pad, const std::vector<int16_t> &data)
 }
 
 Float_t AtHDFUnpacker::getBaseline(const std::vector<int16_t> &data)
+{
+   return getBaseline(data.data());
+}
+
+Float_t AtHDFUnpacker::getBaseline(const int16_t *data)
 {
    Float_t baseline = 0;
 
@@ -144,6 +208,14 @@ Float_t AtHDFUnpacker::getBaseline(const std::vector<int16_t> &data)
    }
    return baseline;
 }
+
+/// Fill adc with the trace of the channel, as setAdc does
+void AtHDFUnpacker::fillTrace(const int16_t *data, AtTraceConditioner::trace &adc)
+{
+   auto baseline = getBaseline(data);
+   for (Int_t iTb = 0; iTb < 512; iTb++)
+      adc[iTb] = data[iTb + 5] - baseline;
+}
 void AtHDFUnpacker::setDimensions(AtPad *pad)
 {
    auto PadCenterCoord = fMap->CalcPadCenter(pad->GetPadNum());
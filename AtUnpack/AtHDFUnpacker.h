@@ -5,6 +5,7 @@
 #ifndef _AtHDFUNPACKER_H_
 #define _AtHDFUNPACKER_H_
 
+#include "AtTraceConditioner.h"
 #include "AtUnpacker.h"
 
 #include <Rtypes.h>
@@ -38,12 +39,23 @@ protected:
    std::size_t fFirstEvent{};
    std::size_t fLastEvent{};
 
+   AtTraceConditioner fConditioner; //!
+   std::vector<int16_t> fEventData; //! Every channel of the event, when conditioning
+
 public:
    AtHDFUnpacker(mapPtr map);
    ~AtHDFUnpacker() = default;
 
    void SetBaseLineSubtraction(Bool_t value) { fIsBaseLineSubtraction = value; }
    void SetNumberTimestamps(int numTimestamps) { fNumberTimestamps = numTimestamps; };
+   /**
+    * @brief Condition the traces while unpacking.
+    *
+    * The whole event is read at once, and the FPN/ch0 subtraction and zero suppression of the conditioner are
+    * done in the same pass that fills the pads. Replaces running AtFilterFPN and/or AtFilterSubtraction on the
+    * unpacked event. Requires SetBaseLineSubtraction(true) for the subtractions, as the filters.
+    */
+   void SetConditioning(const AtTraceConditioner &conditioner) { fConditioner = conditioner; }
 
    void Init() override;
    void FillRawEvent(AtRawEvent &event) override;
@@ -57,6 +69,7 @@ protected:
    virtual void setFirstAndLastEventNum();
    virtual void processData();
    virtual void processPad(std::size_t padIndex);
+   void processConditionedData(std::size_t npads);
    virtual std::size_t n_pads(std::string i_raw_event);
    virtual std::vector<int16_t> pad_raw_data(std::size_t i_pad);
    hid_t open_file(char const *file, IO_MODE mode);
@@ -70,6 +83,7 @@ protected:
    void close_dataset(hid_t dataset);
    void end_raw_event();
    Float_t getBaseline(const std::vector<int16_t> &data);
+   Float_t getBaseline(const int16_t *data);
 
    template <typename T>
    void read_slab(hid_t dataset, hsize_t *counts, hsize_t *offsets, hsize_t *dims_out, T *data)
@@ -90,6 +104,7 @@ protected:
    AtPad *createPadAndSetIsAux(const AtPadReference &padRef);
    void setDimensions(AtPad *pad);
    void setAdc(AtPad *pad, const std::vector<int16_t> &data);
+   void fillTrace(const int16_t *data, AtTraceConditioner::trace &adc);
 
    // Following methods satisfy the data_handler interface
    std::vector<uint64_t> get_header(std::string headerName);
@@ -97,7 +112,7 @@ protected:
    static herr_t file_info(hid_t loc_id, const char *name, const H5L_info_t *linfo, void *opdata);
    void close();
    std::string get_event_name(std::size_t idx);
-   ClassDefOverride(AtHDFUnpacker, 1);
+   ClassDefOverride(AtHDFUnpacker, 2);
 };
 
 #endif
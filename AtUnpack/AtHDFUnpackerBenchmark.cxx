@@ -0,0 +1,120 @@
+#include "AtHDFUnpacker.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtMap.h"
+#include "AtPad.h"
+#include "AtPadReference.h"
+#include "AtRawEvent.h"
+#include "AtTraceConditioner.h"
+
+#include <TString.h>
+#include <TSystem.h>
+
+#include <H5Dpublic.h>
+#include <H5Fpublic.h>
+#include <H5Gpublic.h>
+#include <H5Ppublic.h>
+#include <H5Spublic.h>
+#include <H5Tpublic.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+/// Unpacker that can go back to the first event of the file
+class AtHDFUnpackerBenchmark : public AtHDFUnpacker {
+public:
+   using AtHDFUnpacker::AtHDFUnpacker;
+   void Rewind()
+   {
+      fEventID = 0;
+      fDataEventID = fFirstEvent;
+   }
+};
+
+void WriteDataset(hid_t loc, const char *name, hid_t type, const std::vector<hsize_t> &dims, const void *data)
+{
+   auto space = H5Screate_simple(dims.size(), dims.data(), nullptr);
+   auto dataset = H5Dcreate2(loc, name, type, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+   H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+   H5Dclose(dataset);
+   H5Sclose(space);
+}
+
+/**
+ * Write a HDF5 file as produced by the GET DAQ with one event, the fission raw event. Every pad is a row of
+ * cobo, asad, aget, channel, pad and the 512 time buckets of the raw trace. Returns the name of the file.
+ */
+TString WriteHDFEvent()
+{
+   auto map = AtBenchmark::GetMap();
+   auto rawEvent = AtBenchmark::MakeFissionRawEvent();
+
+   std::vector<int16_t> data;
+   for (auto &pad : rawEvent.GetPads()) {
+      auto ref = map->GetPadRef(pad->GetPadNum());
+      for (auto val : {ref.cobo, ref.asad, ref.aget, ref.ch, pad->GetPadNum()})
+         data.push_back(val);
+      for (int tb = 0; tb < 512; ++tb)
+         data.push_back(pad->GetRawADC(tb));
+   }
+   std::vector<uint64_t> header = {0, 123456789};
+   std::vector<uint64_t> meta = {0, 0, 0, 0};
+
+   TString fileName = "AtHDFUnpackerBenchmark";
+   fclose(gSystem->TempFileName(fileName));
+   auto file = H5Fcreate(fileName.Data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+   auto get = H5Gcreate2(file, "get", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+   WriteDataset(get, "evt0_data", H5T_NATIVE_INT16, {static_cast<hsize_t>(rawEvent.GetNumPads()), 517}, data.data());
+   WriteDataset(get, "evt0_header", H5T_NATIVE_UINT64, {header.size()}, header.data());
+   H5Gclose(get);
+   auto metaGroup = H5Gcreate2(file, "meta", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+   WriteDataset(metaGroup, "meta", H5T_NATIVE_UINT64, {meta.size()}, meta.data());
+   H5Gclose(metaGroup);
+   H5Fclose(file);
+   return fileName;
+}
+
+void RunUnpacker(benchmark::State &state, const AtTraceConditioner *conditioner)
+{
+   auto fileName = WriteHDFEvent();
+   AtHDFUnpackerBenchmark unpacker(AtBenchmark::GetMap());
+   unpacker.SetInputFileName(fileName.Data());
+   unpacker.SetBaseLineSubtraction(true);
+   unpacker.SetNumberTimestamps(1);
+   if (conditioner)
+      unpacker.SetConditioning(*conditioner);
+   unpacker.Init();
+
+   AtRawEvent event;
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      event.Clear();
+      unpacker.Rewind();
+      unpacker.FillRawEvent(event);
+   }
+   counter.SetCounters();
+
+   state.counters["pads"] = event.GetNumPads();
+   gSystem->Unlink(fileName);
+}
+
+void BM_HDFUnpack(benchmark::State &state)
+{
+   RunUnpacker(state, nullptr);
+}
+BENCHMARK(BM_HDFUnpack);
+
+void BM_HDFUnpackZeroSuppressed(benchmark::State &state)
+{
+   AtTraceConditioner conditioner;
+   conditioner.SetZeroSuppression(30);
+   RunUnpacker(state, &conditioner);
+}
+BENCHMARK(BM_HDFUnpackZeroSuppressed);
+
+} // namespace
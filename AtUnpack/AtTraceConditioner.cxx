@@ -0,0 +1,137 @@
+#include "AtTraceConditioner.h"
+
+#include "AtPadReference.h"
+
+#include <FairLogger.h>
+
+#include <algorithm>
+#include <cmath>
+
+AtTraceConditioner::AtTraceConditioner(Int_t numCoBos) : fFPN(numCoBos, std::vector<Reference>(16)), fCh0(numCoBos)
+{
+   for (auto &cobo : fCh0)
+      cobo.resize(4);
+}
+
+void AtTraceConditioner::SetFPNSubtraction(Bool_t averageAgets, Double_t threshold)
+{
+   fSubtractFPN = true;
+   fAverageAgets = averageAgets;
+   fFPNThreshold = threshold;
+}
+
+void AtTraceConditioner::SetCh0Subtraction(Double_t threshold)
+{
+   fSubtractCh0 = true;
+   fCh0Threshold = threshold;
+}
+
+void AtTraceConditioner::SetZeroSuppression(Double_t threshold)
+{
+   fZeroSuppression = true;
+   fZeroThreshold = threshold;
+}
+
+void AtTraceConditioner::Clear()
+{
+   ClearBlock();
+   fNumberMissed = 0;
+}
+
+void AtTraceConditioner::ClearBlock()
+{
+   // Only the references used by the last block are reset, the grid covers every CoBo of the detector
+   for (auto ref : fUsed)
+      *ref = Reference();
+   fUsed.clear();
+}
+
+AtTraceConditioner::Reference *AtTraceConditioner::getFPN(const AtPadReference &ref)
+{
+   auto group = fAverageAgets ? ref.asad : 4 * ref.asad + ref.aget;
+   if (ref.cobo < 0 || ref.cobo >= fFPN.size() || group < 0 || group >= fFPN[ref.cobo].size())
+      return nullptr;
+   return &fFPN[ref.cobo][group];
+}
+
+AtTraceConditioner::Reference *AtTraceConditioner::getCh0(const AtPadReference &ref)
+{
+   if (ref.cobo < 0 || ref.cobo >= fCh0.size() || ref.asad < 0 || ref.asad >= fCh0[ref.cobo].size())
+      return nullptr;
+   return &fCh0[ref.cobo][ref.asad];
+}
+
+void AtTraceConditioner::AddFPN(const AtPadReference &ref, const trace &adc)
+{
+   auto fpn = getFPN(ref);
+   if (!fSubtractFPN || fpn == nullptr)
+      return;
+
+   for (int i = 2; i < 510; ++i)
+      if (std::abs(adc[i] - adc[i - 1]) > fFPNThreshold)
+         return;
+
+   if (fpn->fCount == 0)
+      fUsed.push_back(fpn);
+   fpn->fCount++;
+   for (int tb = 0; tb < 512; ++tb)
+      fpn->fSum[tb] += adc[tb];
+}
+
+void AtTraceConditioner::AddCh0(const AtPadReference &ref, trace adc)
+{
+   auto ch0 = getCh0(ref);
+   if (!fSubtractCh0 || ch0 == nullptr || ref.ch != 0)
+      return;
+
+   if (fSubtractFPN)
+      subtract(getFPN(ref), ref, adc);
+   if (std::any_of(adc.begin(), adc.end(), [this](Double_t val) { return val > fCh0Threshold; }))
+      return;
+
+   if (ch0->fCount == 0)
+      fUsed.push_back(ch0);
+   ch0->fCount++;
+   for (int tb = 0; tb < 512; ++tb)
+      ch0->fSum[tb] += adc[tb];
+}
+
+/// Average the reference the first time it is used, returns nullptr if there was nothing to average.
+const AtTraceConditioner::trace *AtTraceConditioner::getAverage(Reference *ref, const AtPadReference &padRef)
+{
+   if (!ref->fAveraged) {
+      ref->fAveraged = true;
+      if (ref->fCount == 0) {
+         fUsed.push_back(ref);
+         fNumberMissed++;
+         LOG(error) << "No reference to subtract from " << padRef;
+      } else
+         for (auto &val : ref->fSum)
+            val /= ref->fCount;
+   }
+   return ref->fCount == 0 ? nullptr : &ref->fSum;
+}
+
+void AtTraceConditioner::subtract(Reference *ref, const AtPadReference &padRef, trace &adc)
+{
+   if (ref == nullptr)
+      return;
+
+   auto avg = getAverage(ref, padRef);
+   if (avg == nullptr)
+      return;
+   for (int tb = 0; tb < 512; ++tb)
+      adc[tb] -= (*avg)[tb];
+}
+
+Bool_t AtTraceConditioner::Condition(const AtPadReference &ref, trace &adc, Bool_t subtract)
+{
+   if (subtract && fSubtractFPN)
+      this->subtract(getFPN(ref), ref, adc);
+   if (subtract && fSubtractCh0)
+      this->subtract(getCh0(ref), ref, adc);
+
+   if (fZeroSuppression)
+      return std::any_of(adc.begin(), adc.end(), [this](Double_t val) { return val > fZeroThreshold; });
+   return true;
+}
@@ -0,0 +1,101 @@
+#ifndef ATTRACECONDITIONER_H
+#define ATTRACECONDITIONER_H
+
+#include <Rtypes.h>
+
+#include <array>
+#include <vector>
+
+struct AtPadReference;
+
+/**
+ * @brief Signal conditioning of the traces of a block of GET channels, done by the unpackers while decoding.
+ *
+ * Does in a single pass over the decoded channels what the raw event filters do in separate passes over the
+ * whole event:
+ * - FPN subtraction: the average of the FPN channels of each AGET (or AsAd) is subtracted from every pad of that
+ *   AGET (or AsAd). The same as AtFilterFPN, FPN channels with a jump larger than the threshold between two time
+ *   buckets are not used.
+ * - Ch0 subtraction: the average of the channel 0 pads of each AsAd with no time bucket above the threshold is
+ *   subtracted from every pad of that AsAd. The same as AtFilterSubtraction (after the FPN subtraction if both
+ *   are enabled, as when running AtFilterFPN then AtFilterSubtraction).
+ * - Zero suppression: pads with no time bucket above the threshold (after the subtractions) are not added to the
+ *   event at all.
+ *
+ * The unpacker first passes the reference channels of the block (AddFPN then AddCh0), then conditions each pad
+ * with Condition() before adding it to the event. A block is whatever the unpacker decodes at once (the whole
+ * event, or the frame of one AsAd), every reference of a pad must be in the same block. Aux pads are not
+ * conditioned.
+ */
+class AtTraceConditioner {
+public:
+   using trace = std::array<Double_t, 512>;
+
+private:
+   struct Reference {
+      trace fSum{};
+      Int_t fCount{0};
+      Bool_t fAveraged{false};
+   };
+   using ReferenceGrid = std::vector<std::vector<Reference>>;
+
+   Bool_t fSubtractFPN{false};
+   Bool_t fAverageAgets{false};
+   Double_t fFPNThreshold{0};
+   Bool_t fSubtractCh0{false};
+   Double_t fCh0Threshold{0};
+   Bool_t fZeroSuppression{false};
+   Double_t fZeroThreshold{0};
+   Bool_t fSetIsGood{false};
+
+   ReferenceGrid fFPN; //< [cobo][aget or asad]
+   ReferenceGrid fCh0; //< [cobo][asad]
+   std::vector<Reference *> fUsed;
+   Int_t fNumberMissed{0};
+
+public:
+   AtTraceConditioner(Int_t numCoBos = 10);
+
+   /// Subtract the FPN channels, averaged per AsAd if averageAgets is true and per AGET otherwise.
+   void SetFPNSubtraction(Bool_t averageAgets, Double_t threshold);
+   /// Subtract the channel 0 pads with every time bucket below threshold, averaged per AsAd.
+   void SetCh0Subtraction(Double_t threshold);
+   /// Drop the pads with every time bucket below threshold.
+   void SetZeroSuppression(Double_t threshold);
+   /// Set if the unpacker should mark the event bad if a pad has no reference to subtract.
+   void SetIsGood(Bool_t val) { fSetIsGood = val; }
+
+   Bool_t IsEnabled() const { return fSubtractFPN || fSubtractCh0 || fZeroSuppression; }
+   Bool_t IsSubtractFPN() const { return fSubtractFPN; }
+   Bool_t IsSubtractCh0() const { return fSubtractCh0; }
+   /// Is the event good, given the pads conditioned since the last Clear()
+   Bool_t IsGoodEvent() const { return !fSetIsGood || fNumberMissed == 0; }
+
+   /// Reset the references, called at the start of each event.
+   void Clear();
+   /// Reset the references (but not the event status), called at the start of each block.
+   void ClearBlock();
+
+   /// Add a FPN channel of the block (with its baseline subtracted ADC).
+   void AddFPN(const AtPadReference &ref, const trace &adc);
+   /// Add a channel 0 pad of the block (after its pedestal subtraction). Must be called after every AddFPN.
+   void AddCh0(const AtPadReference &ref, trace adc);
+
+   /**
+    * @brief Condition the trace of a pad.
+    *
+    * @param[in] ref Electronic reference of the pad.
+    * @param[in,out] adc Trace of the pad. The references are only subtracted if subtract is true (the pad is
+    * pedestal subtracted), as the raw event filters do.
+    * @return If the pad should be kept.
+    */
+   Bool_t Condition(const AtPadReference &ref, trace &adc, Bool_t subtract = true);
+
+private:
+   Reference *getFPN(const AtPadReference &ref);
+   Reference *getCh0(const AtPadReference &ref);
+   const trace *getAverage(Reference *ref, const AtPadReference &padRef);
+   void subtract(Reference *ref, const AtPadReference &padRef, trace &adc);
+};
+
+#endif // ATTRACECONDITIONER_H
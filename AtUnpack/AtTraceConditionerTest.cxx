@@ -0,0 +1,257 @@
+#include "AtTraceConditioner.h"
+
+#include "AtFilterFPN.h"
+#include "AtFilterSubtraction.h"
+#include "AtMap.h"
+#include "AtPad.h"
+#include "AtPadReference.h"
+#include "AtRawEvent.h"
+
+#include <Math/Point2D.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+
+namespace {
+/// Map of a single CoBo, every channel of it but the FPN channels is a pad
+class AtConditionerTestMap : public AtMap {
+public:
+   AtConditionerTestMap()
+   {
+      int padNum = 0;
+      for (int asad = 0; asad < 4; ++asad)
+         for (int aget = 0; aget < 4; ++aget)
+            for (int ch = 0; ch < 68; ++ch) {
+               AtPadReference ref{0, asad, aget, ch};
+               if (IsFPNchannel(ref))
+                  continue;
+               fPadMap[ref] = padNum;
+               fPadMapInverse[padNum] = ref;
+               padNum++;
+            }
+      fNumberPads = padNum;
+   }
+
+   void Dump() override {}
+   void GeneratePadPlane() override {}
+   ROOT::Math::XYPoint CalcPadCenter(Int_t) override { return {}; }
+   Int_t BinToPad(Int_t binval) override { return binval; }
+};
+
+using Traces = std::map<int, AtPad::trace>;
+
+class AtTraceConditionerTest : public ::testing::Test {
+protected:
+   static constexpr double kFPNThreshold = 10;
+   static constexpr double kCh0Threshold = 50;
+
+   std::shared_ptr<AtMap> fMap{std::make_shared<AtConditionerTestMap>()};
+
+   /**
+    * Pedestal subtracted event with a FPN pattern per AGET and a ch0 pattern per AsAd on top of the noise of each
+    * channel, and a pulse on two channels of every AGET. One FPN channel has a jump and one ch0 pad has a pulse, so
+    * neither is used as a reference.
+    */
+   AtRawEvent MakeEvent()
+   {
+      std::mt19937 rng(7);
+      std::normal_distribution<double> noise(0, 1);
+      AtRawEvent event;
+
+      for (int asad = 0; asad < 4; ++asad)
+         for (int aget = 0; aget < 4; ++aget) {
+            AtPad::trace fpn, ch0;
+            for (int tb = 0; tb < 512; ++tb) {
+               fpn[tb] = 20 * std::sin(tb / 30. + asad) + 2 * aget;
+               ch0[tb] = 10 * std::cos(tb / 50. + asad);
+            }
+
+            for (int ch = 0; ch < 68; ++ch) {
+               AtPadReference ref{0, asad, aget, ch};
+               AtPad::trace adc;
+               for (int tb = 0; tb < 512; ++tb)
+                  adc[tb] = fpn[tb] + noise(rng);
+
+               if (fMap->IsFPNchannel(ref)) {
+                  if (asad == 1 && aget == 2 && ch == 56)
+                     AddPulse(adc, 200, 100);
+                  auto pad = event.AddFPN(ref);
+                  pad->SetADC(adc);
+                  pad->SetPedestalSubtracted(true);
+                  continue;
+               }
+
+               for (int tb = 0; tb < 512; ++tb)
+                  adc[tb] += ch0[tb];
+               if (ch == 5 || ch == 30 || (asad == 2 && aget == 1 && ch == 0))
+                  AddPulse(adc, 100 + 50 * aget, 500);
+               auto pad = event.AddPad(fMap->GetPadNum(ref));
+               pad->SetADC(adc);
+               pad->SetPedestalSubtracted(true);
+            }
+         }
+      return event;
+   }
+
+   static void AddPulse(AtPad::trace &adc, int start, double amp)
+   {
+      for (int tb = start; tb < 512; ++tb)
+         adc[tb] += amp * std::exp(-(tb - start) / 20.);
+   }
+
+   /// Add a pulse to every FPN channel of the AGET, so none of them is used
+   void SpoilFPN(AtRawEvent &event, int asad, int aget)
+   {
+      for (auto &[ref, pad] : event.GetFpnPads())
+         if (ref.asad == asad && ref.aget == aget) {
+            auto adc = pad.GetADC();
+            AddPulse(adc, 300, 100);
+            event.GetFpn(ref)->SetADC(adc);
+         }
+   }
+   /// Add a pulse to every ch0 pad of the AsAd, so none of them is used
+   void SpoilCh0(AtRawEvent &event, int asad)
+   {
+      for (int aget = 0; aget < 4; ++aget) {
+         auto pad = event.GetPad(fMap->GetPadNum({0, asad, aget, 0}));
+         auto adc = pad->GetADC();
+         AddPulse(adc, 300, 500);
+         pad->SetADC(adc);
+      }
+   }
+
+   /// Traces after AtFilterFPN followed by AtFilterSubtraction
+   Traces RunFilters(AtRawEvent &event, bool averageAgets, bool &isGood)
+   {
+      AtFilterFPN fpn(fMap, averageAgets, 1);
+      fpn.SetThreshold(kFPNThreshold);
+      fpn.SetIsGood(true);
+      fpn.Init();
+      fpn.InitEvent(&event);
+      for (auto &pad : event.GetPads())
+         fpn.Filter(pad.get(), nullptr);
+
+      AtFilterSubtraction sub(fMap, 1);
+      sub.SetThreshold(kCh0Threshold);
+      sub.SetIsGood(true);
+      sub.Init();
+      sub.InitEvent(&event);
+      for (auto &pad : event.GetPads())
+         sub.Filter(pad.get(), nullptr);
+
+      isGood = fpn.IsGoodEvent() && sub.IsGoodEvent();
+      Traces traces;
+      for (auto &pad : event.GetPads())
+         traces[pad->GetPadNum()] = pad->GetADC();
+      return traces;
+   }
+
+   /// Traces after the conditioner, with the whole event as a single block
+   Traces RunConditioner(const AtRawEvent &event, AtTraceConditioner &conditioner)
+   {
+      conditioner.Clear();
+      for (auto &[ref, pad] : event.GetFpnPads())
+         conditioner.AddFPN(ref, pad.GetADC());
+      for (auto &pad : event.GetPads())
+         conditioner.AddCh0(fMap->GetPadRef(pad->GetPadNum()), pad->GetADC());
+
+      Traces traces;
+      for (auto &pad : event.GetPads()) {
+         auto adc = pad->GetADC();
+         EXPECT_TRUE(conditioner.Condition(fMap->GetPadRef(pad->GetPadNum()), adc));
+         traces[pad->GetPadNum()] = adc;
+      }
+      return traces;
+   }
+
+   void ExpectSameTraces(const Traces &filtered, const Traces &conditioned)
+   {
+      ASSERT_EQ(filtered.size(), conditioned.size());
+      for (auto &[padNum, adc] : filtered)
+         for (int tb = 0; tb < 512; ++tb)
+            ASSERT_NEAR(conditioned.at(padNum)[tb], adc[tb], 1e-9) << fMap->GetPadRef(padNum) << " tb " << tb;
+   }
+
+   void ExpectMatchesFilters(bool averageAgets)
+   {
+      auto filterEvent = MakeEvent();
+      bool filterGood = false;
+      auto filtered = RunFilters(filterEvent, averageAgets, filterGood);
+
+      AtTraceConditioner conditioner(1);
+      conditioner.SetFPNSubtraction(averageAgets, kFPNThreshold);
+      conditioner.SetCh0Subtraction(kCh0Threshold);
+      conditioner.SetIsGood(true);
+      auto conditioned = RunConditioner(MakeEvent(), conditioner);
+
+      EXPECT_TRUE(filterGood);
+      EXPECT_TRUE(conditioner.IsGoodEvent());
+      ExpectSameTraces(filtered, conditioned);
+   }
+};
+} // namespace
+
+TEST_F(AtTraceConditionerTest, MatchesFiltersPerAget)
+{
+   ExpectMatchesFilters(false);
+}
+
+TEST_F(AtTraceConditionerTest, MatchesFiltersPerAsad)
+{
+   ExpectMatchesFilters(true);
+}
+
+TEST_F(AtTraceConditionerTest, MissedReference)
+{
+   AtTraceConditioner conditioner(1);
+   conditioner.SetFPNSubtraction(false, kFPNThreshold);
+   conditioner.SetCh0Subtraction(kCh0Threshold);
+
+   // No FPN channel of an AGET
+   auto filterEvent = MakeEvent();
+   SpoilFPN(filterEvent, 3, 0);
+   bool filterGood = true;
+   auto filtered = RunFilters(filterEvent, false, filterGood);
+
+   auto event = MakeEvent();
+   SpoilFPN(event, 3, 0);
+   auto conditioned = RunConditioner(event, conditioner);
+   EXPECT_FALSE(filterGood);
+   EXPECT_TRUE(conditioner.IsGoodEvent()) << "Should only be bad if SetIsGood is set";
+   conditioner.SetIsGood(true);
+   EXPECT_FALSE(conditioner.IsGoodEvent());
+   ExpectSameTraces(filtered, conditioned);
+
+   // The next event has every reference
+   RunConditioner(MakeEvent(), conditioner);
+   EXPECT_TRUE(conditioner.IsGoodEvent());
+
+   // No ch0 pad of an AsAd
+   filterEvent = MakeEvent();
+   SpoilCh0(filterEvent, 1);
+   filtered = RunFilters(filterEvent, false, filterGood);
+
+   event = MakeEvent();
+   SpoilCh0(event, 1);
+   conditioned = RunConditioner(event, conditioner);
+   EXPECT_FALSE(filterGood);
+   EXPECT_FALSE(conditioner.IsGoodEvent());
+   ExpectSameTraces(filtered, conditioned);
+}
+
+TEST_F(AtTraceConditionerTest, ZeroSuppression)
+{
+   AtTraceConditioner conditioner(1);
+   conditioner.SetZeroSuppression(100);
+
+   AtPadReference ref{0, 0, 0, 1};
+   AtPad::trace adc{};
+   adc[10] = 99;
+   EXPECT_FALSE(conditioner.Condition(ref, adc));
+   adc[20] = 101;
+   EXPECT_TRUE(conditioner.Condition(ref, adc));
+}
@@ -24,5 +24,6 @@
 #pragma link C++ class AtROOTUnpacker + ;
 #pragma link C++ class AtGRAWUnpacker + ;
 #pragma link C++ class AtUnpackTask + ;
+#pragma link C++ class AtTraceConditioner - !;
 
 #endif
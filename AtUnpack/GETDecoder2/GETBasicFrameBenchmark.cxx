@@ -0,0 +1,108 @@
+#include "GETBasicFrame.h"
+
+#include "AtBenchmark.h"
+#include "AtBenchmarkFixtures.h"
+#include "AtMap.h"
+#include "AtPad.h"
+#include "AtPadReference.h"
+
+#include <TString.h>
+#include <TSystem.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <vector>
+
+namespace {
+
+/// Append val to the frame as a big endian number of numBytes bytes
+void PutBytes(std::vector<uint8_t> &frame, uint64_t val, int numBytes)
+{
+   for (int i = numBytes - 1; i >= 0; --i)
+      frame.push_back((val >> (8 * i)) & 0xff);
+}
+
+/**
+ * Write a GRAW file with one partial readout frame (GETFRAMEBASICTYPE1) of the AsAd with the most pads in the
+ * fission raw event, with every time bucket of these pads. Returns the name of the file.
+ */
+TString WriteGRAWFrame()
+{
+   auto map = AtBenchmark::GetMap();
+   auto rawEvent = AtBenchmark::MakeFissionRawEvent();
+
+   std::map<std::pair<int, int>, std::vector<const AtPad *>> padsOfAsad;
+   for (auto &pad : rawEvent.GetPads()) {
+      auto ref = map->GetPadRef(pad->GetPadNum());
+      padsOfAsad[{ref.cobo, ref.asad}].push_back(pad.get());
+   }
+   auto asad = padsOfAsad.begin();
+   for (auto it = padsOfAsad.begin(); it != padsOfAsad.end(); ++it)
+      if (it->second.size() > asad->second.size())
+         asad = it;
+
+   std::vector<uint32_t> items;
+   for (auto pad : asad->second) {
+      auto ref = map->GetPadRef(pad->GetPadNum());
+      for (uint32_t tb = 0; tb < 512; ++tb) {
+         uint32_t sample = std::max(0, std::min(4095, pad->GetRawADC(tb)));
+         items.push_back((uint32_t(ref.aget) << 30) | (uint32_t(ref.ch) << 23) | (tb << 14) | sample);
+      }
+   }
+
+   // Big endian, with blocks of 256 bytes. The header fills one block.
+   constexpr int blockSize = 256;
+   uint64_t numBlocks = 1 + (items.size() * 4 + blockSize - 1) / blockSize;
+   std::vector<uint8_t> frame;
+   PutBytes(frame, 0x08, 1);               // metaType
+   PutBytes(frame, numBlocks, 3);          // frameSize
+   PutBytes(frame, 0, 1);                  // dataSource
+   PutBytes(frame, GETFRAMEBASICTYPE1, 2); // frameType
+   PutBytes(frame, 5, 1);                  // revision
+   PutBytes(frame, 1, 2);                  // headerSize
+   PutBytes(frame, 4, 2);                  // itemSize
+   PutBytes(frame, items.size(), 4);       // nItems
+   PutBytes(frame, 123456789, 6);          // eventTime
+   PutBytes(frame, 1, 4);                  // eventID
+   PutBytes(frame, asad->first.first, 1);  // coboID
+   PutBytes(frame, asad->first.second, 1); // asadID
+   PutBytes(frame, 0, 2);                  // readOffset
+   PutBytes(frame, 0, 1);                  // status
+   frame.resize(blockSize, 0);             // hitPat, multip, windowOut, lastCell
+   for (auto item : items)
+      PutBytes(frame, item, 4);
+   frame.resize(numBlocks * blockSize, 0);
+
+   TString fileName = "GETBasicFrameBenchmark";
+   auto file = gSystem->TempFileName(fileName);
+   fwrite(frame.data(), 1, frame.size(), file);
+   fclose(file);
+   return fileName;
+}
+
+void BM_GETBasicFrameRead(benchmark::State &state)
+{
+   auto fileName = WriteGRAWFrame();
+   std::ifstream stream(fileName.Data(), std::ios::binary);
+   GETBasicFrame frame;
+
+   AtBenchmark::EventCounter counter(state);
+   for (auto _ : state) {
+      stream.clear();
+      stream.seekg(0);
+      frame.Read(stream);
+      benchmark::DoNotOptimize(frame.GetSample(0, 0));
+   }
+   counter.SetCounters();
+
+   state.counters["items"] = frame.GetNItems();
+   gSystem->Unlink(fileName);
+}
+BENCHMARK(BM_GETBasicFrameRead);
+
+} // namespace
@@ -0,0 +1,60 @@
+# This file is meant to be included once in the main CMakelists.txt file
+# It will use (or download if needed) Google Benchmark and add all registered benchmarks
+if(NOT BUILD_BENCHMARKS)
+  message(STATUS "Benchmarks are disabled ${BUILD_BENCHMARKS}")
+  function(attpcroot_generate_benchmarks BENCHMARK_NAME)
+    cmake_parse_arguments(ARG "" "" "SRCS;DEPS" ${ARGN})
+  endfunction()
+
+  return()
+endif()
+
+include(FetchContent)
+find_package(benchmark QUIET)
+if(NOT TARGET benchmark::benchmark)
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+  FetchContent_Declare(
+    googlebenchmark
+    DOWNLOAD_EXTRACT_TIMESTAMP TRUE
+    URL https://github.com/google/benchmark/archive/refs/tags/v1.8.3.zip
+    )
+  FetchContent_MakeAvailable(googlebenchmark)
+endif()
+
+# Benchmarks are not part of the default build, build them all with the target "benchmarks"
+add_custom_target(benchmarks)
+
+set(ATTPCROOT_BENCHMARK_DIR ${CMAKE_SOURCE_DIR}/AtTools/Benchmark)
+
+function(attpcroot_generate_benchmarks BENCHMARK_NAME)
+  cmake_parse_arguments(ARG "" "" "SRCS;DEPS" ${ARGN})
+
+  # We will save benchmarks to a different location than the main build
+  set(ORIG_CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_RUNTIME_OUTPUT_DIRECTORY})
+  set(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/benchmarks)
+
+  message(STATUS "Generating benchmark ${BENCHMARK_NAME} with sources ${ARG_SRCS} and dependencies ${ARG_DEPS}")
+
+  # Every benchmark gets the main (which counts allocations) and the shared fixtures
+  add_executable(${BENCHMARK_NAME} EXCLUDE_FROM_ALL ${ARG_SRCS}
+    ${ATTPCROOT_BENCHMARK_DIR}/AtBenchmark.cxx
+    ${ATTPCROOT_BENCHMARK_DIR}/AtBenchmarkFixtures.cxx
+    )
+  target_include_directories(${BENCHMARK_NAME} PRIVATE ${ATTPCROOT_BENCHMARK_DIR})
+  target_compile_definitions(${BENCHMARK_NAME} PRIVATE ATTPCROOT_SOURCE_DIR="${CMAKE_SOURCE_DIR}")
+  target_link_libraries(${BENCHMARK_NAME} PRIVATE ${ARG_DEPS}
+    FairRoot::Base
+    FairRoot::ParBase
+    FairRoot::FairTools
+    ATTPCROOT::AtMap
+    ATTPCROOT::AtParameter
+    ATTPCROOT::AtData
+    ATTPCROOT::AtSimulationData
+    benchmark::benchmark
+    )
+  add_dependencies(benchmarks ${BENCHMARK_NAME})
+
+  set(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${ORIG_CMAKE_RUNTIME_OUTPUT_DIRECTORY})
+endfunction()
@@ -130,6 +130,10 @@ macro(set_attpcroot_defaults)
     set(BUILD_TESTS ON)
 endif()
 
+  if(NOT DEFINED BUILD_BENCHMARKS)
+    set(BUILD_BENCHMARKS OFF)
+  endif()
+
 endmacro(set_attpcroot_defaults)
 
 function(join VALUES GLUE OUTPUT)
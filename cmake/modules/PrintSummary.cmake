@@ -265,12 +265,28 @@ function(PrintTests)
   endif()
 endfunction()
 
+function(PrintBenchmarks)
+  message(STATUS "  ")
+
+  if(BUILD_BENCHMARKS)
+    message(STATUS "  ${Cyan}BUILD_BENCHMARKS ON ${ColourReset}")
+    message(STATUS "  (Disable with ${BMagenta}-DBUILD_BENCHMARKS=OFF${ColourReset})")
+    message(STATUS "  Build with the target benchmarks, binary output directory: ${CMAKE_BINARY_DIR}/benchmarks")
+    message(STATUS "  ")
+
+  else(BUILD_BENCHMARKS)
+    message(STATUS "  ${Cyan}BUILD_BENCHMARKS OFF ${ColourReset}")
+    message(STATUS "  (Enable with ${BMagenta}-DBUILD_BENCHMARKS=ON${ColourReset})")
+  endif()
+endfunction()
+
 function(PrintSummary)
   PrintProjectAndStandard()
   PrintConfiguration()
   PrintDependencies()
   PrintStaticAnalyzers()
   PrintTests()
+  PrintBenchmarks()
   
   message(STATUS "")
   message(STATUS "Searched for cmake config files in : ${CMAKE_PREFIX_PATH}")
@@ -569,10 +569,6 @@ Bool_t FitManager::FitTracks(std::vector<AtTrack> &tracks)
 
       std::cout << KRED << "       Merged track - Distance to Z (Candidate Track Pool) " << dist << cNORMAL << "\n";
 
-      // Fitters
-      for (auto fitter : fFitters)
-         fitter->Init();
-
       // Kinematic filters and fit selection
 
       std::vector<Int_t> pdgCandFit;
@@ -608,24 +604,27 @@ Bool_t FitManager::FitTracks(std::vector<AtTrack> &tracks)
           }
       }
 
-      try {
+      auto *genfitter = dynamic_cast<AtFITTER::AtGenfit *>(fFitter);
+      const auto &hypotheses = genfitter->GetHypotheses();
+      for (auto pdg : pdgCandFit) {
+         if (std::none_of(hypotheses.begin(), hypotheses.end(),
+                          [&pdg](const AtFITTER::AtGenfit::Hypothesis &hyp) { return hyp.pdg == pdg; })) {
+            std::cout << cRED << " Error! Fitter not found for : " << pdg << "\n";
+            std::exit(EXIT_FAILURE);
+         }
+      }
 
-         for (auto pdg : pdgCandFit) {
+      try {
 
-            genfit::Track *fitTrack;
+         // Every candidate is fitted with the same measurements and seed
+         auto fits = genfitter->FitHypotheses(track, pdgCandFit);
 
-            auto fIt = std::find_if(std::begin(fFitters), std::end(fFitters), [&pdg](AtFITTER::AtFitter *fitter) {
-               return dynamic_cast<AtFITTER::AtGenfit *>(fitter)->GetPDGCode() == pdg;
-            });
-            if (fIt != fFitters.end()) {
-               int index = std::distance(fFitters.begin(), fIt);
-               std::cout << cBLUE << "  -  Fitter for : " << pdg << " found in " << index << cNORMAL << "\n";
-               fitTrack = fFitters[index]->FitTracks(&track);
-            } else {
+         for (auto &fit : fits) {
 
-               std::cout << cRED << " Error! Fitter not found for : " << pdg << "\n";
-               std::exit(EXIT_FAILURE);
-            }
+            Int_t pdg = fit.pdg;
+            genfit::Track *fitTrack = fit.track;
+            std::cout << cBLUE << "  -  Fit for : " << pdg << (fit.skipped ? " skipped by the prefit" : "")
+                      << cNORMAL << "\n";
 
             Int_t atomicNumber = 0;
             Double_t mass = 0;
@@ -743,15 +742,15 @@ Bool_t FitManager::FitTracks(std::vector<AtTrack> &tracks)
 
             try {
 
-               if (fitTrack && fitTrack->hasKalmanFitStatus()) {
+               if (fitTrack && fitTrack->hasKalmanFitStatus(fit.rep)) {
 
-                  auto KalmanFitStatus = fitTrack->getKalmanFitStatus();
-                  auto trackRep = fitTrack->getTrackRep(0); // Only one representation is sved for the moment.
+                  auto KalmanFitStatus = fitTrack->getKalmanFitStatus(fit.rep);
+                  auto trackRep = fit.rep;
                   fitConverged = KalmanFitStatus->isFitConverged(false);
 
                   if (KalmanFitStatus->isFitConverged(false)) {
                      // KalmanFitStatus->Print();
-                     genfit::MeasuredStateOnPlane fitState = fitTrack->getFittedState();
+                     genfit::MeasuredStateOnPlane fitState = fitTrack->getFittedState(0, trackRep);
                      particleQ = fitState.getCharge();
 
                      fChi2 = KalmanFitStatus->getForwardChi2();
@@ -937,19 +936,27 @@ Bool_t FitManager::SetFitters(Bool_t simConv)
 {
    fSimulationConv = simConv;
 
+   // A single fitter with one hypothesis per ion
+   const auto &firstIon = ionList->front();
+   fFitter = new AtFITTER::AtGenfit(fMagneticField, 0.00001, 1000.0, fWorkDir.Data() + firstIon._eLossFile,
+                                    fGasDensity, (Int_t)firstIon._PDG, 5, 20, fNoMatEffects);
+   auto *genfitter = dynamic_cast<AtFITTER::AtGenfit *>(fFitter);
+   genfitter->SetIonName(firstIon._ionName);
+   genfitter->SetMass((Double_t)firstIon._mass);
+   genfitter->SetAtomicNumber((Int_t)firstIon._atomicNumber);
+   genfitter->SetNumFitPoints(1.0);
+   genfitter->SetVerbosityLevel(1);
+   genfitter->SetSimulationConvention(fSimulationConv);
+
    for (auto ion : *ionList) {
-     std::cout << " Creating fitter for : " << ion._ionName << " - " << (Int_t)ion._PDG << "\n";
-     std::cout << " Energy loss file : " << fWorkDir.Data() + ion._eLossFile << "\n";
-     fFitter = new AtFITTER::AtGenfit(fMagneticField, 0.00001, 1000.0, fWorkDir.Data() + ion._eLossFile, fGasDensity,
-                                      (Int_t)ion._PDG, 5, 20, fNoMatEffects);
-     // dynamic_cast<AtFITTER::AtGenfit*>(fFitter)->SetPDGCode((Int_t)ion._PDG);
-     dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetIonName(ion._ionName);
-     dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetMass((Double_t)ion._mass);
-     dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetAtomicNumber((Int_t)ion._atomicNumber);
-     dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetNumFitPoints(1.0);
-     dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetVerbosityLevel(1);
-     dynamic_cast<AtFITTER::AtGenfit *>(fFitter)->SetSimulationConvention(fSimulationConv);
-     fFitters.push_back(fFitter);
+      std::cout << " Adding hypothesis for : " << ion._ionName << " - " << (Int_t)ion._PDG << "\n";
+      std::cout << " Energy loss file : " << fWorkDir.Data() + ion._eLossFile << "\n";
+      AtFITTER::AtGenfit::Hypothesis hypothesis;
+      hypothesis.pdg = (Int_t)ion._PDG;
+      hypothesis.mass = ion._mass;
+      hypothesis.atomicNumber = ion._atomicNumber;
+      hypothesis.eLossFile = fWorkDir.Data() + ion._eLossFile;
+      genfitter->AddHypothesis(hypothesis);
    }
    return true;
 }
@@ -192,7 +192,6 @@ private:
    std::shared_ptr<TTreeReaderValue<UInt_t>> fMultIC;
    std::shared_ptr<TTreeReaderValue<std::string>> fFribEvName;
 
-   std::vector<AtFITTER::AtFitter *> fFitters;
    AtFITTER::AtFitter *fFitter;
    std::shared_ptr<AtTools::AtKinematics> fKinematics;
    firstOrbit GetFirstOrbit(genfit::Track *track, genfit::AbsTrackRep *rep, TVector3 vertex);